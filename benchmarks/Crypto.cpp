@@ -0,0 +1,265 @@
+/**
+ * @file Crypto.cpp
+ * @author Michal Ľaš
+ * @brief Micro-benchmarks of signature algorithms, hash functions and Merkle root computation
+ * @date 2024-05-12
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Run from root folder of the project (logger writes to tmp/log.txt):
+ * ./build/benchmarks/CryptoBench [--benchmark_filter=Falcon512] [--benchmark_out=crypto.json --benchmark_out_format=json]
+ *
+ * Signature benchmarks report operations per second (items_per_second), latency percentiles of single operations
+ * in microseconds (p50_us, p90_us, p99_us) and sizes of keys and signatures in bytes. Sign and verify run with
+ * 1, 2, 4 and 8 threads.
+ */
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include "Log.hpp"
+#include "Signer.hpp"
+#include "RandomGenerator.hpp"
+#include "HashManager.hpp"
+#include "MerkleRootCompute.hpp"
+
+
+namespace{
+
+    /// @brief Seed of the random generator, so the benchmarks use the same keys every run
+    constexpr uint64_t RANDOM_SEED = 2024;
+    /// @brief Maximal number of threads of sign and verify benchmarks
+    constexpr int MAX_THREADS = 8;
+    /// @brief Minimal time of one benchmark in seconds (keeps the whole suite within seconds)
+    constexpr double MIN_TIME = 0.05;
+
+    /// @brief Latencies of single operations, reported as percentiles
+    class LatencyRecorder{
+    public:
+        template <class Operation>
+        void measure(Operation &&operation){
+            auto start = std::chrono::steady_clock::now();
+            operation();
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        }
+
+        void report(benchmark::State &state){
+            if (samples.empty()){
+                return;
+            }
+            std::sort(samples.begin(), samples.end());
+            // percentiles of all threads are averaged
+            state.counters["p50_us"] = benchmark::Counter(percentile(0.50), benchmark::Counter::kAvgThreads);
+            state.counters["p90_us"] = benchmark::Counter(percentile(0.90), benchmark::Counter::kAvgThreads);
+            state.counters["p99_us"] = benchmark::Counter(percentile(0.99), benchmark::Counter::kAvgThreads);
+        }
+
+    private:
+        std::vector<double> samples;
+
+        double percentile(double p) const {
+            return samples[static_cast<size_t>(p * (samples.size() - 1))];
+        }
+    };
+
+    /// @brief Set size counter which is the same for all threads
+    void setSize(benchmark::State &state, const char *name, size_t size){
+        state.counters[name] = benchmark::Counter(static_cast<double>(size), benchmark::Counter::kAvgThreads);
+    }
+
+    /// @brief Keys and signature of a transaction ID shared by all benchmarks of an algorithm
+    template <class Algorithm>
+    struct KeyMaterial{
+        Algorithm algorithm;
+        PQB::byteBuffer pk;
+        PQB::byteBuffer sk;
+        PQB::byteBuffer message;
+        PQB::byteBuffer signature;
+        PQB::ExpandedPrivateKeyPtr expandedKey;
+        PQB::PreparedPublicKeyPtr preparedKey;
+
+        KeyMaterial() : message(PQB::HashMan::SHA512_SIZE, 0xab) {
+            algorithm.genKeys(sk, pk);
+            algorithm.sign(signature, message.data(), message.size(), sk);
+            expandedKey = algorithm.expandPrivateKey(sk);
+            preparedKey = algorithm.preparePublicKey(pk);
+        }
+
+        static const KeyMaterial &get(){
+            static const KeyMaterial keys;
+            return keys;
+        }
+    };
+
+    void signatureBenchmark(benchmark::internal::Benchmark *b){
+        b->ThreadRange(1, MAX_THREADS)->UseRealTime()->MinTime(MIN_TIME)->Unit(benchmark::kMicrosecond);
+    }
+
+    void singleThreadBenchmark(benchmark::internal::Benchmark *b){
+        b->UseRealTime()->MinTime(MIN_TIME)->Unit(benchmark::kMicrosecond);
+    }
+
+} // anonymous namespace
+
+
+/*********** Signature algorithms ***********/
+
+template <class Algorithm>
+static void BM_KeyGen(benchmark::State &state){
+    Algorithm algorithm;
+    PQB::byteBuffer pk;
+    PQB::byteBuffer sk;
+    LatencyRecorder latency;
+    for (auto _ : state){
+        latency.measure([&](){ algorithm.genKeys(sk, pk); });
+    }
+    state.SetItemsProcessed(state.iterations());
+    latency.report(state);
+    setSize(state, "pk_bytes", pk.size());
+    setSize(state, "sk_bytes", sk.size());
+}
+
+template <class Algorithm>
+static void BM_Sign(benchmark::State &state){
+    const KeyMaterial<Algorithm> &keys = KeyMaterial<Algorithm>::get();
+    Algorithm algorithm;
+    PQB::byteBuffer signature;
+    LatencyRecorder latency;
+    size_t signatureBytes = 0;
+    for (auto _ : state){
+        latency.measure([&](){ algorithm.sign(signature, keys.message.data(), keys.message.size(), keys.sk); });
+        signatureBytes += signature.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+    latency.report(state);
+    setSize(state, "sig_bytes", state.iterations() ? signatureBytes / state.iterations() : 0);
+}
+
+template <class Algorithm>
+static void BM_SignExpanded(benchmark::State &state){
+    const KeyMaterial<Algorithm> &keys = KeyMaterial<Algorithm>::get();
+    Algorithm algorithm;
+    PQB::byteBuffer signature;
+    LatencyRecorder latency;
+    for (auto _ : state){
+        latency.measure([&](){ algorithm.sign(signature, keys.message.data(), keys.message.size(), *keys.expandedKey); });
+    }
+    state.SetItemsProcessed(state.iterations());
+    latency.report(state);
+}
+
+template <class Algorithm>
+static void BM_Verify(benchmark::State &state){
+    const KeyMaterial<Algorithm> &keys = KeyMaterial<Algorithm>::get();
+    Algorithm algorithm;
+    LatencyRecorder latency;
+    bool valid = true;
+    for (auto _ : state){
+        latency.measure([&](){ valid &= algorithm.verify(keys.signature, keys.message.data(), keys.message.size(), keys.pk); });
+    }
+    if (!valid){
+        state.SkipWithError("Signature verification failed");
+    }
+    state.SetItemsProcessed(state.iterations());
+    latency.report(state);
+}
+
+template <class Algorithm>
+static void BM_VerifyPrepared(benchmark::State &state){
+    const KeyMaterial<Algorithm> &keys = KeyMaterial<Algorithm>::get();
+    Algorithm algorithm;
+    LatencyRecorder latency;
+    bool valid = true;
+    for (auto _ : state){
+        latency.measure([&](){ valid &= algorithm.verify(keys.signature, keys.message.data(), keys.message.size(), *keys.preparedKey); });
+    }
+    if (!valid){
+        state.SkipWithError("Signature verification failed");
+    }
+    state.SetItemsProcessed(state.iterations());
+    latency.report(state);
+}
+
+#define PQB_SIGNATURE_BENCHMARKS(Algorithm) \
+    BENCHMARK_TEMPLATE(BM_KeyGen, Algorithm)->Apply(singleThreadBenchmark); \
+    BENCHMARK_TEMPLATE(BM_Sign, Algorithm)->Apply(signatureBenchmark); \
+    BENCHMARK_TEMPLATE(BM_SignExpanded, Algorithm)->Apply(signatureBenchmark); \
+    BENCHMARK_TEMPLATE(BM_Verify, Algorithm)->Apply(signatureBenchmark); \
+    BENCHMARK_TEMPLATE(BM_VerifyPrepared, Algorithm)->Apply(signatureBenchmark)
+
+PQB_SIGNATURE_BENCHMARKS(PQB::Falcon512);
+PQB_SIGNATURE_BENCHMARKS(PQB::Falcon1024);
+PQB_SIGNATURE_BENCHMARKS(PQB::Dilithium2);
+PQB_SIGNATURE_BENCHMARKS(PQB::Dilithium3);
+PQB_SIGNATURE_BENCHMARKS(PQB::Dilithium5);
+PQB_SIGNATURE_BENCHMARKS(PQB::Ed25519);
+PQB_SIGNATURE_BENCHMARKS(PQB::ECDSA);
+
+
+/*********** Hashes ***********/
+
+/// @brief SHA-512 of state.range(0) bytes
+static void BM_SHA512(benchmark::State &state){
+    PQB::byteBuffer data(state.range(0), 0xab);
+    byteId_t hash;
+    for (auto _ : state){
+        PQB::HashMan::SHA512_hash(&hash, data.data(), data.size());
+        benchmark::DoNotOptimize(hash);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_SHA512)->RangeMultiplier(8)->Range(64, 64 << 12)->MinTime(MIN_TIME);
+
+/// @brief CRC32C of state.range(0) bytes (hardware implementation if it is supported)
+static void BM_CRC32C(benchmark::State &state){
+    PQB::byteBuffer data(state.range(0), 0xab);
+    for (auto _ : state){
+        benchmark::DoNotOptimize(PQB::HashMan::CRC32C(data.data(), data.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+    state.SetLabel(PQB::HashMan::CRC32C_hardwareSupport() ? "hardware" : "software");
+}
+BENCHMARK(BM_CRC32C)->RangeMultiplier(8)->Range(64, 64 << 12)->MinTime(MIN_TIME);
+
+/// @brief Software CRC32C of state.range(0) bytes
+static void BM_CRC32C_Software(benchmark::State &state){
+    PQB::byteBuffer data(state.range(0), 0xab);
+    for (auto _ : state){
+        benchmark::DoNotOptimize(PQB::HashMan::CRC32C_software(data.data(), data.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_CRC32C_Software)->RangeMultiplier(8)->Range(64, 64 << 12)->MinTime(MIN_TIME);
+
+
+/*********** Merkle tree ***********/
+
+/// @brief Merkle root of state.range(0) transaction IDs
+static void BM_MerkleRoot(benchmark::State &state){
+    std::vector<byteId_t> leafs(state.range(0));
+    for (size_t i = 0; i < leafs.size(); i++){
+        PQB::HashMan::SHA512_hash(&leafs[i], reinterpret_cast<const PQB::byte*>(&i), sizeof(i));
+    }
+    for (auto _ : state){
+        benchmark::DoNotOptimize(PQB::ComputeMerkleRoot(leafs));
+    }
+    state.SetItemsProcessed(state.iterations() * leafs.size());
+}
+BENCHMARK(BM_MerkleRoot)->RangeMultiplier(4)->Range(16, 4096)->MinTime(MIN_TIME)->Unit(benchmark::kMicrosecond);
+
+
+int main(int argc, char **argv){
+    PQB::Log::init();
+    PQB::RandomGenerator::configure({.deterministic=true, .seed=RANDOM_SEED});
+    PQB::RandomGenerator::install();
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
+
+/* END OF FILE */
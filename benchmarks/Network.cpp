@@ -0,0 +1,145 @@
+/**
+ * @file Network.cpp
+ * @author Michal Ľaš
+ * @brief Benchmark of broadcasting messages by a network I/O thread with epoll and io_uring backends on loopback
+ * @date 2024-05-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Run from root folder of the project (logger writes to tmp/log.txt):
+ * ./build/benchmarks/NetworkBench [--benchmark_filter=backend:1]
+ *
+ * One NetworkReactor owns TCP connections with peers on 127.0.0.1 and broadcasts BATCH_SIZE messages to all of them
+ * in each iteration, the benchmark thread receives the frames as the peers. Backend 0 is epoll, backend 1 is io_uring.
+ * Besides throughput of sent frames (items_per_second), system calls of the I/O thread per sent frame
+ * (syscalls_per_frame) and iterations of its event loop per sent frame (loops_per_frame) are reported.
+ */
+
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <poll.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "Log.hpp"
+#include "MessageManagement.hpp"
+
+
+namespace{
+
+    /// @brief Number of broadcasts in one iteration
+    constexpr size_t BATCH_SIZE = 32;
+    /// @brief Minimal time of one benchmark in seconds
+    constexpr double MIN_TIME = 0.2;
+
+    /// @brief Network I/O thread with TCP connections with peers on loopback (peer sockets are read by the benchmark)
+    class LoopbackPeers{
+    public:
+        LoopbackPeers(PQB::IOBackend backend, size_t count)
+        : reactor(std::make_unique<PQB::NetworkReactor>(nullptr, 0, backend)) {
+            int listener = socket(AF_INET, SOCK_STREAM, 0);
+            struct sockaddr_in address = {};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            socklen_t addressLen = sizeof(address);
+            bind(listener, reinterpret_cast<struct sockaddr*>(&address), addressLen);
+            listen(listener, count);
+            getsockname(listener, reinterpret_cast<struct sockaddr*>(&address), &addressLen);
+            for (size_t i = 0; i < count; i++){
+                int peer = socket(AF_INET, SOCK_STREAM, 0);
+                connect(peer, reinterpret_cast<struct sockaddr*>(&address), addressLen);
+                peers.push_back(peer);
+                std::string connectionID = "peer" + std::to_string(i);
+                PQB::Connection *connection = new PQB::Connection(connectionID, new PQB::Sock(accept(listener, nullptr, nullptr)));
+                connection->isConfirmed = true;
+                reactor->addConnection(connection, nullptr);
+            }
+            close(listener);
+        }
+
+        ~LoopbackPeers(){
+            // the reactor is stopped first, so closed peers are not noticed
+            reactor.reset();
+            for (int peer : peers){
+                close(peer);
+            }
+        }
+
+        /// @brief Receive size bytes on each peer socket
+        void receive(size_t size){
+            std::vector<size_t> received(peers.size(), 0);
+            std::vector<struct pollfd> fds(peers.size());
+            PQB::byte buffer[64 * 1024];
+            size_t done = 0;
+            while (done < peers.size()){
+                for (size_t i = 0; i < peers.size(); i++){
+                    fds[i] = {.fd=(received[i] < size ? peers[i] : -1), .events=POLLIN, .revents=0};
+                }
+                poll(fds.data(), fds.size(), 1000);
+                for (size_t i = 0; i < peers.size(); i++){
+                    if ((fds[i].revents & POLLIN) == 0){
+                        continue;
+                    }
+                    ssize_t n = recv(peers[i], buffer, sizeof(buffer), MSG_DONTWAIT);
+                    if (n > 0 && (received[i] += n) >= size){
+                        done++;
+                    }
+                }
+            }
+        }
+
+        std::unique_ptr<PQB::NetworkReactor> reactor;
+
+    private:
+        std::vector<int> peers;
+    };
+
+} // anonymous namespace
+
+
+/// @brief Broadcast messages with state.range(2) bytes of payload to state.range(1) peers with backend state.range(0)
+static void BM_Broadcast(benchmark::State &state){
+    PQB::IOBackend backend = static_cast<PQB::IOBackend>(state.range(0));
+    size_t numOfPeers = state.range(1);
+    size_t payloadSize = state.range(2);
+    auto loopback = std::make_unique<LoopbackPeers>(backend, numOfPeers);
+    PQB::ConnectionManager::MessageRequest_t req = {.type=PQB::ConnectionManager::MessageRequestType::BROADCAST,
+                                                    .connectionID=0, .peerID="", .message=nullptr};
+    // the first message is received when the reactor took all connections
+    loopback->reactor->addMessageRequest(req, std::make_shared<PQB::BlockMessage>(payloadSize), nullptr, false);
+    loopback->receive(payloadSize + PQB::Message::HEADER_SIZE);
+    if (loopback->reactor->getStats().backend != backend){
+        state.SkipWithError("io_uring is not available");
+        return;
+    }
+    PQB::NetworkReactor::Stats_t before = loopback->reactor->getStats();
+    for (auto _ : state){
+        for (size_t i = 0; i < BATCH_SIZE; i++){
+            loopback->reactor->addMessageRequest(req, std::make_shared<PQB::BlockMessage>(payloadSize), nullptr, false);
+        }
+        loopback->receive(BATCH_SIZE * (payloadSize + PQB::Message::HEADER_SIZE));
+    }
+    PQB::NetworkReactor::Stats_t after = loopback->reactor->getStats();
+    double frames = static_cast<double>(state.iterations() * BATCH_SIZE * numOfPeers);
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE * numOfPeers);
+    state.SetBytesProcessed(state.iterations() * BATCH_SIZE * numOfPeers * (payloadSize + PQB::Message::HEADER_SIZE));
+    state.counters["syscalls_per_frame"] = (after.systemCalls - before.systemCalls) / frames;
+    state.counters["loops_per_frame"] = (after.loops - before.loops) / frames;
+    state.SetLabel(backend == PQB::IOBackend::IO_URING ? "io_uring" : "epoll");
+}
+BENCHMARK(BM_Broadcast)
+    ->ArgNames({"backend", "peers", "payload"})
+    ->ArgsProduct({{static_cast<int64_t>(PQB::IOBackend::EPOLL), static_cast<int64_t>(PQB::IOBackend::IO_URING)}, {8, 64}, {256, 16 * 1024}})
+    ->UseRealTime()->MinTime(MIN_TIME)->Unit(benchmark::kMicrosecond);
+
+
+int main(int argc, char **argv){
+    PQB::Log::init();
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
+
+/* END OF FILE */
@@ -0,0 +1,100 @@
+/**
+ * @file SignatureVerifier.cpp
+ * @author Michal Ľaš
+ * @brief Throughput benchmark of parallel signature verification
+ * @date 2024-05-06
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Run from root folder of the project (logger writes to tmp/log.txt):
+ * ./build/benchmarks/SignatureVerifierBench [--benchmark_format=json]
+ */
+
+#include <benchmark/benchmark.h>
+#include "Log.hpp"
+#include "Signer.hpp"
+#include "SignatureVerifier.hpp"
+#include "RandomGenerator.hpp"
+
+
+namespace{
+
+    constexpr size_t BATCH_SIZE = 256;
+    /// @brief Seed of the random generator, so the benchmarks verify the same keys and signatures every run
+    constexpr uint64_t RANDOM_SEED = 2024;
+
+    /// @brief Signed transaction IDs shared by all benchmarks
+    struct SignedData{
+        PQB::byteBuffer pk;
+        PQB::byteBuffer sk;
+        std::vector<PQB::byteBuffer> hashes;
+        std::vector<PQB::byteBuffer> signatures;
+
+        SignedData(){
+            auto ss = PQB::Signer::GetInstance();
+            ss->genKeys(sk, pk);
+            hashes.resize(BATCH_SIZE);
+            signatures.resize(BATCH_SIZE);
+            for (size_t i = 0; i < BATCH_SIZE; i++){
+                hashes[i].resize(64, static_cast<PQB::byte>(i));
+                ss->sign(signatures[i], hashes[i].data(), hashes[i].size(), sk);
+            }
+        }
+
+        PQB::SignatureVerifier::VerifyBatch createBatch() const {
+            PQB::SignatureVerifier::VerifyBatch batch;
+            for (size_t i = 0; i < BATCH_SIZE; i++){
+                batch.push_back({.data=hashes[i].data(), .dataSize=hashes[i].size(), .signature=&signatures[i], .publicKey=&pk});
+            }
+            return batch;
+        }
+    };
+
+    const SignedData &getSignedData(){
+        static SignedData data;
+        return data;
+    }
+
+} // anonymous namespace
+
+
+/// @brief Verification on the calling thread, one signature after another (baseline)
+static void BM_SerialVerify(benchmark::State &state){
+    const SignedData &data = getSignedData();
+    auto ss = PQB::Signer::GetInstance();
+    for (auto _ : state){
+        for (size_t i = 0; i < BATCH_SIZE; i++){
+            benchmark::DoNotOptimize(ss->verify(data.signatures[i], data.hashes[i].data(), data.hashes[i].size(), data.pk));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+BENCHMARK(BM_SerialVerify)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+
+/// @brief Verification of batches by SignatureVerifier with state.range(0) worker threads
+static void BM_SignatureVerifier(benchmark::State &state){
+    const SignedData &data = getSignedData();
+    PQB::SignatureVerifier verifier(state.range(0));
+    for (auto _ : state){
+        PQB::SignatureVerifier::Verdicts verdicts = verifier.verify(data.createBatch());
+        benchmark::DoNotOptimize(verdicts);
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+    state.counters["threads"] = state.range(0);
+}
+BENCHMARK(BM_SignatureVerifier)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+
+int main(int argc, char **argv){
+    PQB::Log::init();
+    PQB::RandomGenerator::configure({.deterministic=true, .seed=RANDOM_SEED});
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
+
+/* END OF FILE */
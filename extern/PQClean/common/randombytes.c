@@ -325,7 +325,22 @@ static int randombytes_js_randombytes_nodejs(void *buf, size_t n) {
 }
 #endif /* defined(__EMSCRIPTEN__) */
 
+/* Source set by PQCLEAN_randombytes_set_source, NULL means the system source */
+static randombytes_source_fn randombytes_source = NULL;
+
+void PQCLEAN_randombytes_set_source(randombytes_source_fn source) {
+    __atomic_store_n(&randombytes_source, source, __ATOMIC_RELEASE);
+}
+
 int randombytes(uint8_t *output, size_t n) {
+    randombytes_source_fn source = __atomic_load_n(&randombytes_source, __ATOMIC_ACQUIRE);
+    if (source != NULL) {
+        return source(output, n);
+    }
+    return PQCLEAN_randombytes_system(output, n);
+}
+
+int PQCLEAN_randombytes_system(uint8_t *output, size_t n) {
     void *buf = (void *)output;
     #if defined(__EMSCRIPTEN__)
     return randombytes_js_randombytes_nodejs(buf, n);
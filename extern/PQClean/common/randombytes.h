@@ -20,6 +20,23 @@ extern "C" {
 #define randombytes     PQCLEAN_randombytes
 int randombytes(uint8_t *output, size_t n);
 
+/*
+ * Write `n` bytes of random bytes from the operating system to `buf`,
+ * regardless of the source set by PQCLEAN_randombytes_set_source
+ */
+int PQCLEAN_randombytes_system(uint8_t *output, size_t n);
+
+/*
+ * Function serving randombytes(), it has to be thread-safe
+ */
+typedef int (*randombytes_source_fn)(uint8_t *output, size_t n);
+
+/*
+ * Serve randombytes() from `source` (e.g. a userspace DRBG),
+ * NULL restores the system source
+ */
+void PQCLEAN_randombytes_set_source(randombytes_source_fn source);
+
 #ifdef __cplusplus
 }
 #endif
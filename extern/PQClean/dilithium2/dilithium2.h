@@ -7,6 +7,8 @@
 #define PQCLEAN_DILITHIUM2_AVX2_CRYPTO_PUBLICKEYBYTES 1312
 #define PQCLEAN_DILITHIUM2_AVX2_CRYPTO_SECRETKEYBYTES 2560
 #define PQCLEAN_DILITHIUM2_AVX2_CRYPTO_BYTES 2420
+/* Prepared public key: (K*L + K) polynomials and CRH(pk), the buffer has to be aligned to 32 bytes */
+#define PQCLEAN_DILITHIUM2_AVX2_CRYPTO_PREPAREDPKBYTES 20544
 #define PQCLEAN_DILITHIUM2_AVX2_CRYPTO_ALGNAME "Dilithium2"
 
 int PQCLEAN_DILITHIUM2_AVX2_crypto_sign_keypair(uint8_t *pk, uint8_t *sk);
@@ -23,6 +25,12 @@ int PQCLEAN_DILITHIUM2_AVX2_crypto_sign_verify(const uint8_t *sig, size_t siglen
         const uint8_t *m, size_t mlen,
         const uint8_t *pk);
 
+int PQCLEAN_DILITHIUM2_AVX2_crypto_sign_prepare_pk(uint8_t *ppk, const uint8_t *pk);
+
+int PQCLEAN_DILITHIUM2_AVX2_crypto_sign_verify_prepared(const uint8_t *sig, size_t siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ppk);
+
 int PQCLEAN_DILITHIUM2_AVX2_crypto_sign_open(uint8_t *m, size_t *mlen,
         const uint8_t *sm, size_t smlen,
         const uint8_t *pk);
@@ -306,9 +306,12 @@ int PQCLEAN_DILITHIUM2_AVX2_crypto_sign_verify(const uint8_t *sig, size_t siglen
     PQCLEAN_DILITHIUM2_AVX2_poly_challenge(&c, sig);
     PQCLEAN_DILITHIUM2_AVX2_poly_ntt(&c);
 
-    /* Unpack z; shortness follows from unpacking */
+    /* Unpack z and check its norm */
     for (i = 0; i < L; i++) {
         PQCLEAN_DILITHIUM2_AVX2_polyz_unpack(&z.vec[i], sig + CTILDEBYTES + i * POLYZ_PACKEDBYTES);
+        if (PQCLEAN_DILITHIUM2_AVX2_poly_chknorm(&z.vec[i], GAMMA1 - BETA)) {
+            return -1;
+        }
         PQCLEAN_DILITHIUM2_AVX2_poly_ntt(&z.vec[i]);
     }
 
@@ -371,6 +374,156 @@ int PQCLEAN_DILITHIUM2_AVX2_crypto_sign_verify(const uint8_t *sig, size_t siglen
     return 0;
 }
 
+/* Public key expanded to the form used by signature verification */
+typedef struct {
+    polyvecl mat[K];        /* matrix A expanded from rho */
+    polyveck t1;            /* t1 * 2^D in NTT domain */
+    uint8_t tr[CRHBYTES];   /* CRH(rho, t1) */
+} prepared_pk;
+
+/* Check that the size in the API header matches the structure */
+typedef char prepared_pk_size_check[(sizeof(prepared_pk) == PQCLEAN_DILITHIUM2_AVX2_CRYPTO_PREPAREDPKBYTES) ? 1 : -1];
+
+/*************************************************
+* Name:        PQCLEAN_DILITHIUM2_AVX2_crypto_sign_prepare_pk
+*
+* Description: Expands public key for repeated signature verification.
+*              Matrix A is expanded from rho and t1 is converted to NTT
+*              domain, so these steps are skipped by
+*              PQCLEAN_DILITHIUM2_AVX2_crypto_sign_verify_prepared.
+*
+* Arguments:   - uint8_t *ppk: pointer to output prepared key (allocated
+*                              array of PQCLEAN_DILITHIUM2_AVX2_CRYPTO_PREPAREDPKBYTES
+*                              bytes aligned to 32 bytes)
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 on success and -1 if ppk is not aligned
+**************************************************/
+int PQCLEAN_DILITHIUM2_AVX2_crypto_sign_prepare_pk(uint8_t *ppk, const uint8_t *pk) {
+    unsigned int i;
+    prepared_pk *prep = (prepared_pk *)ppk;
+
+    if ((uintptr_t)ppk % 32 != 0) {
+        return -1;
+    }
+
+    shake256(prep->tr, CRHBYTES, pk, PQCLEAN_DILITHIUM2_AVX2_CRYPTO_PUBLICKEYBYTES);
+    PQCLEAN_DILITHIUM2_AVX2_polyvec_matrix_expand(prep->mat, pk);
+    for (i = 0; i < K; i++) {
+        PQCLEAN_DILITHIUM2_AVX2_polyt1_unpack(&prep->t1.vec[i], pk + SEEDBYTES + i * POLYT1_PACKEDBYTES);
+        PQCLEAN_DILITHIUM2_AVX2_poly_shiftl(&prep->t1.vec[i]);
+        PQCLEAN_DILITHIUM2_AVX2_poly_ntt(&prep->t1.vec[i]);
+    }
+
+    return 0;
+}
+
+/*************************************************
+* Name:        PQCLEAN_DILITHIUM2_AVX2_crypto_sign_verify_prepared
+*
+* Description: Verifies signature with prepared public key.
+*
+* Arguments:   - uint8_t *m: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *m: pointer to message
+*              - size_t mlen: length of message
+*              - const uint8_t *ppk: pointer to public key prepared by
+*                                    PQCLEAN_DILITHIUM2_AVX2_crypto_sign_prepare_pk
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int PQCLEAN_DILITHIUM2_AVX2_crypto_sign_verify_prepared(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen, const uint8_t *ppk) {
+    unsigned int i, j, pos = 0;
+    /* PQCLEAN_DILITHIUM2_AVX2_polyw1_pack writes additional 14 bytes */
+    ALIGNED_UINT8(K * POLYW1_PACKEDBYTES + 14) buf;
+    uint8_t mu[CRHBYTES];
+    const uint8_t *hint = sig + CTILDEBYTES + L * POLYZ_PACKEDBYTES;
+    const prepared_pk *prep = (const prepared_pk *)ppk;
+    polyvecl z;
+    poly c, w1, h;
+    shake256incctx state;
+
+    if (siglen != PQCLEAN_DILITHIUM2_AVX2_CRYPTO_BYTES) {
+        return -1;
+    }
+    if ((uintptr_t)ppk % 32 != 0) {
+        return -1;
+    }
+
+    /* Compute CRH(H(rho, t1), msg) */
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, prep->tr, CRHBYTES);
+    shake256_inc_absorb(&state, m, mlen);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(mu, CRHBYTES, &state);
+    shake256_inc_ctx_release(&state);
+
+    /* Expand PQCLEAN_DILITHIUM2_AVX2_challenge */
+    PQCLEAN_DILITHIUM2_AVX2_poly_challenge(&c, sig);
+    PQCLEAN_DILITHIUM2_AVX2_poly_ntt(&c);
+
+    /* Unpack z and check its norm */
+    for (i = 0; i < L; i++) {
+        PQCLEAN_DILITHIUM2_AVX2_polyz_unpack(&z.vec[i], sig + CTILDEBYTES + i * POLYZ_PACKEDBYTES);
+        if (PQCLEAN_DILITHIUM2_AVX2_poly_chknorm(&z.vec[i], GAMMA1 - BETA)) {
+            return -1;
+        }
+        PQCLEAN_DILITHIUM2_AVX2_poly_ntt(&z.vec[i]);
+    }
+
+    for (i = 0; i < K; i++) {
+        /* Compute i-th row of Az - c2^Dt1 */
+        PQCLEAN_DILITHIUM2_AVX2_polyvecl_pointwise_acc_montgomery(&w1, &prep->mat[i], &z);
+
+        PQCLEAN_DILITHIUM2_AVX2_poly_pointwise_montgomery(&h, &c, &prep->t1.vec[i]);
+
+        PQCLEAN_DILITHIUM2_AVX2_poly_sub(&w1, &w1, &h);
+        PQCLEAN_DILITHIUM2_AVX2_poly_reduce(&w1);
+        PQCLEAN_DILITHIUM2_AVX2_poly_invntt_tomont(&w1);
+
+        /* Get hint polynomial and reconstruct w1 */
+        memset(h.vec, 0, sizeof(poly));
+        if (hint[OMEGA + i] < pos || hint[OMEGA + i] > OMEGA) {
+            return -1;
+        }
+
+        for (j = pos; j < hint[OMEGA + i]; ++j) {
+            /* Coefficients are ordered for strong unforgeability */
+            if (j > pos && hint[j] <= hint[j - 1]) {
+                return -1;
+            }
+            h.coeffs[hint[j]] = 1;
+        }
+        pos = hint[OMEGA + i];
+
+        PQCLEAN_DILITHIUM2_AVX2_poly_caddq(&w1);
+        PQCLEAN_DILITHIUM2_AVX2_poly_use_hint(&w1, &w1, &h);
+        PQCLEAN_DILITHIUM2_AVX2_polyw1_pack(buf.coeffs + i * POLYW1_PACKEDBYTES, &w1);
+    }
+
+    /* Extra indices are zero for strong unforgeability */
+    for (j = pos; j < OMEGA; ++j) {
+        if (hint[j]) {
+            return -1;
+        }
+    }
+
+    /* Call random oracle and verify PQCLEAN_DILITHIUM2_AVX2_challenge */
+    shake256_inc_init(&state);
+    shake256_inc_absorb(&state, mu, CRHBYTES);
+    shake256_inc_absorb(&state, buf.coeffs, K * POLYW1_PACKEDBYTES);
+    shake256_inc_finalize(&state);
+    shake256_inc_squeeze(buf.coeffs, CTILDEBYTES, &state);
+    shake256_inc_ctx_release(&state);
+    for (i = 0; i < CTILDEBYTES; ++i) {
+        if (buf.coeffs[i] != sig[i]) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
 /*************************************************
 * Name:        PQCLEAN_DILITHIUM2_AVX2_crypto_sign_open
 *
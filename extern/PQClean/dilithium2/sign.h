@@ -22,6 +22,12 @@ int PQCLEAN_DILITHIUM2_AVX2_crypto_sign_verify(const uint8_t *sig, size_t siglen
         const uint8_t *m, size_t mlen,
         const uint8_t *pk);
 
+int PQCLEAN_DILITHIUM2_AVX2_crypto_sign_prepare_pk(uint8_t *ppk, const uint8_t *pk);
+
+int PQCLEAN_DILITHIUM2_AVX2_crypto_sign_verify_prepared(const uint8_t *sig, size_t siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ppk);
+
 int PQCLEAN_DILITHIUM2_AVX2_crypto_sign_open(uint8_t *m, size_t *mlen,
         const uint8_t *sm, size_t smlen,
         const uint8_t *pk);
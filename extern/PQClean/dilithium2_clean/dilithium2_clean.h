@@ -0,0 +1,38 @@
+#ifndef PQCLEAN_DILITHIUM2_CLEAN_API_H
+#define PQCLEAN_DILITHIUM2_CLEAN_API_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PQCLEAN_DILITHIUM2_CLEAN_CRYPTO_PUBLICKEYBYTES 1312
+#define PQCLEAN_DILITHIUM2_CLEAN_CRYPTO_SECRETKEYBYTES 2560
+#define PQCLEAN_DILITHIUM2_CLEAN_CRYPTO_BYTES 2420
+/* Prepared public key: (K*L + K) polynomials and CRH(pk), the buffer has to be aligned to 32 bytes */
+#define PQCLEAN_DILITHIUM2_CLEAN_CRYPTO_PREPAREDPKBYTES 20544
+#define PQCLEAN_DILITHIUM2_CLEAN_CRYPTO_ALGNAME "Dilithium2"
+
+int PQCLEAN_DILITHIUM2_CLEAN_crypto_sign_keypair(uint8_t *pk, uint8_t *sk);
+
+int PQCLEAN_DILITHIUM2_CLEAN_crypto_sign_signature(uint8_t *sig, size_t *siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *sk);
+
+int PQCLEAN_DILITHIUM2_CLEAN_crypto_sign(uint8_t *sm, size_t *smlen,
+                                        const uint8_t *m, size_t mlen,
+                                        const uint8_t *sk);
+
+int PQCLEAN_DILITHIUM2_CLEAN_crypto_sign_verify(const uint8_t *sig, size_t siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *pk);
+
+int PQCLEAN_DILITHIUM2_CLEAN_crypto_sign_prepare_pk(uint8_t *ppk, const uint8_t *pk);
+
+int PQCLEAN_DILITHIUM2_CLEAN_crypto_sign_verify_prepared(const uint8_t *sig, size_t siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ppk);
+
+int PQCLEAN_DILITHIUM2_CLEAN_crypto_sign_open(uint8_t *m, size_t *mlen,
+        const uint8_t *sm, size_t smlen,
+        const uint8_t *pk);
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef PQCLEAN_DILITHIUM2_CLEAN_PARAMS_H
+#define PQCLEAN_DILITHIUM2_CLEAN_PARAMS_H
+
+#define SEEDBYTES 32
+#define CRHBYTES 64
+#define TRBYTES 64
+#define RNDBYTES 32
+#define N 256
+#define Q 8380417
+#define D 13
+#define ROOT_OF_UNITY 1753
+
+#define K 4
+#define L 4
+#define ETA 2
+#define TAU 39
+#define BETA 78
+#define GAMMA1 (1 << 17)
+#define GAMMA2 ((Q-1)/88)
+#define OMEGA 80
+#define CTILDEBYTES 32
+
+#define POLYT1_PACKEDBYTES  320
+#define POLYT0_PACKEDBYTES  416
+#define POLYVECH_PACKEDBYTES (OMEGA + K)
+
+#define POLYZ_PACKEDBYTES   576
+
+#define POLYW1_PACKEDBYTES  192
+
+#define POLYETA_PACKEDBYTES  96
+
+#define PQCLEAN_DILITHIUM2_CLEAN_CRYPTO_PUBLICKEYBYTES (SEEDBYTES + K*POLYT1_PACKEDBYTES)
+#define PQCLEAN_DILITHIUM2_CLEAN_CRYPTO_SECRETKEYBYTES (2*SEEDBYTES \
+        + TRBYTES \
+        + L*POLYETA_PACKEDBYTES \
+        + K*POLYETA_PACKEDBYTES \
+        + K*POLYT0_PACKEDBYTES)
+#define PQCLEAN_DILITHIUM2_CLEAN_CRYPTO_BYTES (CTILDEBYTES + L*POLYZ_PACKEDBYTES + POLYVECH_PACKEDBYTES)
+#define PQCLEAN_DILITHIUM2_CLEAN_CRYPTO_PREPAREDPKBYTES ((K*L + K)*N*4 + CRHBYTES)
+
+#endif
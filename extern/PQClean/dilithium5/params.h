@@ -37,5 +37,6 @@
         + K*POLYETA_PACKEDBYTES \
         + K*POLYT0_PACKEDBYTES)
 #define PQCLEAN_DILITHIUM5_AVX2_CRYPTO_BYTES (CTILDEBYTES + L*POLYZ_PACKEDBYTES + POLYVECH_PACKEDBYTES)
+#define PQCLEAN_DILITHIUM5_AVX2_CRYPTO_PREPAREDPKBYTES ((K*L + K)*N*4 + CRHBYTES)
 
 #endif
@@ -8,6 +8,9 @@
 #define PQCLEAN_FALCON1024_AVX2_CRYPTO_PUBLICKEYBYTES   1793
 #define PQCLEAN_FALCON1024_AVX2_CRYPTO_BYTES            1462
 
+#define PQCLEAN_FALCON1024_AVX2_CRYPTO_EXPANDEDSKBYTES     122880
+#define PQCLEAN_FALCON1024_AVX2_CRYPTO_PREPAREDPKBYTES    2048
+
 #define PQCLEAN_FALCON1024_AVX2_CRYPTO_ALGNAME          "Falcon-1024"
 
 #define PQCLEAN_FALCONPADDED1024_AVX2_CRYPTO_BYTES      1280 // used in signature verification
@@ -37,6 +40,28 @@ int PQCLEAN_FALCON1024_AVX2_crypto_sign_signature(
     uint8_t *sig, size_t *siglen,
     const uint8_t *m, size_t mlen, const uint8_t *sk);
 
+/*
+ * Expand a private key (sk) into the form used by the fast signing
+ * path (LDL tree in FFT representation). The result is written into
+ * esk[], of size PQCLEAN_FALCON1024_AVX2_CRYPTO_EXPANDEDSKBYTES bytes and 64-bit
+ * alignment. The expanded key is as secret as the private key itself.
+ *
+ * Return value: 0 on success, -1 on error (invalid private key).
+ */
+int PQCLEAN_FALCON1024_AVX2_crypto_sign_expand_sk(
+    uint8_t *esk, const uint8_t *sk);
+
+/*
+ * Compute a signature on a provided message (m, mlen) with a private
+ * key expanded by PQCLEAN_FALCON1024_AVX2_crypto_sign_expand_sk() (esk). Output
+ * is the same as of PQCLEAN_FALCON1024_AVX2_crypto_sign_signature().
+ *
+ * Return value: 0 on success, -1 on error.
+ */
+int PQCLEAN_FALCON1024_AVX2_crypto_sign_signature_expanded(
+    uint8_t *sig, size_t *siglen,
+    const uint8_t *m, size_t mlen, const uint8_t *esk);
+
 /*
  * Verify a signature (sig, siglen) on a message (m, mlen) with a given
  * public key (pk).
@@ -49,6 +74,27 @@ int PQCLEAN_FALCON1024_AVX2_crypto_sign_verify(
     const uint8_t *sig, size_t siglen,
     const uint8_t *m, size_t mlen, const uint8_t *pk);
 
+/*
+ * Decode a public key (pk) into the form used internally by signature
+ * verification (NTT representation). The result is written into ppk[],
+ * of size PQCLEAN_FALCON1024_AVX2_CRYPTO_PREPAREDPKBYTES bytes, and it can be
+ * used for any number of calls of PQCLEAN_FALCON1024_AVX2_crypto_sign_verify_prepared().
+ *
+ * Return value: 0 on success, -1 on error (invalid public key).
+ */
+int PQCLEAN_FALCON1024_AVX2_crypto_sign_prepare_pk(
+    uint8_t *ppk, const uint8_t *pk);
+
+/*
+ * Verify a signature (sig, siglen) on a message (m, mlen) with a public
+ * key prepared by PQCLEAN_FALCON1024_AVX2_crypto_sign_prepare_pk() (ppk).
+ *
+ * Return value: 0 on success, -1 on error.
+ */
+int PQCLEAN_FALCON1024_AVX2_crypto_sign_verify_prepared(
+    const uint8_t *sig, size_t siglen,
+    const uint8_t *m, size_t mlen, const uint8_t *ppk);
+
 /*
  * Compute a signature on a message and pack the signature and message
  * into a single object, written into sm[]. The length of that output is
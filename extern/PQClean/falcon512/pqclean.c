@@ -109,36 +109,15 @@ PQCLEAN_FALCON512_AVX2_crypto_sign_keypair(
 }
 
 /*
- * Compute the signature. nonce[] receives the nonce and must have length
- * NONCELEN bytes. sigbuf[] receives the signature value (without nonce
- * or header byte), with *sigbuflen providing the maximum value length and
- * receiving the actual value length.
- *
- * If a signature could be computed but not encoded because it would
- * exceed the output buffer size, then an error is returned.
- *
- * Return value: 0 on success, -1 on error.
+ * Decode the private key (f, g and F) and recompute G. The tmp[] array
+ * must have room for at least 4*2^logn bytes and 16-bit alignment.
+ * Return value is 0 on success, -1 on error.
  */
 static int
-do_sign(uint8_t *nonce, uint8_t *sigbuf, size_t *sigbuflen,
-        const uint8_t *m, size_t mlen, const uint8_t *sk) {
-    union {
-        uint8_t b[72 * 512];
-        uint64_t dummy_u64;
-        fpr dummy_fpr;
-    } tmp;
-    int8_t f[512], g[512], F[512], G[512];
-    struct {
-        int16_t sig[512];
-        uint16_t hm[512];
-    } r;
-    unsigned char seed[48];
-    inner_shake256_context sc;
+decode_sk(int8_t *f, int8_t *g, int8_t *F, int8_t *G,
+          const uint8_t *sk, uint8_t *tmp) {
     size_t u, v;
 
-    /*
-     * Decode the private key.
-     */
     if (sk[0] != 0x50 + 9) {
         return -1;
     }
@@ -167,7 +146,45 @@ do_sign(uint8_t *nonce, uint8_t *sigbuf, size_t *sigbuflen,
     if (u != PQCLEAN_FALCON512_AVX2_CRYPTO_SECRETKEYBYTES) {
         return -1;
     }
-    if (!PQCLEAN_FALCON512_AVX2_complete_private(G, f, g, F, 9, tmp.b)) {
+    if (!PQCLEAN_FALCON512_AVX2_complete_private(G, f, g, F, 9, tmp)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * Compute the signature. nonce[] receives the nonce and must have length
+ * NONCELEN bytes. sigbuf[] receives the signature value (without nonce
+ * or header byte), with *sigbuflen providing the maximum value length and
+ * receiving the actual value length.
+ *
+ * If a signature could be computed but not encoded because it would
+ * exceed the output buffer size, then an error is returned.
+ *
+ * Return value: 0 on success, -1 on error.
+ */
+static int
+do_sign(uint8_t *nonce, uint8_t *sigbuf, size_t *sigbuflen,
+        const uint8_t *m, size_t mlen, const uint8_t *sk) {
+    union {
+        uint8_t b[72 * 512];
+        uint64_t dummy_u64;
+        fpr dummy_fpr;
+    } tmp;
+    int8_t f[512], g[512], F[512], G[512];
+    struct {
+        int16_t sig[512];
+        uint16_t hm[512];
+    } r;
+    unsigned char seed[48];
+    inner_shake256_context sc;
+    size_t v;
+
+    /*
+     * Decode the private key.
+     */
+    if (decode_sk(f, g, F, G, sk, tmp.b) < 0) {
         return -1;
     }
 
@@ -208,36 +225,99 @@ do_sign(uint8_t *nonce, uint8_t *sigbuf, size_t *sigbuflen,
 }
 
 /*
- * Verify a sigature. The nonce has size NONCELEN bytes. sigbuf[]
- * (of size sigbuflen) contains the signature value, not including the
- * header byte or nonce. Return value is 0 on success, -1 on error.
+ * Compute the signature with a private key expanded by
+ * PQCLEAN_FALCON512_AVX2_expand_privkey(). Arguments and return value
+ * are the same as for do_sign().
  */
 static int
-do_verify(
-    const uint8_t *nonce, const uint8_t *sigbuf, size_t sigbuflen,
-    const uint8_t *m, size_t mlen, const uint8_t *pk) {
+do_sign_tree(uint8_t *nonce, uint8_t *sigbuf, size_t *sigbuflen,
+             const uint8_t *m, size_t mlen, const fpr *expanded_key) {
     union {
-        uint8_t b[2 * 512];
+        uint8_t b[48 * 512];
         uint64_t dummy_u64;
         fpr dummy_fpr;
     } tmp;
-    uint16_t h[512], hm[512];
-    int16_t sig[512];
+    struct {
+        int16_t sig[512];
+        uint16_t hm[512];
+    } r;
+    unsigned char seed[48];
     inner_shake256_context sc;
     size_t v;
 
     /*
-     * Decode public key.
+     * Create a random nonce (40 bytes).
+     */
+    randombytes(nonce, NONCELEN);
+
+    /*
+     * Hash message nonce + message into a vector.
+     */
+    inner_shake256_init(&sc);
+    inner_shake256_inject(&sc, nonce, NONCELEN);
+    inner_shake256_inject(&sc, m, mlen);
+    inner_shake256_flip(&sc);
+    PQCLEAN_FALCON512_AVX2_hash_to_point_ct(&sc, r.hm, 9, tmp.b);
+    inner_shake256_ctx_release(&sc);
+
+    /*
+     * Initialize a RNG.
      */
+    randombytes(seed, sizeof seed);
+    inner_shake256_init(&sc);
+    inner_shake256_inject(&sc, seed, sizeof seed);
+    inner_shake256_flip(&sc);
+
+    /*
+     * Compute and return the signature.
+     */
+    PQCLEAN_FALCON512_AVX2_sign_tree(r.sig, &sc, expanded_key, r.hm, 9, tmp.b);
+    v = PQCLEAN_FALCON512_AVX2_comp_encode(sigbuf, *sigbuflen, r.sig, 9);
+    inner_shake256_ctx_release(&sc);
+    if (v != 0) {
+        *sigbuflen = v;
+        return 0;
+    }
+    return -1;
+}
+
+/*
+ * Decode a public key into NTT (Montgomery) representation, as used by
+ * PQCLEAN_FALCON512_AVX2_verify_raw(). Return value is 0 on success, -1 on error.
+ */
+static int
+do_prepare_pk(uint16_t *h, const uint8_t *pk) {
     if (pk[0] != 0x00 + 9) {
         return -1;
     }
     if (PQCLEAN_FALCON512_AVX2_modq_decode(h, 9,
-                                           pk + 1, PQCLEAN_FALCON512_AVX2_CRYPTO_PUBLICKEYBYTES - 1)
+            pk + 1, PQCLEAN_FALCON512_AVX2_CRYPTO_PUBLICKEYBYTES - 1)
             != PQCLEAN_FALCON512_AVX2_CRYPTO_PUBLICKEYBYTES - 1) {
         return -1;
     }
     PQCLEAN_FALCON512_AVX2_to_ntt_monty(h, 9);
+    return 0;
+}
+
+/*
+ * Verify a sigature with a public key already decoded by do_prepare_pk().
+ * The nonce has size NONCELEN bytes. sigbuf[] (of size sigbuflen) contains
+ * the signature value, not including the header byte or nonce. Return value
+ * is 0 on success, -1 on error.
+ */
+static int
+do_verify_prepared(
+    const uint8_t *nonce, const uint8_t *sigbuf, size_t sigbuflen,
+    const uint8_t *m, size_t mlen, const uint16_t *h) {
+    union {
+        uint8_t b[2 * 512];
+        uint64_t dummy_u64;
+        fpr dummy_fpr;
+    } tmp;
+    uint16_t hm[512];
+    int16_t sig[512];
+    inner_shake256_context sc;
+    size_t v;
 
     /*
      * Decode signature.
@@ -281,6 +361,23 @@ do_verify(
     return 0;
 }
 
+/*
+ * Verify a sigature. The nonce has size NONCELEN bytes. sigbuf[]
+ * (of size sigbuflen) contains the signature value, not including the
+ * header byte or nonce. Return value is 0 on success, -1 on error.
+ */
+static int
+do_verify(
+    const uint8_t *nonce, const uint8_t *sigbuf, size_t sigbuflen,
+    const uint8_t *m, size_t mlen, const uint8_t *pk) {
+    uint16_t h[512];
+
+    if (do_prepare_pk(h, pk) < 0) {
+        return -1;
+    }
+    return do_verify_prepared(nonce, sigbuf, sigbuflen, m, mlen, h);
+}
+
 /* see api.h */
 int
 PQCLEAN_FALCON512_AVX2_crypto_sign_signature(
@@ -297,6 +394,57 @@ PQCLEAN_FALCON512_AVX2_crypto_sign_signature(
     return 0;
 }
 
+/* see api.h */
+int
+PQCLEAN_FALCON512_AVX2_crypto_sign_expand_sk(
+    uint8_t *esk, const uint8_t *sk) {
+    union {
+        uint8_t b[48 * 512];
+        uint64_t dummy_u64;
+        fpr dummy_fpr;
+    } tmp;
+    int8_t f[512], g[512], F[512], G[512];
+    int ret = 0;
+
+    if (((uintptr_t)esk & 7) != 0) {
+        return -1;
+    }
+    if (decode_sk(f, g, F, G, sk, tmp.b) < 0) {
+        ret = -1;
+    } else {
+        PQCLEAN_FALCON512_AVX2_expand_privkey((fpr *)esk, f, g, F, G, 9, tmp.b);
+    }
+
+    /*
+     * Do not leave the decoded private key on the stack.
+     */
+    memset(f, 0, sizeof f);
+    memset(g, 0, sizeof g);
+    memset(F, 0, sizeof F);
+    memset(G, 0, sizeof G);
+    memset(tmp.b, 0, sizeof tmp.b);
+    return ret;
+}
+
+/* see api.h */
+int
+PQCLEAN_FALCON512_AVX2_crypto_sign_signature_expanded(
+    uint8_t *sig, size_t *siglen,
+    const uint8_t *m, size_t mlen, const uint8_t *esk) {
+    size_t vlen;
+
+    if (((uintptr_t)esk & 7) != 0) {
+        return -1;
+    }
+    vlen = PQCLEAN_FALCON512_AVX2_CRYPTO_BYTES - NONCELEN - 1;
+    if (do_sign_tree(sig + 1, sig + 1 + NONCELEN, &vlen, m, mlen, (const fpr *)esk) < 0) {
+        return -1;
+    }
+    sig[0] = 0x30 + 9;
+    *siglen = 1 + NONCELEN + vlen;
+    return 0;
+}
+
 /* see api.h */
 int
 PQCLEAN_FALCON512_AVX2_crypto_sign_verify(
@@ -312,6 +460,37 @@ PQCLEAN_FALCON512_AVX2_crypto_sign_verify(
                      sig + 1 + NONCELEN, siglen - 1 - NONCELEN, m, mlen, pk);
 }
 
+/* see api.h */
+int
+PQCLEAN_FALCON512_AVX2_crypto_sign_prepare_pk(
+    uint8_t *ppk, const uint8_t *pk) {
+    uint16_t h[512];
+
+    if (do_prepare_pk(h, pk) < 0) {
+        return -1;
+    }
+    memcpy(ppk, h, sizeof h);
+    return 0;
+}
+
+/* see api.h */
+int
+PQCLEAN_FALCON512_AVX2_crypto_sign_verify_prepared(
+    const uint8_t *sig, size_t siglen,
+    const uint8_t *m, size_t mlen, const uint8_t *ppk) {
+    uint16_t h[512];
+
+    if (siglen < 1 + NONCELEN) {
+        return -1;
+    }
+    if (sig[0] != 0x30 + 9) {
+        return -1;
+    }
+    memcpy(h, ppk, sizeof h);
+    return do_verify_prepared(sig + 1,
+                              sig + 1 + NONCELEN, siglen - 1 - NONCELEN, m, mlen, h);
+}
+
 /* see api.h */
 int
 PQCLEAN_FALCON512_AVX2_crypto_sign(
@@ -47,20 +47,42 @@ namespace PQB{
     }
 
     bool CreateTxC::CheckArguments() const{
-        if (args.size() == ARGS_NUM){
+        if (args.empty() || (args.size() % ARGS_NUM) != 0 || args.size() > ARGS_NUM * MAX_TX_OUTPUTS){
+            return false;
+        }
+        // arguments are pairs of amount and receiver
+        for (size_t i = 0; i < args.size(); i += ARGS_NUM){
             // check if first argument is a number
-            // second argument have to be 128 long hexadecimal string representing wallet address
-            if (isNumber(args.at(0)) && (args.at(1).size() == 128) && isHexadecimal(args.at(1))){
-                return true;
+            // second argument have to be hexadecimal string representing wallet address (128 characters, 64 with SHORT_IDS)
+            if (!isNumber(args.at(i)) || (args.at(i + 1).size() != 2 * byteId_t::size()) || !isHexadecimal(args.at(i + 1))){
+                return false;
             }
         }
-        return false;
+        return true;
     }
 
     void CreateTxC::Behavior() const{
-        uint32_t amount = std::stoul(args.at(0));
-        std::string receiver = args.at(1);
-        std::string ret = model->createTransaction(receiver, amount);
+        std::string ret;
+        if (args.size() == ARGS_NUM){
+            uint32_t amount = std::stoul(args.at(0));
+            std::string receiver = args.at(1);
+            ret = model->createTransaction(receiver, amount);
+        } else { // more receivers -> multi-payment transaction
+            std::vector<std::pair<std::string, PQB::cash>> payments;
+            for (size_t i = 0; i < args.size(); i += ARGS_NUM){
+                payments.emplace_back(args.at(i + 1), std::stoul(args.at(i)));
+            }
+            ret = model->createTransaction(payments);
+        }
+        outputConsole->printToConsole(ret.c_str());
+    }
+
+    void CreateTxBatchC::Behavior() const{
+        std::vector<std::pair<std::string, PQB::cash>> payments;
+        for (size_t i = 0; i < args.size(); i += ARGS_NUM){
+            payments.emplace_back(args.at(i + 1), std::stoul(args.at(i)));
+        }
+        std::string ret = model->createTransactionBatch(payments);
         outputConsole->printToConsole(ret.c_str());
     }
 
@@ -53,10 +53,16 @@ class CreateTxC : public Command{
 public:
     bool CheckArguments() const override;
     void Behavior() const override;
-private:
+protected:
     static const short ARGS_NUM = 2;
 };
 
+/// @brief Create new batch of transactions signed with one signature and broadcast them to peers
+class CreateTxBatchC : public CreateTxC{
+public:
+    void Behavior() const override;
+};
+
 /// @brief Exit Command
 class ExitC : public Command{
 public:
@@ -150,7 +156,18 @@ public:
         return new CreateTxC();
     }
     const char* getCommandHelp() const override{
-        return "createTx: Create new transaction\n\tcreateTx <amount> <receiver wallet address>";
+        return "createTx: Create new transaction (more receivers are paid by one multi-payment transaction)\n\tcreateTx <amount> <receiver wallet address> [<amount> <receiver wallet address> ...]";
+    }
+};
+
+/// @brief CreateTxBatch Command creator
+class CreateTxBatchCC : public CommandCreator{
+public:
+    Command* FactoryMethod() const override{
+        return new CreateTxBatchC();
+    }
+    const char* getCommandHelp() const override{
+        return "createTxBatch: Create new transaction for each receiver, all transactions are signed with one signature\n\tcreateTxBatch <amount> <receiver wallet address> [<amount> <receiver wallet address> ...]";
     }
 };
 
@@ -57,6 +57,7 @@ private:
         {"exit", new ExitCC()},
         {"echo", new EchoCC()},
         {"createTx", new CreateTxCC()},
+        {"createTxBatch", new CreateTxBatchCC()},
         {"whoami", new WhoAmICC()},
         {"walletTxs", new PrintWalletTxCC()},
         {"blocks", new PrintBlocksCC()},
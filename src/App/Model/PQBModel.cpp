@@ -39,7 +39,7 @@ namespace PQB{
             delete connMng;
     }
 
-    bool PQBModel::initializeManagers(NodeType node_type){
+    bool PQBModel::initializeManagers(NodeType node_type, size_t numOfIOThreads, IOBackend backend){
         if (!openConfigurationAndDatabase()){
             return false;
         }
@@ -47,7 +47,7 @@ namespace PQB{
         chain = new Chain(wallet->getUNL().size(), walletID);
         consensus = new ConsensusWrapper(chain, blockS, accS, wallet);
         msgPrc = new MessageProcessor(accS, blockS, consensus, wallet);
-        connMng = new ConnectionManager(msgPrc, accS->addrDB, wallet, node_type);
+        connMng = new ConnectionManager(msgPrc, accS->addrDB, wallet, node_type, numOfIOThreads, backend);
         msgPrc->assignConnectionManager(connMng);
         consensus->assignConnectionManager(connMng);
         return true;
@@ -79,15 +79,51 @@ namespace PQB{
         if (tx == nullptr){
             return "Transaction can not be created because of missing balance!";
         }
-        if (!msgPrc->checkTransaction(tx)){
+        if (!broadcastNewTransaction(tx)){
             return "Transaction can not be sent because of invalid transaction structure, sender or receiver address or invalid signature!";
         }
+        return "Transaction was successfully created.";
+    }
+
+    std::string PQBModel::createTransaction(std::vector<std::pair<std::string, PQB::cash>> &payments){
+        TransactionPtr tx = wallet->createNewTransaction(payments);
+        if (tx == nullptr){
+            return "Transaction can not be created because of invalid number of payments or too large sum of amounts!";
+        }
+        if (!broadcastNewTransaction(tx)){
+            return "Transaction can not be sent because of invalid transaction structure, sender or receiver address or invalid signature!";
+        }
+        return "Transaction was successfully created.";
+    }
+
+    std::string PQBModel::createTransactionBatch(std::vector<std::pair<std::string, PQB::cash>> &payments){
+        std::vector<TransactionPtr> batch = wallet->createNewTransactionBatch(payments);
+        if (batch.empty()){
+            return "Transactions can not be created because of invalid number of payments!";
+        }
+        size_t sent = 0;
+        for (auto &tx : batch){
+            if (broadcastNewTransaction(tx)){
+                sent++;
+            }
+        }
+        if (sent != batch.size()){
+            return std::to_string(batch.size() - sent) + " of " + std::to_string(batch.size()) +
+                   " transactions can not be sent because of invalid transaction structure, sender or receiver address or invalid signature!";
+        }
+        return "Transactions were successfully created.";
+    }
+
+    bool PQBModel::broadcastNewTransaction(TransactionPtr &tx){
+        if (!msgPrc->checkTransaction(tx)){
+            return false;
+        }
         TransactionMessage *msg = new TransactionMessage(tx->getSize());
         msg->serialize(tx.get());
         ConnectionManager::MessageRequest_t req = {.type=ConnectionManager::MessageRequestType::BROADCAST, .connectionID=0, .peerID="", .message=msg};
         connMng->addMessageRequest(req);
         consensus->addTransactionToPool(tx);
-        return "Transaction was successfully created.";
+        return true;
     }
 
     std::string_view PQBModel::getLocalWalletId(){
@@ -121,10 +157,17 @@ namespace PQB{
     }
 
     void PQBModel::getStatistics(std::stringstream &ss){
+        ConnectionManager::QueueLatency_t latency = connMng->getQueueLatency();
         ss
         << std::endl
         << "The program has processed (send/receive) " << connMng->getNumberOfProcessedBytes() << " of bytes in messages." << std::endl
-        << std::endl;
+        << "Sent message requests: " << latency.requests << ", queue-to-wire latency: average " << latency.averageMs
+        << " ms, max " << latency.maxMs << " ms." << std::endl
+        << "Messages dropped because of full outbound queues: " << connMng->getNumberOfDroppedMessages() << std::endl
+        << std::endl
+        << "Network I/O threads: " << connMng->getNumberOfIOThreads() << std::endl;
+        connMng->putIOThreadStatsToStringStream(ss);
+        ss << std::endl;
     }
 
 } // namespace PQB
@@ -34,14 +34,20 @@ private:
     /// @brief Trys to open all configuration files and databases needed for PQB. If operation success return true, else return false
     bool openConfigurationAndDatabase();
 
+    /// @brief Check new transaction, broadcast it to peers and add it to the transaction pool
+    /// @return true if transaction is valid and it was sent, false if it is invalid
+    bool broadcastNewTransaction(TransactionPtr &tx);
+
 public:
 
     PQBModel(std::string &config_file_path);
     ~PQBModel();
 
     /// @brief Trys to initialize ConnectionManager, MessageProcessor and Consensus()
+    /// @param numOfIOThreads number of network I/O threads (0 means a quarter of hardware threads)
+    /// @param backend backend of network I/O threads
     /// @return true if operation is successful false if operation fails
-    bool initializeManagers(NodeType node_type);
+    bool initializeManagers(NodeType node_type, size_t numOfIOThreads = 0, IOBackend backend = IOBackend::EPOLL);
 
     /// @brief Initialize connections on Unique Node List
     void initializeUNLConnections();
@@ -55,6 +61,22 @@ public:
      */
     std::string createTransaction(std::string &receiver, PQB::cash amount);
 
+    /**
+     * @brief Create new multi-payment Transaction (one signature for all payments) and broadcast it to peers
+     * 
+     * @param payments pairs of wallet address of a receiver and amount of resources to transfer
+     * @return std::string status of this operation
+     */
+    std::string createTransaction(std::vector<std::pair<std::string, PQB::cash>> &payments);
+
+    /**
+     * @brief Create new batch of Transactions (one transaction for each payment) signed with one signature and broadcast them to peers
+     * 
+     * @param payments pairs of wallet address of a receiver and amount of resources to transfer
+     * @return std::string status of this operation
+     */
+    std::string createTransactionBatch(std::vector<std::pair<std::string, PQB::cash>> &payments);
+
     /// @brief Get hexadecimal representation of local wallet identifier
     std::string_view getLocalWalletId();
 
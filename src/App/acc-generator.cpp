@@ -66,7 +66,7 @@ int main(){
         acc.balance = wallet.getBalance();
         acc.txSequence = wallet.getTxSeqNum();
         acc.addresses = wallet.getAddressList();
-        byte64_t acc_id = acc.getAccountID();
+        byteId_t acc_id = acc.getAccountID();
 
         if (!accStorage.setAccount(acc_id, acc)){
             std::cerr << "Failed to put account in file: " << file << " into the database!" << std::endl;
@@ -14,6 +14,7 @@
 #include "Controller.hpp"
 #include "PQBModel.hpp"
 #include "Signer.hpp"
+#include "RandomGenerator.hpp"
 #include "Log.hpp"
 
 
@@ -23,10 +24,17 @@ int main(int argc, char *argv[]){
     args_t parsedArgs = a.getArguments();
 
     PQB::Log::init();
+    if (a.flags.r_flag){
+        PQB::RandomGenerator::Config config;
+        config.deterministic = true;
+        config.seed = parsedArgs.random_seed;
+        PQB::RandomGenerator::configure(config);
+        PQB_LOG_WARN("MAIN", "Random generator is seeded deterministically");
+    }
     PQB::Signer::GetInstance(parsedArgs.signature_alg);
 
     PQB::PQBModel model(parsedArgs.conf_file_path);
-    if (!model.initializeManagers(PQB::NodeType::VALIDATOR)){ // The type is hardcoded to be validator for purpose of testing
+    if (!model.initializeManagers(PQB::NodeType::VALIDATOR, parsedArgs.io_threads, parsedArgs.io_backend)){ // The type is hardcoded to be validator for purpose of testing
         PQB_LOG_ERROR("MAIN", "Failed to initialize managers");
         return 1;
     }
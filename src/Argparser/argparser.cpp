@@ -18,15 +18,20 @@ using namespace std;
 ArgParser::ArgParser(int argc, char **argv): _argCount(argc), _progArgs(argv)
 {
     // set arguments options
-    this->_short_opt = "ht:s:c:";
+    this->_short_opt = "ht:s:c:r:n:b:";
     this->_long_opt = {
         {"help", no_argument, nullptr, 'h'},
         {"signature", required_argument, nullptr, 's'},
         {"conf", required_argument, nullptr, 'c'},
+        {"seed", required_argument, nullptr, 'r'},
+        {"io-threads", required_argument, nullptr, 'n'},
+        {"io-backend", required_argument, nullptr, 'b'},
         {nullptr, 0, nullptr, 0}
     };
     // set implicit arguments values
-    this->flags = {false, false, false};
+    this->flags = {false, false, false, false, false, false};
+    this->args.io_threads = 0;
+    this->args.io_backend = PQB::IOBackend::EPOLL;
     // set flag to not parsed arguments yet
     this->__parsed = false;
 }
@@ -82,6 +87,35 @@ args_t ArgParser::getArguments()
             args.conf_file_path = optarg;
             flags.c_flag = true;
             break;
+        case 'r':
+            try {
+                args.random_seed = std::stoull(optarg);
+            } catch (const std::exception &) {
+                cerr << "Invalid random seed: " << optarg << endl;
+                exit(EXIT_FAILURE);
+            }
+            flags.r_flag = true;
+            break;
+        case 'n':
+            try {
+                args.io_threads = std::stoul(optarg);
+            } catch (const std::exception &) {
+                cerr << "Invalid number of network I/O threads: " << optarg << endl;
+                exit(EXIT_FAILURE);
+            }
+            flags.n_flag = true;
+            break;
+        case 'b':
+            if (!strcmp(optarg, "epoll")){
+                args.io_backend = PQB::IOBackend::EPOLL;
+            } else if (!strcmp(optarg, "io_uring")){
+                args.io_backend = PQB::IOBackend::IO_URING;
+            } else {
+                cerr << "Unknown network I/O backend: " << optarg << endl;
+                exit(EXIT_FAILURE);
+            }
+            flags.b_flag = true;
+            break;
         default:
             exit(EXIT_FAILURE); // error message comes from getopt
             break;
@@ -106,6 +140,9 @@ void ArgParser::__printHelp()
          << "--sig <signature algorithm> | -s <signature algorithm>\n\tName of signature algorithm to use. For exmaple falcon1024 or ed25519.\n"
          << "\nOptional arguments:\n\n"
          << "--conf <path to wallet configuration file> | -c <path to wallet configuration file>\n\tIf not used the default path is in local directory tmp/conf.json\n\n"
+         << "--seed <number> | -r <number>\n\tSeed random generator deterministically, keys and signatures are then reproducible. Use only for testing and benchmarks!\n\n"
+         << "--io-threads <number> | -n <number>\n\tNumber of network I/O threads. If not used a quarter of hardware threads is used.\n\n"
+         << "--io-backend <epoll|io_uring> | -b <epoll|io_uring>\n\tBackend of network I/O threads. If not used or if io_uring is not available, epoll is used.\n\n"
          << "Example of usage:\n"
          << "./main -t validator -s falcon1024\n"
          << "./main -t server -s ed25519 -c tmp/conf1.json\n"
@@ -36,6 +36,9 @@ struct args_t
 {
     std::string signature_alg;
     std::string conf_file_path;
+    uint64_t random_seed;   ///< seed of deterministic random generator (used only if r_flag is set)
+    size_t io_threads;      ///< number of network I/O threads (0 means default)
+    PQB::IOBackend io_backend; ///< backend of network I/O threads
 };
 
 
@@ -48,6 +51,9 @@ struct arg_flags_t
     bool s_flag;    ///< signature flag
     bool c_flag;    ///< conf flag
     bool h_flag;    ///< help flag
+    bool r_flag;    ///< deterministic random seed flag
+    bool n_flag;    ///< network I/O threads flag
+    bool b_flag;    ///< network I/O backend flag
 };
 
 /*********** FUNCTIONS AND CLASSES **************/
@@ -14,6 +14,8 @@ namespace PQB{
 
     /// @brief Location on the LevelDB databse where are stored blockchain blocks
     constexpr std::string_view BLOCKS_DATABASE_PATH = "tmp/blocksStorage";
+    /// @brief Location on the LevelDB databse where are stored signatures of transactions of blockchain blocks
+    constexpr std::string_view BLOCK_SIGNATURES_DATABASE_PATH = "tmp/blockSignaturesStorage";
     /// @brief Location on the LevelDB databse where are stored public keys, balances, transaction sequence num., and network addresses of individual accounts
     constexpr std::string_view ACCOUNTS_DATABASE_PATH = "tmp/balanceStorage";
     /// @brief Location on the LevelDB databse where are stored IPv4, IPv6 address and aliases of other nodes (peers)
@@ -28,22 +30,84 @@ namespace PQB{
     constexpr size_t MAX_BLOCK_SIZE = 1048576;
     /// @brief SHA-512 hash of the empty string, It is used for message checking if message was well parsed and as a padding for empty
     /// hash values for exmaple in block's transaction hash etc., if they are not calculated yet or they are just empty
+#ifdef PQB_SHORT_IDS
+    constexpr std::string_view EMPTY_STRING_HASH = "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce";
+#else
     constexpr std::string_view EMPTY_STRING_HASH = "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e";
+#endif
 
     /// @brief Max si of the message sended/received with a socket
     constexpr size_t MAX_MESSAGE_SIZE = 1400;
     /// @brief Network port for PQB server application
     constexpr size_t PQB_SERVER_PORT = 8330;
     /// @brief Maximal number of incoming connection requests in queue for accepting. This may be really important when createing lot of connections at once!!!
-    constexpr size_t MAX_SERVER_QUEUE = 30;
+    constexpr size_t MAX_SERVER_QUEUE = 1024;
+    /// @brief Maximal number of socket events returned by one epoll_wait() call of the ConnectionManager
+    constexpr size_t MAX_EPOLL_EVENTS = 256;
+    /// @brief Number of bytes in the outbound queue of a connection above which low priority messages (TX, INV, GETDATA) for the peer are dropped
+    constexpr size_t OUTBOUND_QUEUE_HIGH_WATER = 4 * 1024 * 1024;
+    /// @brief Number of bytes in the outbound queue of a connection above which the connection is closed (peer is not reading)
+    constexpr size_t OUTBOUND_QUEUE_LIMIT = 64 * 1024 * 1024;
+    /// @brief Size of the read buffer of a connection (bytes are read from the socket to the buffer and frames are parsed from it)
+    constexpr size_t RECEIVE_BUFFER_SIZE = 16 * 1024;
+    /// @brief Maximal number of bytes read from one connection before other connections are served
+    constexpr size_t MAX_RECEIVE_BYTES_PER_ROUND = 1024 * 1024;
+    /// @brief Time in milliseconds in which a started message has to be received completely, else the connection is closed
+    constexpr uint32_t MESSAGE_RECEIVE_TIMEOUT = 30000;
+    /// @brief Number of submission queue entries of io_uring instance of a network I/O thread
+    constexpr unsigned IO_URING_QUEUE_DEPTH = 1024;
+    /// @brief Number of provided receive buffers (of RECEIVE_BUFFER_SIZE bytes) shared by connections of a network I/O thread using io_uring (power of 2)
+    constexpr unsigned IO_URING_BUFFER_COUNT = 256;
+    /// @brief Maximal payload size of VERSION and ACK messages
+    constexpr size_t MAX_HANDSHAKE_MESSAGE_SIZE = 64 * 1024;
+    /// @brief Maximal payload size of TX message (multi-payment transaction with MAX_TX_OUTPUTS outputs fits in)
+    constexpr size_t MAX_TX_MESSAGE_SIZE = 256 * 1024;
+    /// @brief Maximal payload size of ACCOUNT message
+    constexpr size_t MAX_ACCOUNT_MESSAGE_SIZE = 64 * 1024;
+    /// @brief Maximal payload size of INV and GETDATA messages
+    constexpr size_t MAX_INV_MESSAGE_SIZE = 1024 * 1024;
+    /// @brief Maximal payload size of BLOCKPROPOSAL and TXSETPROPOSAL messages
+    constexpr size_t MAX_PROPOSAL_MESSAGE_SIZE = 4 * MAX_BLOCK_SIZE;
+    /// @brief Maximal payload size of BLOCK message (with signatures of transactions)
+    constexpr size_t MAX_BLOCK_MESSAGE_SIZE = 32 * MAX_BLOCK_SIZE;
 
-    /// @brief Message Version
-    constexpr uint32_t MSG_VERSION = 1;
+    /// @brief Flag of message version marking nodes with 32-byte identifiers (they can not communicate with nodes with 64-byte identifiers)
+    constexpr uint32_t MSG_FLAG_SHORT_IDS = 0x80000000;
+    /// @brief Message Version (version 2 uses CRC32C instead of SHA-512 as message check sum, version 3 supports sessions with UNL peers,
+    /// version 4 supports compact transaction set proposals, version 5 supports delta transaction set proposals,
+    /// version 6 supports transaction set sketches)
+#ifdef PQB_SHORT_IDS
+    constexpr uint32_t MSG_VERSION = 6 | MSG_FLAG_SHORT_IDS;
+#else
+    constexpr uint32_t MSG_VERSION = 6;
+#endif
     /// @brief Current transaction version
     constexpr uint32_t TX_VERSION = 1;
+    /// @brief Version of multi-payment transaction (transaction with a list of receivers and amounts under one signature)
+    constexpr uint32_t TX_VERSION_MULTI_PAYMENT = 2;
+    /// @brief Maximal number of outputs (receivers) of a multi-payment transaction
+    constexpr size_t MAX_TX_OUTPUTS = 1024;
+    /// @brief Flag of transaction version marking transaction signed in a batch (signature is made over Merkle root of IDs of the batch)
+    constexpr uint32_t TX_FLAG_BATCH_SIGNED = 0x80000000;
+    /// @brief Maximal depth of Merkle tree of a transaction batch (batch has at most 2^16 transactions)
+    constexpr size_t MAX_TX_BATCH_DEPTH = 16;
+    /// @brief Transactions which arrived to the transaction pool less than this time in milliseconds ago are sent whole in compact
+    /// transaction set proposals (peers probably do not have them yet), other transactions are given just by short IDs
+    constexpr uint32_t COMPACT_PROPOSAL_PREFILL_TIME = 2000;
+    /// @brief Time in milliseconds after which reconstruction of a compact transaction set proposal with missing transactions is abandoned
+    constexpr uint32_t COMPACT_PROPOSAL_TIMEOUT = 20000;
+    /// @brief Number of different transactions which a transaction set sketch decodes in addition to the transactions
+    /// which arrived recently (see COMPACT_PROPOSAL_PREFILL_TIME)
+    constexpr size_t TX_SET_SKETCH_MARGIN = 16;
+    /// @brief Number of newest blocks whose transaction signatures are kept in the storage, signatures of older blocks are pruned
+    constexpr uint32_t BLOCK_SIGNATURES_PRUNE_DEPTH = 1000;
 
     /// ID/hash of the genesis block
-    constexpr std::string_view GENESIS_BLOCK_HASH = "B40FA957FE22271545BF8082FC798C8D0E3C9788DC18793755B39035CD5B142DFC04C316C3256C48D0EDCFEE62779B5C74A0BFA2BF4F680BFD2C9500FFA118ED";
+#ifdef PQB_SHORT_IDS
+    constexpr std::string_view GENESIS_BLOCK_HASH = "8E6EB78D0A4AE949374ABFCA2960C46B6EDB9A3C4A1E66290816EE8FAB432E52";
+#else
+    constexpr std::string_view GENESIS_BLOCK_HASH = "C5ACB8E67B7545A1C56056A343ACA93A9F028ED66A955E39082736AB303EDF7C2C8D04A05359D6E2070AD741E9142FCD095E82E69D3436724B75339AC8D5A30C";
+#endif
 }
 
 /* END OF FILE */
\ No newline at end of file
@@ -18,6 +18,7 @@
 namespace PQB{
 
     extern const std::string_view BLOCKS_DATABASE_PATH;
+    extern const std::string_view BLOCK_SIGNATURES_DATABASE_PATH;
     extern const std::string_view ACCOUNTS_DATABASE_PATH;
     extern const std::string_view ADDRESS_DATABASE_PATH;
 
@@ -30,9 +31,32 @@ namespace PQB{
     extern const size_t MAX_MESSAGE_SIZE;
     extern const size_t PQB_SERVER_PORT;
     extern const size_t MAX_SERVER_QUEUE;
+    extern const size_t MAX_EPOLL_EVENTS;
+    extern const size_t OUTBOUND_QUEUE_HIGH_WATER;
+    extern const size_t OUTBOUND_QUEUE_LIMIT;
+    extern const size_t RECEIVE_BUFFER_SIZE;
+    extern const size_t MAX_RECEIVE_BYTES_PER_ROUND;
+    extern const uint32_t MESSAGE_RECEIVE_TIMEOUT;
+    extern const unsigned IO_URING_QUEUE_DEPTH;
+    extern const unsigned IO_URING_BUFFER_COUNT;
+    extern const size_t MAX_HANDSHAKE_MESSAGE_SIZE;
+    extern const size_t MAX_TX_MESSAGE_SIZE;
+    extern const size_t MAX_ACCOUNT_MESSAGE_SIZE;
+    extern const size_t MAX_INV_MESSAGE_SIZE;
+    extern const size_t MAX_PROPOSAL_MESSAGE_SIZE;
+    extern const size_t MAX_BLOCK_MESSAGE_SIZE;
 
     extern const uint32_t MSG_VERSION;
+    extern const uint32_t MSG_FLAG_SHORT_IDS;
     extern const uint32_t TX_VERSION;
+    extern const uint32_t TX_VERSION_MULTI_PAYMENT;
+    extern const size_t MAX_TX_OUTPUTS;
+    extern const uint32_t TX_FLAG_BATCH_SIGNED;
+    extern const size_t MAX_TX_BATCH_DEPTH;
+    extern const uint32_t COMPACT_PROPOSAL_PREFILL_TIME;
+    extern const uint32_t COMPACT_PROPOSAL_TIMEOUT;
+    extern const size_t TX_SET_SKETCH_MARGIN;
+    extern const uint32_t BLOCK_SIGNATURES_PRUNE_DEPTH;
 
     extern const std::string_view GENESIS_BLOCK_HASH;
 }
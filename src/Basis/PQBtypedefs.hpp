@@ -26,6 +26,12 @@ namespace PQB{
         VALIDATOR,
         SERVER
     };
+
+    /// @brief Backends of network I/O threads
+    enum class IOBackend : uint32_t{
+        EPOLL,      ///< readiness notifications by epoll and non-blocking system calls
+        IO_URING    ///< completion-based I/O by io_uring (Linux 6.1), epoll is used if it is not available
+    };
 }
 
 
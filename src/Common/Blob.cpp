@@ -20,6 +20,6 @@ void base_blob<BITS>::setHex(const std::string &str){
     PQB::hexStringToBytes(str, m_data.begin(), WIDTH);
 }
 
-// Explicit instantiations for base_blob<512>
-template std::string base_blob<512>::getHex() const;
-template void base_blob<512>::setHex(const std::string&);
\ No newline at end of file
+// Explicit instantiations for base_blob<PQB_ID_BITS>
+template std::string base_blob<PQB_ID_BITS>::getHex() const;
+template void base_blob<PQB_ID_BITS>::setHex(const std::string&);
\ No newline at end of file
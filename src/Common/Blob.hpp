@@ -37,6 +37,15 @@
 
 #include "HexBase.hpp"
 
+
+#ifdef PQB_SHORT_IDS
+/// @brief Size of identifiers and hashes in bits (SHA-512 truncated to 256 bits, see CMake option SHORT_IDS)
+constexpr unsigned int PQB_ID_BITS = 256;
+#else
+/// @brief Size of identifiers and hashes in bits (SHA-512)
+constexpr unsigned int PQB_ID_BITS = 512;
+#endif
+
 /**
  * @brief Template base class for fixed-sized opaque blobs.
  * 
@@ -111,12 +120,13 @@ public:
 
 
 /**
- * @brief 512-bit opaque blob.
- * 
+ * @brief Opaque blob for identifiers and hashes. Its width is configurable: 512-bit, or 256-bit if the project
+ * is build with SHORT_IDS option (PQB_ID_BITS), so the name does not state the size (use size() for it).
+ *
  */
-class byte64_t : public base_blob<512> {
+class byteId_t : public base_blob<PQB_ID_BITS> {
 public:
-    constexpr byte64_t() = default;
-    constexpr explicit byte64_t(uint8_t v) : base_blob<512>(v) {}
-    constexpr explicit byte64_t(std::span<const unsigned char> vch) : base_blob<512>(vch) {}
+    constexpr byteId_t() = default;
+    constexpr explicit byteId_t(uint8_t v) : base_blob<PQB_ID_BITS>(v) {}
+    constexpr explicit byteId_t(std::span<const unsigned char> vch) : base_blob<PQB_ID_BITS>(vch) {}
 };
\ No newline at end of file
@@ -60,7 +60,7 @@ namespace PQB{
         }
     }
 
-    bool Chain::updateValidBlock(byte64_t &block_id){
+    bool Chain::updateValidBlock(byteId_t &block_id){
         const auto it = ch.find(block_id);
         if (it != ch.end()){
             if (checkQuorum(it->second)){
@@ -72,7 +72,7 @@ namespace PQB{
         return false;
     }
 
-    void Chain::assignAccountHashToValidBlock(byte64_t &accHash){
+    void Chain::assignAccountHashToValidBlock(byteId_t &accHash){
         auto it = ch.find(validBlock.id);
         validBlock.block->accountBalanceMerkleRootHash = accHash;
         validBlock.id = validBlock.block->getBlockHash();
@@ -89,7 +89,7 @@ namespace PQB{
     }
 
     void Chain::putChainDataToStringStream(std::stringstream &ss){
-        byte64_t genesisId;
+        byteId_t genesisId;
         genesisId.setHex(std::string(GENESIS_BLOCK_HASH));
         const auto it = ch.find(genesisId);
         if (it != ch.end()){
@@ -116,11 +116,11 @@ namespace PQB{
         
     }
 
-    std::pair<byte64_t&, BlockHeaderPtr&> Chain::getPreferredBlock(){
+    std::pair<byteId_t&, BlockHeaderPtr&> Chain::getPreferredBlock(){
         return getPreferredBlock(&validBlock);
     }
 
-    std::pair<byte64_t&, BlockHeaderPtr&> Chain::getPreferredBlock(BlockNode *n)
+    std::pair<byteId_t&, BlockHeaderPtr&> Chain::getPreferredBlock(BlockNode *n)
     {
         if (n->childs.empty()){
             return {n->id, n->block};
@@ -30,7 +30,7 @@ namespace PQB{
  */
 struct BlockNode{
 
-    using ID = byte64_t;
+    using ID = byteId_t;
 
     // id is hash of the block, but with accountMerkleRoothHash set to Null. It is because this root hash is unknow until full validation
     // and execution of transactions. The real hash of the block can be optained from block->getHash() in case that this block was validated.
@@ -80,15 +80,15 @@ public:
     /// If there is not such a block do nothing and return false.
     /// This method should be called after insert method to check if current working block reach consensus
     /// @return true if block reach consensus and becomes new valid block, false if not
-    bool updateValidBlock(byte64_t &block_id);
+    bool updateValidBlock(byteId_t &block_id);
 
     /// @brief Once block was validated, its transactions executed, and the new account hash calculated
     /// the new account hash should be placed to this block with this method
     /// @param accHash new account hash
-    void assignAccountHashToValidBlock(byte64_t &accHash);
+    void assignAccountHashToValidBlock(byteId_t &accHash);
 
     /// @brief Get ID and header of Block on which majority of UNL nodes are woking on
-    std::pair<byte64_t&, BlockHeaderPtr&> getPreferredBlock();
+    std::pair<byteId_t&, BlockHeaderPtr&> getPreferredBlock();
 
     static BlockPtr getGenesisBlock(){
         BlockPtr genesis = std::make_shared<Block>();
@@ -106,7 +106,7 @@ public:
 private:
 
     /// @brief Get preferred block of given block `n` with its ID
-    std::pair<byte64_t&, BlockHeaderPtr&> getPreferredBlock(BlockNode *n);
+    std::pair<byteId_t&, BlockHeaderPtr&> getPreferredBlock(BlockNode *n);
 
     /// @brief return hardcoded genesis block
     static BlockNode getGenesisBlockNode(){
@@ -11,6 +11,7 @@
 
 #include "Consensus.hpp"
 #include "MessageManagement.hpp"
+#include "RandomGenerator.hpp"
 #include "Log.hpp"
 
 namespace PQB{
@@ -57,7 +58,7 @@ namespace PQB{
         
     }
 
-    bool ConsensusWrapper::isTransactionInPool(const byte64_t tx_id){
+    bool ConsensusWrapper::isTransactionInPool(const byteId_t tx_id){
         std::lock_guard<std::mutex> lock(consensusMutex_);
         if (txPool_.find(tx_id) != txPool_.end()){
             return true;
@@ -65,7 +66,7 @@ namespace PQB{
         return false;
     }
 
-    TransactionPtr ConsensusWrapper::getTransactionFromPool(const byte64_t tx_id){
+    TransactionPtr ConsensusWrapper::getTransactionFromPool(const byteId_t tx_id){
         std::lock_guard<std::mutex> lock(consensusMutex_);
         const auto &it = txPool_.find(tx_id);
         if (it != txPool_.end()){
@@ -79,6 +80,11 @@ namespace PQB{
         const auto it = txPool_.find(tx->IDHash);
         if (it == txPool_.end()){
             txPool_.emplace(tx->IDHash, tx);
+            auto now = std::chrono::steady_clock::now();
+            recentTxs_.emplace_back(now, tx->IDHash);
+            while ((now - recentTxs_.front().first) > std::chrono::milliseconds(COMPACT_PROPOSAL_PREFILL_TIME)){
+                recentTxs_.pop_front();
+            }
             consensusCondition_.notify_one();
             return true;
         } else {
@@ -86,7 +92,7 @@ namespace PQB{
         }
     }
 
-    void ConsensusWrapper::removeTransactionFromPool(const byte64_t tx_id){
+    void ConsensusWrapper::removeTransactionFromPool(const byteId_t tx_id){
         std::lock_guard<std::mutex> lock(consensusMutex_);
         txPool_.erase(tx_id);
     }
@@ -101,7 +107,194 @@ namespace PQB{
         consensus_->gotTxSet(prop);
     }
 
-    std::pair<byte64_t&, BlockHeaderPtr&> ConsensusWrapper::getPreferred(){
+    void ConsensusWrapper::getTransactionsByShortIds(const CompactTxSetProposal &prop, std::vector<TransactionPtr> &txs){
+        PQB::byte key[HashMan::SIPHASH_KEY_SIZE];
+        prop.getShortIdKey(key);
+        // short IDs which are in the proposal more times or which match more transactions can not be resolved
+        std::vector<bool> ambiguous(prop.shortIds.size(), false);
+        std::unordered_map<ShortTxId, size_t> indexes;
+        indexes.reserve(prop.shortIds.size());
+        for (size_t i = 0; i < prop.shortIds.size(); i++){
+            auto [it, inserted] = indexes.emplace(prop.shortIds[i], i);
+            if (!inserted){
+                ambiguous[i] = true;
+                ambiguous[it->second] = true;
+            }
+        }
+        txs.assign(prop.shortIds.size(), nullptr);
+        std::lock_guard<std::mutex> lock(consensusMutex_);
+        for (const auto &[txId, tx] : txPool_){
+            const auto it = indexes.find(CompactTxSetProposal::getShortId(key, txId));
+            if (it == indexes.end() || ambiguous[it->second]){
+                continue;
+            }
+            if (txs[it->second] != nullptr){
+                ambiguous[it->second] = true;
+                txs[it->second] = nullptr;
+                continue;
+            }
+            txs[it->second] = tx;
+        }
+    }
+
+    bool ConsensusWrapper::reconstructTxSet(const CompactTxSetProposal &prop, TransactionSet &set, std::vector<uint32_t> &missing){
+        std::vector<TransactionPtr> txs;
+        getTransactionsByShortIds(prop, txs);
+        missing.clear();
+        for (uint32_t i = 0; i < txs.size(); i++){
+            if (txs[i] == nullptr){
+                missing.push_back(i);
+            }
+        }
+        if (!missing.empty()){
+            return false;
+        }
+        TransactionSet reconstructed(txs.begin(), txs.end());
+        if (reconstructed.size() != txs.size() || ComputeTxSetMerkleRoot(reconstructed) != prop.proposal.TxSetId){
+            PQB_LOG_TRACE("CONSENSUS", "Transaction set {} reconstructed from short IDs does not match its ID",
+                        shortStr(prop.proposal.TxSetId.getHex()));
+            return false;
+        }
+        set = std::move(reconstructed);
+        return true;
+    }
+
+    bool ConsensusWrapper::getProposedTransactions(const byteId_t &txSetId, const std::vector<uint32_t> &indexes, BlockBody &txs){
+        std::lock_guard<std::mutex> lock(consensusMutex_);
+        const auto it = consensus_->acquiredSets_.find(txSetId.getHex());
+        if (it == consensus_->acquiredSets_.end()){
+            return false;
+        }
+        const TransactionSet &set = it->second.set;
+        if (indexes.empty()){
+            for (const auto &tx : set){
+                txs.addTransaction(tx);
+            }
+            return true;
+        }
+        std::vector<uint32_t> sortedIndexes = indexes;
+        std::sort(sortedIndexes.begin(), sortedIndexes.end());
+        sortedIndexes.erase(std::unique(sortedIndexes.begin(), sortedIndexes.end()), sortedIndexes.end());
+        auto txIt = set.begin();
+        uint32_t position = 0;
+        for (const auto index : sortedIndexes){
+            if (index >= set.size()){
+                break;
+            }
+            std::advance(txIt, index - position);
+            position = index;
+            txs.addTransaction(*txIt);
+        }
+        return true;
+    }
+
+    bool ConsensusWrapper::applyTxSetDelta(const TxSetDeltaProposal &delta, TransactionSet &set){
+        std::lock_guard<std::mutex> lock(consensusMutex_);
+        // the same set could be already proposed by another peer
+        const auto resultIt = consensus_->acquiredSets_.find(delta.proposal.TxSetId.getHex());
+        if (resultIt != consensus_->acquiredSets_.end()){
+            set = resultIt->second.set;
+            return true;
+        }
+        const auto baseIt = consensus_->acquiredSets_.find(delta.baseTxSetId.getHex());
+        if (baseIt == consensus_->acquiredSets_.end()){
+            return false;
+        }
+        set = baseIt->second.set;
+        if (!delta.removed.empty()){
+            std::set<byteId_t> removed(delta.removed.begin(), delta.removed.end());
+            std::erase_if(set, [&removed](const TransactionPtr &tx){ return removed.contains(tx->IDHash); });
+        }
+        for (const auto &txId : delta.added){
+            const auto poolIt = txPool_.find(txId);
+            if (poolIt == txPool_.end() || !set.insert(poolIt->second).second){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool ConsensusWrapper::notifyTxSetSketchProposal(const TxSetSketchProposal &sketchProp, TxSetProposalPtr &prop){
+        std::lock_guard<std::mutex> lock(consensusMutex_);
+        // stale proposal would be ignored by the consensus, so its sketch is not decoded
+        if (!consensus_->isCurrentProposal(*prop)){
+            PQB_LOG_TRACE("CONSENSUS", "Sketch of transaction set {} is not from current round", shortStr(prop->TxSetId.getHex()));
+            return true;
+        }
+        const auto knownIt = consensus_->acquiredSets_.find(prop->TxSetId.getHex());
+        if (knownIt != consensus_->acquiredSets_.end()){
+            prop->txSet.txSet = knownIt->second.set;
+            consensus_->gotTxSet(prop);
+            return true;
+        }
+        // difference from our proposed set gives disputes directly
+        bool againstPosition = consensus_->result_.isSet();
+        TransactionSet set;
+        if (againstPosition){
+            set = consensus_->result_.txns;
+        } else {
+            getCurrentTransactionSet(set);
+        }
+        PQB::byte key[HashMan::SIPHASH_KEY_SIZE];
+        sketchProp.getShortIdKey(key);
+        std::unordered_map<ShortTxId, TransactionPtr> ourIds;
+        ourIds.reserve(set.size());
+        SetSketch diffSketch(sketchProp.sketch.getCellCount());
+        for (const auto &tx : set){
+            ShortTxId shortId = CompactTxSetProposal::getShortId(key, tx->IDHash);
+            if (!ourIds.emplace(shortId, tx).second){
+                return false;
+            }
+            diffSketch.insert(shortId);
+        }
+        std::vector<ShortTxId> onlyPeer, onlyOur;
+        SetSketch peerSketch = sketchProp.sketch;
+        if (!peerSketch.subtract(diffSketch) || !peerSketch.decode(onlyPeer, onlyOur)){
+            PQB_LOG_TRACE("CONSENSUS", "Sketch of transaction set {} can not be decoded", shortStr(prop->TxSetId.getHex()));
+            return false;
+        }
+        TransactionSet diff;
+        for (const auto shortId : onlyOur){
+            const auto it = ourIds.find(shortId);
+            if (it == ourIds.end()){
+                return false;
+            }
+            set.erase(it->second);
+            diff.insert(it->second);
+        }
+        if (!onlyPeer.empty()){
+            std::unordered_map<ShortTxId, TransactionPtr> peerTxs;
+            for (const auto shortId : onlyPeer){
+                peerTxs.emplace(shortId, nullptr);
+            }
+            for (const auto &[txId, tx] : txPool_){
+                const auto it = peerTxs.find(CompactTxSetProposal::getShortId(key, txId));
+                if (it != peerTxs.end()){
+                    if (it->second != nullptr){ // short ID is not unique
+                        return false;
+                    }
+                    it->second = tx;
+                }
+            }
+            for (const auto &[shortId, tx] : peerTxs){
+                if (tx == nullptr || !set.insert(tx).second){
+                    return false;
+                }
+                diff.insert(tx);
+            }
+        }
+        if (set.size() != prop->txSet.transactionCount || ComputeTxSetMerkleRoot(set) != prop->TxSetId){
+            PQB_LOG_TRACE("CONSENSUS", "Transaction set {} reconciled from sketch does not match its ID", shortStr(prop->TxSetId.getHex()));
+            return false;
+        }
+        PQB_LOG_TRACE("CONSENSUS", "Transaction set {} reconciled from sketch with {} different transactions",
+                    shortStr(prop->TxSetId.getHex()), diff.size());
+        prop->txSet.txSet = std::move(set);
+        consensus_->gotTxSet(prop, againstPosition ? &diff : nullptr);
+        return true;
+    }
+
+    std::pair<byteId_t&, BlockHeaderPtr&> ConsensusWrapper::getPreferred(){
         return chain_->getPreferredBlock();
     }
 
@@ -115,43 +308,95 @@ namespace PQB{
         return wallet_->getUNL().size();
     }
 
-    void ConsensusWrapper::share(TxSetProposal &prop){
+    void ConsensusWrapper::share(TxSetProposal &prop, TxSetDeltaProposal *delta){
         prop.issuer = wallet_->getWalletID();
-        prop.sign(wallet_->getSecretKey());
-        TxSetProposalMessage *msg = new TxSetProposalMessage(prop.getSize());
-        msg->serialize(&prop);
-        ConnectionManager::MessageRequest_t req = {.type=ConnectionManager::MessageRequestType::BROADCAST, .connectionID=0, .peerID="", .message=msg};
+        prop.sign(*wallet_->getExpandedSecretKey());
+        const size_t legacySize = Message::HEADER_SIZE + prop.getSize();
+
+        uint64_t salt;
+        RandomGenerator::generate(reinterpret_cast<PQB::byte*>(&salt), sizeof(salt));
+        CompactTxSetProposal compact(prop, salt);
+        // transactions which arrived recently were probably not received by all peers yet, so they are sent whole
+        auto now = std::chrono::steady_clock::now();
+        for (const auto &[arrival, txId] : recentTxs_){
+            if ((now - arrival) > std::chrono::milliseconds(COMPACT_PROPOSAL_PREFILL_TIME)){
+                continue;
+            }
+            const auto poolIt = txPool_.find(txId);
+            if (poolIt == txPool_.end()){
+                continue;
+            }
+            const auto setIt = prop.txSet.txSet.find(poolIt->second);
+            if (setIt != prop.txSet.txSet.end() && *setIt == poolIt->second){
+                compact.prefilled.addTransaction(poolIt->second);
+            }
+        }
+        // sketch decodes differences caused by recent transactions which peers may not have included yet
+        TxSetSketchProposal sketch(prop, salt, compact.prefilled.txSet.size() + TX_SET_SKETCH_MARGIN);
+        sketch.prefilled = compact.prefilled;
+        Message *msg;
+        if (delta != nullptr){
+            delta->proposal.setExceptTxSet(prop);
+        }
+        if (delta != nullptr && delta->getSize() < std::min(compact.getSize(), sketch.getSize())){
+            msg = new TxSetDeltaProposalMessage(delta->getSize());
+            msg->serialize(delta);
+            PQB_LOG_TRACE("CONSENSUS", "Transaction set {} shared as difference from {} with {} added and {} removed transactions ({} bytes instead of {} bytes)",
+                        shortStr(prop.TxSetId.getHex()), shortStr(delta->baseTxSetId.getHex()), delta->added.size(), delta->removed.size(),
+                        msg->getSize(), legacySize);
+        } else if (sketch.getSize() < compact.getSize()){
+            msg = new TxSetSketchProposalMessage(sketch.getSize());
+            msg->serialize(&sketch);
+            PQB_LOG_TRACE("CONSENSUS", "Transaction set {} shared as sketch with {} cells and {} prefilled transactions ({} bytes instead of {} bytes)",
+                        shortStr(prop.TxSetId.getHex()), sketch.sketch.getCellCount(), sketch.prefilled.txSet.size(), msg->getSize(), legacySize);
+        } else {
+            msg = new CompactTxSetProposalMessage(compact.getSize());
+            msg->serialize(&compact);
+            PQB_LOG_TRACE("CONSENSUS", "Transaction set {} shared with {} of {} transactions prefilled ({} bytes instead of {} bytes)",
+                        shortStr(prop.TxSetId.getHex()), compact.prefilled.txSet.size(), compact.shortIds.size(), msg->getSize(), legacySize);
+        }
+        // whole proposal is serialized by an I/O thread just if some peer has older message version, its copy is kept until then
+        auto legacyProp = std::make_shared<TxSetProposal>(prop);
+        auto createLegacyMsg = [legacyProp]() -> Message* {
+            TxSetProposalMessage *legacyMsg = new TxSetProposalMessage(legacyProp->getSize());
+            legacyMsg->serialize(legacyProp.get());
+            return legacyMsg;
+        };
+        ConnectionManager::MessageRequest_t req = {.type=ConnectionManager::MessageRequestType::BROADCAST, .connectionID=0, .peerID="",
+                                                   .message=msg, .legacyMessage=createLegacyMsg};
         connMng_->addMessageRequest(req);
     }
 
     void ConsensusWrapper::share(BlockProposal &prop){
         prop.issuer = wallet_->getWalletID();
-        prop.sign(wallet_->getSecretKey());
+        prop.sign(*wallet_->getExpandedSecretKey());
         BlockProposalMessage *msg = new BlockProposalMessage(prop.getSize());
         msg->serialize(&prop);
         ConnectionManager::MessageRequest_t req = {.type=ConnectionManager::MessageRequestType::BROADCAST, .connectionID=0, .peerID="", .message=msg};
         connMng_->addMessageRequest(req);
     }
 
-    bool ConsensusWrapper::addBlockProposalToChain(BlockProposalPtr &blockProp, byte64_t &currBlockId){
+    bool ConsensusWrapper::addBlockProposalToChain(BlockProposalPtr &blockProp, byteId_t &currBlockId){
         BlockHeaderPtr blockhdr = std::make_shared<BlockHeader>();
         blockhdr->accountBalanceMerkleRootHash.SetNull();
         blockhdr->previousBlockHash = blockProp->proposedBlockHeader.previousBlockHash;
         blockhdr->sequence = blockProp->proposedBlockHeader.sequence;
         blockhdr->size = blockProp->proposedBlockHeader.size;
         blockhdr->transactionsMerkleRootHash = blockProp->proposedBlockHeader.transactionsMerkleRootHash;
+        blockhdr->signaturesMerkleRootHash = blockProp->proposedBlockHeader.signaturesMerkleRootHash;
         blockhdr->version = blockProp->proposedBlockHeader.version;
         chain_->insert(blockProp->issuer.getHex(), std::move(blockhdr));
         return chain_->updateValidBlock(currBlockId);
     }
 
-    bool ConsensusWrapper::addBlockHeaderToChain(BlockPtr &block, byte64_t &currBlockId){
+    bool ConsensusWrapper::addBlockHeaderToChain(BlockPtr &block, byteId_t &currBlockId){
         BlockHeaderPtr blockhdr = std::make_shared<BlockHeader>();
         blockhdr->accountBalanceMerkleRootHash.SetNull();
         blockhdr->previousBlockHash = block->previousBlockHash;
         blockhdr->sequence = block->sequence;
         blockhdr->size = block->size;
         blockhdr->transactionsMerkleRootHash = block->transactionsMerkleRootHash;
+        blockhdr->signaturesMerkleRootHash = block->signaturesMerkleRootHash;
         blockhdr->version = block->version;
         chain_->insert(wallet_->getWalletID().getHex(), std::move(blockhdr), true);
         return chain_->updateValidBlock(currBlockId);
@@ -161,15 +406,13 @@ namespace PQB{
         std::string thisNodeId = wallet->getWalletID().getHex();
         WalletData::TxState stateOfTx = WalletData::TxState::WAITING; // used in case of transaction related to local wallet
         AccountBalance acc;
-        byte64_t currAcc; // Id of current processed account
+        byteId_t currAcc; // Id of current processed account
         currAcc.SetNull();
         std::string senderHash;
-        std::string receiverHash;
         PQB::cash upBalance = 0; // updated balance
         auto it = txSet.begin();
         while (it != txSet.end()){
             TransactionPtr tx = *it;
-            receiverHash = tx->receiverWalletAddress.getHex();
 
             // Get balance data from account storage
             if (currAcc != tx->senderWalletAddress){
@@ -187,7 +430,7 @@ namespace PQB{
             bool thisNodeTxAsReceiv = false;
             if (tx->senderWalletAddress == wallet->getWalletID()){
                 thisNodeTxAsSender = true;
-            } else if (tx->receiverWalletAddress == wallet->getWalletID()){
+            } else if (tx->getAmountFor(wallet->getWalletID()) != 0){
                 thisNodeTxAsReceiv = true;
             }
 
@@ -241,12 +484,16 @@ namespace PQB{
                 accDiffs[senderHash] = {.id=&tx->senderWalletAddress, .balanceDiff=(0-tx->cashAmount), .txSequence=tx->sequenceNumber};
             }
             
-            const auto receiverIt = accDiffs.find(receiverHash);
-            if (receiverIt != accDiffs.end()){
-                receiverIt->second.balanceDiff += tx->cashAmount;
-            } else {
-                accDiffs[receiverHash] = {.id=&tx->receiverWalletAddress, .balanceDiff=tx->cashAmount, .txSequence=0};
-            }
+            // Credit all receivers (one receiver or all outputs of multi-payment transaction)
+            tx->forEachOutput([&accDiffs](const byteId_t &receiver, PQB::cash amount){
+                std::string receiverHash = receiver.getHex();
+                const auto receiverIt = accDiffs.find(receiverHash);
+                if (receiverIt != accDiffs.end()){
+                    receiverIt->second.balanceDiff += amount;
+                } else {
+                    accDiffs[receiverHash] = {.id=&receiver, .balanceDiff=amount, .txSequence=0};
+                }
+            });
             // Update local wallet
             if (thisNodeTxAsSender) { wallet->updateTransaction(tx->IDHash.getHex(), stateOfTx); }
             else if (thisNodeTxAsReceiv) { wallet->receivedTransaction(tx->IDHash.getHex(), tx->getTransactionData(), stateOfTx); }
@@ -274,12 +521,16 @@ namespace PQB{
         if (block->txSet.size() != txSetCount){ // if there were invalid transactions recalculate txSet
             block->transactionCount = block->txSet.size();
             block->transactionsMerkleRootHash = ComputeTxSetMerkleRoot(block->txSet);
+            block->signaturesMerkleRootHash = ComputeTxSetSignaturesMerkleRoot(block->txSet);
             block->size = block->getSize();
         }
 
         block->accountBalanceMerkleRootHash = accS_->blncDB->getAccountsMerkleRootHash();
         chain_->assignAccountHashToValidBlock(block->accountBalanceMerkleRootHash);
         blockS_->setBlock(block.get());
+        if (block->sequence > BLOCK_SIGNATURES_PRUNE_DEPTH){
+            blockS_->pruneSignatures(block->sequence - BLOCK_SIGNATURES_PRUNE_DEPTH);
+        }
     }
 
     /*  CONSENSUS  */
@@ -364,20 +615,23 @@ namespace PQB{
                     shortStr(result_.txProposal.TxSetId.getHex()), currBlock_->sequence);
     }
 
-    void Consensus::gotTxSet(TxSetProposalPtr &prop){
+    bool Consensus::isCurrentProposal(const TxSetProposal &prop) const{
         if (phase_ == ConsensusPhase::ACCEPTED){
-            return;
+            return false;
+        }
+        if (prop.previousBlockId != prevBlockid_){
+            return false;
         }
-        if (prop->previousBlockId != prevBlockid_){
+        const auto peerPosIt = currPeerProposals_.find(prop.issuer.getHex());
+        return (peerPosIt == currPeerProposals_.end() || prop.seq > peerPosIt->second.seq);
+    }
+
+    void Consensus::gotTxSet(TxSetProposalPtr &prop, const TransactionSet *diff){
+        if (!isCurrentProposal(*prop)){
             return;
         }
         PeerId peerId = prop->issuer.getHex();
         auto peerPosIt = currPeerProposals_.find(peerId);
-        if (peerPosIt != currPeerProposals_.end()){
-            if (prop->seq <= peerPosIt->second.seq){
-                return;
-            }
-        }
 
         TxSetId id = prop->TxSetId.getHex();
         CProposal newPos = {.prevBlockId=std::move(prop->previousBlockId), .txSetId=id, .time=prop->time, .seq=prop->seq};
@@ -404,7 +658,7 @@ namespace PQB{
         } else {
             for (const auto &[nodeId, peerPos] : currPeerProposals_){
                 if (peerPos.txSetId == id){
-                    updateDisputes(nodeId, newCTxSet);
+                    updateDisputes(nodeId, newCTxSet, diff);
                 }
             }
         }
@@ -447,6 +701,8 @@ namespace PQB{
             }
         }
         if (currSetCopy != result_.txns){
+            // peers have the previous proposal, so just the difference from it is sent
+            TxSetDeltaProposal delta(result_.txProposal.seq, result_.txProposal.TxSetId, result_.txns, currSetCopy);
             result_.txns = std::move(currSetCopy);
             const auto time = std::chrono::system_clock::now();
             result_.txProposal.time = std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
@@ -455,7 +711,7 @@ namespace PQB{
             result_.txProposal.txSet.transactionCount = result_.txns.size();
             result_.txProposal.txSet.txSet = result_.txns;
             result_.txProposal.TxSetId = ComputeTxSetMerkleRoot(result_.txns);
-            wrapper_->share(result_.txProposal);
+            wrapper_->share(result_.txProposal, &delta);
 
             CTxSet newCTxSet = {.set=result_.txns, .setId=result_.txProposal.TxSetId, .time=result_.txProposal.time};
             if (acquiredSets_.emplace(result_.txProposal.TxSetId.getHex(), newCTxSet).second){
@@ -490,6 +746,7 @@ namespace PQB{
         currBlock_->transactionCount = result_.txns.size();
         currBlock_->txSet = std::move(result_.txns);
         currBlock_->transactionsMerkleRootHash = result_.txProposal.TxSetId;
+        currBlock_->signaturesMerkleRootHash = ComputeTxSetSignaturesMerkleRoot(currBlock_->txSet);
         currBlock_->size = currBlock_->getSize();
         currBlockId_ = currBlock_->getBlockHash();
         // Create proposal on this block
@@ -527,7 +784,7 @@ namespace PQB{
         }
     }
 
-    void Consensus::createDisputes(CTxSet &set){
+    void Consensus::createDisputes(CTxSet &set, const TransactionSet *diff){
         
         // Only create disputes if this is a new set
         if (!result_.compares.emplace(set.setId).second){
@@ -539,9 +796,12 @@ namespace PQB{
             return;
         }
 
-        TransactionSet diff;
-        std::set_symmetric_difference(result_.txns.begin(), result_.txns.end(), set.set.begin(), set.set.end(), std::inserter(diff, diff.end()));
-        for (auto &tx : diff){
+        TransactionSet computedDiff;
+        if (diff == nullptr){
+            std::set_symmetric_difference(result_.txns.begin(), result_.txns.end(), set.set.begin(), set.set.end(), std::inserter(computedDiff, computedDiff.end()));
+            diff = &computedDiff;
+        }
+        for (auto &tx : *diff){
             
             std::string txId = tx->IDHash.getHex();
 
@@ -567,9 +827,9 @@ namespace PQB{
         }
     }
 
-    void Consensus::updateDisputes(const PeerId &node, CTxSet &set){
+    void Consensus::updateDisputes(const PeerId &node, CTxSet &set, const TransactionSet *diff){
         if (result_.compares.find(set.setId) == result_.compares.end()){
-            createDisputes(set);
+            createDisputes(set, diff);
         }
 
         for (auto &it : result_.disputes){
@@ -28,6 +28,8 @@
 #pragma once
 
 #include <map>
+#include <deque>
+#include <vector>
 #include <unordered_map>
 #include <thread>
 #include <mutex>
@@ -65,6 +67,7 @@ private:
     ConnectionManager *connMng_;
 
     TransactionPool txPool_;
+    std::deque<std::pair<std::chrono::steady_clock::time_point, byteId_t>> recentTxs_; ///< IDs of transactions added to txPool_ in last COMPACT_PROPOSAL_PREFILL_TIME ms with time of arrival
     Consensus *consensus_;
     std::jthread consensusThread_;
     std::condition_variable consensusCondition_;
@@ -74,8 +77,12 @@ private:
     /// @brief Thread which is running loop with consensus
     void consensusThread();
 
-    /// @brief Broadcast transaction set proposal to peers, this will also set the signature of the proposal
-    void share(TxSetProposal &prop);
+    /// @brief Broadcast transaction set proposal to peers, this will also set the signature of the proposal.
+    /// The proposal is sent as the smallest of CompactTxSetProposal, TxSetSketchProposal and TxSetDeltaProposal (transactions
+    /// which arrived recently are prefilled), peers with older message version get the whole proposal.
+    /// @param prop proposal to share
+    /// @param delta difference of the proposal from the previous proposal or nullptr (its proposal is set here)
+    void share(TxSetProposal &prop, TxSetDeltaProposal *delta = nullptr);
 
     /// @brief Broadcast block proposal to peers, this will also set the signature of the proposal
     void share(BlockProposal &prop);
@@ -85,14 +92,14 @@ private:
     /// @param blockProp proposal with block header that will be inserted into chain
     /// @param currBlockId id of current working block
     /// @return true if quorum for consensus on block validation was reached, false if not
-    bool addBlockProposalToChain(BlockProposalPtr &blockProp, byte64_t &currBlockId);
+    bool addBlockProposalToChain(BlockProposalPtr &blockProp, byteId_t &currBlockId);
 
     /// @brief Add Block header to Chain (header issuer is local node)
     /// @warning this method should be used to add block headers that was issued by this node only
     /// @param block block with block header that will be inserted into chain
     /// @param currBlockId id of current working block (hash of `block`)
     /// @return true if quorum for consensus on block validation was reached, false if not
-    bool addBlockHeaderToChain(BlockPtr &block, byte64_t &currBlockId);
+    bool addBlockHeaderToChain(BlockPtr &block, byteId_t &currBlockId);
 
     /// @brief Iterate through given `txSet`, check the sequence numbers of the transactions, balances of accounts and fill  
     /// `accDiffs` hash table with account differences. This also notify wallet and set wallet account balance and transaction records.
@@ -111,7 +118,7 @@ private:
     void executeBlock(BlockPtr block);
 
     /// @brief Get ID and header of Block on which majority of UNL nodes are woking on
-    std::pair<byte64_t&, BlockHeaderPtr&> getPreferred();
+    std::pair<byteId_t&, BlockHeaderPtr&> getPreferred();
 
     /// @brief Fill `set` with transactions (transactions from txPool_)
     /// @param set [out] final set of transactions
@@ -133,17 +140,17 @@ public:
     }
 
     /// @brief Check if given transaction is in Transaction pool
-    bool isTransactionInPool(const byte64_t tx_id);
+    bool isTransactionInPool(const byteId_t tx_id);
 
     /// @brief Get transaction from pool based on give transaction has (ID), return nullptr if not found
-    TransactionPtr getTransactionFromPool(const byte64_t tx_id);
+    TransactionPtr getTransactionFromPool(const byteId_t tx_id);
 
     /// @brief Add new transaction to the transaction pool
     /// @return true if transaction was added, false if transaction already exists in the pool
     bool addTransactionToPool(TransactionPtr tx);
 
     /// @brief Erase transaction from transaction pool, if not found do nothing
-    void removeTransactionFromPool(const byte64_t tx_id);
+    void removeTransactionFromPool(const byteId_t tx_id);
 
     /// @brief Notify ConsensusWrapper that new BlockProposal was received
     void notifyBlockProposal(BlockProposalPtr &prop);
@@ -151,6 +158,57 @@ public:
     /// @brief Notify ConsensusWrapper that new TransactionSetProposal was received
     void notifyTxSetProposal(TxSetProposalPtr &prop);
 
+    /**
+     * @brief Find transactions of a compact transaction set proposal in the transaction pool by their short IDs
+     * 
+     * @param prop compact proposal
+     * @param txs [out] transactions in order of short IDs of the proposal, nullptr if the transaction was not found or if
+     * its short ID is not unique (then it has to be requested by its index)
+     */
+    void getTransactionsByShortIds(const CompactTxSetProposal &prop, std::vector<TransactionPtr> &txs);
+
+    /**
+     * @brief Reconstruct transaction set of a compact transaction set proposal from the transaction pool
+     * 
+     * @param prop compact proposal
+     * @param set [out] reconstructed transaction set, it is filled only if it matches ID of the proposal
+     * @param missing [out] indexes of short IDs which were not resolved (see getTransactionsByShortIds())
+     * @return true if the whole set was reconstructed and it matches ID of the proposal
+     * @return false if some transactions are missing or if short IDs matched wrong transactions (`missing` is empty then)
+     */
+    bool reconstructTxSet(const CompactTxSetProposal &prop, TransactionSet &set, std::vector<uint32_t> &missing);
+
+    /**
+     * @brief Get transactions of a transaction set which was proposed in current consensus round
+     * 
+     * @param txSetId ID of the transaction set
+     * @param indexes indexes of transactions in the set (in order of TransactionSet), empty for all transactions
+     * @param txs [out] found transactions
+     * @return false if the transaction set is not known
+     */
+    bool getProposedTransactions(const byteId_t &txSetId, const std::vector<uint32_t> &indexes, BlockBody &txs);
+
+    /**
+     * @brief Create transaction set of a delta proposal from its base set which was proposed in current consensus round.
+     * Added transactions are taken from the transaction pool.
+     * 
+     * @param delta delta proposal
+     * @param set [out] resulting transaction set (its ID has to be checked)
+     * @return false if the base set or some of added transactions is not known
+     */
+    bool applyTxSetDelta(const TxSetDeltaProposal &delta, TransactionSet &set);
+
+    /**
+     * @brief Reconcile transaction set of a sketch proposal with our proposed transaction set (or with the transaction pool
+     * if we have not proposed yet) and notify the consensus about the proposal. Disputes are created from the decoded difference.
+     * 
+     * @param sketchProp sketch proposal (its prefilled transactions have to be already in the transaction pool)
+     * @param prop [in,out] proposal of the sketch, its transaction set is filled
+     * @return false if the difference can not be decoded or if some different transaction is not known (then the set has to be requested),
+     * true also if the proposal is not from current round or it is older than the last proposal of its issuer (then it is ignored)
+     */
+    bool notifyTxSetSketchProposal(const TxSetSketchProposal &sketchProp, TxSetProposalPtr &prop);
+
     static void countAccountDifferencesByTxSet(
     AccountBalanceStorage *accBalanceStorage, 
     Wallet *wallet,
@@ -162,11 +220,14 @@ public:
 
 
 class Consensus{
+
+friend class ConsensusWrapper;
+
 private:
 
     using PeerId = std::string;
     using TxSetId = std::string;
-    using BlockId = byte64_t;
+    using BlockId = byteId_t;
     using Ms = std::chrono::milliseconds;
     using Clock = std::chrono::steady_clock;
     using TimePoint = std::chrono::time_point<Clock>;
@@ -202,8 +263,13 @@ public:
     /// @brief Take current transactions, place them to a block and move to establish phase
     void closeBlock();
 
+    /// @brief Check if a transaction set proposal is based on our previous block and if it is newer than the last proposal of its issuer
+    bool isCurrentProposal(const TxSetProposal &prop) const;
+
     /// @brief Process a transaction set (`prop`) by the consensus
-    void gotTxSet(TxSetProposalPtr &prop);
+    /// @param prop proposal with the transaction set
+    /// @param diff transactions which are just in one of `prop` set and our set (nullptr if not known)
+    void gotTxSet(TxSetProposalPtr &prop, const TransactionSet *diff = nullptr);
 
     /// @brief Process a block proposal (`prop`) by the consensus
     void peerProposal(BlockProposalPtr &prop);
@@ -211,12 +277,14 @@ public:
     /// @brief Create hash map of disputed transactions (it is stored in result_->disputes)
     /// Disputes are transactions that are different between proposed set of transactions
     /// @param set Set of transaction for which to create disputes
-    void createDisputes(CTxSet &set);
+    /// @param diff symmetric difference of `set` and our set, it is computed if nullptr
+    void createDisputes(CTxSet &set, const TransactionSet *diff = nullptr);
 
     /// @brief Update disputes based on new proposed `set` from some `node`
     /// @param node node for which to update disputes
     /// @param set set of proposed transactions
-    void updateDisputes(const PeerId &node, CTxSet &set);
+    /// @param diff symmetric difference of `set` and our set, it is computed if nullptr
+    void updateDisputes(const PeerId &node, CTxSet &set, const TransactionSet *diff = nullptr);
 
     /// @brief Base on disputed transaction update our proposal
     void updateProposals();
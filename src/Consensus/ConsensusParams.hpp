@@ -67,7 +67,7 @@ enum class ConsensusPhase{
 
 /// @brief Consensus proposal
 struct CProposal{
-    byte64_t prevBlockId; ///< last proposed block ID
+    byteId_t prevBlockId; ///< last proposed block ID
     std::string txSetId;  ///< last proposed transaction set ID
     timestamp time;       ///< proposed time
     uint32_t seq;         ///< sequence number of the last proposal
@@ -76,7 +76,7 @@ struct CProposal{
 /// @brief Transaction set for consensus
 struct CTxSet{
     TransactionSet set;
-    byte64_t setId;
+    byteId_t setId;
     timestamp time;    ///< last time when this set was proposed
 
     /// @brief Check if given transaction exists in this set
@@ -88,7 +88,7 @@ class ConsensusResult{
 public:
 
     TransactionSet txns; ///< set of transactions consensus agrees on
-    std::set<byte64_t> compares;
+    std::set<byteId_t> compares;
     TxSetProposal txProposal;
     std::unordered_map<std::string, DisputeTransaction> disputes; ///< collection of disputed transactios
     std::chrono::duration<double, std::milli> roundTime; ///< duration of the establish phase
@@ -16,9 +16,9 @@
 namespace PQB{
 
 
-byte64_t ComputeMerkleRoot(std::vector<byte64_t> leafsHashes){
+byteId_t ComputeMerkleRoot(std::vector<byteId_t> leafsHashes){
     if (leafsHashes.empty()){
-        byte64_t empty;
+        byteId_t empty;
         empty.setHex(std::string(EMPTY_STRING_HASH));
         return empty;
     }
@@ -36,8 +36,31 @@ byte64_t ComputeMerkleRoot(std::vector<byte64_t> leafsHashes){
 }
 
 
-byte64_t ComputeBlocksMerkleRoot(PQB::Block &block){
-    std::vector<byte64_t> txHashes;
+byteId_t ComputeMerkleRootAndPaths(std::vector<byteId_t> leafsHashes, std::vector<std::vector<byteId_t>> &paths){
+    paths.assign(leafsHashes.size(), {});
+    if (leafsHashes.empty()){
+        return ComputeMerkleRoot(std::move(leafsHashes));
+    }
+    for (size_t level = 0; leafsHashes.size() > 1; level++)
+    {
+        if(leafsHashes.size() & 1){
+            leafsHashes.push_back(leafsHashes.back());
+        }
+        // node of leaf i on this level has index (i >> level), its sibling differs in the lowest bit
+        for(size_t i = 0; i < paths.size(); i++){
+            paths[i].push_back(leafsHashes[(i >> level) ^ 1]);
+        }
+        for(size_t i = 0, j = 0; i < leafsHashes.size(); i += 2, j++){
+            HashMan::SHA512_hash(&(leafsHashes[j]), leafsHashes[i], leafsHashes[i+1]);
+        }
+        leafsHashes.resize(leafsHashes.size() / 2);
+    }
+    return leafsHashes[0];
+}
+
+
+byteId_t ComputeBlocksMerkleRoot(PQB::Block &block){
+    std::vector<byteId_t> txHashes;
     if(block.txSet.size() & 1){
         txHashes.reserve(block.txSet.size()+1);
     }else{
@@ -51,8 +74,8 @@ byte64_t ComputeBlocksMerkleRoot(PQB::Block &block){
 }
 
 
-byte64_t ComputeTxSetMerkleRoot(TransactionSet &set){
-    std::vector<byte64_t> txHashes;
+byteId_t ComputeTxSetMerkleRoot(TransactionSet &set){
+    std::vector<byteId_t> txHashes;
     if(set.size() & 1){
         txHashes.reserve(set.size()+1);
     }else{
@@ -65,6 +88,16 @@ byte64_t ComputeTxSetMerkleRoot(TransactionSet &set){
     return ComputeMerkleRoot(std::move(txHashes));
 }
 
+
+byteId_t ComputeTxSetSignaturesMerkleRoot(TransactionSet &set){
+    std::vector<byteId_t> witnessHashes;
+    witnessHashes.reserve(set.size() + 1);
+    for(const auto &tx : set){
+        witnessHashes.push_back(tx->getWitnessHash());
+    }
+    return ComputeMerkleRoot(std::move(witnessHashes));
+}
+
 } // PQB namespace
 
 
@@ -25,7 +25,7 @@ namespace PQB{
  * @brief Compute Merkle Root Hash for given vector
  * 
  * @param leafsHashes pointers to vector with SHA-512 hashes
- * @return byte64_t SHA-512 Merkle Root Hash
+ * @return byteId_t SHA-512 Merkle Root Hash
  * 
  * @note This function should not be used for directly calculating block's Merkle tree root hash!
  * This is because a vector can have duplicit elements in it, which can lead to invalid calculation
@@ -33,25 +33,48 @@ namespace PQB{
  * 
  * @warning This algorithm is not optimized!
  */
-byte64_t ComputeMerkleRoot(std::vector<byte64_t> leafsHashes);
+byteId_t ComputeMerkleRoot(std::vector<byteId_t> leafsHashes);
+
+
+/**
+ * @brief Compute Merkle Root Hash for given vector and audit paths of all leafs
+ * 
+ * Audit path of a leaf are hashes of siblings of nodes on the way from the leaf to the root (bottom-up). The root
+ * can be computed from the leaf, its index and the audit path (see Transaction::getSignedHash()).
+ * 
+ * @param leafsHashes vector with SHA-512 hashes
+ * @param paths [out] audit paths of leafs in order of `leafsHashes`
+ * @return byteId_t SHA-512 Merkle Root Hash (the same as ComputeMerkleRoot())
+ */
+byteId_t ComputeMerkleRootAndPaths(std::vector<byteId_t> leafsHashes, std::vector<std::vector<byteId_t>> &paths);
 
 
 /**
  * @brief Compute Merkle Tree Root of block's transactions
  * 
  * @param block 
- * @return byte64_t SHA-512 Merkle Root Hash
+ * @return byteId_t SHA-512 Merkle Root Hash
  */
-byte64_t ComputeBlocksMerkleRoot(PQB::Block &block);
+byteId_t ComputeBlocksMerkleRoot(PQB::Block &block);
 
 
 /**
  * @brief Compute Merkle Tree Root of transaction set
  * 
  * @param set 
- * @return byte64_t SHA-512 Merkle Root Hash
+ * @return byteId_t SHA-512 Merkle Root Hash
+ */
+byteId_t ComputeTxSetMerkleRoot(TransactionSet &set);
+
+
+/**
+ * @brief Compute Merkle Tree Root of witnesses (signatures) of transaction set (BlockHeader::signaturesMerkleRootHash)
+ * 
+ * @param set transaction set with signed transactions
+ * @return byteId_t SHA-512 Merkle Root Hash
+ * @exception if some transaction of the set is not signed
  */
-byte64_t ComputeTxSetMerkleRoot(TransactionSet &set);
+byteId_t ComputeTxSetSignaturesMerkleRoot(TransactionSet &set);
 
 
 } // PQB namespace
@@ -19,6 +19,7 @@ namespace PQB{
             blockId.IsNull() ||
             proposedBlockHeader.previousBlockHash.IsNull() ||
             proposedBlockHeader.transactionsMerkleRootHash.IsNull() ||
+            proposedBlockHeader.signaturesMerkleRootHash.IsNull() ||
             !proposedBlockHeader.accountBalanceMerkleRootHash.IsNull() ||
             proposedBlockHeader.sequence == 0){
                 return false;
@@ -26,7 +27,7 @@ namespace PQB{
         return true;
     }
 
-    void BlockProposal::getHash(byte64_t &outHash) const{
+    void BlockProposal::getHash(byteId_t &outHash) const{
         byteBuffer dataToHash;
         size_t offset = 0;
         dataToHash.resize(sizeof(typeOfProposal) + sizeof(issuer) + sizeof(blockId));
@@ -37,17 +38,24 @@ namespace PQB{
     }
 
     void BlockProposal::sign(byteBuffer &privateKey){
-        byte64_t propHash;
+        byteId_t propHash;
         getHash(propHash);
-        SignAlgorithmPtr s = Signer::GetInstance();
-        signatureSize = s->sign(signature, propHash.data(), propHash.size(), privateKey);
+        auto &s = ChosenSigner::get();
+        signatureSize = s.sign(signature, propHash.data(), propHash.size(), privateKey);
+    }
+
+    void BlockProposal::sign(const ExpandedPrivateKey &privateKey){
+        byteId_t propHash;
+        getHash(propHash);
+        auto &s = ChosenSigner::get();
+        signatureSize = s.sign(signature, propHash.data(), propHash.size(), privateKey);
     }
 
     bool BlockProposal::verify(byteBuffer &publicKey){
-        byte64_t propHash;
+        byteId_t propHash;
         getHash(propHash);
-        SignAlgorithmPtr s = Signer::GetInstance();
-        if (s->verify(signature, propHash.data(), propHash.size(), publicKey)){
+        auto &s = ChosenSigner::get();
+        if (s.verify(signature, propHash.data(), propHash.size(), publicKey)){
             return true;
         }
         return false;
@@ -105,7 +113,7 @@ namespace PQB{
         return true;
     }
 
-    void TxSetProposal::getHash(byte64_t &outHash) const
+    void TxSetProposal::getHash(byteId_t &outHash) const
     {
         byteBuffer dataToHash;
         size_t offset = 0;
@@ -120,17 +128,24 @@ namespace PQB{
     }
 
     void TxSetProposal::sign(byteBuffer &privateKey){
-        byte64_t propHash;
+        byteId_t propHash;
+        getHash(propHash);
+        auto &s = ChosenSigner::get();
+        signatureSize = s.sign(signature, propHash.data(), propHash.size(), privateKey);
+    }
+
+    void TxSetProposal::sign(const ExpandedPrivateKey &privateKey){
+        byteId_t propHash;
         getHash(propHash);
-        SignAlgorithmPtr s = Signer::GetInstance();
-        signatureSize = s->sign(signature, propHash.data(), propHash.size(), privateKey);
+        auto &s = ChosenSigner::get();
+        signatureSize = s.sign(signature, propHash.data(), propHash.size(), privateKey);
     }
 
     bool TxSetProposal::verify(byteBuffer &publicKey){
-        byte64_t propHash;
+        byteId_t propHash;
         getHash(propHash);
-        SignAlgorithmPtr s = Signer::GetInstance();
-        if (s->verify(signature, propHash.data(), propHash.size(), publicKey)){
+        auto &s = ChosenSigner::get();
+        if (s.verify(signature, propHash.data(), propHash.size(), publicKey)){
             return true;
         }
         return false;
@@ -184,6 +199,48 @@ namespace PQB{
         txSet.deserialize(buffer, offset);
     }
 
+    void TxSetProposal::setExceptTxSet(const TxSetProposal &prop){
+        seq = prop.seq;
+        time = prop.time;
+        issuer = prop.issuer;
+        TxSetId = prop.TxSetId;
+        previousBlockId = prop.previousBlockId;
+        signatureSize = prop.signatureSize;
+        signature = prop.signature;
+        txSet.setNull();
+        txSet.transactionCount = prop.txSet.txSet.size();
+    }
+
+    size_t TxSetProposal::getSizeExceptTxSet() const{
+        if (signatureSize == 0){
+            throw Exceptions::Proposal("Proposal can not be serialized because proposal is not signed and size of the signature is unknow!");
+        }
+        return sizeof(typeOfProposal) +
+               sizeof(seq) +
+               sizeof(time) +
+               sizeof(issuer) +
+               sizeof(TxSetId) +
+               sizeof(previousBlockId) +
+               sizeof(signatureSize) +
+               signatureSize +
+               sizeof(txSet.transactionCount);
+    }
+
+    void TxSetProposal::serializeExceptTxSet(byteBuffer &buffer, size_t &offset) const{
+        if ((buffer.size() - offset) < getSizeExceptTxSet())
+            throw PQB::Exceptions::Proposal("Serialization: serialization buffer has not enough size to serialize the proposal");
+        serializeField(buffer, offset, typeOfProposal);
+        serializeField(buffer, offset, seq);
+        serializeField(buffer, offset, time);
+        serializeField(buffer, offset, issuer);
+        serializeField(buffer, offset, TxSetId);
+        serializeField(buffer, offset, previousBlockId);
+        serializeField(buffer, offset, signatureSize);
+        std::memcpy(buffer.data() + offset, signature.data(), signatureSize);
+        offset += signatureSize;
+        serializeField(buffer, offset, txSet.transactionCount);
+    }
+
     void TxSetProposal::deserializeExceptTxSet(const byteBuffer &buffer, size_t &offset){
         if ((buffer.size() - offset) < (sizeof(typeOfProposal) + sizeof(seq) + sizeof(time) + sizeof(issuer) + sizeof(TxSetId) + sizeof(previousBlockId) + sizeof(signatureSize)))
             throw PQB::Exceptions::Proposal("Deserialization: buffer has not enough size to deserialize the proposal");
@@ -199,9 +256,180 @@ namespace PQB{
         signature.resize(signatureSize);
         std::memcpy(signature.data(), buffer.data() + offset, signatureSize);
         offset += signatureSize;
+        if ((buffer.size() - offset) < sizeof(txSet.transactionCount))
+            throw PQB::Exceptions::Proposal("Deserialization: buffer has not enough size to deserialize the proposal");
         deserializeField(buffer, offset, txSet.transactionCount);
     }
 
+
+
+    CompactTxSetProposal::CompactTxSetProposal(const TxSetProposal &prop, uint64_t shortIdSalt){
+        setNull();
+        proposal.setExceptTxSet(prop);
+        salt = shortIdSalt;
+        PQB::byte key[HashMan::SIPHASH_KEY_SIZE];
+        getShortIdKey(key);
+        shortIds.reserve(prop.txSet.txSet.size());
+        for (const auto &tx : prop.txSet.txSet){
+            shortIds.push_back(getShortId(key, tx->IDHash));
+        }
+    }
+
+    void CompactTxSetProposal::getShortIdKey(const byteId_t &issuer, uint64_t salt, PQB::byte *key){
+        byteBuffer dataToHash;
+        size_t offset = 0;
+        dataToHash.resize(sizeof(issuer) + sizeof(salt));
+        serializeField(dataToHash, offset, issuer);
+        serializeField(dataToHash, offset, salt);
+        byteId_t hash;
+        HashMan::SHA512_hash(&hash, dataToHash.data(), dataToHash.size());
+        std::memcpy(key, hash.data(), HashMan::SIPHASH_KEY_SIZE);
+    }
+
+    size_t CompactTxSetProposal::getSize() const{
+        return proposal.getSizeExceptTxSet() +
+               sizeof(salt) +
+               shortIds.size() * sizeof(ShortTxId) +
+               prefilled.getSize();
+    }
+
+    void CompactTxSetProposal::serialize(byteBuffer &buffer, size_t &offset) const{
+        if ((buffer.size() - offset) < getSize())
+            throw PQB::Exceptions::Proposal("Serialization: serialization buffer has not enough size to serialize the proposal");
+        if (shortIds.size() != proposal.txSet.transactionCount)
+            throw PQB::Exceptions::Proposal("Serialization: number of short IDs does not match number of transactions of the proposal");
+        proposal.serializeExceptTxSet(buffer, offset);
+        serializeField(buffer, offset, salt);
+        for (const auto shortId : shortIds){
+            serializeField(buffer, offset, shortId);
+        }
+        prefilled.serialize(buffer, offset);
+    }
+
+    void CompactTxSetProposal::deserialize(const byteBuffer &buffer, size_t &offset){
+        proposal.deserializeExceptTxSet(buffer, offset);
+        if ((buffer.size() - offset) < sizeof(salt))
+            throw PQB::Exceptions::Proposal("Deserialization: buffer has not enough size to deserialize the proposal");
+        deserializeField(buffer, offset, salt);
+        // number of transactions is checked before the allocation of short IDs
+        if (((buffer.size() - offset) / sizeof(ShortTxId)) < proposal.txSet.transactionCount)
+            throw PQB::Exceptions::Proposal("Deserialization: buffer has not enough size to deserialize the proposal");
+        shortIds.resize(proposal.txSet.transactionCount);
+        for (auto &shortId : shortIds){
+            deserializeField(buffer, offset, shortId);
+        }
+        prefilled.deserialize(buffer, offset);
+    }
+
+
+
+
+    TxSetSketchProposal::TxSetSketchProposal(const TxSetProposal &prop, uint64_t shortIdSalt, size_t capacity)
+    : sketch(SetSketch::getCellCount(capacity)){
+        proposal.setExceptTxSet(prop);
+        salt = shortIdSalt;
+        PQB::byte key[HashMan::SIPHASH_KEY_SIZE];
+        getShortIdKey(key);
+        for (const auto &tx : prop.txSet.txSet){
+            sketch.insert(CompactTxSetProposal::getShortId(key, tx->IDHash));
+        }
+    }
+
+    size_t TxSetSketchProposal::getSize() const{
+        return proposal.getSizeExceptTxSet() +
+               sizeof(salt) +
+               sketch.getSize() +
+               prefilled.getSize();
+    }
+
+    void TxSetSketchProposal::serialize(byteBuffer &buffer, size_t &offset) const{
+        if ((buffer.size() - offset) < getSize())
+            throw PQB::Exceptions::Proposal("Serialization: serialization buffer has not enough size to serialize the proposal");
+        proposal.serializeExceptTxSet(buffer, offset);
+        serializeField(buffer, offset, salt);
+        sketch.serialize(buffer, offset);
+        prefilled.serialize(buffer, offset);
+    }
+
+    void TxSetSketchProposal::deserialize(const byteBuffer &buffer, size_t &offset){
+        proposal.deserializeExceptTxSet(buffer, offset);
+        if ((buffer.size() - offset) < sizeof(salt))
+            throw PQB::Exceptions::Proposal("Deserialization: buffer has not enough size to deserialize the proposal");
+        deserializeField(buffer, offset, salt);
+        sketch.deserialize(buffer, offset);
+        prefilled.deserialize(buffer, offset);
+    }
+
+
+
+    TxSetDeltaProposal::TxSetDeltaProposal(uint32_t baseProposalSeq, const byteId_t &baseSetId, const TransactionSet &baseSet, const TransactionSet &newSet){
+        setNull();
+        baseSeq = baseProposalSeq;
+        baseTxSetId = baseSetId;
+        // sets are ordered by senders, so the difference is computed on transaction IDs
+        std::set<byteId_t> baseIds, newIds;
+        for (const auto &tx : baseSet){
+            baseIds.insert(tx->IDHash);
+        }
+        for (const auto &tx : newSet){
+            newIds.insert(tx->IDHash);
+        }
+        std::set_difference(baseIds.begin(), baseIds.end(), newIds.begin(), newIds.end(), std::back_inserter(removed));
+        std::set_difference(newIds.begin(), newIds.end(), baseIds.begin(), baseIds.end(), std::back_inserter(added));
+    }
+
+    size_t TxSetDeltaProposal::getSize() const{
+        return proposal.getSizeExceptTxSet() +
+               sizeof(baseSeq) +
+               sizeof(baseTxSetId) +
+               sizeof(uint32_t) +
+               removed.size() * sizeof(byteId_t) +
+               sizeof(uint32_t) +
+               added.size() * sizeof(byteId_t);
+    }
+
+    void TxSetDeltaProposal::serialize(byteBuffer &buffer, size_t &offset) const{
+        if ((buffer.size() - offset) < getSize())
+            throw PQB::Exceptions::Proposal("Serialization: serialization buffer has not enough size to serialize the proposal");
+        proposal.serializeExceptTxSet(buffer, offset);
+        serializeField(buffer, offset, baseSeq);
+        serializeField(buffer, offset, baseTxSetId);
+        serializeField(buffer, offset, static_cast<uint32_t>(removed.size()));
+        for (const auto &txId : removed){
+            serializeField(buffer, offset, txId);
+        }
+        serializeField(buffer, offset, static_cast<uint32_t>(added.size()));
+        for (const auto &txId : added){
+            serializeField(buffer, offset, txId);
+        }
+    }
+
+    void TxSetDeltaProposal::deserialize(const byteBuffer &buffer, size_t &offset){
+        proposal.deserializeExceptTxSet(buffer, offset);
+        if ((buffer.size() - offset) < (sizeof(baseSeq) + sizeof(baseTxSetId) + sizeof(uint32_t)))
+            throw PQB::Exceptions::Proposal("Deserialization: buffer has not enough size to deserialize the proposal");
+        deserializeField(buffer, offset, baseSeq);
+        deserializeField(buffer, offset, baseTxSetId);
+        // numbers of IDs are checked before the allocation
+        uint32_t count;
+        deserializeField(buffer, offset, count);
+        if (((buffer.size() - offset) / sizeof(byteId_t)) < count)
+            throw PQB::Exceptions::Proposal("Deserialization: buffer has not enough size to deserialize the proposal");
+        removed.resize(count);
+        for (auto &txId : removed){
+            deserializeField(buffer, offset, txId);
+        }
+        if ((buffer.size() - offset) < sizeof(count))
+            throw PQB::Exceptions::Proposal("Deserialization: buffer has not enough size to deserialize the proposal");
+        deserializeField(buffer, offset, count);
+        if (((buffer.size() - offset) / sizeof(byteId_t)) < count)
+            throw PQB::Exceptions::Proposal("Deserialization: buffer has not enough size to deserialize the proposal");
+        added.resize(count);
+        for (auto &txId : added){
+            deserializeField(buffer, offset, txId);
+        }
+    }
+
 } // namespace PQB
 
 /* END OF FILE */
\ No newline at end of file
@@ -12,7 +12,10 @@
 #pragma once
 
 #include <set>
+#include <vector>
 #include <memory>
+#include <algorithm>
+#include <iterator>
 #include "PQBtypedefs.hpp"
 #include "Block.hpp"
 #include "Signer.hpp"
@@ -21,6 +24,7 @@
 #include "Blob.hpp"
 #include "PQBtypedefs.hpp"
 #include "Serialize.hpp"
+#include "SetSketch.hpp"
 
 
 namespace PQB{
@@ -36,8 +40,8 @@ class BlockProposal{
 public:
 
     ProposalType typeOfProposal{ProposalType::BLOCK};
-    byte64_t issuer;  ///< identification of the proposal creator
-    byte64_t blockId; ///< identification of this new proposed block
+    byteId_t issuer;  ///< identification of the proposal creator
+    byteId_t blockId; ///< identification of this new proposed block
 
     uint32_t signatureSize;
     std::vector<PQB::byte> signature; ///< signature of the issuer
@@ -62,11 +66,14 @@ public:
 
     /// @brief Get hash of this proposal
     /// @param outHash [out] output hash
-    void getHash(byte64_t &outHash) const;
+    void getHash(byteId_t &outHash) const;
 
     /// @brief sign the proposal
     void sign(byteBuffer &privateKey);
 
+    /// @brief sign the proposal with expanded private key (see SignAlgorithm::expandPrivateKey())
+    void sign(const ExpandedPrivateKey &privateKey);
+
     /// @brief verify the proposal signature
     bool verify(byteBuffer &publicKey);
 
@@ -94,9 +101,9 @@ public:
     ProposalType typeOfProposal{ProposalType::TxSet};
     uint32_t seq;     ///< sequence number of the proposal, unique for user, initialzed to 0 at the start of each round
     timestamp time;   ///< time of proposal creation
-    byte64_t issuer;  ///< identification of the proposal creator
-    byte64_t TxSetId; ///< identification of proposed transaction set (Merkle root hash of the transaction set)
-    byte64_t previousBlockId; ///< identification of previous Block on which this proposal is based on
+    byteId_t issuer;  ///< identification of the proposal creator
+    byteId_t TxSetId; ///< identification of proposed transaction set (Merkle root hash of the transaction set)
+    byteId_t previousBlockId; ///< identification of previous Block on which this proposal is based on
 
     uint32_t signatureSize;
     std::vector<PQB::byte> signature; ///< signature of the issuer
@@ -124,11 +131,14 @@ public:
 
     /// @brief Get hash of this proposal
     /// @param outHash [out] output hash
-    void getHash(byte64_t &outHash) const;
+    void getHash(byteId_t &outHash) const;
 
     /// @brief sign the proposal
     void sign(byteBuffer &privateKey);
 
+    /// @brief sign the proposal with expanded private key (see SignAlgorithm::expandPrivateKey())
+    void sign(const ExpandedPrivateKey &privateKey);
+
     /// @brief verify the proposal signature
     bool verify(byteBuffer &publicKey);
 
@@ -148,6 +158,19 @@ public:
     /// @exception if buffer has not enough size for the proposal deserialization
     void deserialize(const byteBuffer &buffer, size_t &offset);
 
+    /// @brief Copy the proposal except the transactions of its TxSet (number of transactions is set to the size of `prop` TxSet)
+    void setExceptTxSet(const TxSetProposal &prop);
+
+    /// @brief Get size of the proposal without transactions of the TxSet (just number of transactions is included)
+    /// @exception if proposal is not signed so size of signature is unknow
+    size_t getSizeExceptTxSet() const;
+
+    /// @brief Serialize TxSetProposal data except the TxSet (just number of transactions is serialized)
+    /// @param buffer buffer for serialization
+    /// @param offset offset to the buffer
+    /// @exception if buffer has not enough size for the proposal serialization
+    void serializeExceptTxSet(byteBuffer &buffer, size_t &offset) const;
+
     /// @brief Deserialize TxSetProposal data except the TxSet
     /// @param buffer buffer with serialized data
     /// @param offset offset to the buffer
@@ -157,8 +180,196 @@ public:
 };
 
 
+typedef uint64_t ShortTxId; ///< Short identifier of a transaction in a compact transaction set proposal
+
+
+/**
+ * @brief Transaction set proposal with short IDs of the transactions instead of the transactions. Receivers of the proposal
+ * have most of the proposed transactions in their transaction pools, so they find them by short IDs. Transactions which
+ * receivers probably do not have (for example the newest ones) are sent whole in `prefilled`.
+ * 
+ * Short ID is SipHash-2-4 of the transaction ID with a key derived from the issuer and a random salt of the proposal,
+ * so colliding transactions can not be prepared in advance.
+ */
+class CompactTxSetProposal{
+public:
+
+    TxSetProposal proposal;          ///< signed proposal, its txSet has just transactionCount (transactions are given by shortIds)
+    uint64_t salt;                   ///< salt of short IDs chosen by the issuer
+    std::vector<ShortTxId> shortIds; ///< short IDs of all proposed transactions in order of the transaction set
+    BlockBody prefilled;             ///< proposed transactions sent whole (with signatures)
+
+    CompactTxSetProposal(){
+        setNull();
+    }
+
+    /**
+     * @brief Create compact form of a signed proposal. Short IDs of all transactions of the proposal are computed,
+     * prefilled transactions are not chosen.
+     * 
+     * @param prop signed proposal with the transaction set
+     * @param shortIdSalt salt of short IDs
+     */
+    CompactTxSetProposal(const TxSetProposal &prop, uint64_t shortIdSalt);
+
+    void setNull(){
+        proposal.setNull();
+        salt = 0;
+        shortIds.clear();
+        prefilled.setNull();
+    }
+
+    /// @brief Get key of short IDs of this proposal (first HashMan::SIPHASH_KEY_SIZE bytes of SHA-512 of the issuer and the salt)
+    /// @param key [out] buffer of HashMan::SIPHASH_KEY_SIZE bytes
+    void getShortIdKey(PQB::byte *key) const{
+        getShortIdKey(proposal.issuer, salt, key);
+    }
+
+    /// @brief Get key of short IDs of a proposal of `issuer` with `salt`
+    /// @param key [out] buffer of HashMan::SIPHASH_KEY_SIZE bytes
+    static void getShortIdKey(const byteId_t &issuer, uint64_t salt, PQB::byte *key);
+
+    /// @brief Get short ID of a transaction
+    /// @param key key of short IDs (see getShortIdKey())
+    /// @param txId ID of the transaction
+    static ShortTxId getShortId(const PQB::byte *key, const byteId_t &txId){
+        return HashMan::SipHash24(key, txId.data(), txId.size());
+    }
+
+    /// @brief Get size of the compact proposal in bytes
+    /// @exception if proposal is not signed so size of signature is unknow
+    size_t getSize() const;
+
+    /// @brief Serialize CompactTxSetProposal
+    /// @param buffer buffer for serialization
+    /// @param offset offset to the buffer
+    /// @exception if buffer has not enough size for the proposal serialization
+    void serialize(byteBuffer &buffer, size_t &offset) const;
+
+    /// @brief Deserialize CompactTxSetProposal
+    /// @param buffer buffer with serialized data
+    /// @param offset offset to the buffer
+    /// @exception if buffer has not enough size for the proposal deserialization
+    void deserialize(const byteBuffer &buffer, size_t &offset);
+};
+
+
+/**
+ * @brief Transaction set proposal given as a difference from the previous proposal of the same issuer. In establish phase
+ * the proposal changes just by a few disputed transactions, so only IDs of added and removed transactions are sent.
+ * 
+ * The signed proposal has ID of the resulting transaction set, so receivers apply the difference to the base set
+ * and check the result by its Merkle root hash.
+ */
+class TxSetDeltaProposal{
+public:
+
+    TxSetProposal proposal;         ///< signed proposal of the resulting set, its txSet has just transactionCount
+    uint32_t baseSeq;               ///< sequence number of the base proposal of the same issuer
+    byteId_t baseTxSetId;           ///< ID of the transaction set of the base proposal
+    std::vector<byteId_t> removed;  ///< IDs of transactions removed from the base set
+    std::vector<byteId_t> added;    ///< IDs of transactions added to the base set
+
+    TxSetDeltaProposal(){
+        setNull();
+    }
+
+    /**
+     * @brief Create difference between transaction sets of two proposals, the proposal itself is not set (see TxSetProposal::setExceptTxSet())
+     * 
+     * @param baseProposalSeq sequence number of the base proposal
+     * @param baseSetId ID of the base transaction set
+     * @param baseSet base transaction set
+     * @param newSet transaction set of the new proposal
+     */
+    TxSetDeltaProposal(uint32_t baseProposalSeq, const byteId_t &baseSetId, const TransactionSet &baseSet, const TransactionSet &newSet);
+
+    void setNull(){
+        proposal.setNull();
+        baseSeq = 0;
+        baseTxSetId.SetNull();
+        removed.clear();
+        added.clear();
+    }
+
+    /// @brief Get size of the delta proposal in bytes
+    /// @exception if proposal is not signed so size of signature is unknow
+    size_t getSize() const;
+
+    /// @brief Serialize TxSetDeltaProposal
+    /// @param buffer buffer for serialization
+    /// @param offset offset to the buffer
+    /// @exception if buffer has not enough size for the proposal serialization
+    void serialize(byteBuffer &buffer, size_t &offset) const;
+
+    /// @brief Deserialize TxSetDeltaProposal
+    /// @param buffer buffer with serialized data
+    /// @param offset offset to the buffer
+    /// @exception if buffer has not enough size for the proposal deserialization
+    void deserialize(const byteBuffer &buffer, size_t &offset);
+};
+
+
+/**
+ * @brief Transaction set proposal with a sketch of short IDs of the transactions (see SetSketch). Receiver subtracts
+ * sketch of its own transaction set and decodes the difference, so the size of the proposal depends on the expected
+ * number of different transactions and not on the size of the set. Short IDs are the same as in CompactTxSetProposal.
+ */
+class TxSetSketchProposal{
+public:
+
+    TxSetProposal proposal; ///< signed proposal, its txSet has just transactionCount
+    uint64_t salt;          ///< salt of short IDs chosen by the issuer
+    SetSketch sketch;       ///< sketch of short IDs of all proposed transactions
+    BlockBody prefilled;    ///< proposed transactions sent whole (with signatures)
+
+    TxSetSketchProposal(){
+        setNull();
+    }
+
+    /**
+     * @brief Create sketch of a signed proposal, prefilled transactions are not chosen
+     * 
+     * @param prop signed proposal with the transaction set
+     * @param shortIdSalt salt of short IDs
+     * @param capacity expected number of different transactions which the sketch should decode
+     */
+    TxSetSketchProposal(const TxSetProposal &prop, uint64_t shortIdSalt, size_t capacity);
+
+    void setNull(){
+        proposal.setNull();
+        salt = 0;
+        sketch.setNull();
+        prefilled.setNull();
+    }
+
+    /// @brief Get key of short IDs of this proposal (see CompactTxSetProposal::getShortIdKey())
+    void getShortIdKey(PQB::byte *key) const{
+        CompactTxSetProposal::getShortIdKey(proposal.issuer, salt, key);
+    }
+
+    /// @brief Get size of the sketch proposal in bytes
+    /// @exception if proposal is not signed so size of signature is unknow
+    size_t getSize() const;
+
+    /// @brief Serialize TxSetSketchProposal
+    /// @param buffer buffer for serialization
+    /// @param offset offset to the buffer
+    /// @exception if buffer has not enough size for the proposal serialization
+    void serialize(byteBuffer &buffer, size_t &offset) const;
+
+    /// @brief Deserialize TxSetSketchProposal
+    /// @param buffer buffer with serialized data
+    /// @param offset offset to the buffer
+    /// @exception if buffer has not enough size for the proposal deserialization
+    void deserialize(const byteBuffer &buffer, size_t &offset);
+};
+
+
 typedef std::shared_ptr<BlockProposal> BlockProposalPtr;
 typedef std::shared_ptr<TxSetProposal> TxSetProposalPtr;
+typedef std::shared_ptr<CompactTxSetProposal> CompactTxSetProposalPtr;
+typedef std::shared_ptr<TxSetDeltaProposal> TxSetDeltaProposalPtr;
 
 } // namespace PQB
 
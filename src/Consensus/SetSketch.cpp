@@ -0,0 +1,122 @@
+/**
+ * @file SetSketch.cpp
+ * @author Michal Ľaš
+ * @brief Invertible Bloom lookup table for reconciliation of transaction sets
+ * @date 2024-05-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+#include "SetSketch.hpp"
+
+
+namespace PQB{
+
+    SetSketch::SetSketch(size_t cellCount){
+        cells.assign(std::max(PARTS, cellCount - cellCount % PARTS), {.count=0, .keySum=0, .hashSum=0});
+    }
+
+    uint64_t SetSketch::mix(uint64_t key, uint64_t seed){
+        uint64_t z = key + (seed + 1) * 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    void SetSketch::update(std::vector<Cell> &table, const SetSketch &sketch, uint64_t key, int32_t count){
+        uint64_t keyHash = getKeyHash(key);
+        for (size_t part = 0; part < PARTS; part++){
+            Cell &cell = table[sketch.getCellIndex(key, part)];
+            cell.count += count;
+            cell.keySum ^= key;
+            cell.hashSum ^= keyHash;
+        }
+    }
+
+    void SetSketch::insert(uint64_t key){
+        if (!cells.empty()){
+            update(cells, *this, key, 1);
+        }
+    }
+
+    bool SetSketch::subtract(const SetSketch &other){
+        if (other.cells.size() != cells.size()){
+            return false;
+        }
+        for (size_t i = 0; i < cells.size(); i++){
+            cells[i].count -= other.cells[i].count;
+            cells[i].keySum ^= other.cells[i].keySum;
+            cells[i].hashSum ^= other.cells[i].hashSum;
+        }
+        return true;
+    }
+
+    bool SetSketch::decode(std::vector<uint64_t> &onlyThis, std::vector<uint64_t> &onlyOther) const{
+        std::vector<Cell> table = cells;
+        // cells with one key are peeled, which can make other cells pure
+        std::vector<size_t> candidates(table.size());
+        for (size_t i = 0; i < table.size(); i++){
+            candidates[i] = i;
+        }
+        // crafted sketch can make a key pure again with opposite count after it was peeled, so peeling would never end
+        std::unordered_set<uint64_t> peeled;
+        while (!candidates.empty()){
+            const Cell &cell = table[candidates.back()];
+            candidates.pop_back();
+            if ((cell.count != 1 && cell.count != -1) || cell.hashSum != getKeyHash(cell.keySum)){
+                continue;
+            }
+            uint64_t key = cell.keySum;
+            int32_t count = cell.count;
+            // each key of a valid difference is peeled once and there can not be more keys than cells
+            if (!peeled.insert(key).second || peeled.size() > table.size()){
+                return false;
+            }
+            (count == 1 ? onlyThis : onlyOther).push_back(key);
+            update(table, *this, key, -count);
+            for (size_t part = 0; part < PARTS; part++){
+                candidates.push_back(getCellIndex(key, part));
+            }
+        }
+        for (const auto &cell : table){
+            if (cell.count != 0 || cell.keySum != 0 || cell.hashSum != 0){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void SetSketch::serialize(byteBuffer &buffer, size_t &offset) const{
+        if ((buffer.size() - offset) < getSize())
+            throw PQB::Exceptions::Proposal("Serialization: serialization buffer has not enough size to serialize the set sketch");
+        serializeField(buffer, offset, static_cast<uint32_t>(cells.size()));
+        for (const auto &cell : cells){
+            serializeField(buffer, offset, cell.count);
+            serializeField(buffer, offset, cell.keySum);
+            serializeField(buffer, offset, cell.hashSum);
+        }
+    }
+
+    void SetSketch::deserialize(const byteBuffer &buffer, size_t &offset){
+        uint32_t cellCount;
+        if ((buffer.size() - offset) < sizeof(cellCount))
+            throw PQB::Exceptions::Proposal("Deserialization: buffer has not enough size to deserialize the set sketch");
+        deserializeField(buffer, offset, cellCount);
+        const size_t cellSize = sizeof(Cell::count) + sizeof(Cell::keySum) + sizeof(Cell::hashSum);
+        if (cellCount == 0 || (cellCount % PARTS) != 0)
+            throw PQB::Exceptions::Proposal("Deserialization: invalid number of cells of the set sketch");
+        if (((buffer.size() - offset) / cellSize) < cellCount)
+            throw PQB::Exceptions::Proposal("Deserialization: buffer has not enough size to deserialize the set sketch");
+        cells.resize(cellCount);
+        for (auto &cell : cells){
+            deserializeField(buffer, offset, cell.count);
+            deserializeField(buffer, offset, cell.keySum);
+            deserializeField(buffer, offset, cell.hashSum);
+        }
+    }
+
+} // namespace PQB
+
+/* END OF FILE */
@@ -0,0 +1,131 @@
+/**
+ * @file SetSketch.hpp
+ * @author Michal Ľaš
+ * @brief Invertible Bloom lookup table for reconciliation of transaction sets
+ * @date 2024-05-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+#include <algorithm>
+#include "PQBtypedefs.hpp"
+#include "PQBExceptions.hpp"
+#include "Serialize.hpp"
+
+
+namespace PQB{
+
+
+/**
+ * @brief Sketch of a set of 64-bit keys (invertible Bloom lookup table). Sketch of one set is subtracted from sketch
+ * of another set, then the symmetric difference of the sets can be decoded if it is not much larger than the capacity of
+ * the sketch, no matter how large the sets are.
+ *
+ * Each key is added to one cell in each of three parts of the table. Keys are expected to be random (short IDs of transactions),
+ * so they are just mixed to get indexes of the cells.
+ */
+class SetSketch{
+public:
+
+    /// @brief Cell of the table
+    struct Cell{
+        int32_t count;      ///< number of added keys (negative after subtraction)
+        uint64_t keySum;    ///< XOR of added keys
+        uint64_t hashSum;   ///< XOR of hashes of added keys, used to recognize cells with one key
+    };
+
+    /// @brief Number of parts of the table (each key is in one cell of each part)
+    static constexpr size_t PARTS = 3;
+
+    SetSketch(){
+        setNull();
+    }
+
+    /// @brief Create empty sketch with given number of cells (see getCellCount())
+    explicit SetSketch(size_t cellCount);
+
+    void setNull(){
+        cells.clear();
+    }
+
+    /// @brief Get number of cells of a sketch which decodes differences of about `capacity` keys
+    static size_t getCellCount(size_t capacity){
+        // small tables need relatively more cells to decode the difference
+        return PARTS * ((5 * capacity / 2 + 15 + PARTS - 1) / PARTS);
+    }
+
+    /// @brief Get number of cells of this sketch
+    size_t getCellCount() const{
+        return cells.size();
+    }
+
+    /// @brief Add a key to the sketch
+    void insert(uint64_t key);
+
+    /**
+     * @brief Subtract other sketch from this sketch, then this sketch represents keys which are just in one of the sets
+     *
+     * @param other sketch with the same number of cells
+     * @return false if the number of cells is different
+     */
+    bool subtract(const SetSketch &other);
+
+    /**
+     * @brief Decode keys from subtracted sketch
+     *
+     * @param onlyThis [out] keys which are in the set of this sketch and not in the subtracted one
+     * @param onlyOther [out] keys which are in the subtracted set and not in the set of this sketch
+     * @return false if the difference can not be decoded (it is too large or the sketch is malformed)
+     */
+    bool decode(std::vector<uint64_t> &onlyThis, std::vector<uint64_t> &onlyOther) const;
+
+    /// @brief Get size of the sketch in bytes
+    size_t getSize() const{
+        return sizeof(uint32_t) + cells.size() * (sizeof(Cell::count) + sizeof(Cell::keySum) + sizeof(Cell::hashSum));
+    }
+
+    /// @brief Serialize SetSketch
+    /// @param buffer buffer for serialization
+    /// @param offset offset to the buffer
+    /// @exception if buffer has not enough size for the sketch serialization
+    void serialize(byteBuffer &buffer, size_t &offset) const;
+
+    /// @brief Deserialize SetSketch
+    /// @param buffer buffer with serialized data
+    /// @param offset offset to the buffer
+    /// @exception if buffer has not enough size for the sketch deserialization or if the number of cells is invalid
+    void deserialize(const byteBuffer &buffer, size_t &offset);
+
+private:
+
+    /// @brief Mix the key with a seed (splitmix64 finalizer)
+    static uint64_t mix(uint64_t key, uint64_t seed);
+
+    /// @brief Get index of the cell of the key in given part of the table
+    size_t getCellIndex(uint64_t key, size_t part) const{
+        size_t partSize = cells.size() / PARTS;
+        return part * partSize + static_cast<size_t>(mix(key, part) % partSize);
+    }
+
+    /// @brief Hash of the key stored in hashSum of cells
+    static uint64_t getKeyHash(uint64_t key){
+        return mix(key, PARTS);
+    }
+
+    /// @brief Add key to its cells `count` times (-1 removes it)
+    static void update(std::vector<Cell> &table, const SetSketch &sketch, uint64_t key, int32_t count);
+
+    std::vector<Cell> cells;
+};
+
+
+} // namespace PQB
+
+/* END OF FILE */
@@ -0,0 +1,125 @@
+/**
+ * @file CRC32C.cpp
+ * @author Michal Ľaš
+ * @brief CRC32C (Castagnoli) check sum with SSE4.2 hardware support and software fallback
+ * @date 2024-05-02
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <array>
+#include <cstring>
+#include "HashManager.hpp"
+
+#if defined(__x86_64__)
+    #include <nmmintrin.h>
+    #define PQB_CRC32C_X86 1
+#endif
+
+
+namespace PQB{
+
+namespace{
+
+    /// @brief Reversed Castagnoli polynomial
+    constexpr uint32_t CRC32C_POLY = 0x82F63B78;
+
+    /// @brief Tables for slicing-by-8 software implementation
+    constexpr std::array<std::array<uint32_t, 256>, 8> makeCRC32CTables(){
+        std::array<std::array<uint32_t, 256>, 8> tables{};
+        for (uint32_t i = 0; i < 256; i++){
+            uint32_t crc = i;
+            for (int j = 0; j < 8; j++){
+                crc = (crc & 1) ? ((crc >> 1) ^ CRC32C_POLY) : (crc >> 1);
+            }
+            tables[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; i++){
+            for (size_t t = 1; t < 8; t++){
+                tables[t][i] = (tables[t - 1][i] >> 8) ^ tables[0][tables[t - 1][i] & 0xFF];
+            }
+        }
+        return tables;
+    }
+
+    constexpr auto CRC32C_TABLES = makeCRC32CTables();
+
+    uint32_t crc32cSoftware(uint32_t crc, const PQB::byte *data, size_t size){
+        while (size > 0 && (reinterpret_cast<uintptr_t>(data) & 7) != 0){
+            crc = (crc >> 8) ^ CRC32C_TABLES[0][(crc ^ *data++) & 0xFF];
+            size--;
+        }
+        while (size >= 8){
+            uint32_t low;
+            uint32_t high;
+            std::memcpy(&low, data, sizeof(low));
+            std::memcpy(&high, data + 4, sizeof(high));
+            low ^= crc;
+            crc = CRC32C_TABLES[7][low & 0xFF] ^ CRC32C_TABLES[6][(low >> 8) & 0xFF] ^
+                  CRC32C_TABLES[5][(low >> 16) & 0xFF] ^ CRC32C_TABLES[4][low >> 24] ^
+                  CRC32C_TABLES[3][high & 0xFF] ^ CRC32C_TABLES[2][(high >> 8) & 0xFF] ^
+                  CRC32C_TABLES[1][(high >> 16) & 0xFF] ^ CRC32C_TABLES[0][high >> 24];
+            data += 8;
+            size -= 8;
+        }
+        while (size > 0){
+            crc = (crc >> 8) ^ CRC32C_TABLES[0][(crc ^ *data++) & 0xFF];
+            size--;
+        }
+        return crc;
+    }
+
+#ifdef PQB_CRC32C_X86
+    __attribute__((target("sse4.2")))
+    uint32_t crc32cHardware(uint32_t crc, const PQB::byte *data, size_t size){
+        while (size > 0 && (reinterpret_cast<uintptr_t>(data) & 7) != 0){
+            crc = _mm_crc32_u8(crc, *data++);
+            size--;
+        }
+        uint64_t crc64 = crc;
+        while (size >= 8){
+            uint64_t chunk;
+            std::memcpy(&chunk, data, sizeof(chunk));
+            crc64 = _mm_crc32_u64(crc64, chunk);
+            data += 8;
+            size -= 8;
+        }
+        crc = static_cast<uint32_t>(crc64);
+        while (size > 0){
+            crc = _mm_crc32_u8(crc, *data++);
+            size--;
+        }
+        return crc;
+    }
+#endif
+
+} // anonymous namespace
+
+
+bool HashMan::CRC32C_hardwareSupport(){
+#ifdef PQB_CRC32C_X86
+    static const bool support = __builtin_cpu_supports("sse4.2");
+    return support;
+#else
+    return false;
+#endif
+}
+
+uint32_t HashMan::CRC32C(const PQB::byte *inputData, size_t dataSize, uint32_t crc){
+#ifdef PQB_CRC32C_X86
+    if (CRC32C_hardwareSupport()){
+        return ~crc32cHardware(~crc, inputData, dataSize);
+    }
+#endif
+    return ~crc32cSoftware(~crc, inputData, dataSize);
+}
+
+uint32_t HashMan::CRC32C_software(const PQB::byte *inputData, size_t dataSize, uint32_t crc){
+    return ~crc32cSoftware(~crc, inputData, dataSize);
+}
+
+} // PQB namespace
+
+
+/* END OF FILE */
@@ -0,0 +1,61 @@
+/**
+ * @file CpuFeatures.cpp
+ * @author Michal Ľaš
+ * @brief Detection of instruction set extensions of the CPU
+ * @date 2024-05-11
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+#include "CpuFeatures.hpp"
+
+
+namespace PQB{
+
+namespace{
+
+    CpuFeatures detect(){
+        CpuFeatures features;
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init();
+        features.popcnt = __builtin_cpu_supports("popcnt");
+        features.sse42 = __builtin_cpu_supports("sse4.2");
+        features.avx2 = __builtin_cpu_supports("avx2");
+        features.bmi2 = __builtin_cpu_supports("bmi2");
+        features.fma = __builtin_cpu_supports("fma");
+        features.avx512f = __builtin_cpu_supports("avx512f");
+        features.avx512bw = __builtin_cpu_supports("avx512bw");
+#endif
+        return features;
+    }
+
+} // anonymous namespace
+
+
+const CpuFeatures &CpuFeatures::get(){
+    static const CpuFeatures features = detect();
+    return features;
+}
+
+std::string CpuFeatures::toString() const {
+    std::string str;
+    auto append = [&str](bool supported, const char *name){
+        if (supported){
+            str += str.empty() ? name : std::string(" ") + name;
+        }
+    };
+    append(popcnt, "popcnt");
+    append(sse42, "sse4.2");
+    append(avx2, "avx2");
+    append(bmi2, "bmi2");
+    append(fma, "fma");
+    append(avx512f, "avx512f");
+    append(avx512bw, "avx512bw");
+    return str.empty() ? "none" : str;
+}
+
+} // namespace PQB
+
+/* END OF FILE */
@@ -0,0 +1,43 @@
+/**
+ * @file CpuFeatures.hpp
+ * @author Michal Ľaš
+ * @brief Detection of instruction set extensions of the CPU
+ * @date 2024-05-11
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+#pragma once
+
+#include <string>
+
+
+namespace PQB{
+
+
+/**
+ * @brief Instruction set extensions supported by the CPU the program runs on (detected by CPUID once at the first use).
+ * Used for choosing implementations of signature algorithms at startup.
+ */
+struct CpuFeatures{
+    bool popcnt = false;
+    bool sse42 = false;
+    bool avx2 = false;
+    bool bmi2 = false;
+    bool fma = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+
+    /// @brief Get features of the CPU
+    static const CpuFeatures &get();
+
+    /// @brief Get supported features as a string for logging (e.g. "popcnt sse4.2 avx2")
+    std::string toString() const;
+};
+
+
+} // namespace PQB
+
+/* END OF FILE */
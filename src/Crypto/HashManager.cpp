@@ -1,7 +1,7 @@
 /**
  * @file HashManager.cpp
  * @author Michal Ľaš
- * @brief Interface for SHA-512 hash function
+ * @brief Interface for SHA-512 and SipHash-2-4 hash functions
  * @date 2024-02-11
  * 
  * @copyright Copyright (c) 2024
@@ -14,18 +14,32 @@
 namespace PQB{
 
 
-void HashMan::SHA512_hash(byte64_t *result, const PQB::byte *inputData, unsigned int dataSize){
+void HashMan::SHA512_hash(byteId_t *result, const PQB::byte *inputData, unsigned int dataSize){
     CryptoPP::SHA512 sha512Hash;
     sha512Hash.Update(inputData, dataSize);
-    sha512Hash.Final(result->begin());
+    sha512Hash.TruncatedFinal(result->begin(), result->size());
 }
 
 
-void HashMan::SHA512_hash(byte64_t *result, const byte64_t &first, const byte64_t &second){
+void HashMan::SHA512_hash(byteId_t *result, const byteId_t &first, const byteId_t &second){
     CryptoPP::SHA512 sha512Hash;
     sha512Hash.Update(first.data(), first.size());
     sha512Hash.Update(second.data(), second.size());
-    sha512Hash.Final(result->begin());
+    sha512Hash.TruncatedFinal(result->begin(), result->size());
+}
+
+
+uint64_t HashMan::SipHash24(const PQB::byte *key, const PQB::byte *inputData, size_t dataSize){
+    CryptoPP::SipHash<2, 4> sipHash(key, SIPHASH_KEY_SIZE);
+    sipHash.Update(inputData, dataSize);
+    PQB::byte digest[CryptoPP::SipHash<2, 4>::DIGESTSIZE];
+    sipHash.Final(digest);
+    // digest is the 64-bit value in little-endian order
+    uint64_t result = 0;
+    for (int i = sizeof(digest) - 1; i >= 0; i--){
+        result = (result << 8) | digest[i];
+    }
+    return result;
 }
 
 } // PQB namespace
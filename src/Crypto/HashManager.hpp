@@ -1,7 +1,7 @@
 /**
  * @file HashManager.hpp
  * @author Michal Ľaš
- * @brief Interface for SHA-512 hash function
+ * @brief Interface for SHA-512 hash function, SipHash-2-4 and CRC32C check sum
  * @date 2024-02-11
  * 
  * @copyright Copyright (c) 2024
@@ -14,6 +14,7 @@
 #include <vector>
 
 #include <cryptopp/sha.h>
+#include <cryptopp/siphash.h>
 
 #include "Blob.hpp"
 #include "PQBtypedefs.hpp"
@@ -28,23 +29,53 @@ public:
     static constexpr size_t SHA512_SIZE = 64; ///< size of SHA-512 in bytes
 
     /**
-     * @brief Calculates hash of given data
+     * @brief Calculates hash of given data. Result is SHA-512 truncated to the size of byteId_t (32 bytes with SHORT_IDS option).
      * 
      * @param result Pointer to result
      * @param inputData Pointer to begining of data
      * @param dataSize Size of the data
      */
-    static void SHA512_hash(byte64_t *result, const PQB::byte *inputData, unsigned int dataSize);
+    static void SHA512_hash(byteId_t *result, const PQB::byte *inputData, unsigned int dataSize);
 
 
     /**
-     * @brief Calculates hash of 2 byte64_t together
+     * @brief Calculates hash of 2 byteId_t together (truncated to the size of byteId_t)
      * 
      * @param result Pointer to result
      * @param first 
      * @param second 
      */
-    static void SHA512_hash(byte64_t *result, const byte64_t &first, const byte64_t &second);
+    static void SHA512_hash(byteId_t *result, const byteId_t &first, const byteId_t &second);
+
+    static constexpr size_t SIPHASH_KEY_SIZE = 16; ///< size of SipHash key in bytes
+
+    /**
+     * @brief Calculates SipHash-2-4 of given data. It is a fast keyed hash, so it is used for short
+     * identifiers which can not be easily collided by someone who does not know the key.
+     * 
+     * @param key Pointer to key of SIPHASH_KEY_SIZE bytes
+     * @param inputData Pointer to begining of data
+     * @param dataSize Size of the data
+     * @return 64-bit SipHash-2-4 of the data
+     */
+    static uint64_t SipHash24(const PQB::byte *key, const PQB::byte *inputData, size_t dataSize);
+
+    /**
+     * @brief Calculates CRC32C (Castagnoli) check sum of given data. If CPU supports SSE4.2 then hardware
+     * crc32 instruction is used, else the software (slicing-by-8) implementation is used.
+     * 
+     * @param inputData Pointer to begining of data
+     * @param dataSize Size of the data
+     * @param crc Previous CRC32C value, this allows to calculate check sum of data in more parts (0 for new check sum)
+     * @return CRC32C of the data
+     */
+    static uint32_t CRC32C(const PQB::byte *inputData, size_t dataSize, uint32_t crc = 0);
+
+    /// @brief Software implementation of CRC32C. Same as CRC32C() but it never uses hardware instruction.
+    static uint32_t CRC32C_software(const PQB::byte *inputData, size_t dataSize, uint32_t crc = 0);
+
+    /// @brief Check if CPU supports hardware CRC32C instruction (SSE4.2)
+    static bool CRC32C_hardwareSupport();
 };
 
 
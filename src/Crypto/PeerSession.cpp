@@ -0,0 +1,114 @@
+/**
+ * @file PeerSession.cpp
+ * @author Michal Ľaš
+ * @brief Kyber1024 key encapsulation and authentication of messages of a peer session
+ * @date 2024-05-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+#include "PeerSession.hpp"
+#include <cstring>
+#include <cryptopp/sha.h>
+#include <cryptopp/poly1305.h>
+#include <cryptopp/misc.h>      // SecureWipeBuffer, VerifyBufsEqual
+#include "RandomGenerator.hpp"
+#include "PQBExceptions.hpp"
+extern "C"{
+    #include <kyber1024.h>
+}
+
+
+namespace PQB{
+
+namespace{
+
+    constexpr size_t NONCE_SIZE = 12;
+    /// @brief Domain separation of derived keys
+    constexpr char KEY_LABEL[] = "PQB peer session";
+
+} // namespace
+
+
+void PeerSession::genKemKeys(byteBuffer &secretKey, byteBuffer &publicKey){
+    secretKey.resize(PQCLEAN_KYBER1024_CLEAN_CRYPTO_SECRETKEYBYTES);
+    publicKey.resize(PQCLEAN_KYBER1024_CLEAN_CRYPTO_PUBLICKEYBYTES);
+    if (PQCLEAN_KYBER1024_CLEAN_crypto_kem_keypair(publicKey.data(), secretKey.data()) != 0){
+        throw PQB::Exceptions::Signer("Kyber1024 key generation failed");
+    }
+}
+
+bool PeerSession::encapsulate(byteBuffer &ciphertext, byteBuffer &sharedSecret, const byteBuffer &publicKey){
+    if (publicKey.size() != PQCLEAN_KYBER1024_CLEAN_CRYPTO_PUBLICKEYBYTES){
+        return false;
+    }
+    ciphertext.resize(PQCLEAN_KYBER1024_CLEAN_CRYPTO_CIPHERTEXTBYTES);
+    sharedSecret.resize(PQCLEAN_KYBER1024_CLEAN_CRYPTO_BYTES);
+    return PQCLEAN_KYBER1024_CLEAN_crypto_kem_enc(ciphertext.data(), sharedSecret.data(), publicKey.data()) == 0;
+}
+
+bool PeerSession::decapsulate(byteBuffer &sharedSecret, const byteBuffer &ciphertext, const byteBuffer &secretKey){
+    if (ciphertext.size() != PQCLEAN_KYBER1024_CLEAN_CRYPTO_CIPHERTEXTBYTES || secretKey.size() != PQCLEAN_KYBER1024_CLEAN_CRYPTO_SECRETKEYBYTES){
+        return false;
+    }
+    sharedSecret.resize(PQCLEAN_KYBER1024_CLEAN_CRYPTO_BYTES);
+    return PQCLEAN_KYBER1024_CLEAN_crypto_kem_dec(sharedSecret.data(), ciphertext.data(), secretKey.data()) == 0;
+}
+
+PeerSession::PeerSession(const byteBuffer &sharedSecret, const byteId_t &transcriptHash, bool isInitiator)
+: sendCounter(0), recvCounter(0){
+    // SHA-512(label || shared secret || transcript) = key of initiator || key of responder
+    byte keys[CryptoPP::SHA512::DIGESTSIZE];
+    CryptoPP::SHA512 hash;
+    hash.Update(reinterpret_cast<const byte*>(KEY_LABEL), sizeof(KEY_LABEL) - 1);
+    hash.Update(sharedSecret.data(), sharedSecret.size());
+    hash.Update(transcriptHash.data(), transcriptHash.size());
+    hash.Final(keys);
+    std::memcpy(sendKey, keys + (isInitiator ? 0 : KEY_SIZE), KEY_SIZE);
+    std::memcpy(recvKey, keys + (isInitiator ? KEY_SIZE : 0), KEY_SIZE);
+    CryptoPP::SecureWipeBuffer(keys, sizeof(keys));
+}
+
+PeerSession::~PeerSession(){
+    CryptoPP::SecureWipeBuffer(sendKey, KEY_SIZE);
+    CryptoPP::SecureWipeBuffer(recvKey, KEY_SIZE);
+}
+
+void PeerSession::computeTag(const byte *data, size_t size, byte *tag){
+    poly1305Tag(tag, sendKey, sendCounter++, data, size, nullptr, 0);
+}
+
+void PeerSession::computeTag(const byte *header, size_t headerSize, const byte *payload, size_t payloadSize, byte *tag){
+    poly1305Tag(tag, sendKey, sendCounter++, header, headerSize, payload, payloadSize);
+}
+
+bool PeerSession::verifyTag(const byte *data, size_t size, const byte *tag){
+    byte expected[TAG_SIZE];
+    poly1305Tag(expected, recvKey, recvCounter, data, size, nullptr, 0);
+    if (!CryptoPP::VerifyBufsEqual(expected, tag, TAG_SIZE)){
+        return false;
+    }
+    recvCounter++;
+    return true;
+}
+
+void PeerSession::poly1305Tag(byte *tag, const byte *key, uint64_t counter, const byte *header, size_t headerSize,
+                              const byte *payload, size_t payloadSize){
+    byte nonce[NONCE_SIZE] = {};
+    for (int i = 0; i < 8; i++){
+        nonce[4 + i] = (byte)(counter >> (8 * i));
+    }
+    byte macKey[KEY_SIZE];
+    RandomGenerator::chacha20(macKey, KEY_SIZE, key, nonce);
+    CryptoPP::Poly1305TLS mac(macKey, KEY_SIZE);
+    mac.Update(header, headerSize);
+    mac.Update(payload, payloadSize);
+    mac.TruncatedFinal(tag, TAG_SIZE);
+    CryptoPP::SecureWipeBuffer(macKey, KEY_SIZE);
+}
+
+} // namespace PQB
+
+/* END OF FILE */
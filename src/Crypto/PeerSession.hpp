@@ -0,0 +1,113 @@
+/**
+ * @file PeerSession.hpp
+ * @author Michal Ľaš
+ * @brief Kyber1024 key encapsulation and authentication of messages of a peer session
+ * @date 2024-05-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <cstdint>
+#include "PQBtypedefs.hpp"
+#include "Blob.hpp"
+
+
+namespace PQB{
+
+
+/**
+ * @brief Symmetric keys of a connection with a peer, established by Kyber1024 key encapsulation.
+ *
+ * The peer which opens the connection (initiator) sends an ephemeral Kyber1024 public key and the other peer (responder)
+ * answers with a ciphertext encapsulating a shared secret. The key exchange itself is authenticated by signatures of the peers,
+ * which is done by the caller. From the shared secret and hash of the handshake (transcript) one key for each direction is derived.
+ *
+ * Each message is authenticated with 16 bytes long Poly1305 tag. The one-time Poly1305 key is the first block of ChaCha20
+ * keystream with the key of the direction and the number of the message as a nonce (as in RFC 8439), so a tag of a replayed
+ * or reordered message is not valid. Messages are not encrypted.
+ */
+class PeerSession{
+public:
+
+    /// @brief Size of the key of one direction
+    static constexpr size_t KEY_SIZE = 32;
+    /// @brief Size of the authentication tag of a message
+    static constexpr size_t TAG_SIZE = 16;
+
+    /**
+     * @brief Generate ephemeral Kyber1024 key pair (initiator)
+     *
+     * @param secretKey [out] generated secret key
+     * @param publicKey [out] generated public key
+     * @exception PQB::Exceptions::Signer if key generation fails
+     */
+    static void genKemKeys(byteBuffer &secretKey, byteBuffer &publicKey);
+
+    /**
+     * @brief Encapsulate a new shared secret to the public key of the initiator (responder)
+     *
+     * @param ciphertext [out] ciphertext for the initiator
+     * @param sharedSecret [out] shared secret
+     * @param publicKey Kyber1024 public key of the initiator
+     * @return false if the public key has invalid size or encapsulation fails
+     */
+    static bool encapsulate(byteBuffer &ciphertext, byteBuffer &sharedSecret, const byteBuffer &publicKey);
+
+    /**
+     * @brief Decapsulate the shared secret from the ciphertext of the responder (initiator)
+     *
+     * @param sharedSecret [out] shared secret
+     * @param ciphertext ciphertext of the responder
+     * @param secretKey Kyber1024 secret key of the initiator
+     * @return false if the ciphertext has invalid size or decapsulation fails
+     */
+    static bool decapsulate(byteBuffer &sharedSecret, const byteBuffer &ciphertext, const byteBuffer &secretKey);
+
+    /**
+     * @brief Derive keys of the session
+     *
+     * @param sharedSecret shared secret of the key encapsulation
+     * @param transcriptHash hash of the handshake (both sides have to use the same hash)
+     * @param isInitiator true if local peer opened the connection
+     */
+    PeerSession(const byteBuffer &sharedSecret, const byteId_t &transcriptHash, bool isInitiator);
+    ~PeerSession();
+
+    PeerSession(const PeerSession&) = delete;
+    PeerSession& operator=(const PeerSession&) = delete;
+
+    /// @brief Compute tag of the next sent message
+    /// @param tag [out] buffer of TAG_SIZE bytes
+    void computeTag(const byte *data, size_t size, byte *tag);
+
+    /// @brief Compute tag of the next sent message which header and payload are in separate buffers (the tag is the same
+    /// as the tag of one buffer with both parts)
+    /// @param tag [out] buffer of TAG_SIZE bytes
+    void computeTag(const byte *header, size_t headerSize, const byte *payload, size_t payloadSize, byte *tag);
+
+    /// @brief Verify tag of the next received message. The counter of received messages is increased only if the tag is valid.
+    /// @return true if the tag is valid
+    bool verifyTag(const byte *data, size_t size, const byte *tag);
+
+private:
+    byte sendKey[KEY_SIZE];     ///< key of messages sent by local peer
+    byte recvKey[KEY_SIZE];     ///< key of messages received from the peer
+    uint64_t sendCounter;       ///< number of sent messages
+    uint64_t recvCounter;       ///< number of received messages
+
+    /// @brief Compute Poly1305 tag of the data (header followed by payload) with one-time key derived from the key and the counter
+    static void poly1305Tag(byte *tag, const byte *key, uint64_t counter, const byte *header, size_t headerSize,
+                            const byte *payload, size_t payloadSize);
+};
+
+using PeerSessionPtr = std::unique_ptr<PeerSession>;
+
+
+} // namespace PQB
+
+/* END OF FILE */
@@ -0,0 +1,241 @@
+/**
+ * @file RandomGenerator.cpp
+ * @author Michal Ľaš
+ * @brief Buffered userspace random generator for signature algorithms
+ * @date 2024-05-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+#include "RandomGenerator.hpp"
+#include <atomic>
+#include <mutex>
+#include <cstring>
+#include <algorithm>
+#include <pthread.h>
+#include <cryptopp/misc.h>      // SecureWipeBuffer
+#include "randombytes.h"
+#include "PQBExceptions.hpp"
+
+
+namespace PQB{
+
+namespace{
+
+    constexpr size_t KEY_SIZE = 32;
+    constexpr size_t NONCE_SIZE = 12;
+    constexpr size_t BLOCK_SIZE = 64;
+
+    std::mutex configMutex;                     ///< mutex protecting currentConfig
+    RandomGenerator::Config currentConfig;
+    std::atomic<uint64_t> generation{1};        ///< incremented by configure() and in a child process after fork()
+    std::atomic<uint64_t> nextThreadIndex{0};   ///< index of the next seeded thread in deterministic mode
+
+    void onFork(){
+        generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void registerForkHandler(){
+        static const bool registered = (pthread_atfork(nullptr, nullptr, onFork) == 0);
+        (void)registered;
+    }
+
+    inline uint32_t load32(const byte *p){
+        return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+
+    inline void store32(byte *p, uint32_t v){
+        p[0] = (byte)v; p[1] = (byte)(v >> 8); p[2] = (byte)(v >> 16); p[3] = (byte)(v >> 24);
+    }
+
+    inline uint32_t rotl(uint32_t v, int n){
+        return (v << n) | (v >> (32 - n));
+    }
+
+    inline void quarterRound(uint32_t &a, uint32_t &b, uint32_t &c, uint32_t &d){
+        a += b; d ^= a; d = rotl(d, 16);
+        c += d; b ^= c; b = rotl(b, 12);
+        a += b; d ^= a; d = rotl(d, 8);
+        c += d; b ^= c; b = rotl(b, 7);
+    }
+
+    void chacha20Block(byte *output, const uint32_t input[16]){
+        uint32_t x[16];
+        std::memcpy(x, input, sizeof(x));
+        for (int i = 0; i < 10; i++){
+            quarterRound(x[0], x[4], x[8],  x[12]);
+            quarterRound(x[1], x[5], x[9],  x[13]);
+            quarterRound(x[2], x[6], x[10], x[14]);
+            quarterRound(x[3], x[7], x[11], x[15]);
+            quarterRound(x[0], x[5], x[10], x[15]);
+            quarterRound(x[1], x[6], x[11], x[12]);
+            quarterRound(x[2], x[7], x[8],  x[13]);
+            quarterRound(x[3], x[4], x[9],  x[14]);
+        }
+        for (int i = 0; i < 16; i++){
+            store32(output + 4 * i, x[i] + input[i]);
+        }
+        CryptoPP::SecureWipeBuffer(x, 16);
+    }
+
+
+    /// @brief DRBG state of one thread
+    struct ThreadState{
+        byte key[KEY_SIZE];
+        byte buffer[RandomGenerator::BUFFER_SIZE];
+        size_t position = RandomGenerator::BUFFER_SIZE;     ///< number of served (wiped) bytes of the buffer
+        size_t generated = 0;                               ///< bytes generated since the last seed
+        uint64_t seedGeneration = 0;                        ///< generation of the seed, 0 if not seeded
+        std::chrono::steady_clock::time_point seededAt;
+        RandomGenerator::Config config;                     ///< configuration used since the last seed
+
+        ~ThreadState(){
+            CryptoPP::SecureWipeBuffer(key, KEY_SIZE);
+            CryptoPP::SecureWipeBuffer(buffer, RandomGenerator::BUFFER_SIZE);
+        }
+
+        bool needsReseed() const {
+            if (config.deterministic){
+                return false;
+            }
+            return (generated >= config.reseedBytes || std::chrono::steady_clock::now() - seededAt >= config.reseedTime);
+        }
+
+        void seed(){
+            registerForkHandler();
+            uint64_t current = generation.load(std::memory_order_acquire);
+            {
+                std::lock_guard<std::mutex> lock(configMutex);
+                config = currentConfig;
+            }
+
+            if (config.deterministic){
+                byte seedKey[KEY_SIZE] = {};
+                byte nonce[NONCE_SIZE] = {};
+                uint64_t index = nextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+                for (int i = 0; i < 8; i++){
+                    seedKey[i] = (byte)(config.seed >> (8 * i));
+                    nonce[i] = (byte)(index >> (8 * i));
+                }
+                RandomGenerator::chacha20(key, KEY_SIZE, seedKey, nonce);
+            } else {
+                byte entropy[KEY_SIZE];
+                if (PQCLEAN_randombytes_system(entropy, KEY_SIZE) != 0){
+                    throw PQB::Exceptions::Signer("Failed to seed random generator from the operating system");
+                }
+                // keep the previous key mixed in, a state that was never seeded has no key yet
+                for (size_t i = 0; i < KEY_SIZE; i++){
+                    key[i] = (seedGeneration == 0) ? entropy[i] : (key[i] ^ entropy[i]);
+                }
+                CryptoPP::SecureWipeBuffer(entropy, KEY_SIZE);
+            }
+
+            // bytes generated from the old key are not served anymore
+            CryptoPP::SecureWipeBuffer(buffer, RandomGenerator::BUFFER_SIZE);
+            position = RandomGenerator::BUFFER_SIZE;
+            generated = 0;
+            seededAt = std::chrono::steady_clock::now();
+            seedGeneration = current;
+        }
+
+        void refill(){
+            static const byte nonce[NONCE_SIZE] = {};
+            RandomGenerator::chacha20(buffer, RandomGenerator::BUFFER_SIZE, key, nonce);
+            // the first bytes of the keystream are the next key, so the key is never used twice
+            std::memcpy(key, buffer, KEY_SIZE);
+            CryptoPP::SecureWipeBuffer(buffer, KEY_SIZE);
+            position = KEY_SIZE;
+        }
+    };
+
+    thread_local ThreadState state;
+
+    int pqcleanRandomBytes(uint8_t *output, size_t n){
+        try{
+            RandomGenerator::generate(output, n);
+        } catch (const PQB::Exceptions::Signer &){
+            return -1;
+        }
+        return 0;
+    }
+
+} // namespace
+
+
+void RandomGenerator::configure(const Config &config){
+    std::lock_guard<std::mutex> lock(configMutex);
+    currentConfig = config;
+    nextThreadIndex.store(0, std::memory_order_relaxed);
+    generation.fetch_add(1, std::memory_order_release);
+}
+
+RandomGenerator::Config RandomGenerator::getConfig(){
+    std::lock_guard<std::mutex> lock(configMutex);
+    return currentConfig;
+}
+
+void RandomGenerator::generate(byte *output, size_t size){
+    if (state.seedGeneration != generation.load(std::memory_order_acquire)){
+        state.seed();
+    }
+    while (size > 0){
+        if (state.position == BUFFER_SIZE){
+            if (state.needsReseed()){
+                state.seed();
+            }
+            state.refill();
+        }
+        size_t n = std::min(size, BUFFER_SIZE - state.position);
+        std::memcpy(output, state.buffer + state.position, n);
+        CryptoPP::SecureWipeBuffer(state.buffer + state.position, n);
+        state.position += n;
+        state.generated += n;
+        output += n;
+        size -= n;
+    }
+}
+
+void RandomGenerator::install(){
+    PQCLEAN_randombytes_set_source(pqcleanRandomBytes);
+}
+
+void RandomGenerator::uninstall(){
+    PQCLEAN_randombytes_set_source(nullptr);
+}
+
+void RandomGenerator::chacha20(byte *output, size_t size, const byte *key, const byte *nonce, uint32_t counter){
+    uint32_t input[16];
+    input[0] = 0x61707865;
+    input[1] = 0x3320646e;
+    input[2] = 0x79622d32;
+    input[3] = 0x6b206574;
+    for (int i = 0; i < 8; i++){
+        input[4 + i] = load32(key + 4 * i);
+    }
+    input[12] = counter;
+    for (int i = 0; i < 3; i++){
+        input[13 + i] = load32(nonce + 4 * i);
+    }
+
+    byte block[BLOCK_SIZE];
+    while (size > 0){
+        size_t n = std::min(size, BLOCK_SIZE);
+        if (n == BLOCK_SIZE){
+            chacha20Block(output, input);
+        } else {
+            chacha20Block(block, input);
+            std::memcpy(output, block, n);
+        }
+        input[12]++;
+        output += n;
+        size -= n;
+    }
+    CryptoPP::SecureWipeBuffer(block, BLOCK_SIZE);
+    CryptoPP::SecureWipeBuffer(input, 16);
+}
+
+} // namespace PQB
+
+/* END OF FILE */
@@ -0,0 +1,102 @@
+/**
+ * @file RandomGenerator.hpp
+ * @author Michal Ľaš
+ * @brief Buffered userspace random generator for signature algorithms
+ * @date 2024-05-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cryptopp/cryptlib.h>
+#include "PQBtypedefs.hpp"
+
+
+namespace PQB{
+
+
+/**
+ * @brief Per-thread ChaCha20 DRBG serving random bytes to PQClean (randombytes()) and Crypto++ algorithms,
+ * so key generation and signing do not make a getrandom system call for every request.
+ *
+ * Every thread has its own state (key and buffer of generated bytes). When the buffer is refilled the first 32 bytes
+ * of the new keystream replace the key (fast key erasure), and served bytes are wiped from the buffer, so past outputs
+ * cannot be recovered from the state. The key is reseeded from the operating system after Config::reseedBytes bytes
+ * or after Config::reseedTime, after configure() and in a child process after fork().
+ *
+ * With Config::deterministic the generator is seeded only from Config::seed (and index of the thread in order of
+ * first use), which gives reproducible keys and signatures for benchmarks and tests. Never use it in production.
+ */
+class RandomGenerator{
+public:
+
+    /// @brief Size of the buffer of generated bytes of each thread
+    static constexpr size_t BUFFER_SIZE = 1024;
+    /// @brief Default number of bytes generated from one seed
+    static constexpr size_t DEFAULT_RESEED_BYTES = 1024 * 1024;
+    /// @brief Default time after which the generator is reseeded
+    static constexpr std::chrono::seconds DEFAULT_RESEED_TIME{60};
+
+    /// @brief Configuration of the generator
+    struct Config{
+        size_t reseedBytes = DEFAULT_RESEED_BYTES;              ///< reseed after generating this many bytes
+        std::chrono::seconds reseedTime = DEFAULT_RESEED_TIME;  ///< reseed after this time
+        bool deterministic = false;                             ///< seed only from `seed` (no system entropy)
+        uint64_t seed = 0;                                      ///< seed used in deterministic mode
+    };
+
+    RandomGenerator() = delete;
+
+    /**
+     * @brief Set configuration of the generator. States of all threads are reseeded before next use.
+     * In deterministic mode threads are indexed again in order of their next use.
+     */
+    static void configure(const Config &config);
+
+    /// @brief Get current configuration of the generator
+    static Config getConfig();
+
+    /**
+     * @brief Generate random bytes from the DRBG of the calling thread
+     *
+     * @param output output buffer
+     * @param size number of bytes to generate
+     * @exception PQB::Exceptions::Signer if the generator cannot be seeded from the operating system
+     */
+    static void generate(byte *output, size_t size);
+
+    /// @brief Serve PQClean randombytes() from this generator (it can be called more times)
+    static void install();
+
+    /// @brief Serve PQClean randombytes() directly from the operating system again
+    static void uninstall();
+
+    /**
+     * @brief Generate ChaCha20 keystream (RFC 8439)
+     *
+     * @param output output buffer
+     * @param size number of bytes to generate
+     * @param key 32 bytes long key
+     * @param nonce 12 bytes long nonce
+     * @param counter initial block counter
+     */
+    static void chacha20(byte *output, size_t size, const byte *key, const byte *nonce, uint32_t counter = 0);
+
+    /// @brief Random number generator for Crypto++ algorithms backed by RandomGenerator::generate()
+    class CryptoPPAdapter : public CryptoPP::RandomNumberGenerator{
+    public:
+        void GenerateBlock(CryptoPP::byte *output, size_t size) override {
+            RandomGenerator::generate(output, size);
+        }
+    };
+};
+
+
+} // namespace PQB
+
+/* END OF FILE */
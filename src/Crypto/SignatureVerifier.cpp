@@ -0,0 +1,143 @@
+/**
+ * @file SignatureVerifier.cpp
+ * @author Michal Ľaš
+ * @brief Pool of worker threads for parallel verification of digital signatures
+ * @date 2024-05-06
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+#include "SignatureVerifier.hpp"
+#include "Log.hpp"
+
+
+namespace PQB{
+
+    SignatureVerifier::SignatureVerifier(size_t numOfThreads){
+        if (numOfThreads == 0){
+            numOfThreads = std::thread::hardware_concurrency();
+            if (numOfThreads == 0)
+                numOfThreads = 1;
+        }
+        workersRun = true;
+        for (size_t i = 0; i < numOfThreads; i++){
+            workers.emplace_back(&SignatureVerifier::worker, this);
+        }
+    }
+
+    SignatureVerifier::~SignatureVerifier(){
+        {
+            std::lock_guard<std::mutex> lock(taskQueueMutex);
+            workersRun = false;
+        }
+        taskCondition.notify_all();
+        for (auto &w : workers){
+            if (w.joinable())
+                w.join();
+        }
+    }
+
+    void SignatureVerifier::submit(VerifyBatch batch, uint64_t orderingKey, VerdictsCallback callback){
+        BatchStatePtr state = std::make_shared<BatchState>();
+        state->jobs = std::move(batch);
+        state->verdicts.resize(state->jobs.size(), 0);
+        state->remainingJobs = state->jobs.size();
+        state->orderingKey = orderingKey;
+        state->callback = std::move(callback);
+        state->completed = false;
+
+        {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            orderingQueues[orderingKey].batches.push_back(state);
+        }
+
+        if (state->jobs.empty()){
+            completeBatch(state);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(taskQueueMutex);
+            for (size_t i = 0; i < state->jobs.size(); i++){
+                taskQueue.push_back({.batch=state, .jobIndex=i});
+            }
+        }
+        if (state->jobs.size() == 1)
+            taskCondition.notify_one();
+        else
+            taskCondition.notify_all();
+    }
+
+    std::future<SignatureVerifier::Verdicts> SignatureVerifier::submit(VerifyBatch batch, uint64_t orderingKey){
+        auto promise = std::make_shared<std::promise<Verdicts>>();
+        std::future<Verdicts> future = promise->get_future();
+        submit(std::move(batch), orderingKey, [promise](Verdicts &verdicts){
+            promise->set_value(std::move(verdicts));
+        });
+        return future;
+    }
+
+    void SignatureVerifier::worker(){
+        while (true){
+            std::unique_lock<std::mutex> lock(taskQueueMutex);
+            taskCondition.wait(lock, [this]{ return (!taskQueue.empty() || !workersRun); });
+            if (!workersRun && taskQueue.empty()){
+                return;
+            }
+            Task task = std::move(taskQueue.front());
+            taskQueue.pop_front();
+            lock.unlock();
+
+            const VerifyJob &job = task.batch->jobs[task.jobIndex];
+            bool verdict = false;
+            try{
+                auto &s = ChosenSigner::get();
+                if (job.preparedKey != nullptr)
+                    verdict = s.verify(*job.signature, job.data, job.dataSize, *job.preparedKey);
+                else
+                    verdict = s.verify(*job.signature, job.data, job.dataSize, *job.publicKey);
+            } catch (const std::exception &e){
+                PQB_LOG_ERROR("SIGNATURE VERIFIER", "Signature verification failed with exception: {}", e.what());
+            }
+            task.batch->verdicts[task.jobIndex] = verdict;
+
+            // the last finished job of the batch completes it
+            if (task.batch->remainingJobs.fetch_sub(1, std::memory_order_acq_rel) == 1){
+                completeBatch(task.batch);
+            }
+        }
+    }
+
+    void SignatureVerifier::completeBatch(const BatchStatePtr &batch){
+        std::unique_lock<std::mutex> lock(orderMutex);
+        batch->completed = true;
+        auto it = orderingQueues.find(batch->orderingKey);
+        // If other worker is delivering verdicts of this ordering key, it will deliver also this batch
+        if (it == orderingQueues.end() || it->second.delivering){
+            return;
+        }
+        it->second.delivering = true;
+        while (!it->second.batches.empty() && it->second.batches.front()->completed){
+            BatchStatePtr ready = it->second.batches.front();
+            it->second.batches.pop_front();
+            lock.unlock();
+
+            Verdicts verdicts(ready->verdicts.begin(), ready->verdicts.end());
+            if (ready->callback)
+                ready->callback(verdicts);
+
+            lock.lock();
+            // orderingQueues could be rehashed while the lock was released
+            it = orderingQueues.find(batch->orderingKey);
+        }
+        it->second.delivering = false;
+        if (it->second.batches.empty()){
+            orderingQueues.erase(it);
+        }
+    }
+
+} // namespace PQB
+
+/* END OF FILE */
@@ -0,0 +1,133 @@
+/**
+ * @file SignatureVerifier.hpp
+ * @author Michal Ľaš
+ * @brief Pool of worker threads for parallel verification of digital signatures
+ * @date 2024-05-06
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <functional>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include "PQBtypedefs.hpp"
+#include "Signer.hpp"
+
+
+namespace PQB{
+
+
+/**
+ * @brief Pool of worker threads verifying signatures with the chosen signature algorithm (ChosenSigner).
+ *
+ * Signatures are submitted in batches. Jobs of one batch are verified in parallel by all workers and the verdicts are
+ * returned asynchronously (by a callback or a future). Batches submitted with the same ordering key (for example
+ * connection ID of a peer) are completed in the same order as they were submitted, so processing of messages from one
+ * peer keeps its order even if verification of later messages finishes sooner.
+ */
+class SignatureVerifier{
+public:
+
+    /// @brief One signature to verify. Pointed data are not copied, so they have to be valid until the verdict is returned.
+    struct VerifyJob{
+        const PQB::byte *data;          ///< signed data
+        size_t dataSize;                ///< size of signed data
+        const byteBuffer *signature;    ///< signature of the data
+        const byteBuffer *publicKey;    ///< public key of the signer
+        const PreparedPublicKey *preparedKey = nullptr; ///< prepared public key of the signer, if set it is used instead of publicKey
+    };
+
+    typedef std::vector<VerifyJob> VerifyBatch;
+    typedef std::vector<bool> Verdicts; ///< verdicts[i] is result of verification of the i-th job of a batch
+    typedef std::function<void(Verdicts &)> VerdictsCallback;
+
+    /**
+     * @brief Construct a new Signature Verifier object and start worker threads
+     *
+     * @param numOfThreads number of worker threads (0 means number of hardware threads)
+     */
+    SignatureVerifier(size_t numOfThreads = 0);
+    ~SignatureVerifier();
+
+    SignatureVerifier(const SignatureVerifier &) = delete;
+    void operator=(const SignatureVerifier &) = delete;
+
+    /**
+     * @brief Submit a batch of signatures for verification
+     *
+     * @param batch signatures to verify
+     * @param orderingKey callbacks of batches with the same ordering key are called in order of submission
+     * @param callback function called with verdicts (it is called from a worker thread, so it should be short)
+     */
+    void submit(VerifyBatch batch, uint64_t orderingKey, VerdictsCallback callback);
+
+    /// @brief Submit a batch of signatures for verification. Returned future becomes ready when all verdicts are known.
+    std::future<Verdicts> submit(VerifyBatch batch, uint64_t orderingKey = 0);
+
+    /// @brief Verify a batch of signatures in parallel and wait for the verdicts
+    Verdicts verify(VerifyBatch batch){
+        return submit(std::move(batch)).get();
+    }
+
+    /// @brief Get number of worker threads
+    size_t getNumberOfThreads() const {
+        return workers.size();
+    }
+
+private:
+
+    /// @brief State of one submitted batch
+    struct BatchState{
+        VerifyBatch jobs;
+        std::vector<char> verdicts;             ///< std::vector<bool> can not be written from more threads at once
+        std::atomic<size_t> remainingJobs;
+        uint64_t orderingKey;
+        VerdictsCallback callback;
+        bool completed;                         ///< protected by orderMutex
+    };
+    typedef std::shared_ptr<BatchState> BatchStatePtr;
+
+    /// @brief One job of a batch waiting for a worker
+    struct Task{
+        BatchStatePtr batch;
+        size_t jobIndex;
+    };
+
+    /// @brief Batches of one ordering key in order of submission
+    struct OrderingQueue{
+        std::deque<BatchStatePtr> batches;
+        bool delivering = false;                ///< some worker is just calling callbacks of this queue
+    };
+
+    std::vector<std::jthread> workers;
+    std::atomic_bool workersRun;                ///< flag telling if worker threads are running
+
+    std::deque<Task> taskQueue;                 ///< jobs waiting for verification
+    std::mutex taskQueueMutex;
+    std::condition_variable taskCondition;
+
+    std::unordered_map<uint64_t, OrderingQueue> orderingQueues; ///< submitted batches by ordering key
+    std::mutex orderMutex;
+
+    /// @brief Worker thread
+    void worker();
+
+    /// @brief Called by a worker which finished last job of a batch. Calls callbacks of completed batches in order of submission.
+    void completeBatch(const BatchStatePtr &batch);
+};
+
+
+} // namespace PQB
+
+/* END OF FILE */
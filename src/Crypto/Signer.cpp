@@ -11,47 +11,238 @@
 
 #include "Signer.hpp"
 
-#include <cryptopp/osrng.h>
 #include <cryptopp/hex.h>       // HexEncoder
 #include <cryptopp/filters.h>   // ArraySink
+#include <cryptopp/misc.h>      // SecureWipeBuffer
+#include "RandomGenerator.hpp"
+#include "CpuFeatures.hpp"
 #include "PQBExceptions.hpp"
 #include "Log.hpp"
 
+extern "C"{
+    #include <falcon1024_clean.h>
+    #include <falcon512_clean.h>
+    #include <dilithium5_clean.h>
+    #include <dilithium3_clean.h>
+    #include <dilithium2_clean.h>
+}
+
 namespace PQB{
 
+namespace{
+
+/// @brief Functions of one implementation (build) of PQClean signature algorithm
+struct PQCleanApi{
+    const char *implementation;
+    int (*keypair)(uint8_t *pk, uint8_t *sk);
+    int (*signature)(uint8_t *sig, size_t *siglen, const uint8_t *m, size_t mlen, const uint8_t *sk);
+    int (*verify)(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen, const uint8_t *pk);
+    int (*preparePk)(uint8_t *ppk, const uint8_t *pk);
+    int (*verifyPrepared)(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen, const uint8_t *ppk);
+    int (*expandSk)(uint8_t *esk, const uint8_t *sk);   ///< nullptr if the algorithm has no expanded signing
+    int (*signatureExpanded)(uint8_t *sig, size_t *siglen, const uint8_t *m, size_t mlen, const uint8_t *esk);
+};
+
+#define PQB_PQCLEAN_DILITHIUM_API(implementation, prefix) \
+    {implementation, prefix##crypto_sign_keypair, prefix##crypto_sign_signature, prefix##crypto_sign_verify, \
+     prefix##crypto_sign_prepare_pk, prefix##crypto_sign_verify_prepared, nullptr, nullptr}
+
+#define PQB_PQCLEAN_FALCON_API(implementation, prefix) \
+    {implementation, prefix##crypto_sign_keypair, prefix##crypto_sign_signature, prefix##crypto_sign_verify, \
+     prefix##crypto_sign_prepare_pk, prefix##crypto_sign_verify_prepared, prefix##crypto_sign_expand_sk, prefix##crypto_sign_signature_expanded}
+
+// Both implementations of an algorithm are used with the same sizes of keys and signatures (see Signer.hpp)
+static_assert(PQCLEAN_FALCON1024_AVX2_CRYPTO_SECRETKEYBYTES == PQCLEAN_FALCON1024_CLEAN_CRYPTO_SECRETKEYBYTES &&
+              PQCLEAN_FALCON1024_AVX2_CRYPTO_PUBLICKEYBYTES == PQCLEAN_FALCON1024_CLEAN_CRYPTO_PUBLICKEYBYTES &&
+              PQCLEAN_FALCON1024_AVX2_CRYPTO_BYTES == PQCLEAN_FALCON1024_CLEAN_CRYPTO_BYTES &&
+              PQCLEAN_FALCON1024_AVX2_CRYPTO_PREPAREDPKBYTES == PQCLEAN_FALCON1024_CLEAN_CRYPTO_PREPAREDPKBYTES &&
+              PQCLEAN_FALCON1024_AVX2_CRYPTO_EXPANDEDSKBYTES == PQCLEAN_FALCON1024_CLEAN_CRYPTO_EXPANDEDSKBYTES);
+static_assert(PQCLEAN_FALCON512_AVX2_CRYPTO_SECRETKEYBYTES == PQCLEAN_FALCON512_CLEAN_CRYPTO_SECRETKEYBYTES &&
+              PQCLEAN_FALCON512_AVX2_CRYPTO_PUBLICKEYBYTES == PQCLEAN_FALCON512_CLEAN_CRYPTO_PUBLICKEYBYTES &&
+              PQCLEAN_FALCON512_AVX2_CRYPTO_BYTES == PQCLEAN_FALCON512_CLEAN_CRYPTO_BYTES &&
+              PQCLEAN_FALCON512_AVX2_CRYPTO_PREPAREDPKBYTES == PQCLEAN_FALCON512_CLEAN_CRYPTO_PREPAREDPKBYTES &&
+              PQCLEAN_FALCON512_AVX2_CRYPTO_EXPANDEDSKBYTES == PQCLEAN_FALCON512_CLEAN_CRYPTO_EXPANDEDSKBYTES);
+static_assert(PQCLEAN_DILITHIUM5_AVX2_CRYPTO_SECRETKEYBYTES == PQCLEAN_DILITHIUM5_CLEAN_CRYPTO_SECRETKEYBYTES &&
+              PQCLEAN_DILITHIUM5_AVX2_CRYPTO_PUBLICKEYBYTES == PQCLEAN_DILITHIUM5_CLEAN_CRYPTO_PUBLICKEYBYTES &&
+              PQCLEAN_DILITHIUM5_AVX2_CRYPTO_BYTES == PQCLEAN_DILITHIUM5_CLEAN_CRYPTO_BYTES &&
+              PQCLEAN_DILITHIUM5_AVX2_CRYPTO_PREPAREDPKBYTES == PQCLEAN_DILITHIUM5_CLEAN_CRYPTO_PREPAREDPKBYTES);
+static_assert(PQCLEAN_DILITHIUM3_AVX2_CRYPTO_SECRETKEYBYTES == PQCLEAN_DILITHIUM3_CLEAN_CRYPTO_SECRETKEYBYTES &&
+              PQCLEAN_DILITHIUM3_AVX2_CRYPTO_PUBLICKEYBYTES == PQCLEAN_DILITHIUM3_CLEAN_CRYPTO_PUBLICKEYBYTES &&
+              PQCLEAN_DILITHIUM3_AVX2_CRYPTO_BYTES == PQCLEAN_DILITHIUM3_CLEAN_CRYPTO_BYTES &&
+              PQCLEAN_DILITHIUM3_AVX2_CRYPTO_PREPAREDPKBYTES == PQCLEAN_DILITHIUM3_CLEAN_CRYPTO_PREPAREDPKBYTES);
+static_assert(PQCLEAN_DILITHIUM2_AVX2_CRYPTO_SECRETKEYBYTES == PQCLEAN_DILITHIUM2_CLEAN_CRYPTO_SECRETKEYBYTES &&
+              PQCLEAN_DILITHIUM2_AVX2_CRYPTO_PUBLICKEYBYTES == PQCLEAN_DILITHIUM2_CLEAN_CRYPTO_PUBLICKEYBYTES &&
+              PQCLEAN_DILITHIUM2_AVX2_CRYPTO_BYTES == PQCLEAN_DILITHIUM2_CLEAN_CRYPTO_BYTES &&
+              PQCLEAN_DILITHIUM2_AVX2_CRYPTO_PREPAREDPKBYTES == PQCLEAN_DILITHIUM2_CLEAN_CRYPTO_PREPAREDPKBYTES);
+
+const PQCleanApi falcon1024Avx2 = PQB_PQCLEAN_FALCON_API("PQClean AVX2", PQCLEAN_FALCON1024_AVX2_);
+const PQCleanApi falcon1024Clean = PQB_PQCLEAN_FALCON_API("PQClean clean", PQCLEAN_FALCON1024_CLEAN_);
+const PQCleanApi falcon512Avx2 = PQB_PQCLEAN_FALCON_API("PQClean AVX2", PQCLEAN_FALCON512_AVX2_);
+const PQCleanApi falcon512Clean = PQB_PQCLEAN_FALCON_API("PQClean clean", PQCLEAN_FALCON512_CLEAN_);
+const PQCleanApi dilithium5Avx2 = PQB_PQCLEAN_DILITHIUM_API("PQClean AVX2", PQCLEAN_DILITHIUM5_AVX2_);
+const PQCleanApi dilithium5Clean = PQB_PQCLEAN_DILITHIUM_API("PQClean clean", PQCLEAN_DILITHIUM5_CLEAN_);
+const PQCleanApi dilithium3Avx2 = PQB_PQCLEAN_DILITHIUM_API("PQClean AVX2", PQCLEAN_DILITHIUM3_AVX2_);
+const PQCleanApi dilithium3Clean = PQB_PQCLEAN_DILITHIUM_API("PQClean clean", PQCLEAN_DILITHIUM3_CLEAN_);
+const PQCleanApi dilithium2Avx2 = PQB_PQCLEAN_DILITHIUM_API("PQClean AVX2", PQCLEAN_DILITHIUM2_AVX2_);
+const PQCleanApi dilithium2Clean = PQB_PQCLEAN_DILITHIUM_API("PQClean clean", PQCLEAN_DILITHIUM2_CLEAN_);
+
+/// @brief AVX2 builds of Falcon are compiled with -mavx2
+bool falconAvx2Supported(){
+    return CpuFeatures::get().avx2;
+}
+
+/// @brief AVX2 builds of Dilithium are compiled with -mavx2 -mpopcnt
+bool dilithiumAvx2Supported(){
+    const CpuFeatures &cpu = CpuFeatures::get();
+    return cpu.avx2 && cpu.popcnt;
+}
+
+// Implementation of each algorithm is chosen once by CPUID, the portable (clean) one runs on any x86-64 CPU.
+// Both implementations produce the same keys and signatures, so nodes with different CPUs agree on them.
+const PQCleanApi &falcon1024Api(){
+    static const PQCleanApi &api = falconAvx2Supported() ? falcon1024Avx2 : falcon1024Clean;
+    return api;
+}
+
+const PQCleanApi &falcon512Api(){
+    static const PQCleanApi &api = falconAvx2Supported() ? falcon512Avx2 : falcon512Clean;
+    return api;
+}
+
+const PQCleanApi &dilithium5Api(){
+    static const PQCleanApi &api = dilithiumAvx2Supported() ? dilithium5Avx2 : dilithium5Clean;
+    return api;
+}
+
+const PQCleanApi &dilithium3Api(){
+    static const PQCleanApi &api = dilithiumAvx2Supported() ? dilithium3Avx2 : dilithium3Clean;
+    return api;
+}
+
+const PQCleanApi &dilithium2Api(){
+    static const PQCleanApi &api = dilithiumAvx2Supported() ? dilithium2Avx2 : dilithium2Clean;
+    return api;
+}
+
+/// @brief Public key of PQClean algorithm prepared by crypto_sign_prepare_pk() (both implementations require 32 bytes alignment)
+template <class Algorithm, size_t Size>
+class PQCleanPreparedKey : public PreparedPublicKey{
+public:
+    alignas(32) PQB::byte data[Size];
+};
+
+/// @brief Public key of Crypto++ algorithm, the verifier object is constructed just once
+template <class Verifier>
+class CryptoPPPreparedKey : public PreparedPublicKey{
+public:
+    template <class... Args>
+    explicit CryptoPPPreparedKey(Args&&... args) : verifier(std::forward<Args>(args)...) {}
+    Verifier verifier;
+};
+
+/// @brief Private key of PQClean algorithm expanded by crypto_sign_expand_sk(), wiped on destruction
+template <class Algorithm, size_t Size>
+class PQCleanExpandedKey : public ExpandedPrivateKey{
+public:
+    ~PQCleanExpandedKey(){
+        CryptoPP::SecureWipeBuffer(data, Size);
+    }
+    alignas(32) PQB::byte data[Size];
+};
+
+/// @brief Copy of a private key for algorithms without expanded signing, wiped on destruction
+class RawExpandedKey : public ExpandedPrivateKey{
+public:
+    RawExpandedKey(const PQB::byteBuffer &privateKey) : key(privateKey) {}
+    ~RawExpandedKey(){
+        CryptoPP::SecureWipeBuffer(key.data(), key.size());
+    }
+    PQB::byteBuffer key;
+};
+
+/// @brief Cast prepared public key or expanded private key to the type of the algorithm
+template <class T, class Base>
+const T &castKey(const Base &baseKey){
+    const T *key = dynamic_cast<const T*>(&baseKey);
+    if (key == nullptr){
+        throw PQB::Exceptions::Signer("Key was not prepared by this algorithm!");
+    }
+    return *key;
+}
+
+} // anonymous namespace
+
 SignAlgorithmPtr Signer::GetInstance(std::string chosenAlgorithm){
     static SignAlgorithmPtr __algorithmInstance = nullptr;
     if(__algorithmInstance == nullptr){
+        SignAlgorithmPtr algorithm;
+#ifdef PQB_SIGN_ALGORITHM
+        // the algorithm is fixed at compile time, share the instance of StaticSigner (not owned by the pointer)
+        if (chosenAlgorithm == PQB_SIGN_ALGORITHM_NAME){
+            algorithm = SignAlgorithmPtr(SignAlgorithmPtr(), &ChosenSigner::get());
+        } else {
+            PQB_LOG_ERROR("SIGNER", "Program was compiled only with {} digital signature algorithm, chosen: {}", PQB_SIGN_ALGORITHM_NAME, chosenAlgorithm);
+            throw PQB::Exceptions::Signer("Chosen algorithm for digital signature is not compiled in!");
+        }
+#else
         if(chosenAlgorithm == "falcon1024"){
-            __algorithmInstance = std::make_shared<Falcon1024>();
+            algorithm = std::make_shared<Falcon1024>();
         } else if (chosenAlgorithm == "falcon512") {
-            __algorithmInstance = std::make_shared<Falcon512>();
+            algorithm = std::make_shared<Falcon512>();
         } else if (chosenAlgorithm == "dilithium5") {
-            __algorithmInstance = std::make_shared<Dilithium5>();
+            algorithm = std::make_shared<Dilithium5>();
         } else if (chosenAlgorithm == "dilithium3") {
-            __algorithmInstance = std::make_shared<Dilithium3>();
+            algorithm = std::make_shared<Dilithium3>();
         } else if (chosenAlgorithm == "dilithium2") {
-            __algorithmInstance = std::make_shared<Dilithium2>();
+            algorithm = std::make_shared<Dilithium2>();
         } else if (chosenAlgorithm == "ed25519"){
-            __algorithmInstance = std::make_shared<Ed25519>();
+            algorithm = std::make_shared<Ed25519>();
         } else if (chosenAlgorithm == "ecdsa"){
-            __algorithmInstance = std::make_shared<ECDSA>();
+            algorithm = std::make_shared<ECDSA>();
         } else {
             PQB_LOG_ERROR("SIGNER", "Chosen unknow algorithm for digital signature: {}", chosenAlgorithm);
             throw PQB::Exceptions::Signer("Chosen unknow algorithm for digital signature!");
         }
-        PQB_LOG_INFO("SIGNER", "{} was chosen for digital signatures", chosenAlgorithm);
+#endif
+        // fail here with an error instead of crashing on an illegal instruction later
+        if (!algorithm->isSupportedByCPU()){
+            PQB_LOG_ERROR("SIGNER", "{} implementation of {} is not supported by this CPU (CPU features: {})",
+                          algorithm->getImplementation(), chosenAlgorithm, CpuFeatures::get().toString());
+            throw PQB::Exceptions::Signer("Chosen algorithm for digital signature is not supported by this CPU!");
+        }
+        __algorithmInstance = algorithm;
+        RandomGenerator::install();
+        PQB_LOG_INFO("SIGNER", "{} was chosen for digital signatures ({} implementation, CPU features: {})",
+                     chosenAlgorithm, __algorithmInstance->getImplementation(), CpuFeatures::get().toString());
     }
     return __algorithmInstance;
 }
 
+/*********** SignAlgorithm ***********/
+
+ExpandedPrivateKeyPtr SignAlgorithm::expandPrivateKey(const PQB::byteBuffer &privateKey){
+    if (privateKey.size() != getPrivateKeySize()){
+        throw PQB::Exceptions::Signer("Key expansion: invalid private key size!");
+    }
+    return std::make_shared<RawExpandedKey>(privateKey);
+}
+
+size_t SignAlgorithm::sign(PQB::byteBuffer &signature, const PQB::byte *dataToSign, size_t dataSize, const ExpandedPrivateKey &privateKey){
+    const RawExpandedKey &key = castKey<RawExpandedKey>(privateKey);
+    return sign(signature, dataToSign, dataSize, key.key);
+}
+
 /*********** Falcon-1024 ***********/
 
+std::string Falcon1024::getImplementation(){
+    return falcon1024Api().implementation;
+}
+
 void Falcon1024::genKeys(PQB::byteBuffer &privateKey, PQB::byteBuffer &publicKey){
     privateKey.resize(privateKeySize);
     publicKey.resize(publicKeySize);
 
-    int ok = PQCLEAN_FALCON1024_AVX2_crypto_sign_keypair(publicKey.data(), privateKey.data());
+    int ok = falcon1024Api().keypair(publicKey.data(), privateKey.data());
     if(ok){
         throw PQB::Exceptions::Signer("Key generation: key generation failure!");
     }
@@ -61,7 +252,35 @@ size_t Falcon1024::sign(PQB::byteBuffer &signature, const PQB::byte *dataToSign,
     signature.resize(signatureSize);
     size_t signatureLength;
 
-    int ok = PQCLEAN_FALCON1024_AVX2_crypto_sign_signature(signature.data(), &signatureLength, dataToSign, dataSize, privateKey.data());
+    int ok = falcon1024Api().signature(signature.data(), &signatureLength, dataToSign, dataSize, privateKey.data());
+    if(ok){
+        throw PQB::Exceptions::Signer("Signing: message signing failure!");
+    }
+
+    signature.resize(signatureLength);
+    return signatureLength;
+}
+
+ExpandedPrivateKeyPtr Falcon1024::expandPrivateKey(const PQB::byteBuffer &privateKey){
+    using ExpandedKey = PQCleanExpandedKey<Falcon1024, expandedPrivateKeySize>;
+    if (privateKey.size() != privateKeySize){
+        throw PQB::Exceptions::Signer("Key expansion: invalid private key size!");
+    }
+    auto expanded = std::make_shared<ExpandedKey>();
+    int ok = falcon1024Api().expandSk(expanded->data, privateKey.data());
+    if(ok){
+        throw PQB::Exceptions::Signer("Key expansion: invalid private key!");
+    }
+    return expanded;
+}
+
+size_t Falcon1024::sign(PQB::byteBuffer &signature, const PQB::byte *dataToSign, size_t dataSize, const ExpandedPrivateKey &privateKey){
+    using ExpandedKey = PQCleanExpandedKey<Falcon1024, expandedPrivateKeySize>;
+    const ExpandedKey &key = castKey<ExpandedKey>(privateKey);
+    signature.resize(signatureSize);
+    size_t signatureLength;
+
+    int ok = falcon1024Api().signatureExpanded(signature.data(), &signatureLength, dataToSign, dataSize, key.data);
     if(ok){
         throw PQB::Exceptions::Signer("Signing: message signing failure!");
     }
@@ -71,17 +290,41 @@ size_t Falcon1024::sign(PQB::byteBuffer &signature, const PQB::byte *dataToSign,
 }
 
 bool Falcon1024::verify(const PQB::byteBuffer &signature, const PQB::byte *signedData, size_t dataSize, const PQB::byteBuffer &publicKey){
-    int ok = PQCLEAN_FALCON1024_AVX2_crypto_sign_verify(signature.data(), signature.size(), signedData, dataSize, publicKey.data());
+    int ok = falcon1024Api().verify(signature.data(), signature.size(), signedData, dataSize, publicKey.data());
+    return (ok == 0 ? true : false);
+}
+
+PreparedPublicKeyPtr Falcon1024::preparePublicKey(const PQB::byteBuffer &publicKey){
+    using PreparedKey = PQCleanPreparedKey<Falcon1024, preparedPublicKeySize>;
+    if (publicKey.size() != publicKeySize){
+        throw PQB::Exceptions::Signer("Key preparation: invalid public key size!");
+    }
+    auto prepared = std::make_shared<PreparedKey>();
+    int ok = falcon1024Api().preparePk(prepared->data, publicKey.data());
+    if(ok){
+        throw PQB::Exceptions::Signer("Key preparation: invalid public key!");
+    }
+    return prepared;
+}
+
+bool Falcon1024::verify(const PQB::byteBuffer &signature, const PQB::byte *signedData, size_t dataSize, const PreparedPublicKey &publicKey){
+    using PreparedKey = PQCleanPreparedKey<Falcon1024, preparedPublicKeySize>;
+    const PreparedKey &key = castKey<PreparedKey>(publicKey);
+    int ok = falcon1024Api().verifyPrepared(signature.data(), signature.size(), signedData, dataSize, key.data);
     return (ok == 0 ? true : false);
 }
 
 /*********** Falcon-512 ***********/
 
+std::string Falcon512::getImplementation(){
+    return falcon512Api().implementation;
+}
+
 void Falcon512::genKeys(PQB::byteBuffer &privateKey, PQB::byteBuffer &publicKey){
     privateKey.resize(privateKeySize);
     publicKey.resize(publicKeySize);
 
-    int ok = PQCLEAN_FALCON512_AVX2_crypto_sign_keypair(publicKey.data(), privateKey.data());
+    int ok = falcon512Api().keypair(publicKey.data(), privateKey.data());
     if(ok){
         throw PQB::Exceptions::Signer("Key generation: key generation failure!");
     }
@@ -91,7 +334,35 @@ size_t Falcon512::sign(PQB::byteBuffer &signature, const PQB::byte *dataToSign,
     signature.resize(signatureSize);
     size_t signatureLength;
 
-    int ok = PQCLEAN_FALCON512_AVX2_crypto_sign_signature(signature.data(), &signatureLength, dataToSign, dataSize, privateKey.data());
+    int ok = falcon512Api().signature(signature.data(), &signatureLength, dataToSign, dataSize, privateKey.data());
+    if(ok){
+        throw PQB::Exceptions::Signer("Signing: message signing failure!");
+    }
+
+    signature.resize(signatureLength);
+    return signatureLength;
+}
+
+ExpandedPrivateKeyPtr Falcon512::expandPrivateKey(const PQB::byteBuffer &privateKey){
+    using ExpandedKey = PQCleanExpandedKey<Falcon512, expandedPrivateKeySize>;
+    if (privateKey.size() != privateKeySize){
+        throw PQB::Exceptions::Signer("Key expansion: invalid private key size!");
+    }
+    auto expanded = std::make_shared<ExpandedKey>();
+    int ok = falcon512Api().expandSk(expanded->data, privateKey.data());
+    if(ok){
+        throw PQB::Exceptions::Signer("Key expansion: invalid private key!");
+    }
+    return expanded;
+}
+
+size_t Falcon512::sign(PQB::byteBuffer &signature, const PQB::byte *dataToSign, size_t dataSize, const ExpandedPrivateKey &privateKey){
+    using ExpandedKey = PQCleanExpandedKey<Falcon512, expandedPrivateKeySize>;
+    const ExpandedKey &key = castKey<ExpandedKey>(privateKey);
+    signature.resize(signatureSize);
+    size_t signatureLength;
+
+    int ok = falcon512Api().signatureExpanded(signature.data(), &signatureLength, dataToSign, dataSize, key.data);
     if(ok){
         throw PQB::Exceptions::Signer("Signing: message signing failure!");
     }
@@ -101,17 +372,41 @@ size_t Falcon512::sign(PQB::byteBuffer &signature, const PQB::byte *dataToSign,
 }
 
 bool Falcon512::verify(const PQB::byteBuffer &signature, const PQB::byte *signedData, size_t dataSize, const PQB::byteBuffer &publicKey){
-    int ok = PQCLEAN_FALCON512_AVX2_crypto_sign_verify(signature.data(), signature.size(), signedData, dataSize, publicKey.data());
+    int ok = falcon512Api().verify(signature.data(), signature.size(), signedData, dataSize, publicKey.data());
+    return (ok == 0 ? true : false);
+}
+
+PreparedPublicKeyPtr Falcon512::preparePublicKey(const PQB::byteBuffer &publicKey){
+    using PreparedKey = PQCleanPreparedKey<Falcon512, preparedPublicKeySize>;
+    if (publicKey.size() != publicKeySize){
+        throw PQB::Exceptions::Signer("Key preparation: invalid public key size!");
+    }
+    auto prepared = std::make_shared<PreparedKey>();
+    int ok = falcon512Api().preparePk(prepared->data, publicKey.data());
+    if(ok){
+        throw PQB::Exceptions::Signer("Key preparation: invalid public key!");
+    }
+    return prepared;
+}
+
+bool Falcon512::verify(const PQB::byteBuffer &signature, const PQB::byte *signedData, size_t dataSize, const PreparedPublicKey &publicKey){
+    using PreparedKey = PQCleanPreparedKey<Falcon512, preparedPublicKeySize>;
+    const PreparedKey &key = castKey<PreparedKey>(publicKey);
+    int ok = falcon512Api().verifyPrepared(signature.data(), signature.size(), signedData, dataSize, key.data);
     return (ok == 0 ? true : false);
 }
 
 /*********** Dilithium5 ***********/
 
+std::string Dilithium5::getImplementation(){
+    return dilithium5Api().implementation;
+}
+
 void Dilithium5::genKeys(PQB::byteBuffer &privateKey, PQB::byteBuffer &publicKey){
     privateKey.resize(privateKeySize);
     publicKey.resize(publicKeySize);
 
-    int ok = PQCLEAN_DILITHIUM5_AVX2_crypto_sign_keypair(publicKey.data(), privateKey.data());
+    int ok = dilithium5Api().keypair(publicKey.data(), privateKey.data());
     if(ok){
         throw PQB::Exceptions::Signer("Key generation: key generation failure!");
     }
@@ -121,7 +416,7 @@ size_t Dilithium5::sign(PQB::byteBuffer &signature, const PQB::byte *dataToSign,
     signature.resize(signatureSize);
     size_t signatureLength;
 
-    int ok = PQCLEAN_DILITHIUM5_AVX2_crypto_sign_signature(signature.data(), &signatureLength, dataToSign, dataSize, privateKey.data());
+    int ok = dilithium5Api().signature(signature.data(), &signatureLength, dataToSign, dataSize, privateKey.data());
     if(ok){
         throw PQB::Exceptions::Signer("Signing: message signing failure!");
     }
@@ -131,17 +426,41 @@ size_t Dilithium5::sign(PQB::byteBuffer &signature, const PQB::byte *dataToSign,
 }
 
 bool Dilithium5::verify(const PQB::byteBuffer &signature, const PQB::byte *signedData, size_t dataSize, const PQB::byteBuffer &publicKey){
-    int ok = PQCLEAN_DILITHIUM5_AVX2_crypto_sign_verify(signature.data(), signature.size(), signedData, dataSize, publicKey.data());
+    int ok = dilithium5Api().verify(signature.data(), signature.size(), signedData, dataSize, publicKey.data());
+    return (ok == 0 ? true : false);
+}
+
+PreparedPublicKeyPtr Dilithium5::preparePublicKey(const PQB::byteBuffer &publicKey){
+    using PreparedKey = PQCleanPreparedKey<Dilithium5, preparedPublicKeySize>;
+    if (publicKey.size() != publicKeySize){
+        throw PQB::Exceptions::Signer("Key preparation: invalid public key size!");
+    }
+    auto prepared = std::make_shared<PreparedKey>();
+    int ok = dilithium5Api().preparePk(prepared->data, publicKey.data());
+    if(ok){
+        throw PQB::Exceptions::Signer("Key preparation: invalid public key!");
+    }
+    return prepared;
+}
+
+bool Dilithium5::verify(const PQB::byteBuffer &signature, const PQB::byte *signedData, size_t dataSize, const PreparedPublicKey &publicKey){
+    using PreparedKey = PQCleanPreparedKey<Dilithium5, preparedPublicKeySize>;
+    const PreparedKey &key = castKey<PreparedKey>(publicKey);
+    int ok = dilithium5Api().verifyPrepared(signature.data(), signature.size(), signedData, dataSize, key.data);
     return (ok == 0 ? true : false);
 }
 
 /*********** Dilithium3 ***********/
 
+std::string Dilithium3::getImplementation(){
+    return dilithium3Api().implementation;
+}
+
 void Dilithium3::genKeys(PQB::byteBuffer &privateKey, PQB::byteBuffer &publicKey){
     privateKey.resize(privateKeySize);
     publicKey.resize(publicKeySize);
 
-    int ok = PQCLEAN_DILITHIUM3_AVX2_crypto_sign_keypair(publicKey.data(), privateKey.data());
+    int ok = dilithium3Api().keypair(publicKey.data(), privateKey.data());
     if(ok){
         throw PQB::Exceptions::Signer("Key generation: key generation failure!");
     }
@@ -151,7 +470,7 @@ size_t Dilithium3::sign(PQB::byteBuffer &signature, const PQB::byte *dataToSign,
     signature.resize(signatureSize);
     size_t signatureLength;
 
-    int ok = PQCLEAN_DILITHIUM3_AVX2_crypto_sign_signature(signature.data(), &signatureLength, dataToSign, dataSize, privateKey.data());
+    int ok = dilithium3Api().signature(signature.data(), &signatureLength, dataToSign, dataSize, privateKey.data());
     if(ok){
         throw PQB::Exceptions::Signer("Signing: message signing failure!");
     }
@@ -161,17 +480,41 @@ size_t Dilithium3::sign(PQB::byteBuffer &signature, const PQB::byte *dataToSign,
 }
 
 bool Dilithium3::verify(const PQB::byteBuffer &signature, const PQB::byte *signedData, size_t dataSize, const PQB::byteBuffer &publicKey){
-    int ok = PQCLEAN_DILITHIUM3_AVX2_crypto_sign_verify(signature.data(), signature.size(), signedData, dataSize, publicKey.data());
+    int ok = dilithium3Api().verify(signature.data(), signature.size(), signedData, dataSize, publicKey.data());
+    return (ok == 0 ? true : false);
+}
+
+PreparedPublicKeyPtr Dilithium3::preparePublicKey(const PQB::byteBuffer &publicKey){
+    using PreparedKey = PQCleanPreparedKey<Dilithium3, preparedPublicKeySize>;
+    if (publicKey.size() != publicKeySize){
+        throw PQB::Exceptions::Signer("Key preparation: invalid public key size!");
+    }
+    auto prepared = std::make_shared<PreparedKey>();
+    int ok = dilithium3Api().preparePk(prepared->data, publicKey.data());
+    if(ok){
+        throw PQB::Exceptions::Signer("Key preparation: invalid public key!");
+    }
+    return prepared;
+}
+
+bool Dilithium3::verify(const PQB::byteBuffer &signature, const PQB::byte *signedData, size_t dataSize, const PreparedPublicKey &publicKey){
+    using PreparedKey = PQCleanPreparedKey<Dilithium3, preparedPublicKeySize>;
+    const PreparedKey &key = castKey<PreparedKey>(publicKey);
+    int ok = dilithium3Api().verifyPrepared(signature.data(), signature.size(), signedData, dataSize, key.data);
     return (ok == 0 ? true : false);
 }
 
 /*********** Dilithium2 ***********/
 
+std::string Dilithium2::getImplementation(){
+    return dilithium2Api().implementation;
+}
+
 void Dilithium2::genKeys(PQB::byteBuffer &privateKey, PQB::byteBuffer &publicKey){
     privateKey.resize(privateKeySize);
     publicKey.resize(publicKeySize);
 
-    int ok = PQCLEAN_DILITHIUM2_AVX2_crypto_sign_keypair(publicKey.data(), privateKey.data());
+    int ok = dilithium2Api().keypair(publicKey.data(), privateKey.data());
     if(ok){
         throw PQB::Exceptions::Signer("Key generation: key generation failure!");
     }
@@ -181,7 +524,7 @@ size_t Dilithium2::sign(PQB::byteBuffer &signature, const PQB::byte *dataToSign,
     signature.resize(signatureSize);
     size_t signatureLength;
 
-    int ok = PQCLEAN_DILITHIUM2_AVX2_crypto_sign_signature(signature.data(), &signatureLength, dataToSign, dataSize, privateKey.data());
+    int ok = dilithium2Api().signature(signature.data(), &signatureLength, dataToSign, dataSize, privateKey.data());
     if(ok){
         throw PQB::Exceptions::Signer("Signing: message signing failure!");
     }
@@ -191,7 +534,27 @@ size_t Dilithium2::sign(PQB::byteBuffer &signature, const PQB::byte *dataToSign,
 }
 
 bool Dilithium2::verify(const PQB::byteBuffer &signature, const PQB::byte *signedData, size_t dataSize, const PQB::byteBuffer &publicKey){
-    int ok = PQCLEAN_DILITHIUM2_AVX2_crypto_sign_verify(signature.data(), signature.size(), signedData, dataSize, publicKey.data());
+    int ok = dilithium2Api().verify(signature.data(), signature.size(), signedData, dataSize, publicKey.data());
+    return (ok == 0 ? true : false);
+}
+
+PreparedPublicKeyPtr Dilithium2::preparePublicKey(const PQB::byteBuffer &publicKey){
+    using PreparedKey = PQCleanPreparedKey<Dilithium2, preparedPublicKeySize>;
+    if (publicKey.size() != publicKeySize){
+        throw PQB::Exceptions::Signer("Key preparation: invalid public key size!");
+    }
+    auto prepared = std::make_shared<PreparedKey>();
+    int ok = dilithium2Api().preparePk(prepared->data, publicKey.data());
+    if(ok){
+        throw PQB::Exceptions::Signer("Key preparation: invalid public key!");
+    }
+    return prepared;
+}
+
+bool Dilithium2::verify(const PQB::byteBuffer &signature, const PQB::byte *signedData, size_t dataSize, const PreparedPublicKey &publicKey){
+    using PreparedKey = PQCleanPreparedKey<Dilithium2, preparedPublicKeySize>;
+    const PreparedKey &key = castKey<PreparedKey>(publicKey);
+    int ok = dilithium2Api().verifyPrepared(signature.data(), signature.size(), signedData, dataSize, key.data);
     return (ok == 0 ? true : false);
 }
 
@@ -201,7 +564,7 @@ void Ed25519::genKeys(PQB::byteBuffer& privateKey, PQB::byteBuffer& publicKey){
     privateKey.resize(privateKeySize);
     publicKey.resize(publicKeySize);
 
-    CryptoPP::AutoSeededRandomPool prng;
+    RandomGenerator::CryptoPPAdapter prng;
     CryptoPP::ed25519::Signer signer;
     signer.AccessPrivateKey().GenerateRandom(prng);
     CryptoPP::ed25519::Verifier verifier(signer);
@@ -215,7 +578,7 @@ void Ed25519::genKeys(PQB::byteBuffer& privateKey, PQB::byteBuffer& publicKey){
 }
 
 size_t Ed25519::sign(PQB::byteBuffer& signature, const PQB::byte* dataToSign, size_t dataSize, const PQB::byteBuffer& privateKey){
-    CryptoPP::AutoSeededRandomPool prng;
+    RandomGenerator::CryptoPPAdapter prng;
     CryptoPP::Integer privKey(privateKey.data(), privateKey.size());
     CryptoPP::ed25519::Signer signer(privKey);
 
@@ -239,6 +602,19 @@ bool Ed25519::verify(const PQB::byteBuffer &signature, const PQB::byte *signedDa
     return verifier.VerifyMessage(signedData, dataSize, signature.data(), signature.size());
 }
 
+PreparedPublicKeyPtr Ed25519::preparePublicKey(const PQB::byteBuffer &publicKey){
+    if (publicKey.size() != publicKeySize){
+        throw PQB::Exceptions::Signer("Key preparation: invalid public key size!");
+    }
+    CryptoPP::Integer pubKey(publicKey.data(), publicKey.size());
+    return std::make_shared<CryptoPPPreparedKey<CryptoPP::ed25519::Verifier>>(pubKey);
+}
+
+bool Ed25519::verify(const PQB::byteBuffer &signature, const PQB::byte *signedData, size_t dataSize, const PreparedPublicKey &publicKey){
+    const auto &key = castKey<CryptoPPPreparedKey<CryptoPP::ed25519::Verifier>>(publicKey);
+    return key.verifier.VerifyMessage(signedData, dataSize, signature.data(), signature.size());
+}
+
 /*********** ECDSA ***********/
 
 void ECDSA::genKeys(PQB::byteBuffer &privateKey, PQB::byteBuffer &publicKey){
@@ -246,7 +622,7 @@ void ECDSA::genKeys(PQB::byteBuffer &privateKey, PQB::byteBuffer &publicKey){
     publicKey.resize(publicKeySize);
 
     using ECDSA = CryptoPP::ECDSA<CryptoPP::ECP, CryptoPP::SHA256>;
-    CryptoPP::AutoSeededRandomPool prng;
+    RandomGenerator::CryptoPPAdapter prng;
 
     ECDSA::PrivateKey sk;
     sk.Initialize(prng, CryptoPP::ASN1::secp256k1());
@@ -270,7 +646,7 @@ void ECDSA::genKeys(PQB::byteBuffer &privateKey, PQB::byteBuffer &publicKey){
 
 size_t ECDSA::sign(PQB::byteBuffer &signature, const PQB::byte *dataToSign, size_t dataSize, const PQB::byteBuffer &privateKey){
     using ECDSA = CryptoPP::ECDSA<CryptoPP::ECP, CryptoPP::SHA256>;
-    CryptoPP::AutoSeededRandomPool prng;
+    RandomGenerator::CryptoPPAdapter prng;
     CryptoPP::Integer privKey(privateKey.data(), privateKey.size());
 
     ECDSA::PrivateKey sk;
@@ -296,6 +672,27 @@ bool ECDSA::verify(const PQB::byteBuffer &signature, const PQB::byte *signedData
     return verifier.VerifyMessage(signedData, dataSize, signature.data(), signature.size());
 }
 
+PreparedPublicKeyPtr ECDSA::preparePublicKey(const PQB::byteBuffer &publicKey){
+    using ECDSA = CryptoPP::ECDSA<CryptoPP::ECP, CryptoPP::SHA256>;
+    if (publicKey.size() != publicKeySize){
+        throw PQB::Exceptions::Signer("Key preparation: invalid public key size!");
+    }
+    ECDSA::PublicKey pk;
+    CryptoPP::ECP::Point point;
+    pk.AccessGroupParameters().Initialize(CryptoPP::ASN1::secp256k1());
+    if (!pk.GetGroupParameters().GetCurve().DecodePoint(point, publicKey.data(), publicKey.size())){
+        throw PQB::Exceptions::Signer("Key preparation: invalid public key!");
+    }
+    pk.Initialize(CryptoPP::ASN1::secp256k1(), point);
+    return std::make_shared<CryptoPPPreparedKey<ECDSA::Verifier>>(pk);
+}
+
+bool ECDSA::verify(const PQB::byteBuffer &signature, const PQB::byte *signedData, size_t dataSize, const PreparedPublicKey &publicKey){
+    using ECDSA = CryptoPP::ECDSA<CryptoPP::ECP, CryptoPP::SHA256>;
+    const auto &key = castKey<CryptoPPPreparedKey<ECDSA::Verifier>>(publicKey);
+    return key.verifier.VerifyMessage(signedData, dataSize, signature.data(), signature.size());
+}
+
 } // PQB namespace
 
 /* END OF FILE */
\ No newline at end of file
@@ -29,6 +29,30 @@ extern "C"{
 
 namespace PQB{
 
+/**
+ * @brief Public key expanded to the form used by signature verification (for example decoded key in NTT domain).
+ * Created by SignAlgorithm::preparePublicKey() and accepted only by the same algorithm.
+ * Preparing the key costs about as much as one verification, so it pays off for keys that verify many signatures.
+ */
+class PreparedPublicKey{
+public:
+    virtual ~PreparedPublicKey() = default;
+};
+
+typedef std::shared_ptr<const PreparedPublicKey> PreparedPublicKeyPtr;
+
+/**
+ * @brief Private key expanded to the form used by signing (for example Falcon LDL tree), so it is not expanded for each
+ * signature. Created by SignAlgorithm::expandPrivateKey(), the key is securely wiped from memory when the object is destroyed.
+ * Algorithms without a faster signing path just keep a copy of the private key.
+ */
+class ExpandedPrivateKey{
+public:
+    virtual ~ExpandedPrivateKey() = default;
+};
+
+typedef std::shared_ptr<const ExpandedPrivateKey> ExpandedPrivateKeyPtr;
+
 /**
  * @brief Abstract class for signature algorithms, utilize methods that each signature algorithm has to implement
  * 
@@ -56,6 +80,29 @@ public:
      */
     virtual size_t sign(PQB::byteBuffer& signature, const PQB::byte* dataToSign, size_t dataSize, const PQB::byteBuffer& privateKey) = 0;
 
+    /**
+     * @brief Expand private key to the form used by signing, so it is not expanded by each sign() call
+     * 
+     * @param privateKey private key to expand
+     * @return ExpandedPrivateKeyPtr expanded private key
+     * 
+     * @exception PQB::Exceptions::Signer if private key is invalid
+     */
+    virtual ExpandedPrivateKeyPtr expandPrivateKey(const PQB::byteBuffer& privateKey);
+
+    /**
+     * @brief Sign data with expanded private key
+     * 
+     * @param signature output buffer for signature
+     * @param dataToSign pointer to the data
+     * @param dataSize size of the data
+     * @param privateKey private key expanded by expandPrivateKey() of this algorithm
+     * @return size_t length of the signature
+     * 
+     * @exception PQB::Exceptions::Signer if signing fails or private key was not expanded by this algorithm
+     */
+    virtual size_t sign(PQB::byteBuffer& signature, const PQB::byte* dataToSign, size_t dataSize, const ExpandedPrivateKey& privateKey);
+
     /**
      * @brief 
      * 
@@ -67,9 +114,40 @@ public:
      * @return false validation failure
      */
     virtual bool verify(const PQB::byteBuffer& signature, const PQB::byte* signedData, size_t dataSize, const PQB::byteBuffer& publicKey) = 0;
+
+    /**
+     * @brief Expand public key to the form used by verification, so it is not expanded by each verify() call
+     * 
+     * @param publicKey public key to prepare
+     * @return PreparedPublicKeyPtr prepared public key
+     * 
+     * @exception PQB::Exceptions::Signer if public key is invalid
+     */
+    virtual PreparedPublicKeyPtr preparePublicKey(const PQB::byteBuffer& publicKey) = 0;
+
+    /**
+     * @brief Verify signature with prepared public key
+     * 
+     * @param signature signature to be verified
+     * @param signedData pointer to the data which was signed
+     * @param dataSize size of the data
+     * @param publicKey public key prepared by preparePublicKey() of this algorithm
+     * @return true successful validation
+     * @return false validation failure
+     * 
+     * @exception PQB::Exceptions::Signer if public key was not prepared by this algorithm
+     */
+    virtual bool verify(const PQB::byteBuffer& signature, const PQB::byte* signedData, size_t dataSize, const PreparedPublicKey& publicKey) = 0;
     virtual size_t getPrivateKeySize() = 0;
     virtual size_t getPublicKeySize() = 0;
     virtual size_t getSignatureSize() = 0;
+
+    /// @brief Name of the implementation (build) of the algorithm, e.g. "PQClean AVX2" or "PQClean clean" (chosen by CPU features)
+    virtual std::string getImplementation() { return "Crypto++"; }
+
+    /// @brief Check if the CPU supports all instructions used by the implementation of the algorithm
+    virtual bool isSupportedByCPU() { return true; }
+
     virtual ~SignAlgorithm() = default;
 };
 
@@ -82,6 +160,7 @@ typedef std::shared_ptr<SignAlgorithm> SignAlgorithmPtr;
  *
  * 
  * @note The algorithm is chosen by first invocation of GetInstance(chosenAlgorithm) method, by default is used algorithm Falcon-1024.
+ * If the algorithm is fixed at compile time (SIGN_ALGORITHM CMake option), only this algorithm can be chosen.
  * 
  * 
  */
@@ -98,115 +177,211 @@ public:
      * After first call this parameter makes no other difference in returned digital signature algorithm.
      * @return SignAlgorithmPtr Instance of choosen digital signature algorithm
      */
+#ifdef PQB_SIGN_ALGORITHM_NAME
+    static SignAlgorithmPtr GetInstance(std::string chosenAlgorithm = PQB_SIGN_ALGORITHM_NAME);
+#else
     static SignAlgorithmPtr GetInstance(std::string chosenAlgorithm = "falcon1024");
+#endif
 };
 
 
-class Falcon1024 : public SignAlgorithm{
+class Falcon1024 final : public SignAlgorithm{
 public:
     void genKeys(PQB::byteBuffer& privateKey, PQB::byteBuffer& publicKey) override;
     size_t sign(PQB::byteBuffer& signature, const PQB::byte* dataToSign, size_t dataSize, const PQB::byteBuffer& privateKey) override;
+    ExpandedPrivateKeyPtr expandPrivateKey(const PQB::byteBuffer& privateKey) override;
+    size_t sign(PQB::byteBuffer& signature, const PQB::byte* dataToSign, size_t dataSize, const ExpandedPrivateKey& privateKey) override;
     bool verify(const PQB::byteBuffer& signature, const PQB::byte* signedData, size_t dataSize, const PQB::byteBuffer& publicKey) override;
+    PreparedPublicKeyPtr preparePublicKey(const PQB::byteBuffer& publicKey) override;
+    bool verify(const PQB::byteBuffer& signature, const PQB::byte* signedData, size_t dataSize, const PreparedPublicKey& publicKey) override;
     size_t getPrivateKeySize() override { return privateKeySize; }
     size_t getPublicKeySize() override { return publicKeySize; }
     size_t getSignatureSize() override { return signatureSize; }
-private:
+    std::string getImplementation() override;
+
     static constexpr size_t privateKeySize = PQCLEAN_FALCON1024_AVX2_CRYPTO_SECRETKEYBYTES;
     static constexpr size_t publicKeySize = PQCLEAN_FALCON1024_AVX2_CRYPTO_PUBLICKEYBYTES;
     static constexpr size_t signatureSize = PQCLEAN_FALCON1024_AVX2_CRYPTO_BYTES;
+private:
+    static constexpr size_t preparedPublicKeySize = PQCLEAN_FALCON1024_AVX2_CRYPTO_PREPAREDPKBYTES;
+    static constexpr size_t expandedPrivateKeySize = PQCLEAN_FALCON1024_AVX2_CRYPTO_EXPANDEDSKBYTES;
 };
 
 
-class Falcon512 : public SignAlgorithm{
+class Falcon512 final : public SignAlgorithm{
 public:
     void genKeys(PQB::byteBuffer& privateKey, PQB::byteBuffer& publicKey) override;
     size_t sign(PQB::byteBuffer& signature, const PQB::byte* dataToSign, size_t dataSize, const PQB::byteBuffer& privateKey) override;
+    ExpandedPrivateKeyPtr expandPrivateKey(const PQB::byteBuffer& privateKey) override;
+    size_t sign(PQB::byteBuffer& signature, const PQB::byte* dataToSign, size_t dataSize, const ExpandedPrivateKey& privateKey) override;
     bool verify(const PQB::byteBuffer& signature, const PQB::byte* signedData, size_t dataSize, const PQB::byteBuffer& publicKey) override;
+    PreparedPublicKeyPtr preparePublicKey(const PQB::byteBuffer& publicKey) override;
+    bool verify(const PQB::byteBuffer& signature, const PQB::byte* signedData, size_t dataSize, const PreparedPublicKey& publicKey) override;
     size_t getPrivateKeySize() override { return privateKeySize; }
     size_t getPublicKeySize() override { return publicKeySize; }
     size_t getSignatureSize() override { return signatureSize; }
-private:
+    std::string getImplementation() override;
+
     static constexpr size_t privateKeySize = PQCLEAN_FALCON512_AVX2_CRYPTO_SECRETKEYBYTES;
     static constexpr size_t publicKeySize = PQCLEAN_FALCON512_AVX2_CRYPTO_PUBLICKEYBYTES;
     static constexpr size_t signatureSize = PQCLEAN_FALCON512_AVX2_CRYPTO_BYTES;
+private:
+    static constexpr size_t preparedPublicKeySize = PQCLEAN_FALCON512_AVX2_CRYPTO_PREPAREDPKBYTES;
+    static constexpr size_t expandedPrivateKeySize = PQCLEAN_FALCON512_AVX2_CRYPTO_EXPANDEDSKBYTES;
 };
 
 
-class Dilithium5 : public SignAlgorithm{
+class Dilithium5 final : public SignAlgorithm{
 public:
+    using SignAlgorithm::sign;
     void genKeys(PQB::byteBuffer& privateKey, PQB::byteBuffer& publicKey) override;
     size_t sign(PQB::byteBuffer& signature, const PQB::byte* dataToSign, size_t dataSize, const PQB::byteBuffer& privateKey) override;
     bool verify(const PQB::byteBuffer& signature, const PQB::byte* signedData, size_t dataSize, const PQB::byteBuffer& publicKey) override;
+    PreparedPublicKeyPtr preparePublicKey(const PQB::byteBuffer& publicKey) override;
+    bool verify(const PQB::byteBuffer& signature, const PQB::byte* signedData, size_t dataSize, const PreparedPublicKey& publicKey) override;
     size_t getPrivateKeySize() override { return privateKeySize; }
     size_t getPublicKeySize() override { return publicKeySize; }
     size_t getSignatureSize() override { return signatureSize; }
-private:
+    std::string getImplementation() override;
+
     static constexpr size_t privateKeySize = PQCLEAN_DILITHIUM5_AVX2_CRYPTO_SECRETKEYBYTES;
     static constexpr size_t publicKeySize = PQCLEAN_DILITHIUM5_AVX2_CRYPTO_PUBLICKEYBYTES;
     static constexpr size_t signatureSize = PQCLEAN_DILITHIUM5_AVX2_CRYPTO_BYTES;
+private:
+    static constexpr size_t preparedPublicKeySize = PQCLEAN_DILITHIUM5_AVX2_CRYPTO_PREPAREDPKBYTES;
 };
 
 
-class Dilithium3 : public SignAlgorithm{
+class Dilithium3 final : public SignAlgorithm{
 public:
+    using SignAlgorithm::sign;
     void genKeys(PQB::byteBuffer& privateKey, PQB::byteBuffer& publicKey) override;
     size_t sign(PQB::byteBuffer& signature, const PQB::byte* dataToSign, size_t dataSize, const PQB::byteBuffer& privateKey) override;
     bool verify(const PQB::byteBuffer& signature, const PQB::byte* signedData, size_t dataSize, const PQB::byteBuffer& publicKey) override;
+    PreparedPublicKeyPtr preparePublicKey(const PQB::byteBuffer& publicKey) override;
+    bool verify(const PQB::byteBuffer& signature, const PQB::byte* signedData, size_t dataSize, const PreparedPublicKey& publicKey) override;
     size_t getPrivateKeySize() override { return privateKeySize; }
     size_t getPublicKeySize() override { return publicKeySize; }
     size_t getSignatureSize() override { return signatureSize; }
-private:
+    std::string getImplementation() override;
+
     static constexpr size_t privateKeySize = PQCLEAN_DILITHIUM3_AVX2_CRYPTO_SECRETKEYBYTES;
     static constexpr size_t publicKeySize = PQCLEAN_DILITHIUM3_AVX2_CRYPTO_PUBLICKEYBYTES;
     static constexpr size_t signatureSize = PQCLEAN_DILITHIUM3_AVX2_CRYPTO_BYTES;
+private:
+    static constexpr size_t preparedPublicKeySize = PQCLEAN_DILITHIUM3_AVX2_CRYPTO_PREPAREDPKBYTES;
 };
 
 
-class Dilithium2 : public SignAlgorithm{
+class Dilithium2 final : public SignAlgorithm{
 public:
+    using SignAlgorithm::sign;
     void genKeys(PQB::byteBuffer& privateKey, PQB::byteBuffer& publicKey) override;
     size_t sign(PQB::byteBuffer& signature, const PQB::byte* dataToSign, size_t dataSize, const PQB::byteBuffer& privateKey) override;
     bool verify(const PQB::byteBuffer& signature, const PQB::byte* signedData, size_t dataSize, const PQB::byteBuffer& publicKey) override;
+    PreparedPublicKeyPtr preparePublicKey(const PQB::byteBuffer& publicKey) override;
+    bool verify(const PQB::byteBuffer& signature, const PQB::byte* signedData, size_t dataSize, const PreparedPublicKey& publicKey) override;
     size_t getPrivateKeySize() override { return privateKeySize; }
     size_t getPublicKeySize() override { return publicKeySize; }
     size_t getSignatureSize() override { return signatureSize; }
-private:
+    std::string getImplementation() override;
+
     static constexpr size_t privateKeySize = PQCLEAN_DILITHIUM2_AVX2_CRYPTO_SECRETKEYBYTES;
     static constexpr size_t publicKeySize = PQCLEAN_DILITHIUM2_AVX2_CRYPTO_PUBLICKEYBYTES;
     static constexpr size_t signatureSize = PQCLEAN_DILITHIUM2_AVX2_CRYPTO_BYTES;
+private:
+    static constexpr size_t preparedPublicKeySize = PQCLEAN_DILITHIUM2_AVX2_CRYPTO_PREPAREDPKBYTES;
 };
 
 
-class Ed25519 : public SignAlgorithm{
+class Ed25519 final : public SignAlgorithm{
 public:
+    using SignAlgorithm::sign;
     void genKeys(PQB::byteBuffer& privateKey, PQB::byteBuffer& publicKey) override;
     size_t sign(PQB::byteBuffer& signature, const PQB::byte* dataToSign, size_t dataSize, const PQB::byteBuffer& privateKey) override;
     bool verify(const PQB::byteBuffer& signature, const PQB::byte* signedData, size_t dataSize, const PQB::byteBuffer& publicKey) override;
+    PreparedPublicKeyPtr preparePublicKey(const PQB::byteBuffer& publicKey) override;
+    bool verify(const PQB::byteBuffer& signature, const PQB::byte* signedData, size_t dataSize, const PreparedPublicKey& publicKey) override;
     size_t getPrivateKeySize() override { return privateKeySize; }
     size_t getPublicKeySize() override { return publicKeySize; }
     size_t getSignatureSize() override { return signatureSize; }
-private:
+
     static constexpr size_t privateKeySize = CryptoPP::ed25519PrivateKey::SECRET_KEYLENGTH;
     static constexpr size_t publicKeySize = CryptoPP::ed25519PublicKey::PUBLIC_KEYLENGTH;
     static constexpr size_t signatureSize = CryptoPP::ed25519PrivateKey::SIGNATURE_LENGTH;
 };
 
 
-class ECDSA : public SignAlgorithm{
+class ECDSA final : public SignAlgorithm{
 public:
+    using SignAlgorithm::sign;
     void genKeys(PQB::byteBuffer& privateKey, PQB::byteBuffer& publicKey) override;
     size_t sign(PQB::byteBuffer& signature, const PQB::byte* dataToSign, size_t dataSize, const PQB::byteBuffer& privateKey) override;
     bool verify(const PQB::byteBuffer& signature, const PQB::byte* signedData, size_t dataSize, const PQB::byteBuffer& publicKey) override;
+    PreparedPublicKeyPtr preparePublicKey(const PQB::byteBuffer& publicKey) override;
+    bool verify(const PQB::byteBuffer& signature, const PQB::byte* signedData, size_t dataSize, const PreparedPublicKey& publicKey) override;
     size_t getPrivateKeySize() override { return privateKeySize; }
     size_t getPublicKeySize() override { return publicKeySize; }
     size_t getSignatureSize() override { return signatureSize; }
-private:
+
     static constexpr size_t privateKeySize = 32;
     static constexpr size_t publicKeySize = 33;
     static constexpr size_t signatureSize = 64; // CryptoPP::ECDSA<CryptoPP::ECP, CryptoPP::SHA256>::Signer::MaxSignatureLength();
 };
 
 
+
+/**
+ * @brief Signature algorithm fixed at compile time (for example StaticSigner<Falcon512>). Calls through get() are not
+ * virtual (the algorithm classes are final) and sizes of keys and signatures are compile time constants.
+ *
+ * @tparam Algorithm class of the signature algorithm
+ */
+template <class Algorithm>
+class StaticSigner{
+public:
+    StaticSigner() = delete;
+
+    /// @brief Get the signature algorithm
+    static Algorithm &get(){
+        static Algorithm algorithm;
+        return algorithm;
+    }
+
+    static constexpr size_t getPrivateKeySize() { return Algorithm::privateKeySize; }
+    static constexpr size_t getPublicKeySize() { return Algorithm::publicKeySize; }
+    static constexpr size_t getSignatureSize() { return Algorithm::signatureSize; }
+};
+
+
+/**
+ * @brief Signature algorithm chosen at runtime by Signer::GetInstance(), with the same interface as StaticSigner.
+ * get() returns reference to the chosen algorithm, so hot paths do not copy shared pointer.
+ */
+class RuntimeSigner{
+public:
+    RuntimeSigner() = delete;
+
+    /// @brief Get the signature algorithm (chooses the default algorithm if Signer::GetInstance() was not called yet)
+    static SignAlgorithm &get(){
+        static SignAlgorithm &algorithm = *Signer::GetInstance();
+        return algorithm;
+    }
+
+    static size_t getPrivateKeySize() { return get().getPrivateKeySize(); }
+    static size_t getPublicKeySize() { return get().getPublicKeySize(); }
+    static size_t getSignatureSize() { return get().getSignatureSize(); }
+};
+
+
+/// @brief Signature algorithm used by the program, fixed at compile time by the SIGN_ALGORITHM CMake option or chosen at runtime
+#ifdef PQB_SIGN_ALGORITHM
+using ChosenSigner = StaticSigner<PQB_SIGN_ALGORITHM>;
+#else
+using ChosenSigner = RuntimeSigner;
+#endif
+
+
 } // PQB namespace
 
 
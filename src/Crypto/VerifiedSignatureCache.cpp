@@ -0,0 +1,114 @@
+/**
+ * @file VerifiedSignatureCache.cpp
+ * @author Michal Ľaš
+ * @brief Bounded lock-free cache of already verified signatures
+ * @date 2024-05-07
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+#include <cstring>
+#include <cryptopp/sha.h>
+#include "VerifiedSignatureCache.hpp"
+#include "HashManager.hpp"
+
+
+namespace PQB{
+
+    VerifiedSignatureCache::VerifiedSignatureCache(size_t capacity){
+        size_t slotCount = 2;
+        while (slotCount < capacity){
+            slotCount <<= 1;
+        }
+        mask = slotCount - 1;
+        slots = std::make_unique<Slot[]>(slotCount);
+        for (size_t i = 0; i < slotCount; i++){
+            slots[i].version.store(0, std::memory_order_relaxed);
+            for (auto &word : slots[i].words){
+                word.store(0, std::memory_order_relaxed);
+            }
+        }
+        hits = 0;
+        misses = 0;
+    }
+
+    VerifiedSignatureCache::Entry VerifiedSignatureCache::createEntry(const PQB::byte *signedData, size_t dataSize,
+                                                                      const byteBuffer &signature, const byteId_t &publicKeyHash){
+        // entry has 32 bytes, so it does not depend on the size of identifiers (byteId_t has 32 bytes with SHORT_IDS)
+        Entry entry;
+        PQB::byte digest[sizeof(entry.words)];
+        CryptoPP::SHA512 sha512Hash;
+        sha512Hash.Update(signedData, dataSize);
+        sha512Hash.Update(signature.data(), signature.size());
+        sha512Hash.Update(publicKeyHash.data(), publicKeyHash.size());
+        sha512Hash.TruncatedFinal(digest, sizeof(digest));
+        std::memcpy(entry.words, digest, sizeof(entry.words));
+        return entry;
+    }
+
+    VerifiedSignatureCache::Entry VerifiedSignatureCache::createEntry(const PQB::byte *signedData, size_t dataSize,
+                                                                      const byteBuffer &signature, const byteBuffer &publicKey){
+        byteId_t publicKeyHash;
+        HashMan::SHA512_hash(&publicKeyHash, publicKey.data(), publicKey.size());
+        return createEntry(signedData, dataSize, signature, publicKeyHash);
+    }
+
+    bool VerifiedSignatureCache::contains(const Entry &entry){
+        Entry stored;
+        if ((readSlot(slots[firstSlot(entry)], stored) && stored == entry) ||
+            (readSlot(slots[secondSlot(entry)], stored) && stored == entry)){
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void VerifiedSignatureCache::insert(const Entry &entry){
+        Slot &first = slots[firstSlot(entry)];
+        Slot &second = slots[secondSlot(entry)];
+        Entry stored;
+        if (readSlot(first, stored) && stored == entry)
+            return;
+        if (readSlot(second, stored) && stored == entry)
+            return;
+        // prefer empty slot, else overwrite one of the slots (chosen by the entry, so it is deterministic but spread)
+        if (first.version.load(std::memory_order_relaxed) == 0){
+            writeSlot(first, entry);
+        } else if (second.version.load(std::memory_order_relaxed) == 0){
+            writeSlot(second, entry);
+        } else {
+            writeSlot((entry.words[2] & 1) ? first : second, entry);
+        }
+    }
+
+    bool VerifiedSignatureCache::readSlot(const Slot &slot, Entry &entry) const{
+        uint64_t versionBefore = slot.version.load(std::memory_order_acquire);
+        if (versionBefore == 0 || (versionBefore & 1)){
+            return false;
+        }
+        for (size_t i = 0; i < 4; i++){
+            entry.words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return (slot.version.load(std::memory_order_relaxed) == versionBefore);
+    }
+
+    bool VerifiedSignatureCache::writeSlot(Slot &slot, const Entry &entry){
+        uint64_t version = slot.version.load(std::memory_order_relaxed);
+        if ((version & 1) || !slot.version.compare_exchange_strong(version, version + 1, std::memory_order_acquire)){
+            return false; // other thread is writing this slot, this entry is just not cached
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < 4; i++){
+            slot.words[i].store(entry.words[i], std::memory_order_relaxed);
+        }
+        slot.version.store(version + 2, std::memory_order_release);
+        return true;
+    }
+
+} // namespace PQB
+
+/* END OF FILE */
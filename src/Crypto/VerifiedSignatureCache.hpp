@@ -0,0 +1,136 @@
+/**
+ * @file VerifiedSignatureCache.hpp
+ * @author Michal Ľaš
+ * @brief Bounded lock-free cache of already verified signatures
+ * @date 2024-05-07
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include "PQBtypedefs.hpp"
+#include "Blob.hpp"
+
+
+namespace PQB{
+
+
+/**
+ * @brief Cache remembering signatures which already passed SignAlgorithm::verify(), so the same transaction or proposal
+ * received multiple times (gossip, proposals of other peers, block import) is not verified again.
+ *
+ * An entry is 256 bits of SHA-512 hash of signed data (transaction ID), the signature, and SHA-512 hash of the signer's
+ * public key. The signature is part of the entry, so a transaction with known ID but different (invalid) signature
+ * is not found in the cache.
+ *
+ * The cache has fixed number of slots and each entry can be stored in one of two slots. If both slots are occupied an older
+ * entry is overwritten. Slots are guarded by sequence numbers (seqlock), so lookups and insertions from more threads do not
+ * need any lock. A lookup that meets concurrent write just returns false (signature is then verified again).
+ */
+class VerifiedSignatureCache{
+public:
+
+    /// @brief Key of a cache entry
+    struct Entry{
+        uint64_t words[4];
+
+        bool operator==(const Entry &other) const {
+            return (words[0] == other.words[0] && words[1] == other.words[1] &&
+                    words[2] == other.words[2] && words[3] == other.words[3]);
+        }
+    };
+
+    /// @brief Hash of an entry for unordered containers (entry is already a hash)
+    struct EntryHash{
+        size_t operator()(const Entry &entry) const {
+            return entry.words[0];
+        }
+    };
+
+    /// @brief Default number of slots in the cache
+    static constexpr size_t DEFAULT_CAPACITY = 65536;
+
+    /**
+     * @brief Construct a new Verified Signature Cache object
+     *
+     * @param capacity number of slots in the cache (rounded up to power of two)
+     */
+    VerifiedSignatureCache(size_t capacity = DEFAULT_CAPACITY);
+
+    VerifiedSignatureCache(const VerifiedSignatureCache &) = delete;
+    void operator=(const VerifiedSignatureCache &) = delete;
+
+    /**
+     * @brief Create cache entry for a signature
+     *
+     * @param signedData pointer to the signed data (for example transaction ID)
+     * @param dataSize size of the signed data
+     * @param signature signature of the data
+     * @param publicKeyHash SHA-512 hash of the signer's public key
+     * @return Entry cache entry
+     */
+    static Entry createEntry(const PQB::byte *signedData, size_t dataSize, const byteBuffer &signature, const byteId_t &publicKeyHash);
+
+    /// @brief Create cache entry for a signature, the public key is hashed by this method
+    static Entry createEntry(const PQB::byte *signedData, size_t dataSize, const byteBuffer &signature, const byteBuffer &publicKey);
+
+    /// @brief Check if the entry is in the cache (signature was already verified)
+    bool contains(const Entry &entry);
+
+    /// @brief Insert an entry to the cache (call it only after successful verification of the signature)
+    void insert(const Entry &entry);
+
+    /// @brief Get number of lookups that found the entry in the cache
+    size_t getNumberOfHits() const {
+        return hits.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Get number of lookups that did not find the entry in the cache
+    size_t getNumberOfMisses() const {
+        return misses.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Get number of slots of the cache
+    size_t getCapacity() const {
+        return mask + 1;
+    }
+
+private:
+
+    /// @brief One slot of the cache. Version is odd while the slot is being written, zero if the slot was never written.
+    struct Slot{
+        std::atomic<uint64_t> version;
+        std::atomic<uint64_t> words[4];
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask; ///< capacity - 1
+
+    std::atomic<size_t> hits;
+    std::atomic<size_t> misses;
+
+    /// @brief Indexes of two slots where the entry can be stored
+    size_t firstSlot(const Entry &entry) const {
+        return entry.words[0] & mask;
+    }
+    size_t secondSlot(const Entry &entry) const {
+        return entry.words[1] & mask;
+    }
+
+    /// @brief Read entry from a slot, return false if slot is empty or it is being written
+    bool readSlot(const Slot &slot, Entry &entry) const;
+
+    /// @brief Write entry to a slot, return false if other thread is writing the slot
+    bool writeSlot(Slot &slot, const Entry &entry);
+};
+
+
+} // namespace PQB
+
+/* END OF FILE */
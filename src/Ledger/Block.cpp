@@ -15,8 +15,8 @@
 
 namespace PQB{
 
-    byte64_t BlockHeader::getBlockHash() const{
-        byte64_t blockHash;
+    byteId_t BlockHeader::getBlockHash() const{
+        byteId_t blockHash;
         byteBuffer buffer;
         size_t offset = 0;
         buffer.resize(getSize());
@@ -30,6 +30,7 @@ namespace PQB{
                sizeof(sequence) +
                sizeof(size) +
                sizeof(transactionsMerkleRootHash) +
+               sizeof(signaturesMerkleRootHash) +
                sizeof(previousBlockHash) +
                sizeof(accountBalanceMerkleRootHash);
     }
@@ -40,6 +41,8 @@ namespace PQB{
         if (!skipChecks){
             if (transactionsMerkleRootHash.IsNull())
                 throw PQB::Exceptions::Block("Serialization: Missing block's transactionsMerkleRootHash");
+            if (signaturesMerkleRootHash.IsNull())
+                throw PQB::Exceptions::Block("Serialization: Missing block's signaturesMerkleRootHash");
             if (previousBlockHash.IsNull())
                 throw PQB::Exceptions::Block("Serialization: Missing block's previousBlockHash");
             if (accountBalanceMerkleRootHash.IsNull())
@@ -49,6 +52,7 @@ namespace PQB{
         serializeField(buffer, offset, sequence);
         serializeField(buffer, offset, size);
         serializeField(buffer, offset, transactionsMerkleRootHash);
+        serializeField(buffer, offset, signaturesMerkleRootHash);
         serializeField(buffer, offset, previousBlockHash);
         serializeField(buffer, offset, accountBalanceMerkleRootHash);
     }
@@ -60,6 +64,7 @@ namespace PQB{
         deserializeField(buffer, offset, sequence);
         deserializeField(buffer, offset, size);
         deserializeField(buffer, offset, transactionsMerkleRootHash);
+        deserializeField(buffer, offset, signaturesMerkleRootHash);
         deserializeField(buffer, offset, previousBlockHash);
         deserializeField(buffer, offset, accountBalanceMerkleRootHash);
     }
@@ -69,46 +74,89 @@ namespace PQB{
         transactionCount++;
     }
 
-    size_t BlockBody::getSize() const{
+    bool BlockBody::hasSignatures() const{
+        for (const auto &tx : txSet){
+            if (tx->signatureSize == 0)
+                return false;
+        }
+        return true;
+    }
+
+    size_t BlockBody::getSize(bool withSignatures) const{
         size_t txSetSize = 0;
         for (const auto &tx : txSet){
-            txSetSize += tx->getSize();
+            txSetSize += tx->getDataSize();
+        }
+        if (withSignatures){
+            txSetSize += getSignaturesSize();
         }
-        return txSetSize + sizeof(transactionCount);
+        return txSetSize + sizeof(transactionCount) + sizeof(uint8_t);
     }
 
-    void BlockBody::serialize(byteBuffer &buffer, size_t &offset) const{
-        if ((buffer.size() - offset) < getSize())
+    size_t BlockBody::getSignaturesSize() const{
+        size_t signaturesSize = 0;
+        for (const auto &tx : txSet){
+            signaturesSize += tx->getWitnessSize();
+        }
+        return signaturesSize;
+    }
+
+    void BlockBody::serialize(byteBuffer &buffer, size_t &offset, bool withSignatures) const{
+        if ((buffer.size() - offset) < getSize(withSignatures))
             throw PQB::Exceptions::Block("Serialization: buffer size is too small for serialization");
         serializeField(buffer, offset, transactionCount);
         for (const auto &tx : txSet){
-            tx->serialize(buffer, offset);
+            tx->serializeData(buffer, offset);
+        }
+        uint8_t signaturesIncluded = withSignatures ? 1 : 0;
+        serializeField(buffer, offset, signaturesIncluded);
+        if (withSignatures){
+            serializeSignatures(buffer, offset);
         }
     }
 
-    void BlockBody::deserialize(const byteBuffer &buffer, size_t &offset){
+    void BlockBody::deserialize(const byteBuffer &buffer, size_t &offset, bool withSignatures){
         if ((buffer.size() - offset) < sizeof(transactionCount))
             throw PQB::Exceptions::Block("Deserialization: buffer size is too small for deserialization");
         deserializeField(buffer, offset, transactionCount);
         for (size_t i = 0; i < transactionCount; i++){
             TransactionPtr tx = std::make_shared<Transaction>();
-            tx->deserialize(buffer, offset);
+            tx->deserializeData(buffer, offset);
             txSet.insert(tx);
         }
+        uint8_t signaturesIncluded;
+        if ((buffer.size() - offset) < sizeof(signaturesIncluded))
+            throw PQB::Exceptions::Block("Deserialization: buffer size is too small for deserialization");
+        deserializeField(buffer, offset, signaturesIncluded);
+        if (signaturesIncluded && withSignatures){
+            deserializeSignatures(buffer, offset);
+        }
+    }
+
+    void BlockBody::serializeSignatures(byteBuffer &buffer, size_t &offset) const{
+        for (const auto &tx : txSet){
+            tx->serializeWitness(buffer, offset);
+        }
+    }
+
+    void BlockBody::deserializeSignatures(const byteBuffer &buffer, size_t &offset){
+        for (const auto &tx : txSet){
+            tx->deserializeWitness(buffer, offset);
+        }
     }
 
-    size_t Block::getSize() const{
-        return BlockHeader::getSize() + BlockBody::getSize();
+    size_t Block::getSize(bool withSignatures) const{
+        return BlockHeader::getSize() + BlockBody::getSize(withSignatures);
     }
 
-    void Block::serialize(byteBuffer &buffer, size_t &offset) const{
+    void Block::serialize(byteBuffer &buffer, size_t &offset, bool withSignatures) const{
         BlockHeader::serialize(buffer, offset);
-        BlockBody::serialize(buffer, offset);
+        BlockBody::serialize(buffer, offset, withSignatures);
     }
 
-    void Block::deserialize(const byteBuffer &buffer, size_t &offset){
+    void Block::deserialize(const byteBuffer &buffer, size_t &offset, bool withSignatures){
         BlockHeader::deserialize(buffer, offset);
-        BlockBody::deserialize(buffer, offset);
+        BlockBody::deserialize(buffer, offset, withSignatures);
     }
 
 
@@ -31,9 +31,10 @@ public:
     uint32_t version;                       ///< Version of the block
     uint32_t sequence;                      ///< Sequence number (block height)
     uint32_t size;                          ///< Block size in bytes
-    byte64_t transactionsMerkleRootHash;    ///< Merkle root hash of the block's transactions
-    byte64_t previousBlockHash;             ///< Hash of the previous block
-    byte64_t accountBalanceMerkleRootHash;  ///< Hash of the account balances
+    byteId_t transactionsMerkleRootHash;    ///< Merkle root hash of the block's transactions
+    byteId_t signaturesMerkleRootHash;      ///< Merkle root hash of the witnesses (signatures) of the block's transactions
+    byteId_t previousBlockHash;             ///< Hash of the previous block
+    byteId_t accountBalanceMerkleRootHash;  ///< Hash of the account balances
 
     BlockHeader(){
         setNull();
@@ -44,6 +45,7 @@ public:
         version = 0;
         sequence = 0;
         transactionsMerkleRootHash.SetNull();
+        signaturesMerkleRootHash.SetNull();
         previousBlockHash.SetNull();
         accountBalanceMerkleRootHash.SetNull();
         size = 0;
@@ -51,7 +53,7 @@ public:
 
     /// @brief Get the Hash of block's header
     /// @return SHA-512 hash of the block
-    byte64_t getBlockHash() const;
+    byteId_t getBlockHash() const;
 
     /// @brief Get size of the BlockHeader in bytes
     static size_t getSize();
@@ -61,7 +63,7 @@ public:
     /// @param offset offset to the buffer
     /// @param skipChecks flag telling if there should be made checks if all importatant fields are filled (default is false)
     /// @exception if buffer has not enough size for the block serialization or when `skipChecks` is set to true if important fields are not 
-    /// specified (such as transactionsMerkleRootHash, previousBlockHash, and accountBalanceMerkleRootHash)
+    /// specified (such as transactionsMerkleRootHash, signaturesMerkleRootHash, previousBlockHash, and accountBalanceMerkleRootHash)
     void serialize(byteBuffer &buffer, size_t &offset, bool skipChecks = false) const;
 
     /// @brief Deserialize BlockHeader
@@ -71,6 +73,14 @@ public:
 };
 
 
+/**
+ * @brief Body of a block
+ * 
+ * Body is serialized as a data section (transactionCount and data parts of all transactions) followed by a flag telling
+ * if the signatures section is included and by the signatures section (witnesses of transactions in order of txSet).
+ * Signatures are committed by BlockHeader::signaturesMerkleRootHash, so they can be stored separately, not loaded
+ * for already validated blocks or pruned.
+ */
 class BlockBody
 {
 public:
@@ -90,20 +100,37 @@ public:
     /// @brief Add a transaction to txSet
     void addTransaction(TransactionPtr tx);
 
+    /// @brief Check if all transactions of the body have their signatures (they were not skipped or pruned)
+    bool hasSignatures() const;
+
     /// @brief Get size of the BlockBody in bytes
-    size_t getSize() const;
+    /// @param withSignatures if false, size of the body without the signatures section is returned
+    size_t getSize(bool withSignatures = true) const;
+
+    /// @brief Get size of the signatures section in bytes
+    size_t getSignaturesSize() const;
 
     /// @brief Serialize BlockBody
     /// @param buffer buffer for serialization
     /// @param offset offset to the buffer
+    /// @param withSignatures if false, the signatures section is not serialized
     /// @exception if buffer has not enough size for the block serialization
-    void serialize(byteBuffer &buffer, size_t &offset) const;
+    void serialize(byteBuffer &buffer, size_t &offset, bool withSignatures = true) const;
 
     /// @brief Deserialize BlockBody
     /// @param buffer buffer with serialized data
     /// @param offset offset to the buffer
+    /// @param withSignatures if false, the signatures section is skipped (transactions have no signatures)
     /// @exception if buffer has not enough size for the block deserialization
-    void deserialize(const byteBuffer &buffer, size_t &offset);
+    void deserialize(const byteBuffer &buffer, size_t &offset, bool withSignatures = true);
+
+    /// @brief Serialize the signatures section (witnesses of all transactions in order of txSet)
+    /// @exception if buffer has not enough size or some transaction has no signature
+    void serializeSignatures(byteBuffer &buffer, size_t &offset) const;
+
+    /// @brief Deserialize the signatures section into transactions of txSet
+    /// @exception if buffer has not enough size for the signatures
+    void deserializeSignatures(const byteBuffer &buffer, size_t &offset);
 
 };
 
@@ -131,6 +158,7 @@ public:
         hdr.version = version;
         hdr.sequence = sequence;
         hdr.transactionsMerkleRootHash = transactionsMerkleRootHash;
+        hdr.signaturesMerkleRootHash = signaturesMerkleRootHash;
         hdr.previousBlockHash = previousBlockHash;
         hdr.accountBalanceMerkleRootHash = accountBalanceMerkleRootHash;
         hdr.size = size;
@@ -142,25 +170,29 @@ public:
         version = hdr->version;
         sequence = hdr->sequence;
         transactionsMerkleRootHash = hdr->transactionsMerkleRootHash;
+        signaturesMerkleRootHash = hdr->signaturesMerkleRootHash;
         previousBlockHash = hdr->previousBlockHash;
         accountBalanceMerkleRootHash = hdr->accountBalanceMerkleRootHash;
         size = hdr->size;
     }
 
     /// @brief Get size of the Block in bytes
-    size_t getSize() const;
+    /// @param withSignatures if false, size of the block without the signatures section is returned
+    size_t getSize(bool withSignatures = true) const;
 
     /// @brief Serialize Block
     /// @param buffer buffer for serialization
     /// @param offset offset to the buffer
-    /// @exception if buffer has not enough size for the block serialization or importnat fields in BlockHeader are not specified (such as transactionsMerkleRootHash, previousBlockHash, and accountBalanceMerkleRootHash)
-    void serialize(byteBuffer &buffer, size_t &offset) const;
+    /// @param withSignatures if false, the signatures section is not serialized
+    /// @exception if buffer has not enough size for the block serialization or importnat fields in BlockHeader are not specified (such as transactionsMerkleRootHash, signaturesMerkleRootHash, previousBlockHash, and accountBalanceMerkleRootHash)
+    void serialize(byteBuffer &buffer, size_t &offset, bool withSignatures = true) const;
 
     /// @brief Deserialize Block
     /// @param buffer buffer with serialized data
     /// @param offset offset to the buffer
+    /// @param withSignatures if false, the signatures section is skipped (transactions have no signatures)
     /// @exception if buffer has not enough size for the block deserialization
-    void deserialize(const byteBuffer &buffer, size_t &offset);
+    void deserialize(const byteBuffer &buffer, size_t &offset, bool withSignatures = true);
 };
 
 
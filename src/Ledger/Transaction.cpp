@@ -19,13 +19,29 @@ namespace PQB{
         if (versionNumber == 0 ||
             sequenceNumber == 0 ||
             senderWalletAddress.IsNull() ||
-            receiverWalletAddress.IsNull() ||
             IDHash.IsNull() ||
             signature.size() == 0 ||
             signatureSize == 0){
                 return false;
             }
-        return true;
+        if (isBatchSigned() && (batchPath.size() > MAX_TX_BATCH_DEPTH || (batchIndex >> batchPath.size()) != 0)){
+            return false;
+        }
+        if (!isMultiPayment()){
+            return !receiverWalletAddress.IsNull();
+        }
+        if (outputs.empty() || outputs.size() > MAX_TX_OUTPUTS){
+            return false;
+        }
+        // cashAmount has to be the sum of outputs (it is used for balance checks of the sender)
+        uint64_t sum = 0;
+        for (const auto &output : outputs){
+            if (output.receiverWalletAddress.IsNull()){
+                return false;
+            }
+            sum += output.cashAmount;
+        }
+        return sum == cashAmount;
     }
 
     void Transaction::setHash(){
@@ -39,64 +55,185 @@ namespace PQB{
     void Transaction::sign(byteBuffer &privateKey){
         if (IDHash.IsNull())
             throw PQB::Exceptions::Transaction("Sign: transaction does not have an ID!");
-        SignAlgorithmPtr s = Signer::GetInstance();
-        signatureSize = s->sign(signature, IDHash.data(), IDHash.size(), privateKey);
+        auto &s = ChosenSigner::get();
+        byteId_t signedHash = getSignedHash();
+        signatureSize = s.sign(signature, signedHash.data(), signedHash.size(), privateKey);
+
+    }
+
+    void Transaction::sign(const ExpandedPrivateKey &privateKey){
+        if (IDHash.IsNull())
+            throw PQB::Exceptions::Transaction("Sign: transaction does not have an ID!");
+        auto &s = ChosenSigner::get();
+        byteId_t signedHash = getSignedHash();
+        signatureSize = s.sign(signature, signedHash.data(), signedHash.size(), privateKey);
+    }
 
+    byteId_t Transaction::getSignedHash() const{
+        if (!isBatchSigned()){
+            return IDHash;
+        }
+        // the same computation as in ComputeMerkleRoot(), index of the node on each level says if it is left or right child
+        byteId_t node = IDHash;
+        uint32_t index = batchIndex;
+        for (const auto &sibling : batchPath){
+            if (index & 1){
+                HashMan::SHA512_hash(&node, sibling, node);
+            } else {
+                HashMan::SHA512_hash(&node, node, sibling);
+            }
+            index >>= 1;
+        }
+        return node;
     }
 
     bool Transaction::verify(byteBuffer &publicKey){
-        SignAlgorithmPtr s = Signer::GetInstance();
-        if (s->verify(signature, IDHash.data(), IDHash.size(), publicKey)){
+        auto &s = ChosenSigner::get();
+        byteId_t signedHash = getSignedHash();
+        if (s.verify(signature, signedHash.data(), signedHash.size(), publicKey)){
             return true;
         }
         return false;
     }
 
     size_t Transaction::getSize() const{
+        return getDataSize() + getWitnessSize();
+    }
+
+    size_t Transaction::getDataSize() const{
+        return TransactionData::getSize() + sizeof(IDHash);
+    }
+
+    size_t Transaction::getWitnessSize() const{
         if (signatureSize == 0){
             throw PQB::Exceptions::Transaction("getSize: transaction is not sign! Signature size is unknow!");
         }
-        return TransactionData::getSize() + sizeof(IDHash) + sizeof(signatureSize) + signatureSize;
+        size_t size = sizeof(signatureSize) + signatureSize;
+        if (isBatchSigned()){
+            size += sizeof(batchIndex) + sizeof(uint8_t) + batchPath.size() * sizeof(byteId_t);
+        }
+        return size;
+    }
+
+    byteId_t Transaction::getWitnessHash() const{
+        byteId_t witnessHash;
+        byteBuffer buffer(getWitnessSize());
+        size_t offset = 0;
+        serializeWitness(buffer, offset);
+        HashMan::SHA512_hash(&witnessHash, buffer.data(), buffer.size());
+        return witnessHash;
     }
 
     void Transaction::serialize(byteBuffer &buffer, size_t &offset) const{
+        if ((buffer.size() - offset) < getSize())
+            throw PQB::Exceptions::Transaction("Serialization: serialization buffer has not enough size to serialize the transaction");
+        serializeData(buffer, offset);
+        serializeWitness(buffer, offset);
+    }
+
+    void Transaction::deserialize(const byteBuffer &buffer, size_t &offset){
+        deserializeData(buffer, offset);
+        deserializeWitness(buffer, offset);
+    }
+
+    void Transaction::serializeData(byteBuffer &buffer, size_t &offset) const{
         if (IDHash.IsNull())
             throw PQB::Exceptions::Transaction("Serialization: transaction does not have an ID!");
-        if ((buffer.size() - offset) < getSize())
+        if ((buffer.size() - offset) < getDataSize())
             throw PQB::Exceptions::Transaction("Serialization: serialization buffer has not enough size to serialize the transaction");
         TransactionData::serialize(buffer, offset);
         serializeField(buffer, offset, IDHash);
+    }
+
+    void Transaction::deserializeData(const byteBuffer &buffer, size_t &offset){
+        if ((buffer.size() - offset) < (TransactionData::FIXED_SIZE + sizeof(receiverWalletAddress) + sizeof(IDHash)))
+            throw PQB::Exceptions::Transaction("Deserialization: buffer has not enough size to deserialize the transaction");
+        TransactionData::deserialize(buffer, offset);
+        if ((buffer.size() - offset) < sizeof(IDHash))
+            throw PQB::Exceptions::Transaction("Deserialization: buffer has not enough size to deserialize the transaction");
+        deserializeField(buffer, offset, IDHash);
+        signature.clear();
+        signatureSize = 0;
+        batchIndex = 0;
+        batchPath.clear();
+    }
+
+    void Transaction::serializeWitness(byteBuffer &buffer, size_t &offset) const{
+        if ((buffer.size() - offset) < getWitnessSize())
+            throw PQB::Exceptions::Transaction("Serialization: serialization buffer has not enough size to serialize the transaction");
         serializeField(buffer, offset, signatureSize);
         std::memcpy(buffer.data() + offset, signature.data(), signatureSize);
         offset += signatureSize;
+        if (isBatchSigned()){
+            if (batchPath.size() > MAX_TX_BATCH_DEPTH)
+                throw PQB::Exceptions::Transaction("Serialization: audit path of the batch-signed transaction is too long");
+            uint8_t pathLength = static_cast<uint8_t>(batchPath.size());
+            serializeField(buffer, offset, batchIndex);
+            serializeField(buffer, offset, pathLength);
+            for (const auto &node : batchPath){
+                serializeField(buffer, offset, node);
+            }
+        }
     }
 
-    void Transaction::deserialize(const byteBuffer &buffer, size_t &offset){
-        if ((buffer.size() - offset) < (TransactionData::getSize() + sizeof(IDHash) + sizeof(signatureSize)))
+    void Transaction::deserializeWitness(const byteBuffer &buffer, size_t &offset){
+        if ((buffer.size() - offset) < sizeof(signatureSize))
             throw PQB::Exceptions::Transaction("Deserialization: buffer has not enough size to deserialize the transaction");
-        TransactionData::deserialize(buffer, offset);
-        deserializeField(buffer, offset, IDHash);
         deserializeField(buffer, offset, signatureSize);
+        if (signatureSize > ChosenSigner::getSignatureSize())
+            throw PQB::Exceptions::Transaction("Deserialization: signature is longer than signatures of the signature algorithm");
         if ((buffer.size() - offset) < signatureSize)
             throw PQB::Exceptions::Transaction("Deserialization: buffer has not enough size to deserialize the transaction");
         signature.resize(signatureSize);
         std::memcpy(signature.data(), buffer.data() + offset, signatureSize);
         offset += signatureSize;
+        batchIndex = 0;
+        batchPath.clear();
+        if (isBatchSigned()){
+            uint8_t pathLength;
+            if ((buffer.size() - offset) < (sizeof(batchIndex) + sizeof(pathLength)))
+                throw PQB::Exceptions::Transaction("Deserialization: buffer has not enough size to deserialize the transaction");
+            deserializeField(buffer, offset, batchIndex);
+            deserializeField(buffer, offset, pathLength);
+            if (pathLength > MAX_TX_BATCH_DEPTH)
+                throw PQB::Exceptions::Transaction("Deserialization: audit path of the batch-signed transaction is too long");
+            if ((buffer.size() - offset) < (pathLength * sizeof(byteId_t)))
+                throw PQB::Exceptions::Transaction("Deserialization: buffer has not enough size to deserialize the transaction");
+            batchPath.resize(pathLength);
+            for (auto &node : batchPath){
+                deserializeField(buffer, offset, node);
+            }
+        }
+    }
+
+    PQB::cash TransactionData::getAmountFor(const byteId_t &receiver) const{
+        PQB::cash amount = 0;
+        forEachOutput([&](const byteId_t &outputReceiver, PQB::cash outputAmount){
+            if (outputReceiver == receiver){
+                amount += outputAmount;
+            }
+        });
+        return amount;
     }
 
     size_t TransactionData::getSize() const{
-        return sizeof(versionNumber) + 
-               sizeof(sequenceNumber) +
-               sizeof(cashAmount) +
-               sizeof(timestamp) +
-               sizeof(senderWalletAddress) +
-               sizeof(receiverWalletAddress);
+        if (isMultiPayment()){
+            return FIXED_SIZE + sizeof(uint16_t) + outputs.size() * OUTPUT_SIZE;
+        }
+        return FIXED_SIZE + sizeof(receiverWalletAddress);
     }
 
     void TransactionData::serialize(byteBuffer &buffer, size_t &offset) const{
         if (senderWalletAddress.IsNull())
             throw PQB::Exceptions::Transaction("Serialization: transaction does not have a senderWalletAddress!");
-        if (receiverWalletAddress.IsNull()){
+        if (isMultiPayment()){
+            if (outputs.empty() || outputs.size() > MAX_TX_OUTPUTS)
+                throw PQB::Exceptions::Transaction("Serialization: invalid number of outputs of multi-payment transaction!");
+            for (const auto &output : outputs){
+                if (output.receiverWalletAddress.IsNull())
+                    throw PQB::Exceptions::Transaction("Serialization: output of the transaction does not have a receiverWalletAddress!");
+            }
+        } else if (receiverWalletAddress.IsNull()){
             throw PQB::Exceptions::Transaction("Serialization: transaction does not have a receiverWalletAddress!");
         }
         serializeField(buffer, offset, versionNumber);
@@ -104,7 +241,16 @@ namespace PQB{
         serializeField(buffer, offset, cashAmount);
         serializeField(buffer, offset, timestamp);
         serializeField(buffer, offset, senderWalletAddress);
-        serializeField(buffer, offset, receiverWalletAddress);
+        if (!isMultiPayment()){
+            serializeField(buffer, offset, receiverWalletAddress);
+            return;
+        }
+        uint16_t outputCount = static_cast<uint16_t>(outputs.size());
+        serializeField(buffer, offset, outputCount);
+        for (const auto &output : outputs){
+            serializeField(buffer, offset, output.receiverWalletAddress);
+            serializeField(buffer, offset, output.cashAmount);
+        }
     }
 
     void TransactionData::deserialize(const byteBuffer &buffer, size_t &offset){
@@ -113,7 +259,25 @@ namespace PQB{
         deserializeField(buffer, offset, cashAmount);
         deserializeField(buffer, offset, timestamp);
         deserializeField(buffer, offset, senderWalletAddress);
-        deserializeField(buffer, offset, receiverWalletAddress);
+        outputs.clear();
+        if (!isMultiPayment()){
+            deserializeField(buffer, offset, receiverWalletAddress);
+            return;
+        }
+        receiverWalletAddress.SetNull();
+        uint16_t outputCount;
+        if ((buffer.size() - offset) < sizeof(outputCount))
+            throw PQB::Exceptions::Transaction("Deserialization: buffer has not enough size to deserialize outputs of the transaction");
+        deserializeField(buffer, offset, outputCount);
+        if (outputCount > MAX_TX_OUTPUTS)
+            throw PQB::Exceptions::Transaction("Deserialization: multi-payment transaction has too many outputs");
+        if ((buffer.size() - offset) < (outputCount * OUTPUT_SIZE))
+            throw PQB::Exceptions::Transaction("Deserialization: buffer has not enough size to deserialize outputs of the transaction");
+        outputs.resize(outputCount);
+        for (auto &output : outputs){
+            deserializeField(buffer, offset, output.receiverWalletAddress);
+            deserializeField(buffer, offset, output.cashAmount);
+        }
     }
 
 } // namespace PQB
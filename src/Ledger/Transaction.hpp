@@ -16,25 +16,42 @@
 #include <cstring>
 #include <set>
 #include <map>
+#include <vector>
 
 #include "PQBExceptions.hpp"
 #include "Serialize.hpp"
 #include "Signer.hpp"
 #include "PQBtypedefs.hpp"
 #include "Blob.hpp"
+#include "PQBconstants.hpp"
 
 namespace PQB{
 
 
+/// @brief One payment of a multi-payment transaction
+struct TxOutput{
+    byteId_t receiverWalletAddress; ///< address of receiver
+    PQB::cash cashAmount;           ///< amount of transfered resources
+};
+
+
+/**
+ * @brief Data of a transaction
+ *
+ * Transaction of version TX_VERSION transfers `cashAmount` to `receiverWalletAddress`. Transaction of version
+ * TX_VERSION_MULTI_PAYMENT transfers resources to all its `outputs` (at most MAX_TX_OUTPUTS) under one signature
+ * and one sequence number, `cashAmount` is the sum of all outputs and `receiverWalletAddress` is not used (null).
+ */
 class TransactionData
 {
 public:
     uint32_t versionNumber;         ///< version of the transaction
     uint32_t sequenceNumber;        ///< sequence number of the transaction 
-    PQB::cash cashAmount;           ///< amount of transfered resources
+    PQB::cash cashAmount;           ///< amount of transfered resources (sum of outputs in multi-payment transaction)
     PQB::timestamp timestamp;       ///< creation timestamp 
-    byte64_t senderWalletAddress;   ///< address of sender
-    byte64_t receiverWalletAddress; ///< address of receiver
+    byteId_t senderWalletAddress;   ///< address of sender
+    byteId_t receiverWalletAddress; ///< address of receiver (null in multi-payment transaction)
+    std::vector<TxOutput> outputs;  ///< payments of multi-payment transaction (empty in other transactions)
 
     TransactionData(){
         setNull();
@@ -48,30 +65,85 @@ public:
         senderWalletAddress.SetNull();
         receiverWalletAddress.SetNull();
         cashAmount = 0;
+        outputs.clear();
+    }
+
+    /// @brief Get version of the transaction without flags
+    uint32_t getVersion() const{
+        return versionNumber & ~TX_FLAG_BATCH_SIGNED;
+    }
+
+    /// @brief Check if the transaction is a multi-payment transaction (it has a list of outputs)
+    bool isMultiPayment() const{
+        return getVersion() == TX_VERSION_MULTI_PAYMENT;
+    }
+
+    /// @brief Check if the transaction is signed in a batch (TX_FLAG_BATCH_SIGNED flag of the version)
+    bool isBatchSigned() const{
+        return (versionNumber & TX_FLAG_BATCH_SIGNED) != 0;
+    }
+
+    /// @brief Call `f(receiverWalletAddress, cashAmount)` for every payment of the transaction
+    template <class F>
+    void forEachOutput(F &&f) const{
+        if (isMultiPayment()){
+            for (const auto &output : outputs){
+                f(output.receiverWalletAddress, output.cashAmount);
+            }
+        } else {
+            f(receiverWalletAddress, cashAmount);
+        }
+    }
+
+    /// @brief Get number of payments of the transaction
+    size_t getOutputCount() const{
+        return isMultiPayment() ? outputs.size() : 1;
     }
 
+    /// @brief Get amount of resources transfered to the `receiver` by this transaction
+    PQB::cash getAmountFor(const byteId_t &receiver) const;
+
     /// @brief Get size of the TransactionData in bytes
     size_t getSize() const;
 
     /// @brief Serialize TransactionData
     /// @param buffer buffer for serialization
     /// @param offset offset to the buffer
-    /// @exception if addresses of sender and receiver of the transaction are not assigned
+    /// @exception if addresses of sender and receiver of the transaction are not assigned or if multi-payment transaction
+    /// does not have 1 to MAX_TX_OUTPUTS outputs
     void serialize(byteBuffer &buffer, size_t &offset) const;
 
     /// @brief Deserialize TransactionData
     /// @param buffer buffer with serialized data
     /// @param offset offset to the buffer
+    /// @exception if buffer has not enough size to deserialize outputs of multi-payment transaction or if there are
+    /// more than MAX_TX_OUTPUTS outputs
     void deserialize(const byteBuffer &buffer, size_t &offset);
+
+    /// @brief Size of the TransactionData without outputs of multi-payment transaction in bytes
+    static constexpr size_t FIXED_SIZE = sizeof(versionNumber) + sizeof(sequenceNumber) + sizeof(cashAmount) +
+                                         sizeof(timestamp) + sizeof(senderWalletAddress);
+    /// @brief Size of one serialized output of multi-payment transaction in bytes
+    static constexpr size_t OUTPUT_SIZE = sizeof(TxOutput::receiverWalletAddress) + sizeof(TxOutput::cashAmount);
 };
 
 
+/**
+ * @brief Signed transaction
+ *
+ * Transaction is signed alone (signature of IDHash) or in a batch of transactions of the same sender (version has
+ * TX_FLAG_BATCH_SIGNED flag). Signature of batch-signed transaction is made over Merkle root of IDs of all transactions
+ * of the batch, and the transaction carries its index in the batch and audit path from its IDHash to the root.
+ * So the signature is the same for the whole batch and it is verified only once (see VerifiedSignatureCache).
+ */
 class Transaction : public TransactionData
 {
 public:
-    byte64_t IDHash;        ///< Hash of the transaction
-    byteBuffer signature;   ///< Digital signature of the transaction
-    uint32_t signatureSize; ///< Size of the digital signature in bytes
+    byteId_t IDHash;                    ///< Hash of the transaction
+    byteBuffer signature;               ///< Digital signature of the transaction
+    uint32_t signatureSize;             ///< Size of the digital signature in bytes
+    uint32_t batchIndex;                ///< Index of the transaction in its batch (batch-signed transaction)
+    std::vector<byteId_t> batchPath;    ///< Audit path from IDHash to Merkle root of the batch (batch-signed transaction)
 
     Transaction(){
         setNull();
@@ -82,6 +154,8 @@ public:
         TransactionData::setNull();
         IDHash.SetNull();
         signatureSize = 0;
+        batchIndex = 0;
+        batchPath.clear();
     }
 
     /// @brief Return class with TransactionData
@@ -93,6 +167,7 @@ public:
         data.receiverWalletAddress = receiverWalletAddress;
         data.timestamp = timestamp;
         data.cashAmount = cashAmount;
+        data.outputs = outputs;
         return data;
     }
 
@@ -107,6 +182,14 @@ public:
     /// @exception if signing fails or transaction is not hashed (IDHash is null)
     void sign(byteBuffer &privateKey);
 
+    /// @brief Sign the transaction with expanded private key (see SignAlgorithm::expandPrivateKey())
+    /// @exception if signing fails or transaction is not hashed (IDHash is null)
+    void sign(const ExpandedPrivateKey &privateKey);
+
+    /// @brief Get hash signed by the signature of the transaction. It is IDHash or Merkle root of the batch computed from
+    /// IDHash and audit path if the transaction is batch-signed.
+    byteId_t getSignedHash() const;
+
     /// @brief Verify transaction signature
     bool verify(byteBuffer &publicKey);
 
@@ -125,6 +208,38 @@ public:
     /// @param offset offset to the buffer
     /// @exception if buffer has not enough size to deserialize a transaction
     void deserialize(const byteBuffer &buffer, size_t &offset);
+
+    /*
+     * Transaction is serialized as its data part (TransactionData and IDHash) followed by its witness part (signature and
+     * audit path of batch-signed transaction). Blocks store data parts and witnesses of their transactions in separate sections.
+     */
+
+    /// @brief Get size of the data part (TransactionData and IDHash) in bytes
+    size_t getDataSize() const;
+
+    /// @brief Get size of the witness part (signature and audit path of batch-signed transaction) in bytes
+    /// @exception if transaction is not sign so size of signature is unknow
+    size_t getWitnessSize() const;
+
+    /// @brief Get SHA-512 hash of the serialized witness part (leaf of block's signatures Merkle tree)
+    /// @exception if transaction is not sign
+    byteId_t getWitnessHash() const;
+
+    /// @brief Serialize data part of the Transaction
+    /// @exception if buffer has not enough size or if transaction is not hashed so it does not have a IDHash
+    void serializeData(byteBuffer &buffer, size_t &offset) const;
+
+    /// @brief Deserialize data part of the Transaction (witness part is cleared)
+    /// @exception if buffer has not enough size to deserialize the data
+    void deserializeData(const byteBuffer &buffer, size_t &offset);
+
+    /// @brief Serialize witness part of the Transaction
+    /// @exception if buffer has not enough size or if transaction is not signed
+    void serializeWitness(byteBuffer &buffer, size_t &offset) const;
+
+    /// @brief Deserialize witness part of the Transaction (version of the transaction has to be already deserialized)
+    /// @exception if buffer has not enough size to deserialize the witness or if the signature is too long
+    void deserializeWitness(const byteBuffer &buffer, size_t &offset);
 };
 
 
@@ -149,7 +264,7 @@ struct TransactionPtrOrder{
 };
 
 typedef std::set<TransactionPtr, TransactionPtrOrder> TransactionSet;
-typedef std::map<byte64_t, TransactionPtr> TransactionPool;
+typedef std::map<byteId_t, TransactionPtr> TransactionPool;
 
 } // namespace PQB
 
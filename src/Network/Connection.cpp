@@ -11,65 +11,326 @@
 
 #include "Connection.hpp"
 #include "PQBconstants.hpp"
+#include "Signer.hpp"
 #include "Log.hpp"
+#include <algorithm>
+#include <cerrno>
 
 namespace PQB{
 
     class ConnectionManager;
 
+    size_t OutboundFrame::fillIovec(struct iovec *iov) const{
+        const byte *parts[3] = {header.data(), message->getData() + Message::HEADER_SIZE, tag.data()};
+        const size_t sizes[3] = {header.size(), message->getPayloadSize(), tagSize};
+        size_t skip = sent;
+        size_t count = 0;
+        for (int i = 0; i < 3; i++){
+            if (skip >= sizes[i]){
+                skip -= sizes[i];
+                continue;
+            }
+            iov[count].iov_base = const_cast<byte*>(parts[i] + skip);
+            iov[count].iov_len = sizes[i] - skip;
+            skip = 0;
+            count++;
+        }
+        return count;
+    }
+
     Connection::Connection(std::string &connectionID, Sock *socket, bool isOnUNL) 
-    : connID(connectionID), sock(socket){
+    : connID(connectionID), sock(socket), queuedBytes(0), systemCalls(0), readBuffer(RECEIVE_BUFFER_SIZE), readStart(0), readEnd(0),
+      recvState(ReceiveState::HEADER), recvHeaderSize(0), recvMessage(nullptr), recvTagSize(0){
         isConfirmed = false;
         isUNL = isOnUNL;
+        frameCheck = FrameCheck::SHA512; // until message version of the peer is known
+        peerVersion = 1;
+        // frames are reassembled incrementally, so the connection managing thread is never blocked by one peer
+        if (sock->SetNonBlocking() < 0){
+            PQB_LOG_ERROR("NET", "Socket of connection {} can not be set as non-blocking", shortStr(connID));
+        }
     }
 
     Connection::~Connection(){
+        delete recvMessage;
         sock->Shutdown(SHUT_RDWR);
         delete sock;
     }
 
-    void Connection::sendMessage(Message *message){
-        message->setCheckSum();
-        ssize_t bytesToSend = message->getSize();
-        ssize_t bytesSent = 0;
-        while (bytesToSend > 0){
-            ssize_t nBytes = sock->Send(message->getData() + bytesSent, (bytesToSend < MAX_MESSAGE_SIZE ? bytesToSend : MAX_MESSAGE_SIZE), 0);
-            if (nBytes <= 0){
+    bool Connection::sendMessage(const MessagePtr &message){
+        MessageType type = message->getType();
+        // slow peer does not get gossip which it can request again, so its queue does not grow with it
+        if (queuedBytes >= OUTBOUND_QUEUE_HIGH_WATER && (type == MessageType::TX || type == MessageType::INV || type == MessageType::GETDATA)){
+            PQB_LOG_TRACE("NET", "{} message to {} dropped, {} bytes are waiting for sending", Message::messageTypeToString(type), shortStr(connID), queuedBytes);
+            return false;
+        }
+        OutboundFrame frame;
+        frame.message = message;
+        frame.sent = 0;
+        // message is shared with other connections (and I/O threads), so only the header of the frame is written
+        // VERSION and ACK messages establish the session, so they are never authenticated by it
+        if (session != nullptr && type != MessageType::VERSION && type != MessageType::ACK){
+            message->getFrameHeader(FrameCheck::SESSION, frame.header.data());
+            session->computeTag(frame.header.data(), Message::HEADER_SIZE, message->getData() + Message::HEADER_SIZE,
+                                message->getPayloadSize(), frame.tag.data());
+            frame.tagSize = PeerSession::TAG_SIZE;
+        } else {
+            // check sum is computed only once per message and frame check algorithm
+            message->getFrameHeader(frameCheck, frame.header.data());
+            frame.tagSize = 0;
+        }
+        queuedBytes += frame.size();
+        outboundQueue.push_back(std::move(frame));
+        PQB_LOG_TRACE("NET", "{} message queued for {}", Message::messageTypeToString(type), shortStr(connID));
+        return true;
+    }
+
+    size_t Connection::fillOutboundIovec(struct iovec *iov, size_t maxIov, size_t offset, size_t *size) const{
+        size_t iovCount = 0;
+        *size = 0;
+        for (auto it = outboundQueue.begin(); it != outboundQueue.end() && iovCount + 3 <= maxIov; ++it){
+            struct iovec frameIov[3];
+            size_t count = it->fillIovec(frameIov);
+            for (size_t i = 0; i < count; i++){
+                // bytes which belong to a previous request are skipped
+                size_t skip = std::min(offset, frameIov[i].iov_len);
+                offset -= skip;
+                if (skip == frameIov[i].iov_len){
+                    continue;
+                }
+                iov[iovCount].iov_base = static_cast<byte*>(frameIov[i].iov_base) + skip;
+                iov[iovCount].iov_len = frameIov[i].iov_len - skip;
+                *size += iov[iovCount].iov_len;
+                iovCount++;
+            }
+        }
+        return iovCount;
+    }
+
+    void Connection::outboundBytesSent(size_t size){
+        queuedBytes -= size;
+        while (size > 0){
+            OutboundFrame &frame = outboundQueue.front();
+            size_t rest = frame.size() - frame.sent;
+            if (size < rest){
+                frame.sent += size;
                 break;
             }
-            bytesToSend -= nBytes;
-            bytesSent += nBytes;
+            size -= rest;
+            PQB_LOG_TRACE("NET", "{} message sent to {}", Message::messageTypeToString(frame.message->getType()), shortStr(connID));
+            outboundQueue.pop_front();
         }
-        PQB_LOG_TRACE("NET", "{} message sent to {}", Message::messageTypeToString(message->getType()), shortStr(connID));
     }
 
-    Message *Connection::receiveMessage(bool *closeFlag){
+    bool Connection::flushOutboundQueue(){
+        static constexpr size_t MAX_IOVEC = 64;
+        struct iovec iov[MAX_IOVEC];
+        while (!outboundQueue.empty()){
+            size_t size;
+            struct msghdr msg;
+            std::memset(&msg, 0, sizeof(msg));
+            msg.msg_iov = iov;
+            msg.msg_iovlen = fillOutboundIovec(iov, MAX_IOVEC, 0, &size);
+            ssize_t nBytes = sock->Sendmsg(&msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+            systemCalls++;
+            if (nBytes < 0){
+                if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR){
+                    return true; // socket buffer is full, continue after EPOLLOUT event
+                }
+                PQB_LOG_TRACE("NET", "Sending to {} failed", shortStr(connID));
+                return false;
+            }
+            outboundBytesSent(nBytes);
+        }
+        return true;
+    }
+
+    Message *Connection::receiveMessage(bool *closeFlag, size_t *budget){
         *closeFlag = false;
+        while (true){
+            // parse bytes which were already read
+            while (readStart < readEnd){
+                size_t size;
+                byte *target = getReceiveTarget(&size);
+                size = std::min(size, readEnd - readStart);
+                std::memcpy(target, readBuffer.data() + readStart, size);
+                readStart += size;
+                Message *message = nullptr;
+                receivedBytes(size, &message, closeFlag);
+                if (message != nullptr || *closeFlag){
+                    return message;
+                }
+            }
+            if (*budget == 0){
+                return nullptr;
+            }
+            // large rest of the payload is received directly to the message, smaller parts are read to the buffer,
+            // so multiple small frames are read by one system call
+            size_t size;
+            byte *target = getReceiveTarget(&size);
+            bool direct = (size >= readBuffer.size());
+            if (!direct){
+                target = readBuffer.data();
+                size = readBuffer.size();
+            }
+            ssize_t nBytes = sock->Recv(target, std::min(size, *budget), MSG_DONTWAIT);
+            systemCalls++;
+            if (nBytes == 0){
+                *closeFlag = true;
+                return nullptr;
+            } else if (nBytes < 0){
+                if (errno == EINTR){
+                    continue;
+                }
+                if (errno != EAGAIN && errno != EWOULDBLOCK){
+                    *closeFlag = true;
+                }
+                return nullptr;
+            }
+            *budget -= std::min(static_cast<size_t>(nBytes), *budget);
+            if (direct){
+                Message *message = nullptr;
+                receivedBytes(nBytes, &message, closeFlag);
+                if (message != nullptr || *closeFlag){
+                    return message;
+                }
+            } else {
+                readStart = 0;
+                readEnd = nBytes;
+            }
+        }
+    }
+
+    Message *Connection::receiveMessage(const byte **data, size_t *size, bool *closeFlag){
+        *closeFlag = false;
+        while (*size > 0){
+            size_t partSize;
+            byte *target = getReceiveTarget(&partSize);
+            partSize = std::min(partSize, *size);
+            std::memcpy(target, *data, partSize);
+            *data += partSize;
+            *size -= partSize;
+            Message *message = nullptr;
+            receivedBytes(partSize, &message, closeFlag);
+            if (message != nullptr || *closeFlag){
+                return message;
+            }
+        }
+        return nullptr;
+    }
+
+    bool Connection::isReceiveExpired(std::chrono::steady_clock::time_point now) const{
+        if (recvState == ReceiveState::HEADER && recvHeaderSize == 0){
+            return false; // no message was started
+        }
+        return (now - recvStart) > std::chrono::milliseconds(MESSAGE_RECEIVE_TIMEOUT);
+    }
+
+    byte *Connection::getReceiveTarget(size_t *size){
+        switch (recvState)
+        {
+        case ReceiveState::PAYLOAD:
+            *size = recvMessage->getMissingSize();
+            return recvMessage->getMissingData();
+        case ReceiveState::TAG:
+            *size = recvTag.size() - recvTagSize;
+            return recvTag.data() + recvTagSize;
+        default:
+            *size = recvHeader.size() - recvHeaderSize;
+            return recvHeader.data() + recvHeaderSize;
+        }
+    }
+
+    void Connection::receivedBytes(size_t size, Message **message, bool *closeFlag){
+        *message = nullptr;
+        switch (recvState)
+        {
+        case ReceiveState::HEADER:
+            if (recvHeaderSize == 0){
+                recvStart = std::chrono::steady_clock::now();
+            }
+            recvHeaderSize += size;
+            if (recvHeaderSize < recvHeader.size()){
+                return;
+            }
+            if (!startMessage()){
+                *closeFlag = true;
+                return;
+            }
+            recvState = ReceiveState::PAYLOAD;
+            break;
+        case ReceiveState::PAYLOAD:
+            recvMessage->fragmentReceived(size);
+            break;
+        case ReceiveState::TAG:
+            recvTagSize += size;
+            break;
+        }
+
+        if (recvState == ReceiveState::PAYLOAD){
+            if (recvMessage->getMissingSize() > 0){
+                return;
+            }
+            // frames authenticated by a session are followed by the tag
+            if (recvMessage->getMessageHeader().magicNum == MESSAGE_MAGIC_CONST_SESSION){
+                recvState = ReceiveState::TAG;
+                recvTagSize = 0;
+                return;
+            }
+        } else if (recvState == ReceiveState::TAG && recvTagSize < recvTag.size()){
+            return;
+        }
+
+        *message = finishMessage(closeFlag);
+        recvMessage = nullptr;
+        recvState = ReceiveState::HEADER;
+        recvHeaderSize = 0;
+    }
+
+    bool Connection::startMessage(){
         Message::message_hdr_t header;
-        if (!peekForHeader(header, closeFlag))
-            return nullptr;
+        byteBuffer buffer(recvHeader.begin(), recvHeader.end());
+        size_t offset = 0;
+        Message::deserializeMessageHeader(buffer, offset, header);
+        if (!Message::isValidMagicNumber(header.magicNum)){
+            PQB_LOG_WARN("NET", "Invalid message header received from {}, connection will be closed", shortStr(connID));
+            return false;
+        }
+        // size is checked before the message is allocated, so the peer can not make the node allocate arbitrary amount of memory
+        if (header.size > Message::getMaxPayloadSize(header.type)){
+            PQB_LOG_WARN("NET", "{} message of {} bytes from {} exceeds the maximal size, connection will be closed",
+                        Message::messageTypeToString(header.type), header.size, shortStr(connID));
+            return false;
+        }
+        recvMessage = MessageCreator::createMessage(header);
+        if (recvMessage == nullptr){
+            PQB_LOG_WARN("NET", "Message of unknown type received from {}, connection will be closed", shortStr(connID));
+            return false;
+        }
+        recvMessage->addFragment(reinterpret_cast<const char*>(recvHeader.data()), recvHeader.size());
+        return true;
+    }
 
-        Message *newMsg = MessageCreator::createMessage(header);
-        size_t bytesReceived = 0;
-        size_t bufferSize = (newMsg->getSize() < MAX_MESSAGE_SIZE ? newMsg->getSize() : MAX_MESSAGE_SIZE);
-        char *buffer = new char[bufferSize];
-        std::memset(buffer, 0, bufferSize);
-
-        /// @todo There is not timeout on receiving one large message. If second part of the message is larger than MAX_MESSAGE_SIZE and it does not come the thread will be stuck here
-        /// A problem may occure also if recived message is not complete because other parts do not came yet
-        while (bytesReceived < newMsg->getSize()){
-            ssize_t nBytes = sock->Recv(buffer, bufferSize, 0);
-            if (nBytes <= 0)
-                break;
-            
-            newMsg->addFragment(buffer, nBytes);
-            bytesReceived += nBytes;
-            std::memset(buffer, 0, bufferSize);
-            bufferSize = ((newMsg->getSize() - bytesReceived) < MAX_MESSAGE_SIZE ? (newMsg->getSize() - bytesReceived) : MAX_MESSAGE_SIZE);
+    Message *Connection::finishMessage(bool *closeFlag){
+        Message *newMsg = recvMessage;
+        // Messages on a connection with session have to be authenticated by the session, so spoofed or corrupted messages
+        // are rejected before they are deserialized or their signatures are verified
+        if (newMsg->getMessageHeader().magicNum == MESSAGE_MAGIC_CONST_SESSION){
+            if (session == nullptr || !session->verifyTag(newMsg->getData(), newMsg->getSize(), recvTag.data())){
+                PQB_LOG_TRACE("NET", "{} message received from {}, but it was not authenticated",
+                            Message::messageTypeToString(newMsg->getType()), shortStr(connID));
+                delete newMsg;
+                return nullptr;
+            }
+        } else if (session != nullptr){
+            PQB_LOG_TRACE("NET", "{} message received from {}, but it was not authenticated by the session",
+                        Message::messageTypeToString(newMsg->getType()), shortStr(connID));
+            delete newMsg;
+            return nullptr;
         }
-        delete[] buffer;
+
         if (newMsg->checkMessage()){
-            if (filterMessage(newMsg)){
+            if (filterMessage(newMsg, closeFlag)){
                 PQB_LOG_TRACE("NET", "{} message received from {}", Message::messageTypeToString(newMsg->getType()), shortStr(connID));
                 return newMsg;
             } else {
@@ -85,31 +346,37 @@ namespace PQB{
         return nullptr;
     }
 
-    bool Connection::peekForHeader(Message::message_hdr_t &header, bool *closeFlag){
-        *closeFlag = false;
-        byteBuffer buffer;
-        size_t offset = 0;
-        buffer.resize(Message::getHeaderSize());
-        ssize_t nBytes = sock->Recv(buffer.data(), buffer.size(), MSG_PEEK);
-        if (nBytes == 0){
-            *closeFlag = true;
-            return false;
-        } else if (nBytes < 0)
-            return false;
-        Message::deserializeMessageHeader(buffer, offset, header);
-        return header.magicNum == MESSAGE_MAGIC_CONST;
-    }
-
-    bool Connection::filterMessage(Message *message){
+    bool Connection::filterMessage(Message *message, bool *closeFlag){
         switch (message->getType())
         {
-        case MessageType::ACK:
+        case MessageType::ACK:{
+            AckMessage::ack_msg_t ackData;
+            message->deserialize(&ackData);
+            if (handshake != nullptr){
+                bool established = establishSession(ackData);
+                handshake.reset();
+                if (!established){
+                    PQB_LOG_WARN("NET", "Session with {} was not established, connection will be closed", shortStr(connID));
+                    *closeFlag = true;
+                    return false;
+                }
+                PQB_LOG_INFO("NET", "Session with {} established", shortStr(connID));
+            }
+            frameCheck = Message::getFrameCheckForVersion(std::min(ackData.version, MSG_VERSION));
+            peerVersion = ackData.version;
             isConfirmed = true;
             return false;
+        }
         case MessageType::VERSION:
-            return !isConfirmed;
+            // connection where this node offered a session waits for ACK message, VERSION is sent only by the other side
+            return !isConfirmed && handshake == nullptr;
         case MessageType::BLOCKPROPOSAL:
         case MessageType::TXSETPROPOSAL:
+        case MessageType::COMPACTTXSETPROPOSAL:
+        case MessageType::TXSETDELTAPROPOSAL:
+        case MessageType::TXSETSKETCHPROPOSAL:
+        case MessageType::GETPROPOSALTXS:
+        case MessageType::PROPOSALTXS:
             return (isConfirmed && isUNL);
         default:
             return isConfirmed;
@@ -117,6 +384,24 @@ namespace PQB{
         }
     }
 
+    bool Connection::establishSession(const AckMessage::ack_msg_t &ackData){
+        if (ackData.kemCiphertext.empty()){
+            return false;
+        }
+        byteId_t ackHash;
+        AckMessage::getSignedHash(ackData, handshake->versionHash, ackHash);
+        if (!ChosenSigner::get().verify(ackData.signature, ackHash.data(), ackHash.size(), handshake->peerPublicKey)){
+            return false;
+        }
+        byteBuffer sharedSecret;
+        if (!PeerSession::decapsulate(sharedSecret, ackData.kemCiphertext, handshake->kemSecretKey)){
+            return false;
+        }
+        session = std::make_unique<PeerSession>(sharedSecret, ackHash, true);
+        CryptoPP::SecureWipeBuffer(sharedSecret.data(), sharedSecret.size());
+        return true;
+    }
+
 } // namespace PQB
 
 /* END OF FILE */
\ No newline at end of file
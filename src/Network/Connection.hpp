@@ -13,15 +13,55 @@
 
 #include <string>
 #include <cstring>
+#include <deque>
+#include <array>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <memory>
+#include <chrono>
+#include <cryptopp/misc.h>      // SecureWipeBuffer
 #include "Sock.hpp"
 #include "Message.hpp"
+#include "PeerSession.hpp"
 
 
 
 namespace PQB{
 
 
+/// @brief State of session handshake kept by the peer which opened the connection until ACK message is received
+struct SessionHandshake{
+    byteBuffer kemSecretKey;    ///< ephemeral Kyber1024 secret key
+    byteBuffer peerPublicKey;   ///< public key of the peer account which has to sign the ACK message
+    byteId_t versionHash;       ///< VersionMessage::getSignedHash() of sent VERSION message
+
+    ~SessionHandshake(){
+        CryptoPP::SecureWipeBuffer(kemSecretKey.data(), kemSecretKey.size());
+    }
+};
+
+
+/// @brief Frame waiting in the outbound queue of a connection. The header (and the tag) is specific for the connection,
+/// the payload is shared with outbound queues of other connections.
+struct OutboundFrame{
+    std::array<byte, Message::HEADER_SIZE> header;  ///< message header with check sum for the connection
+    MessagePtr message;                             ///< message with the payload
+    std::array<byte, PeerSession::TAG_SIZE> tag;    ///< session tag (only if tagSize is not 0)
+    size_t tagSize;                                 ///< PeerSession::TAG_SIZE if the frame is authenticated by session, else 0
+    size_t sent;                                    ///< number of bytes of the frame which were already sent
+
+    /// @brief Size of the whole frame
+    size_t size() const {
+        return message->getSize() + tagSize;
+    }
+
+    /// @brief Fill I/O vectors with bytes of the frame which were not sent yet
+    /// @param iov array of at least 3 I/O vectors
+    /// @return number of filled I/O vectors
+    size_t fillIovec(struct iovec *iov) const;
+};
+
+
 /// @brief Class representing a connection with a peer
 class Connection{
 public:
@@ -29,6 +69,10 @@ public:
     std::string connID;
     bool isConfirmed;
     bool isUNL;
+    FrameCheck frameCheck; ///< check sum algorithm used for messages sent on this connection (negotiated with VERSION and ACK messages)
+    uint32_t peerVersion;  ///< message version of the peer (from VERSION or ACK message), messages it does not support are not sent to it
+    PeerSessionPtr session; ///< session authenticating messages (only with UNL peers), nullptr if there is no session
+    std::unique_ptr<SessionHandshake> handshake; ///< offered session waiting for ACK message, nullptr if no session was offered
 
     /**
      * @brief Construct a new Connection object
@@ -40,13 +84,81 @@ public:
     Connection(std::string &connectionID, Sock *socket, bool isOnUNL = false);
     ~Connection();
 
-    /// @brief Send message to the peer on this connection 
-    void sendMessage(Message *message);
+    /**
+     * @brief Put message to the outbound queue of this connection, it is sent by flushOutboundQueue(). If the connection
+     * has a session, then the message (except VERSION and ACK) is authenticated by the session instead of the check sum.
+     * Low priority messages (TX, INV and GETDATA) are dropped if the queue has more than OUTBOUND_QUEUE_HIGH_WATER bytes.
+     * 
+     * @param message message to send
+     * @return false if the message was dropped
+     */
+    bool sendMessage(const MessagePtr &message);
 
-    /// @brief Read one message sent from peer
-    /// @param[out] closeFlag Set to true if connection has closed (recv() returns 0)
-    /// @return Pointer to Message or nullptr on failure
-    Message *receiveMessage(bool *closeFlag);
+    /**
+     * @brief Send frames from the outbound queue without blocking. Multiple frames are sent by one system call.
+     * 
+     * @return false if the connection failed, true if the queue is empty or the socket is not writable now (sending continues
+     * after EPOLLOUT event)
+     */
+    bool flushOutboundQueue();
+
+    /**
+     * @brief Fill I/O vectors with not sent bytes of the outbound queue (used for sending by io_uring)
+     * 
+     * @param iov array of I/O vectors
+     * @param maxIov size of the iov array (at least 3)
+     * @param offset number of not sent bytes which are skipped (they are sent by a previous request)
+     * @param[out] size number of bytes in filled I/O vectors
+     * @return number of filled I/O vectors, 0 if there is nothing to send
+     */
+    size_t fillOutboundIovec(struct iovec *iov, size_t maxIov, size_t offset, size_t *size) const;
+
+    /// @brief Remove size sent bytes from the front of the outbound queue
+    void outboundBytesSent(size_t size);
+
+    /// @brief Return number of bytes in the outbound queue
+    size_t getQueuedBytes() const {
+        return queuedBytes;
+    }
+
+    /// @brief Return true if the outbound queue is not empty
+    bool hasQueuedFrames() const {
+        return !outboundQueue.empty();
+    }
+
+    /**
+     * @brief Read received bytes without blocking and return the next complete message sent from peer. Frames are reassembled
+     * incrementally, so a partially received frame is kept in the connection and completed by following calls. Corrupted and
+     * filtered messages are skipped. If the connection has a session, then messages which are not authenticated by the session
+     * are rejected.
+     * 
+     * @param[out] closeFlag Set to true if connection has closed (recv() returns 0) or it should be closed (invalid header,
+     * too large message or session handshake failed)
+     * @param[in,out] budget maximal number of bytes which can be read from the socket, it is decreased by the number of read bytes
+     * @return Pointer to Message or nullptr if no complete message is available (all received bytes were read or budget was spent)
+     */
+    Message *receiveMessage(bool *closeFlag, size_t *budget);
+
+    /**
+     * @brief Return the next complete message from bytes received by the caller (used with io_uring, which receives
+     * to provided buffers). Partially received frame is kept in the connection as with receiveMessage(closeFlag, budget).
+     * 
+     * @param[in,out] data received bytes, moved behind the parsed bytes
+     * @param[in,out] size number of received bytes, decreased by the number of parsed bytes
+     * @param[out] closeFlag Set to true if the connection should be closed
+     * @return Pointer to Message or nullptr if all bytes were parsed without completing a message
+     */
+    Message *receiveMessage(const byte **data, size_t *size, bool *closeFlag);
+
+    /// @brief Give the number of system calls made by the connection since the last call of this method (recv() and sendmsg())
+    uint64_t takeNumberOfSystemCalls(){
+        uint64_t count = systemCalls;
+        systemCalls = 0;
+        return count;
+    }
+
+    /// @brief Return true if a message was started and it was not received completely within MESSAGE_RECEIVE_TIMEOUT
+    bool isReceiveExpired(std::chrono::steady_clock::time_point now) const;
 
     /// @brief Return socked descriptor of this Connection
     socket_t getConnectionSocketFD(){
@@ -55,19 +167,63 @@ public:
 
 private:
 
-    /// @brief Peek for header data in socket
-    /// @param[out] header Parsed message header
-    /// @param[out] closeFlag Set to true if connection has closed (recv() returns 0)
-    /// @return true on success, false on recv failure
-    bool peekForHeader(Message::message_hdr_t &header, bool *closeFlag);
+    /// @brief Part of a frame which is being received
+    enum class ReceiveState{
+        HEADER,     ///< message header (recvHeader)
+        PAYLOAD,    ///< message payload (recvMessage)
+        TAG         ///< session tag (recvTag)
+    };
+
+    /// @brief Get the rest of the part of the frame which is being received
+    /// @param[out] size number of missing bytes of the part
+    /// @return pointer where the next received bytes belong
+    byte *getReceiveTarget(size_t *size);
+
+    /**
+     * @brief Confirm size bytes written to getReceiveTarget() and move to the next part of the frame if the current part is complete
+     * 
+     * @param size number of written bytes
+     * @param[out] message complete message if it passed all checks, else nullptr
+     * @param[out] closeFlag Set to true if the connection should be closed
+     */
+    void receivedBytes(size_t size, Message **message, bool *closeFlag);
+
+    /// @brief Parse the received header and create message for the payload
+    /// @return false if the header is not valid or the message is too large
+    bool startMessage();
+
+    /// @brief Check complete message (check sum or session tag) and filter it
+    /// @param[out] closeFlag Set to true if the connection should be closed
+    /// @return the message if it passed, else nullptr (the message is deleted)
+    Message *finishMessage(bool *closeFlag);
 
     /// @brief Early filter for messages. Filter all messages except ACK if connection is not confirmed.
+    /// ACK message is processed here and check sum algorithm of this connection is set according to the peer's message version.
     /// If connection is confirmed then filter duplicit VERSION messages (to avoid duplicit VERSION messages).
     /// If connection is not on the node UNL, then filter every message except GET* messages, else process each message. 
+    /// @param[out] closeFlag Set to true if the ACK message does not establish offered session
     /// @return True if message pass, false if message do not pass
-    bool filterMessage(Message *message);
+    bool filterMessage(Message *message, bool *closeFlag);
+
+    /// @brief Establish offered session from the ACK message of the peer
+    /// @return false if the ACK message does not accept the session or its signature is not valid
+    bool establishSession(const AckMessage::ack_msg_t &ackData);
 
     Sock *sock;
+    std::deque<OutboundFrame> outboundQueue; ///< frames waiting for sending
+    size_t queuedBytes; ///< number of not sent bytes in outboundQueue
+    uint64_t systemCalls; ///< number of recv() and sendmsg() calls (see takeNumberOfSystemCalls())
+
+    byteBuffer readBuffer;  ///< bytes read from the socket, which were not parsed yet
+    size_t readStart;       ///< first not parsed byte in readBuffer
+    size_t readEnd;         ///< end of read bytes in readBuffer
+    ReceiveState recvState; ///< part of the frame which is being received
+    std::array<byte, Message::HEADER_SIZE> recvHeader; ///< header of the frame
+    size_t recvHeaderSize;  ///< number of received bytes of the header
+    Message *recvMessage;   ///< message which payload is being received (nullptr in HEADER state)
+    std::array<byte, PeerSession::TAG_SIZE> recvTag; ///< session tag of the frame
+    size_t recvTagSize;     ///< number of received bytes of the tag
+    std::chrono::steady_clock::time_point recvStart; ///< time when the first byte of the frame was received
 };
 
 
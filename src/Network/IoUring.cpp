@@ -0,0 +1,251 @@
+/**
+ * @file IoUring.cpp
+ * @author Michal Ľaš
+ * @brief Minimal io_uring instance used by network I/O threads
+ * @date 2024-05-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+#ifdef PQB_IO_URING
+
+#include "IoUring.hpp"
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "Log.hpp"
+
+
+namespace PQB{
+
+namespace{
+
+    int io_uring_setup(unsigned entries, struct io_uring_params *params){
+        return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int io_uring_enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags, const void *arg, size_t argSize){
+        return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSize));
+    }
+
+    int io_uring_register(int fd, unsigned opcode, const void *arg, unsigned nrArgs){
+        return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs));
+    }
+
+} // namespace
+
+
+std::unique_ptr<IoUring> IoUring::create(unsigned entries, unsigned bufferCount, size_t bufferSize){
+    std::unique_ptr<IoUring> ring(new IoUring());
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    // completions are processed only by the thread which submits (Linux 6.1), multishot receive needs Linux 6.0
+    params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+    params.cq_entries = entries * 4;
+    ring->ringFD = io_uring_setup(entries, &params);
+    if (ring->ringFD < 0){
+        PQB_LOG_WARN("IO_URING", "io_uring_setup() failed ({}), Linux 6.1 or newer is required", std::strerror(errno));
+        return nullptr;
+    }
+    if ((params.features & IORING_FEAT_NODROP) == 0 || (params.features & IORING_FEAT_EXT_ARG) == 0){
+        PQB_LOG_WARN("IO_URING", "Required io_uring features are not supported");
+        return nullptr;
+    }
+
+    // map the rings
+    ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMmap){
+        ring->sqRingSize = ring->cqRingSize = std::max(ring->sqRingSize, ring->cqRingSize);
+    }
+    ring->sqRing = mmap(nullptr, ring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ringFD, IORING_OFF_SQ_RING);
+    if (ring->sqRing == MAP_FAILED){
+        ring->sqRing = nullptr;
+        PQB_LOG_WARN("IO_URING", "Submission queue can not be mapped");
+        return nullptr;
+    }
+    if (singleMmap){
+        ring->cqRing = ring->sqRing;
+    } else {
+        ring->cqRing = mmap(nullptr, ring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ringFD, IORING_OFF_CQ_RING);
+        if (ring->cqRing == MAP_FAILED){
+            ring->cqRing = nullptr;
+            PQB_LOG_WARN("IO_URING", "Completion queue can not be mapped");
+            return nullptr;
+        }
+    }
+    ring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    void *sqes = mmap(nullptr, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ringFD, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED){
+        PQB_LOG_WARN("IO_URING", "Submission queue entries can not be mapped");
+        return nullptr;
+    }
+    ring->sqes = static_cast<struct io_uring_sqe*>(sqes);
+
+    byte *sq = static_cast<byte*>(ring->sqRing);
+    ring->sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    ring->sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    ring->sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    ring->sqEntries = params.sq_entries;
+    ring->sqeTail = ring->submittedTail = *ring->sqTail;
+    // entries are always used in order, so the index array is identity
+    unsigned *sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    for (unsigned i = 0; i < params.sq_entries; i++){
+        sqArray[i] = i;
+    }
+    byte *cq = static_cast<byte*>(ring->cqRing);
+    ring->cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    ring->cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    ring->cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    ring->cqes = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    // ring of provided buffers, the kernel picks a buffer when data arrives, so idle connections do not hold any buffer
+    ring->bufferCount = bufferCount;
+    ring->bufferSize = bufferSize;
+    ring->bufferRingSize = bufferCount * sizeof(struct io_uring_buf);
+    void *bufferRing = mmap(nullptr, ring->bufferRingSize, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (bufferRing == MAP_FAILED){
+        PQB_LOG_WARN("IO_URING", "Ring of provided buffers can not be allocated");
+        return nullptr;
+    }
+    // struct io_uring_buf_ring is used as an array of buffers, its flexible array member has different offset in C++
+    ring->bufferRing = static_cast<struct io_uring_buf*>(bufferRing);
+    // memory is written before registration, so the kernel does not pin the shared zero page
+    std::memset(bufferRing, 0, ring->bufferRingSize);
+    struct io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<uint64_t>(ring->bufferRing);
+    reg.ring_entries = bufferCount;
+    reg.bgid = 0;
+    if (io_uring_register(ring->ringFD, IORING_REGISTER_PBUF_RING, &reg, 1) < 0){
+        PQB_LOG_WARN("IO_URING", "Ring of provided buffers can not be registered ({})", std::strerror(errno));
+        return nullptr;
+    }
+    ring->buffers = std::make_unique<byte[]>(bufferCount * bufferSize);
+    for (unsigned i = 0; i < bufferCount; i++){
+        ring->recycleBuffer(static_cast<uint16_t>(i));
+    }
+    return ring;
+}
+
+IoUring::~IoUring(){
+    if (ringFD >= 0){
+        close(ringFD);  // pending requests are canceled
+    }
+    if (bufferRing != nullptr){
+        munmap(bufferRing, bufferRingSize);
+    }
+    if (sqes != nullptr){
+        munmap(sqes, sqesSize);
+    }
+    if (cqRing != nullptr && cqRing != sqRing){
+        munmap(cqRing, cqRingSize);
+    }
+    if (sqRing != nullptr){
+        munmap(sqRing, sqRingSize);
+    }
+}
+
+void IoUring::reserve(unsigned count){
+    if (sqEntries - (sqeTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE)) < count){
+        submitAndWait(0, 0);
+    }
+}
+
+struct io_uring_sqe *IoUring::getSqe(){
+    reserve(1);
+    struct io_uring_sqe *sqe = &sqes[sqeTail & sqMask];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqeTail++;
+    return sqe;
+}
+
+void IoUring::prepareMultishotReceive(int fd, uint64_t userData){
+    struct io_uring_sqe *sqe = getSqe();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = 0;
+    sqe->user_data = userData;
+}
+
+void IoUring::prepareSendmsg(int fd, const struct msghdr *message, bool link, uint64_t userData){
+    struct io_uring_sqe *sqe = getSqe();
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(message);
+    sqe->len = 1;
+    // the rest of a short send is sent by the kernel, so a linked request starts where this one ended
+    sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+    sqe->flags = link ? IOSQE_IO_LINK : 0;
+    sqe->user_data = userData;
+}
+
+void IoUring::prepareRead(int fd, void *buffer, unsigned size, uint64_t userData){
+    struct io_uring_sqe *sqe = getSqe();
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(buffer);
+    sqe->len = size;
+    sqe->off = static_cast<uint64_t>(-1);
+    sqe->user_data = userData;
+}
+
+void IoUring::prepareCancel(int fd, uint64_t userData){
+    struct io_uring_sqe *sqe = getSqe();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = fd;
+    sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+    sqe->user_data = userData;
+}
+
+unsigned IoUring::flushSubmissionQueue(){
+    __atomic_store_n(sqTail, sqeTail, __ATOMIC_RELEASE);
+    unsigned toSubmit = sqeTail - submittedTail;
+    submittedTail = sqeTail;
+    return toSubmit;
+}
+
+bool IoUring::submitAndWait(unsigned waitNr, unsigned timeoutMs){
+    unsigned toSubmit = flushSubmissionQueue();
+    struct __kernel_timespec ts = {.tv_sec=timeoutMs / 1000, .tv_nsec=(timeoutMs % 1000) * 1000000LL};
+    struct io_uring_getevents_arg arg;
+    std::memset(&arg, 0, sizeof(arg));
+    arg.ts = reinterpret_cast<uint64_t>(&ts);
+    // completions are posted only inside io_uring_enter() with IORING_SETUP_DEFER_TASKRUN, so GETEVENTS is always set
+    int ret = io_uring_enter(ringFD, toSubmit, waitNr, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+    systemCalls++;
+    if (ret < 0 && errno != ETIME && errno != EINTR && errno != EBUSY){
+        PQB_LOG_ERROR("IO_URING", "io_uring_enter() failed ({})", std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+bool IoUring::hasCompletions() const{
+    return __atomic_load_n(cqTail, __ATOMIC_ACQUIRE) != *cqHead;
+}
+
+void IoUring::recycleBuffer(uint16_t bufferID){
+    struct io_uring_buf *buf = &bufferRing[bufferTail & (bufferCount - 1)];
+    buf->addr = reinterpret_cast<uint64_t>(getBuffer(bufferID));
+    buf->len = static_cast<uint32_t>(bufferSize);
+    buf->bid = bufferID;
+    bufferTail++;
+    // tail of the ring overlays resv field of the first buffer
+    __atomic_store_n(&bufferRing[0].resv, bufferTail, __ATOMIC_RELEASE);
+}
+
+
+} // namespace PQB
+
+#endif // PQB_IO_URING
+
+/* END OF FILE */
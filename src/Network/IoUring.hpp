@@ -0,0 +1,162 @@
+/**
+ * @file IoUring.hpp
+ * @author Michal Ľaš
+ * @brief Minimal io_uring instance used by network I/O threads
+ * @date 2024-05-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+#pragma once
+
+#ifdef PQB_IO_URING
+
+#include <memory>
+#include <cstdint>
+#include <sys/socket.h>
+#include <linux/io_uring.h>
+#include "PQBtypedefs.hpp"
+
+
+namespace PQB{
+
+
+/**
+ * @brief io_uring instance with a ring of provided receive buffers. It is used directly through system calls
+ * (io_uring_setup, io_uring_enter and io_uring_register), so no other library is needed.
+ *
+ * The instance is not thread-safe, it has to be created and used by one thread (IORING_SETUP_SINGLE_ISSUER).
+ * Requests are prepared to the submission queue and they are submitted together with waiting for completions,
+ * so one system call serves all requests of one iteration of the event loop.
+ */
+class IoUring{
+public:
+
+    /**
+     * @brief Create io_uring instance and register ring of provided buffers (buffer group 0)
+     *
+     * @param entries number of submission queue entries (completion queue has four times more)
+     * @param bufferCount number of provided receive buffers (power of 2)
+     * @param bufferSize size of one receive buffer
+     * @return instance or nullptr if io_uring or some of required features are not supported by the kernel
+     */
+    static std::unique_ptr<IoUring> create(unsigned entries, unsigned bufferCount, size_t bufferSize);
+
+    ~IoUring();
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    /// @brief Make sure that at least count submission queue entries are free (submit prepared entries if not), so linked requests are submitted together
+    void reserve(unsigned count);
+
+    /// @brief Prepare multishot receive to provided buffers. Completions have IORING_CQE_F_MORE flag until the request ends.
+    void prepareMultishotReceive(int fd, uint64_t userData);
+
+    /**
+     * @brief Prepare sendmsg() request. The message header and all buffers have to be valid until the request completes.
+     *
+     * @param fd socket descriptor
+     * @param message message header
+     * @param link true if the next prepared request should start after this one completes (IOSQE_IO_LINK)
+     * @param userData user data of the completion
+     */
+    void prepareSendmsg(int fd, const struct msghdr *message, bool link, uint64_t userData);
+
+    /// @brief Prepare read() request, the buffer has to be valid until the request completes
+    void prepareRead(int fd, void *buffer, unsigned size, uint64_t userData);
+
+    /// @brief Prepare cancellation of all requests of the file descriptor
+    void prepareCancel(int fd, uint64_t userData);
+
+    /**
+     * @brief Submit prepared requests and wait for completions (one io_uring_enter() system call)
+     *
+     * @param waitNr minimal number of completions to wait for (0 just submits and returns)
+     * @param timeoutMs maximal time of waiting in milliseconds
+     * @return false if io_uring_enter() failed
+     */
+    bool submitAndWait(unsigned waitNr, unsigned timeoutMs);
+
+    /// @brief Return true if the completion queue is not empty
+    bool hasCompletions() const;
+
+    /**
+     * @brief Process all available completions. Handler can prepare new requests.
+     *
+     * @param handler function called with each completion (const struct io_uring_cqe &)
+     * @return number of processed completions
+     */
+    template <class Handler>
+    unsigned forEachCompletion(Handler &&handler){
+        unsigned head = *cqHead;
+        unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        unsigned count = tail - head;
+        for (; head != tail; head++){
+            handler(cqes[head & cqMask]);
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+        return count;
+    }
+
+    /// @brief Get provided buffer from a completion (IORING_CQE_F_BUFFER flag)
+    byte *getBuffer(uint16_t bufferID){
+        return buffers.get() + static_cast<size_t>(bufferID) * bufferSize;
+    }
+
+    /// @brief Return provided buffer to the kernel
+    void recycleBuffer(uint16_t bufferID);
+
+    /// @brief Give the number of io_uring_enter() system calls
+    uint64_t getNumberOfSystemCalls() const {
+        return systemCalls;
+    }
+
+private:
+
+    IoUring() = default;
+
+    /// @brief Get next submission queue entry (prepared entries are submitted if the queue is full)
+    struct io_uring_sqe *getSqe();
+
+    /// @brief Make prepared entries visible to the kernel, return number of not submitted entries
+    unsigned flushSubmissionQueue();
+
+    int ringFD = -1;
+    void *sqRing = nullptr;     ///< mapped submission queue ring
+    size_t sqRingSize = 0;
+    void *cqRing = nullptr;     ///< mapped completion queue ring (the same as sqRing with IORING_FEAT_SINGLE_MMAP)
+    size_t cqRingSize = 0;
+    struct io_uring_sqe *sqes = nullptr; ///< mapped submission queue entries
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned sqeTail = 0;       ///< tail of prepared entries (sqTail is updated by flushSubmissionQueue())
+    unsigned submittedTail = 0; ///< tail of entries which were passed to the kernel
+
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned cqMask = 0;
+    struct io_uring_cqe *cqes = nullptr;
+
+    struct io_uring_buf *bufferRing = nullptr; ///< ring of provided buffers shared with the kernel (struct io_uring_buf_ring)
+    size_t bufferRingSize = 0;
+    unsigned bufferCount = 0;
+    unsigned short bufferTail = 0;
+    size_t bufferSize = 0;
+    std::unique_ptr<byte[]> buffers; ///< memory of provided buffers
+
+    uint64_t systemCalls = 0;
+};
+
+
+} // namespace PQB
+
+#endif // PQB_IO_URING
+
+/* END OF FILE */
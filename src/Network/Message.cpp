@@ -14,7 +14,35 @@
 
 namespace PQB{
 
-    Message::Message(const message_hdr_t &messageHeader){
+namespace{
+
+    /// @brief Serialize size and data of a buffer
+    void serializeBuffer(byteBuffer &buffer, size_t &offset, const byteBuffer &field){
+        uint32_t fieldSize = field.size();
+        serializeField(buffer, offset, fieldSize);
+        std::memcpy(buffer.data() + offset, field.data(), fieldSize);
+        offset += fieldSize;
+    }
+
+    /// @brief Deserialize size and data of a buffer
+    /// @return false if the buffer is not complete
+    bool deserializeBuffer(const byteBuffer &buffer, size_t &offset, byteBuffer &field){
+        uint32_t fieldSize;
+        if ((buffer.size() - offset) < sizeof(fieldSize)){
+            return false;
+        }
+        deserializeField(buffer, offset, fieldSize);
+        if ((buffer.size() - offset) < fieldSize){
+            return false;
+        }
+        field.assign(buffer.begin() + offset, buffer.begin() + offset + fieldSize);
+        offset += fieldSize;
+        return true;
+    }
+
+} // namespace
+
+    Message::Message(const message_hdr_t &messageHeader) : sha512CheckSum(0), crc32cCheckSum(0){
         msgHdr = messageHeader;
         currentMessageSize = 0;
         data.resize(msgHdr.size + getHeaderSize(), 0);
@@ -23,6 +51,7 @@ namespace PQB{
     void Message::setRawData(byteBuffer &buffer){
         size_t copySize = (buffer.size() > msgHdr.size) ? msgHdr.size : buffer.size();
         std::memcpy(data.data() + getHeaderSize(), buffer.data(), copySize);
+        invalidateCheckSum();
     }
 
     void Message::serializeMessageHeader(byteBuffer &buffer, size_t &offset, message_hdr_t &header)
@@ -48,6 +77,7 @@ namespace PQB{
 
     void Message::serializeHeader(size_t &offset){
         serializeMessageHeader(data, offset, msgHdr);
+        invalidateCheckSum(); // serializeHeader() is called at the start of each serialization
     }
 
     void Message::deserializeHeader(size_t &offset){
@@ -64,21 +94,92 @@ namespace PQB{
         }
     }
 
+    size_t Message::getMaxPayloadSize(MessageType type){
+        switch (type)
+        {
+        case MessageType::VERSION:
+        case MessageType::ACK:
+            return MAX_HANDSHAKE_MESSAGE_SIZE;
+        case MessageType::TX:
+            return MAX_TX_MESSAGE_SIZE;
+        case MessageType::ACCOUNT:
+            return MAX_ACCOUNT_MESSAGE_SIZE;
+        case MessageType::INV:
+        case MessageType::GETDATA:
+        case MessageType::GETPROPOSALTXS:
+            return MAX_INV_MESSAGE_SIZE;
+        case MessageType::BLOCKPROPOSAL:
+        case MessageType::TXSETPROPOSAL:
+        case MessageType::COMPACTTXSETPROPOSAL:
+        case MessageType::TXSETDELTAPROPOSAL:
+        case MessageType::TXSETSKETCHPROPOSAL:
+        case MessageType::PROPOSALTXS:
+            return MAX_PROPOSAL_MESSAGE_SIZE;
+        case MessageType::BLOCK:
+            return MAX_BLOCK_MESSAGE_SIZE;
+        default:
+            return 0;
+        }
+    }
+
     bool Message::checkMessage() const{
-        if ((data.size() == currentMessageSize) && (msgHdr.magicNum == MESSAGE_MAGIC_CONST)){
-            byte64_t messageHash;
-            HashMan::SHA512_hash(&messageHash, data.data() + getHeaderSize(), getPayloadSize());
-            // compare 32 bits of hash with check sum
-            return (!std::memcmp(messageHash.data(), &msgHdr.checkSum, sizeof(msgHdr.checkSum)));
+        if (data.size() == currentMessageSize){
+            if (msgHdr.magicNum == MESSAGE_MAGIC_CONST){
+                return msgHdr.checkSum == computeCheckSum(FrameCheck::SHA512);
+            } else if (msgHdr.magicNum == MESSAGE_MAGIC_CONST_CRC32C){
+                return msgHdr.checkSum == computeCheckSum(FrameCheck::CRC32C);
+            } else if (msgHdr.magicNum == MESSAGE_MAGIC_CONST_SESSION){
+                return true; // tag is checked by the Connection
+            }
         }
         return false;
     }
 
-    void Message::setCheckSum(){
-        byte64_t messageHash;
-        HashMan::SHA512_hash(&messageHash, data.data() + getHeaderSize(), getPayloadSize());
-        std::memcpy(&msgHdr.checkSum, messageHash.data(), sizeof(msgHdr.checkSum));
-        std::memcpy(data.data() + (getHeaderSize() - sizeof(msgHdr.checkSum)) , &msgHdr.checkSum, sizeof(msgHdr.checkSum));
+    uint32_t Message::getCheckSum(FrameCheck frameCheck) const{
+        if (frameCheck == FrameCheck::SESSION){
+            return 0;
+        }
+        std::atomic<uint64_t> &checkSum = (frameCheck == FrameCheck::CRC32C) ? crc32cCheckSum : sha512CheckSum;
+        uint64_t computed = checkSum.load(std::memory_order_acquire);
+        if ((computed & CHECKSUM_COMPUTED) == 0){
+            // threads which send the message at the same time compute the same value, so no lock is needed
+            computed = CHECKSUM_COMPUTED | computeCheckSum(frameCheck);
+            checkSum.store(computed, std::memory_order_release);
+        }
+        return static_cast<uint32_t>(computed);
+    }
+
+    void Message::getFrameHeader(FrameCheck frameCheck, byte *header) const{
+        message_hdr_t frameHdr = msgHdr;
+        if (frameCheck == FrameCheck::SESSION){
+            frameHdr.magicNum = MESSAGE_MAGIC_CONST_SESSION;
+        } else if (frameCheck == FrameCheck::CRC32C){
+            frameHdr.magicNum = MESSAGE_MAGIC_CONST_CRC32C;
+        } else {
+            frameHdr.magicNum = MESSAGE_MAGIC_CONST;
+        }
+        frameHdr.checkSum = getCheckSum(frameCheck);
+        // the same layout as serializeMessageHeader(), but without a temporary buffer
+        std::memcpy(header, &frameHdr.magicNum, sizeof(frameHdr.magicNum));
+        header += sizeof(frameHdr.magicNum);
+        std::memcpy(header, &frameHdr.type, sizeof(frameHdr.type));
+        header += sizeof(frameHdr.type);
+        std::memcpy(header, &frameHdr.size, sizeof(frameHdr.size));
+        header += sizeof(frameHdr.size);
+        std::memcpy(header, &frameHdr.checkSum, sizeof(frameHdr.checkSum));
+    }
+
+    uint32_t Message::computeCheckSum(FrameCheck frameCheck) const{
+        uint32_t checkSum = 0;
+        if (frameCheck == FrameCheck::CRC32C){
+            checkSum = HashMan::CRC32C(data.data() + getHeaderSize(), getPayloadSize());
+        } else {
+            byteId_t messageHash;
+            HashMan::SHA512_hash(&messageHash, data.data() + getHeaderSize(), getPayloadSize());
+            // check sum is first 32 bits of hash
+            std::memcpy(&checkSum, messageHash.data(), sizeof(checkSum));
+        }
+        return checkSum;
     }
 
     /***** VERSION Message *****/
@@ -90,28 +191,88 @@ namespace PQB{
         serializeField(data, offset, mData->version);
         serializeField(data, offset, mData->nodeType);
         serializeField(data, offset, mData->peerID);
+        if (!mData->kemPublicKey.empty()){
+            serializeBuffer(data, offset, mData->kemPublicKey);
+            serializeBuffer(data, offset, mData->signature);
+        }
     }
 
     void VersionMessage::deserialize(void *messageStruct) const{
         version_msg_t *mData = static_cast<version_msg_t*>(messageStruct);
         size_t offset = getHeaderSize();
+        mData->version = 0;
+        mData->peerID.SetNull();
+        mData->kemPublicKey.clear();
+        mData->signature.clear();
+        if (Message::getPayloadSize() < sizeof(mData->version) + sizeof(mData->nodeType)){
+            return;
+        }
         deserializeField(data, offset, mData->version);
         deserializeField(data, offset, mData->nodeType);
+        // peer with identifiers of different size sends payload of different size
+        if (!hasCompatibleIds(mData->version) || Message::getPayloadSize() < VersionMessage::getPayloadSize()){
+            return;
+        }
         deserializeField(data, offset, mData->peerID);
+        // session offer (malformed offer is ignored)
+        if (offset < data.size()){
+            if (!deserializeBuffer(data, offset, mData->kemPublicKey) || !deserializeBuffer(data, offset, mData->signature)){
+                mData->kemPublicKey.clear();
+                mData->signature.clear();
+            }
+        }
+    }
+
+    void VersionMessage::getSignedHash(const version_msg_t &mData, byteId_t &hash){
+        byteBuffer buffer(getPayloadSize() + sizeof(uint32_t) + mData.kemPublicKey.size());
+        size_t offset = 0;
+        serializeField(buffer, offset, mData.version);
+        serializeField(buffer, offset, mData.nodeType);
+        serializeField(buffer, offset, mData.peerID);
+        serializeBuffer(buffer, offset, mData.kemPublicKey);
+        HashMan::SHA512_hash(&hash, buffer.data(), buffer.size());
     }
 
     /***** ACK Message *****/
 
     void AckMessage::serialize(void *messageStruct){
-        messageStruct = nullptr; // just to fill, there is no structure for ACK message
+        ack_msg_t *mData = static_cast<ack_msg_t*>(messageStruct);
         size_t offset = 0;
         serializeHeader(offset);
-        return;
+        serializeField(data, offset, mData->version);
+        if (!mData->kemCiphertext.empty()){
+            serializeBuffer(data, offset, mData->kemCiphertext);
+            serializeBuffer(data, offset, mData->signature);
+        }
     }
 
     void AckMessage::deserialize(void *messageStruct) const{
-        messageStruct = nullptr; // just to fill, there is no structure for ACK message
-        return;
+        ack_msg_t *mData = static_cast<ack_msg_t*>(messageStruct);
+        mData->kemCiphertext.clear();
+        mData->signature.clear();
+        // ACK message of version 1 has no payload
+        if (Message::getPayloadSize() < AckMessage::getPayloadSize()){
+            mData->version = 1;
+            return;
+        }
+        size_t offset = getHeaderSize();
+        deserializeField(data, offset, mData->version);
+        // accepted session (malformed session is ignored)
+        if (offset < data.size()){
+            if (!deserializeBuffer(data, offset, mData->kemCiphertext) || !deserializeBuffer(data, offset, mData->signature)){
+                mData->kemCiphertext.clear();
+                mData->signature.clear();
+            }
+        }
+    }
+
+    void AckMessage::getSignedHash(const ack_msg_t &mData, const byteId_t &versionHash, byteId_t &hash){
+        byteBuffer buffer(sizeof(versionHash) + getPayloadSize() + sizeof(uint32_t) + mData.kemCiphertext.size());
+        size_t offset = 0;
+        serializeField(buffer, offset, versionHash);
+        serializeField(buffer, offset, mData.version);
+        serializeBuffer(buffer, offset, mData.kemCiphertext);
+        HashMan::SHA512_hash(&hash, buffer.data(), buffer.size());
     }
 
     /***** Block Message *****/
@@ -239,6 +400,98 @@ namespace PQB{
         mData->deserialize(data, offset);
     }
 
+    /***** CompactTxSetProposal Message *****/
+
+    void CompactTxSetProposalMessage::serialize(void *messageStruct){
+        CompactTxSetProposal *mData = static_cast<CompactTxSetProposal*>(messageStruct);
+        size_t offset = 0;
+        serializeHeader(offset);
+        mData->serialize(data, offset);
+    }
+
+    void CompactTxSetProposalMessage::deserialize(void *messageStruct) const{
+        CompactTxSetProposal *mData = static_cast<CompactTxSetProposal*>(messageStruct);
+        size_t offset = getHeaderSize();
+        mData->deserialize(data, offset);
+    }
+
+    /***** TxSetDeltaProposal Message *****/
+
+    void TxSetDeltaProposalMessage::serialize(void *messageStruct){
+        TxSetDeltaProposal *mData = static_cast<TxSetDeltaProposal*>(messageStruct);
+        size_t offset = 0;
+        serializeHeader(offset);
+        mData->serialize(data, offset);
+    }
+
+    void TxSetDeltaProposalMessage::deserialize(void *messageStruct) const{
+        TxSetDeltaProposal *mData = static_cast<TxSetDeltaProposal*>(messageStruct);
+        size_t offset = getHeaderSize();
+        mData->deserialize(data, offset);
+    }
+
+    /***** TxSetSketchProposal Message *****/
+
+    void TxSetSketchProposalMessage::serialize(void *messageStruct){
+        TxSetSketchProposal *mData = static_cast<TxSetSketchProposal*>(messageStruct);
+        size_t offset = 0;
+        serializeHeader(offset);
+        mData->serialize(data, offset);
+    }
+
+    void TxSetSketchProposalMessage::deserialize(void *messageStruct) const{
+        TxSetSketchProposal *mData = static_cast<TxSetSketchProposal*>(messageStruct);
+        size_t offset = getHeaderSize();
+        mData->deserialize(data, offset);
+    }
+
+    /***** GetProposalTxs Message *****/
+
+    void GetProposalTxsMessage::serialize(void *messageStruct){
+        get_proposal_txs_msg_t *mData = static_cast<get_proposal_txs_msg_t*>(messageStruct);
+        size_t offset = 0;
+        serializeHeader(offset);
+        serializeField(data, offset, mData->txSetId);
+        for (const auto index : mData->indexes){
+            serializeField(data, offset, index);
+        }
+    }
+
+    void GetProposalTxsMessage::deserialize(void *messageStruct) const{
+        get_proposal_txs_msg_t *mData = static_cast<get_proposal_txs_msg_t*>(messageStruct);
+        if (Message::getPayloadSize() < GetProposalTxsMessage::getPayloadSize(0)){
+            throw PQB::Exceptions::Message("Deserialization: GETPROPOSALTXS message has not enough size!");
+        }
+        size_t offset = getHeaderSize();
+        deserializeField(data, offset, mData->txSetId);
+        // number of indexes is given by the size of the payload
+        size_t numIndexes = (Message::getPayloadSize() - GetProposalTxsMessage::getPayloadSize(0)) / sizeof(uint32_t);
+        mData->indexes.resize(numIndexes);
+        for (auto &index : mData->indexes){
+            deserializeField(data, offset, index);
+        }
+    }
+
+    /***** ProposalTxs Message *****/
+
+    void ProposalTxsMessage::serialize(void *messageStruct){
+        proposal_txs_msg_t *mData = static_cast<proposal_txs_msg_t*>(messageStruct);
+        size_t offset = 0;
+        serializeHeader(offset);
+        serializeField(data, offset, mData->txSetId);
+        mData->txs.serialize(data, offset);
+    }
+
+    void ProposalTxsMessage::deserialize(void *messageStruct) const{
+        proposal_txs_msg_t *mData = static_cast<proposal_txs_msg_t*>(messageStruct);
+        if (Message::getPayloadSize() < sizeof(mData->txSetId)){
+            throw PQB::Exceptions::Message("Deserialization: PROPOSALTXS message has not enough size!");
+        }
+        size_t offset = getHeaderSize();
+        deserializeField(data, offset, mData->txSetId);
+        mData->txs.deserialize(data, offset);
+    }
+
     /***** MessageCreator *****/
 
     namespace MessageCreator
@@ -257,6 +510,16 @@ namespace PQB{
                 return new BlockProposalMessage(msgHeader);
             case MessageType::TXSETPROPOSAL:
                 return new TxSetProposalMessage(msgHeader);
+            case MessageType::COMPACTTXSETPROPOSAL:
+                return new CompactTxSetProposalMessage(msgHeader);
+            case MessageType::TXSETDELTAPROPOSAL:
+                return new TxSetDeltaProposalMessage(msgHeader);
+            case MessageType::TXSETSKETCHPROPOSAL:
+                return new TxSetSketchProposalMessage(msgHeader);
+            case MessageType::GETPROPOSALTXS:
+                return new GetProposalTxsMessage(msgHeader);
+            case MessageType::PROPOSALTXS:
+                return new ProposalTxsMessage(msgHeader);
             case MessageType::BLOCK:
                 return new BlockMessage(msgHeader);
             case MessageType::ACCOUNT:
@@ -13,8 +13,11 @@
 #include <stdint.h>
 #include <ctime>
 #include <memory>
+#include <atomic>
+#include <algorithm>
 #include "PQBtypedefs.hpp"
 #include "PQBExceptions.hpp"
+#include "PQBconstants.hpp"
 #include "Blob.hpp"
 #include "Transaction.hpp"
 #include "Block.hpp"
@@ -40,10 +43,18 @@ enum class MessageType : uint32_t{
     BLOCKPROPOSAL = 101,
     /// @brief Message poposing a set of transaction to a peer
     TXSETPROPOSAL = 102,
+    /// @brief Message proposing a set of transactions given by short IDs of the transactions (see CompactTxSetProposal)
+    COMPACTTXSETPROPOSAL = 103,
     /// @brief  Message with one account in payload.
     ACCOUNT = 104,
     /// @brief  Message with one block in payload.
     BLOCK = 105,
+    /// @brief Message with transactions of a proposed transaction set, it is a reply to GETPROPOSALTXS message
+    PROPOSALTXS = 106,
+    /// @brief Message proposing a set of transactions as a difference from the previous proposal of the issuer (see TxSetDeltaProposal)
+    TXSETDELTAPROPOSAL = 107,
+    /// @brief Message proposing a set of transactions given by a sketch of short IDs of the transactions (see TxSetSketchProposal)
+    TXSETSKETCHPROPOSAL = 108,
     /// @brief  Message with multiple inventories. Inventory is pair of inventory type and identifier of item.
     /// This message is used to offer to some peer a data about for example block, transaction or account
     INV = 50,
@@ -55,6 +66,9 @@ enum class MessageType : uint32_t{
     /// @brief Message for requesting block inventories. It consists of last block hash which the requesting peer has and number of
     /// following block it is requesting (0 means all). If peer has no blocks yet this field has hash of the genesis block.
     // GETBLOCKS = 53
+    /// @brief Message requesting transactions of a proposed transaction set which could not be found by short IDs of COMPACTTXSETPROPOSAL message.
+    /// It consists of the transaction set ID and indexes of the requested transactions in the set (no indexes means the whole set).
+    GETPROPOSALTXS = 54
 
 };
 
@@ -67,12 +81,35 @@ enum class InvType : uint32_t{
 
 struct inv_message_t{
     InvType requestType;    ///< Type of request, specify what item is requested with this message
-    byte64_t itemID;        ///< unique identifier of the requested item
+    byteId_t itemID;        ///< unique identifier of the requested item
 };
 
 
 /// @brief first 32 bits of SHA-512 hash of empty string. This constant is used as check if message header was parsed successfully
 const uint32_t MESSAGE_MAGIC_CONST = 3481526581;
+/// @brief Magic number of messages with CRC32C check sum (CRC32C of the empty string is 0, so the constant is MESSAGE_MAGIC_CONST with inverted bits)
+const uint32_t MESSAGE_MAGIC_CONST_CRC32C = ~MESSAGE_MAGIC_CONST;
+/// @brief Magic number of messages authenticated by the session of the connection (halves of MESSAGE_MAGIC_CONST swapped).
+/// These messages have check sum 0 and they are followed by PeerSession::TAG_SIZE bytes long tag, which is not part of the payload.
+const uint32_t MESSAGE_MAGIC_CONST_SESSION = (MESSAGE_MAGIC_CONST << 16) | (MESSAGE_MAGIC_CONST >> 16);
+/// @brief First message version which supports CRC32C check sum
+const uint32_t MESSAGE_VERSION_CRC32C = 2;
+/// @brief First message version which supports session handshake in VERSION and ACK messages
+const uint32_t MESSAGE_VERSION_SESSION = 3;
+/// @brief First message version which supports COMPACTTXSETPROPOSAL, GETPROPOSALTXS and PROPOSALTXS messages
+const uint32_t MESSAGE_VERSION_COMPACT_PROPOSAL = 4;
+/// @brief First message version which supports TXSETDELTAPROPOSAL message
+const uint32_t MESSAGE_VERSION_DELTA_PROPOSAL = 5;
+/// @brief First message version which supports TXSETSKETCHPROPOSAL message
+const uint32_t MESSAGE_VERSION_SKETCH_PROPOSAL = 6;
+
+/// @brief Algorithms for checking integrity of a message. Used algorithm is negotiated by message version in VERSION and ACK messages.
+/// The algorithm of received message is determined by the magic number in message header.
+enum class FrameCheck : uint32_t{
+    SHA512, ///< first 32 bits of SHA-512 hash of message payload (message version 1)
+    CRC32C, ///< CRC32C of message payload (message version >= 2)
+    SESSION ///< Poly1305 tag of the whole message computed by the session of the connection (see PeerSession)
+};
 
 class Message{
 public:
@@ -81,7 +118,7 @@ public:
         uint32_t magicNum;  ///< Number for checking if header was well parsed
         MessageType type;   ///< Type of the message
         uint32_t size;      ///< Size of message payload (without header size !)
-        uint32_t checkSum;  ///< Check sum of the message (first 32 bits of SHA-512 hash of the message). This field has to stay at last position in message_hdr_t struct!
+        uint32_t checkSum;  ///< Check sum of the message (CRC32C or first 32 bits of SHA-512 hash of the message, see FrameCheck). This field has to stay at last position in message_hdr_t struct!
         // DO NOT ADD OTHER FIELDS HERE. checkSum has to stay as last field of message_hdr_t struct!
     };
 
@@ -93,14 +130,22 @@ public:
         return data.data();
     }
 
+    /// @brief get pointer to message data (with header)
+    const PQB::byte *getData() const {
+        return data.data();
+    }
+
     /// @brief get size of message data (with header) in bytes
     size_t getSize() const {
         return data.size();
     }
 
+    /// @brief Size of the message header in bytes
+    static constexpr size_t HEADER_SIZE = sizeof(uint32_t) * 4; // sizeof(magicNum) + sizeof(type) + sizeof(size) + sizeof(checksum)
+
     /// @brief Get size of the message header in bytes 
     static size_t getHeaderSize(){
-        return sizeof(uint32_t) * 4; // sizeof(magicNum) + sizeof(type) + sizeof(size) + sizeof(checksum)
+        return HEADER_SIZE;
     }
 
     /// @brief Get size of message data without header
@@ -159,11 +204,79 @@ public:
      */
     void addFragment(const char* fragment, size_t size);
 
+    /// @brief Get pointer to the first byte of the message data which was not received yet. Received bytes can be written
+    /// there directly (up to getMissingSize() bytes) and confirmed by fragmentReceived().
+    byte *getMissingData(){
+        return data.data() + currentMessageSize;
+    }
+
+    /// @brief Get number of bytes of the message data which were not received yet
+    size_t getMissingSize() const {
+        return data.size() - currentMessageSize;
+    }
+
+    /// @brief Confirm that size bytes were written to getMissingData()
+    void fragmentReceived(size_t size){
+        currentMessageSize += std::min(size, getMissingSize());
+    }
+
+    /// @brief Get maximal allowed payload size of a received message of given type (0 for unknown types)
+    static size_t getMaxPayloadSize(MessageType type);
+
     /// @brief Check message size, MAGIC_CONST and the checkSum (message data has to be complete before checking else it returns false)
+    /// Check sum algorithm is chosen by the magic number in the message header. Tag of a message authenticated by a session
+    /// is not checked here, it is checked by the Connection.
     bool checkMessage() const;
 
-    /// @brief set the check sum of this message (check sum is 32 bits of message data hash)
-    void setCheckSum();
+    /**
+     * @brief Get the check sum of message payload for given frame check algorithm. The check sum for each algorithm is computed
+     * just once and it is reused when the message is sent to multiple peers (it is computed again only if message data were
+     * changed by serialize() or setRawData()). The check sum for FrameCheck::SESSION is 0, the tag is computed by the Connection.
+     * 
+     * @param frameCheck algorithm used for check sum
+     */
+    uint32_t getCheckSum(FrameCheck frameCheck) const;
+
+    /**
+     * @brief Write the message header with the magic number and the check sum of given frame check algorithm. Message data
+     * are not changed, so a serialized message can be sent by multiple threads at once, each frame just gets its own header.
+     * 
+     * @param frameCheck algorithm used for check sum
+     * @param header [out] buffer of HEADER_SIZE bytes
+     */
+    void getFrameHeader(FrameCheck frameCheck, byte *header) const;
+
+    /// @brief Check if given magic number is valid magic number of a message header
+    static bool isValidMagicNumber(uint32_t magicNum){
+        return (magicNum == MESSAGE_MAGIC_CONST || magicNum == MESSAGE_MAGIC_CONST_CRC32C || magicNum == MESSAGE_MAGIC_CONST_SESSION);
+    }
+
+    /// @brief Get frame check algorithm for given message version
+    static FrameCheck getFrameCheckForVersion(uint32_t version){
+        return ((version & ~MSG_FLAG_SHORT_IDS) >= MESSAGE_VERSION_CRC32C) ? FrameCheck::CRC32C : FrameCheck::SHA512;
+    }
+
+    /// @brief Check if a peer with given message version understands messages of given type
+    static bool isSupportedByVersion(MessageType type, uint32_t version){
+        switch (type)
+        {
+        case MessageType::COMPACTTXSETPROPOSAL:
+        case MessageType::GETPROPOSALTXS:
+        case MessageType::PROPOSALTXS:
+            return (version & ~MSG_FLAG_SHORT_IDS) >= MESSAGE_VERSION_COMPACT_PROPOSAL;
+        case MessageType::TXSETDELTAPROPOSAL:
+            return (version & ~MSG_FLAG_SHORT_IDS) >= MESSAGE_VERSION_DELTA_PROPOSAL;
+        case MessageType::TXSETSKETCHPROPOSAL:
+            return (version & ~MSG_FLAG_SHORT_IDS) >= MESSAGE_VERSION_SKETCH_PROPOSAL;
+        default:
+            return true;
+        }
+    }
+
+    /// @brief Check if a peer with given message version uses identifiers of the same size as this node
+    static bool hasCompatibleIds(uint32_t version){
+        return (version & MSG_FLAG_SHORT_IDS) == (MSG_VERSION & MSG_FLAG_SHORT_IDS);
+    }
 
     /**
      * @brief Serialize given message structure with message header to one buffer (attribute data).
@@ -206,6 +319,16 @@ public:
             return "BLOCK PROPOSAL";
         case MessageType::TXSETPROPOSAL:
             return "TX SET PROPOSAL";
+        case MessageType::COMPACTTXSETPROPOSAL:
+            return "COMPACT TX SET PROPOSAL";
+        case MessageType::GETPROPOSALTXS:
+            return "GET PROPOSAL TXS";
+        case MessageType::PROPOSALTXS:
+            return "PROPOSAL TXS";
+        case MessageType::TXSETDELTAPROPOSAL:
+            return "TX SET DELTA PROPOSAL";
+        case MessageType::TXSETSKETCHPROPOSAL:
+            return "TX SET SKETCH PROPOSAL";
         default:
             return "UNKNOW";
         }
@@ -216,27 +339,59 @@ protected:
     byteBuffer data;        ///< byte buffer representing message data (at the begining of these buffer is also the header)
 private:
     size_t currentMessageSize; ///< size of added message fragments in bytes
+    /// @brief Flag of a computed check sum in sha512CheckSum and crc32cCheckSum (lower 32 bits are the check sum)
+    static constexpr uint64_t CHECKSUM_COMPUTED = 1ULL << 32;
+    mutable std::atomic<uint64_t> sha512CheckSum; ///< computed SHA-512 check sum of message payload (0 if not computed)
+    mutable std::atomic<uint64_t> crc32cCheckSum; ///< computed CRC32C check sum of message payload (0 if not computed)
+
+    /// @brief Compute the check sum of message payload with given algorithm
+    uint32_t computeCheckSum(FrameCheck frameCheck) const;
+
+    /// @brief Forget computed check sums (message data were changed)
+    void invalidateCheckSum(){
+        sha512CheckSum = 0;
+        crc32cCheckSum = 0;
+    }
 };
 
 
+typedef std::shared_ptr<const Message> MessagePtr; ///< Shared pointer to serialized message (message is shared by outbound queues of all connections it is sent to)
+
+
 class VersionMessage : public Message{
 public:
 
     struct version_msg_t{
         uint32_t version;
         NodeType nodeType;
-        byte64_t peerID;
+        byteId_t peerID;
+        byteBuffer kemPublicKey = {};   ///< ephemeral Kyber1024 public key offering a session (empty if session is not offered)
+        byteBuffer signature = {};      ///< signature of getSignedHash() by the peer (only with kemPublicKey)
     };
 
     VersionMessage(size_t messageSize) : Message(constructMessageHeader(messageSize)) {}
     VersionMessage(message_hdr_t &messageHeader) : Message(messageHeader) {}
 
+    /// @brief Size of the payload without session offer
     static size_t getPayloadSize(){
         return sizeof(uint32_t) + // sizeof(version)
                sizeof(uint32_t) + // sizeof(nodeType)
-               sizeof(byte64_t);  // sizeof(peerID)
+               sizeof(byteId_t);  // sizeof(peerID)
     }
 
+    /// @brief Size of the payload with session offer (if mData.kemPublicKey is not empty)
+    static size_t getPayloadSize(const version_msg_t &mData){
+        if (mData.kemPublicKey.empty()){
+            return getPayloadSize();
+        }
+        return getPayloadSize() +
+               sizeof(uint32_t) + mData.kemPublicKey.size() + // size and data of kemPublicKey
+               sizeof(uint32_t) + mData.signature.size();     // size and data of signature
+    }
+
+    /// @brief Get hash of the version message fields which is signed by the peer offering a session (all fields except signature)
+    static void getSignedHash(const version_msg_t &mData, byteId_t &hash);
+
     ///@brief messageStruct is version_msg_t structure
     void serialize(void *messageStruct) override;
 
@@ -259,17 +414,44 @@ private:
 class AckMessage : public Message{
 public:
 
+    struct ack_msg_t{
+        uint32_t version;           ///< message version of the peer which accepted the connection
+        byteBuffer kemCiphertext = {};  ///< Kyber1024 ciphertext accepting offered session (empty if session is not accepted)
+        byteBuffer signature = {};      ///< signature of getSignedHash() by the peer (only with kemCiphertext)
+    };
+
     AckMessage(size_t messageSize) : Message(constructMessageHeader(messageSize)) {}
     AckMessage(message_hdr_t &messageHeader) : Message(messageHeader) {}
 
+    /// @brief Size of the payload without accepted session
     static size_t getPayloadSize(){
-        return 0; // ACK message has no payload
+        return sizeof(uint32_t); // sizeof(version)
     }
 
-    /// @brief ACK has no payload messageStruct may be anything, this parameter is ignored
+    /// @brief Size of the payload with accepted session (if mData.kemCiphertext is not empty)
+    static size_t getPayloadSize(const ack_msg_t &mData){
+        if (mData.kemCiphertext.empty()){
+            return getPayloadSize();
+        }
+        return getPayloadSize() +
+               sizeof(uint32_t) + mData.kemCiphertext.size() + // size and data of kemCiphertext
+               sizeof(uint32_t) + mData.signature.size();      // size and data of signature
+    }
+
+    /**
+     * @brief Get hash of the ACK message fields which is signed by the peer accepting a session (all fields except signature).
+     * The hash also covers the signed hash of the VERSION message, so it is the hash of the whole handshake.
+     * 
+     * @param mData ACK message fields
+     * @param versionHash VersionMessage::getSignedHash() of the VERSION message offering the session
+     * @param hash [out] computed hash
+     */
+    static void getSignedHash(const ack_msg_t &mData, const byteId_t &versionHash, byteId_t &hash);
+
+    /// @brief messageStruct is ack_msg_t structure
     void serialize(void *messageStruct) override;
 
-    /// @brief ACK has no payload messageStruct may be anything, this parameter is ignored
+    /// @brief messageStruct is ack_msg_t structure. ACK messages of version 1 have no payload, in that case version is set to 1.
     void deserialize(void *messageStruct) const override;
 
 private:
@@ -367,7 +549,7 @@ public:
     /// @param numOfInv number of inventories
     /// @return Size of InvMessage
     static size_t getPayloadSize(size_t numOfInv){
-        return (sizeof(InvType) + sizeof(byte64_t)) * numOfInv;
+        return (sizeof(InvType) + sizeof(byteId_t)) * numOfInv;
     }
 
     /// @brief messageStruct is a vector of inv_message_t strucutres! This is because InvMessage can include more inventories.
@@ -398,7 +580,7 @@ public:
     /// @param numOfInv number of inventories
     /// @return Size of GetDataMessage
     static size_t getPayloadSize(size_t numOfInv){
-        return (sizeof(InvType) + sizeof(byte64_t)) * numOfInv;
+        return (sizeof(InvType) + sizeof(byteId_t)) * numOfInv;
     }
 
     /// @brief messageStruct is a vector of inv_message_t strucutres! This is because InvMessage can include more inventories.
@@ -466,6 +648,149 @@ private:
 };
 
 
+class CompactTxSetProposalMessage : public Message{
+public:
+
+    CompactTxSetProposalMessage(size_t messageSize) : Message(constructMessageHeader(messageSize)) {}
+    CompactTxSetProposalMessage(message_hdr_t &messageHeader) : Message(messageHeader) {}
+
+    /// @brief messageStruct is PQB::CompactTxSetProposal object
+    void serialize(void *messageStruct) override;
+
+    /// @brief messageStruct is PQB::CompactTxSetProposal object
+    void deserialize(void *messageStruct) const override;
+
+private:
+    static message_hdr_t constructMessageHeader(size_t messageSize){
+        message_hdr_t hdr;
+        hdr.magicNum = MESSAGE_MAGIC_CONST;
+        hdr.type = MessageType::COMPACTTXSETPROPOSAL;
+        hdr.size = messageSize;
+        hdr.checkSum = 0;
+        return hdr;
+    }
+};
+
+
+class TxSetDeltaProposalMessage : public Message{
+public:
+
+    TxSetDeltaProposalMessage(size_t messageSize) : Message(constructMessageHeader(messageSize)) {}
+    TxSetDeltaProposalMessage(message_hdr_t &messageHeader) : Message(messageHeader) {}
+
+    /// @brief messageStruct is PQB::TxSetDeltaProposal object
+    void serialize(void *messageStruct) override;
+
+    /// @brief messageStruct is PQB::TxSetDeltaProposal object
+    void deserialize(void *messageStruct) const override;
+
+private:
+    static message_hdr_t constructMessageHeader(size_t messageSize){
+        message_hdr_t hdr;
+        hdr.magicNum = MESSAGE_MAGIC_CONST;
+        hdr.type = MessageType::TXSETDELTAPROPOSAL;
+        hdr.size = messageSize;
+        hdr.checkSum = 0;
+        return hdr;
+    }
+};
+
+
+class TxSetSketchProposalMessage : public Message{
+public:
+
+    TxSetSketchProposalMessage(size_t messageSize) : Message(constructMessageHeader(messageSize)) {}
+    TxSetSketchProposalMessage(message_hdr_t &messageHeader) : Message(messageHeader) {}
+
+    /// @brief messageStruct is PQB::TxSetSketchProposal object
+    void serialize(void *messageStruct) override;
+
+    /// @brief messageStruct is PQB::TxSetSketchProposal object
+    void deserialize(void *messageStruct) const override;
+
+private:
+    static message_hdr_t constructMessageHeader(size_t messageSize){
+        message_hdr_t hdr;
+        hdr.magicNum = MESSAGE_MAGIC_CONST;
+        hdr.type = MessageType::TXSETSKETCHPROPOSAL;
+        hdr.size = messageSize;
+        hdr.checkSum = 0;
+        return hdr;
+    }
+};
+
+
+class GetProposalTxsMessage : public Message{
+public:
+
+    struct get_proposal_txs_msg_t{
+        byteId_t txSetId;               ///< ID of the proposed transaction set
+        std::vector<uint32_t> indexes;  ///< indexes of requested transactions in the set (empty for the whole set)
+    };
+
+    GetProposalTxsMessage(size_t messageSize) : Message(constructMessageHeader(messageSize)) {}
+    GetProposalTxsMessage(message_hdr_t &messageHeader) : Message(messageHeader) {}
+
+    /// @brief Determine size of GetProposalTxsMessage
+    /// @param numOfIndexes number of requested transactions (0 for the whole set)
+    /// @return Size of GetProposalTxsMessage
+    static size_t getPayloadSize(size_t numOfIndexes){
+        return sizeof(byteId_t) + sizeof(uint32_t) * numOfIndexes;
+    }
+
+    /// @brief messageStruct is get_proposal_txs_msg_t structure
+    void serialize(void *messageStruct) override;
+
+    /// @brief messageStruct is get_proposal_txs_msg_t structure
+    /// @exception if the payload is too short
+    void deserialize(void *messageStruct) const override;
+
+private:
+    static message_hdr_t constructMessageHeader(size_t messageSize){
+        message_hdr_t hdr;
+        hdr.magicNum = MESSAGE_MAGIC_CONST;
+        hdr.type = MessageType::GETPROPOSALTXS;
+        hdr.size = messageSize;
+        hdr.checkSum = 0;
+        return hdr;
+    }
+};
+
+
+class ProposalTxsMessage : public Message{
+public:
+
+    struct proposal_txs_msg_t{
+        byteId_t txSetId;   ///< ID of the proposed transaction set
+        BlockBody txs;      ///< requested transactions of the set (with signatures)
+    };
+
+    ProposalTxsMessage(size_t messageSize) : Message(constructMessageHeader(messageSize)) {}
+    ProposalTxsMessage(message_hdr_t &messageHeader) : Message(messageHeader) {}
+
+    /// @brief Determine size of ProposalTxsMessage
+    static size_t getPayloadSize(const proposal_txs_msg_t &mData){
+        return sizeof(byteId_t) + mData.txs.getSize();
+    }
+
+    /// @brief messageStruct is proposal_txs_msg_t structure
+    void serialize(void *messageStruct) override;
+
+    /// @brief messageStruct is proposal_txs_msg_t structure
+    void deserialize(void *messageStruct) const override;
+
+private:
+    static message_hdr_t constructMessageHeader(size_t messageSize){
+        message_hdr_t hdr;
+        hdr.magicNum = MESSAGE_MAGIC_CONST;
+        hdr.type = MessageType::PROPOSALTXS;
+        hdr.size = messageSize;
+        hdr.checkSum = 0;
+        return hdr;
+    }
+};
+
+
 namespace MessageCreator{
 
     /// @brief Create a Message object based on given Message header
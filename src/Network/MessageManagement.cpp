@@ -16,9 +16,32 @@
 namespace PQB
 {
 
-    ConnectionManager::ConnectionManager(MessageProcessor *msgProcessor, AccountAddressStorage *addressStorage, Wallet *wallet, NodeType type)
+    ConnectionManager::ConnectionManager(MessageProcessor *msgProcessor, AccountAddressStorage *addressStorage, Wallet *wallet, NodeType type,
+                                         size_t numOfIOThreads, IOBackend backend)
     : messsagProcessor(msgProcessor), addrStorage(addressStorage), wallet_(wallet), localNodeType(type){
         counterOfProcessedBytes_ = 0;
+        sentRequests_ = 0;
+        queueLatencySumUs_ = 0;
+        queueLatencyMaxUs_ = 0;
+        epollFD = epoll_create1(EPOLL_CLOEXEC);
+        if (epollFD < 0){
+            PQB_LOG_ERROR("CONNECTION MANAGER", "epoll_create1() function failed");
+        }
+        wakeupFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wakeupFD < 0){
+            PQB_LOG_ERROR("CONNECTION MANAGER", "eventfd() function failed");
+        } else {
+            addSocketDescriptor(wakeupFD);
+        }
+        if (numOfIOThreads == 0){
+            numOfIOThreads = std::thread::hardware_concurrency() / 4;
+            if (numOfIOThreads == 0)
+                numOfIOThreads = 1;
+        }
+        for (size_t i = 0; i < numOfIOThreads; i++){
+            reactors.push_back(new NetworkReactor(this, i, backend));
+        }
+        PQB_LOG_INFO("CONNECTION MANAGER", "{} network I/O threads started", reactors.size());
         server = new Server();
         runServer();
         connectionManagerRunFlag = true;
@@ -27,89 +50,188 @@ namespace PQB
 
     ConnectionManager::~ConnectionManager(){
         connectionManagerRunFlag = false;
+        wakeup();
         if (connectionManagerThread.joinable())
             connectionManagerThread.join();
-        // Delete all connections
-        for (auto &connection : connectionPool){
-            delete connection.second;
-        }
-        // Delete all messages in message requests
-        while (!messageRequestQueue.empty()){
-            MessageRequest_t req = messageRequestQueue.top();
-            delete req.message;
-            messageRequestQueue.pop();
+        // Reactors close their connections
+        for (auto reactor : reactors){
+            delete reactor;
         }
-        
         delete server;
+        if (wakeupFD >= 0){
+            close(wakeupFD);
+        }
+        if (epollFD >= 0){
+            close(epollFD);
+        }
     }
 
     void ConnectionManager::addMessageRequest(MessageRequest_t req){
-        std::lock_guard<std::mutex> lock(messageRequestQueueMutex);
-        messageRequestQueue.push(req);
+        req.enqueued = std::chrono::steady_clock::now();
+        // message is shared by all I/O threads and outbound queues of all receivers, it is deleted when the last one sends it
+        MessagePtr message(req.message);
+        LazyMessagePtr legacyMessage = nullptr;
+        if (req.legacyMessage != nullptr){
+            legacyMessage = std::make_shared<LazyMessage_t>();
+            legacyMessage->factory = std::move(req.legacyMessage);
+        }
+        counterOfProcessedBytes_ += message->getSize(); // just for the statistics
+        if (req.type == MessageRequestType::ONE){
+            NetworkReactor *reactor = getConnectionOwner(req.connectionID);
+            if (reactor != nullptr){
+                reactor->addMessageRequest(req, message, legacyMessage, true);
+            }
+            return;
+        }
+        // check sum of the current message version is computed once here, not by each I/O thread
+        message->getCheckSum(Message::getFrameCheckForVersion(MSG_VERSION));
+        for (size_t i = 0; i < reactors.size(); i++){
+            reactors[i]->addMessageRequest(req, message, legacyMessage, i == 0);
+        }
     }
 
     void ConnectionManager::addConnectionRequest(ConnectionRequest_t req){
         PQB_LOG_TRACE("CONNECTION MANAGER", "Connection request {} added", shortStr(req.peerID));
-        std::lock_guard<std::mutex> lock(connectionRequestQueueMutex);
-        connectionRequestQueue.push(req);
+        {
+            std::lock_guard<std::mutex> lock(connectionRequestQueueMutex);
+            connectionRequestQueue.push(req);
+        }
+        wakeup();
+    }
+
+    ConnectionManager::QueueLatency_t ConnectionManager::getQueueLatency(){
+        uint64_t requests = sentRequests_;
+        QueueLatency_t latency = {.requests=requests, .averageMs=0.0, .maxMs=queueLatencyMaxUs_ / 1000.0};
+        if (requests > 0){
+            latency.averageMs = (queueLatencySumUs_ / 1000.0) / requests;
+        }
+        return latency;
+    }
+
+    uint64_t ConnectionManager::getNumberOfDroppedMessages(){
+        uint64_t dropped = 0;
+        for (const auto reactor : reactors){
+            dropped += reactor->getStats().droppedMessages;
+        }
+        return dropped;
+    }
+
+    void ConnectionManager::putIOThreadStatsToStringStream(std::stringstream &ss){
+        ss
+        << std::setw(8) << std::left << "Thread"
+        << std::setw(13) << std::left << "Connections"
+        << std::setw(12) << std::left << "Received"
+        << std::setw(16) << std::left << "Received B"
+        << std::setw(12) << std::left << "Sent"
+        << std::setw(10) << std::left << "Dropped"
+        << std::setw(12) << std::left << "Loops"
+        << std::setw(12) << std::left << "Syscalls"
+        << std::setw(10) << std::left << "Backend"
+        << std::endl;
+
+        for (size_t i = 0; i < reactors.size(); i++){
+            NetworkReactor::Stats_t stats = reactors[i]->getStats();
+            ss
+            << std::setw(8) << i
+            << std::setw(13) << stats.connections
+            << std::setw(12) << stats.receivedMessages
+            << std::setw(16) << stats.receivedBytes
+            << std::setw(12) << stats.sentMessages
+            << std::setw(10) << stats.droppedMessages
+            << std::setw(12) << stats.loops
+            << std::setw(12) << stats.systemCalls
+            << std::setw(10) << (stats.backend == IOBackend::IO_URING ? "io_uring" : "epoll")
+            << std::endl;
+        }
+    }
+
+    void ConnectionManager::wakeup(){
+        if (wakeupFD >= 0){
+            uint64_t one = 1;
+            ssize_t ret = write(wakeupFD, &one, sizeof(one));
+            (void)ret; // counter overflow (EAGAIN) means that the thread is already signaled
+        }
+    }
+
+    void ConnectionManager::recordQueueLatency(std::chrono::steady_clock::time_point enqueued){
+        uint64_t latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - enqueued).count();
+        sentRequests_++;
+        queueLatencySumUs_ += latencyUs;
+        // I/O threads record latencies concurrently
+        uint64_t maxUs = queueLatencyMaxUs_;
+        while (latencyUs > maxUs && !queueLatencyMaxUs_.compare_exchange_weak(maxUs, latencyUs)){
+        }
     }
 
     int ConnectionManager::getConnectionID(std::string &peerID){
-        Connection *conn = getConnectionFromConnectionPool(peerID);
-        if (conn != nullptr){
-            return conn->getConnectionSocketFD();
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto it = peerConnections.find(peerID);
+        if (it != peerConnections.end()){
+            return it->second.connectionID;
         }
         return -1;
     }
 
-    void ConnectionManager::notifyConnectionVersion(socket_t connectionID, std::string &peerID, bool status){
-        // If connection was considered unwanted close it and delete from connectionPool
+    void ConnectionManager::notifyConnectionVersion(socket_t connectionID, std::string &peerID, uint32_t peerVersion, bool status,
+                                                    AckMessage::ack_msg_t &ackData, PeerSessionPtr session){
+        NetworkReactor *reactor = getConnectionOwner(connectionID);
+        if (reactor == nullptr){
+            return;
+        }
+        // If connection was considered unwanted close it
         if (!status){
-            /// The connection can not be deleted right now, because manageConnections() method is iterating through connection set
-            socketsToClose.push_back(connectionID);
+            reactor->closeConnection(connectionID);
             PQB_LOG_INFO("CONNECTION MANAGER", "Connection with {} will be closed because of negative status", shortStr(peerID));
             return;
         }
 
-        Connection *thisConn = getConnectionFromConnectionPool(connectionID);
+        // UNL status is given only to connections with a session, so the peer can not get it just by claiming ID from the UNL
+        bool isUNL = grantsUNLStatus(wallet_->getUNL(), peerID, session != nullptr);
 
         // Handle duplicit connections
-        if (isConnectionInConnectionPool(peerID)){
-            // If same connection already exists, then there is need to keep just one of these connections.
-            // To decide deterministically local wallet ID (local user ID) and connected peer ID are alphabetically compared.
-            // This problem may occure if when two peers initialize connection with each other at the same time, so
-            // they send VERSION message to each other and they are both waiting for ACK message.
-            if (wallet_->getWalletID().getHex() > peerID){ // If local wallet ID > peer ID, delete new connection and keep existing connection
-                socketsToClose.push_back(connectionID);
-                PQB_LOG_INFO("CONNECTION MANAGER", "Duplicit connection with {} peer connection will be closed", shortStr(peerID));
-                return;
-            } else { // Delete existing connection and keep this connection
-                Connection *exConn= getConnectionFromConnectionPool(peerID);
-                // if existing connection was UNL connection this has to keep at as well
-                thisConn->isUNL = exConn->isUNL;
-                // Because there will be inserted new peerID in setOfConnectedPeers, existing peerID has to be renamed first and then
-                // added to vector with socketIDs to delete. New name will be just the substring of former peerID
-                std::string newId = peerID.substr(64);
-                updatePeerIdOfConnectionInConnectionPool(exConn->getConnectionSocketFD(), peerID, newId);
-                socketsToClose.push_back(exConn->getConnectionSocketFD());
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            auto existing = peerConnections.find(peerID);
+            if (existing != peerConnections.end() && existing->second.connectionID != connectionID){
+                // If same connection already exists, then there is need to keep just one of these connections.
+                // This problem may occure if when two peers initialize connection with each other at the same time, so
+                // they send VERSION message to each other and they are both waiting for ACK message.
+                if (!keepNewConnection(isUNL, existing->second.isUNL, wallet_->getWalletID().getHex(), peerID)){
+                    reactor->closeConnection(connectionID);
+                    PQB_LOG_INFO("CONNECTION MANAGER", "Duplicit connection with {} peer connection will be closed", shortStr(peerID));
+                    return;
+                }
+                // Delete existing connection and keep this connection.
+                // The peer ID is taken over by this connection, so closing of the existing connection does not remove it.
+                auto owner = connectionOwners.find(existing->second.connectionID);
+                if (owner != connectionOwners.end()){
+                    owner->second->closeConnection(existing->second.connectionID);
+                }
+                peerConnections.erase(existing);
                 PQB_LOG_INFO("CONNECTION MANAGER", "Duplicit connection with {} our connection will be closed", shortStr(peerID));
             }
         }
-        // Check for UNL connections
-        for (const auto &peer : wallet_->getUNL()){
-            if (peer == peerID){
-                thisConn->isUNL = true;
-            }
-        }
 
-        PQB_LOG_TRACE("CONNECTION MANAGER", "Connection {} renamed to {}", shortStr(thisConn->connID), shortStr(peerID));
-        updatePeerIdOfConnectionInConnectionPool(connectionID, thisConn->connID, peerID);
-        thisConn->isConfirmed = true;
         /// Send ACK
-        AckMessage *msg = new AckMessage(AckMessage::getPayloadSize());
-        msg->serialize(nullptr);
-        MessageRequest_t req = {.type=MessageRequestType::ONE, .connectionID=thisConn->getConnectionSocketFD(), .peerID=peerID, .message=msg};
-        addMessageRequest(req);
+        auto msg = std::make_shared<AckMessage>(AckMessage::getPayloadSize(ackData));
+        msg->serialize(&ackData);
+        reactor->confirmConnection(connectionID, peerID, peerVersion, isUNL, std::move(session), msg);
+    }
+
+    bool ConnectionManager::grantsUNLStatus(const std::vector<std::string> &unl, const std::string &peerID, bool hasSession){
+        if (!hasSession){
+            return false;
+        }
+        return std::find(unl.begin(), unl.end(), peerID) != unl.end();
+    }
+
+    bool ConnectionManager::keepNewConnection(bool newHasSession, bool existingHasSession, const std::string &localID, const std::string &peerID){
+        if (newHasSession != existingHasSession){
+            return newHasSession;
+        }
+        // To decide deterministically local wallet ID (local user ID) and connected peer ID are alphabetically compared.
+        // If local wallet ID > peer ID, the existing connection is kept.
+        return localID <= peerID;
     }
 
     void ConnectionManager::putConnectionDataToStringStream(std::stringstream &ss){
@@ -118,16 +240,12 @@ namespace PQB
         << std::setw(11) << std::left << "Socket fd"
         << std::setw(14) << std::left << "Is confirmed"
         << std::setw(8) << std::left << "Is UNL"
+        << std::setw(12) << std::left << "Queued B"
+        << std::setw(8) << std::left << "Thread"
         << std::endl;
 
-        for (const auto &it : connectionPool){
-            Connection *conn = it.second;
-            ss
-            << std::setw(15) << shortStr(conn->connID)
-            << std::setw(11) << it.first
-            << std::setw(14) << (conn->isConfirmed ? "true" : "false")
-            << std::setw(8) << (conn->isUNL ? "true" : "false") 
-            << std::endl;
+        for (const auto reactor : reactors){
+            reactor->putConnectionDataToStringStream(ss);
         }
     }
 
@@ -146,160 +264,139 @@ namespace PQB
         }
         PQB_LOG_INFO("CONNECTION MANAGER", "Connection with peer: {} established", shortStr(peerID));
         Connection *connection = new Connection(peerID, sock, isOnUNL);
-        if (!addConnectionToConnectionPool(sock->getSocketFD(), connection, peerID)){
+        // Send VERSION message
+        VersionMessage::version_msg_t mData = {.version=MSG_VERSION, .nodeType=localNodeType, .peerID=wallet_->getWalletID()};
+        std::shared_ptr<VersionMessage> msg;
+        if (isOnUNL && offerSession(connection, peerID, mData)){
+            // Connection with offered session is confirmed when the session is established by ACK message,
+            // so no message is sent on it without the session. VERSION message is sent as the first message.
+            msg = std::make_shared<VersionMessage>(VersionMessage::getPayloadSize(mData));
+        } else {
+            // Without session the peer is not authenticated, so the connection can not be UNL connection
+            if (isOnUNL){
+                PQB_LOG_WARN("CONNECTION MANAGER", "Connection with {} will not be UNL connection without session", shortStr(peerID));
+            }
+            connection->isUNL = false;
+            connection->isConfirmed = true;
+            msg = std::make_shared<VersionMessage>(VersionMessage::getPayloadSize());
+        }
+        NetworkReactor *reactor = chooseReactor();
+        if (!registerConnection(sock->getSocketFD(), peerID, reactor, connection->isUNL)){
             delete connection;
             return false;
         }
-        connection->isConfirmed = true;
-        // Send VERSION message
-        VersionMessage *msg = new VersionMessage(VersionMessage::getPayloadSize());
-        VersionMessage::version_msg_t mData = {.version=MSG_VERSION, .nodeType=localNodeType, .peerID=wallet_->getWalletID()};
         msg->serialize(&mData);
-        MessageRequest_t req = {.type=MessageRequestType::ONE, .connectionID=sock->getSocketFD(), .peerID=peerID, .message=msg};
-        addMessageRequest(req);
+        reactor->addConnection(connection, msg);
         return true;
     }
 
-    bool ConnectionManager::acceptNewConnection(std::string &port, Sock *socket){
-        Connection *connection = new Connection(port, socket);
-        if (!addConnectionToConnectionPool(socket->getSocketFD(), connection, port)){
-            delete connection;
+    bool ConnectionManager::offerSession(Connection *connection, std::string &peerID, VersionMessage::version_msg_t &mData){
+        byteId_t peerHash;
+        peerHash.setHex(peerID);
+        auto handshake = std::make_unique<SessionHandshake>();
+        if (!messsagProcessor->getAccountPublicKey(peerHash, handshake->peerPublicKey)){
+            PQB_LOG_WARN("CONNECTION MANAGER", "Public key of {} is unknown, session will not be offered", shortStr(peerID));
             return false;
         }
+        try{
+            PeerSession::genKemKeys(handshake->kemSecretKey, mData.kemPublicKey);
+        } catch (const PQB::Exceptions::Signer &e){
+            PQB_LOG_ERROR("CONNECTION MANAGER", "Session with {} can not be offered: {}", shortStr(peerID), e.what());
+            mData.kemPublicKey.clear();
+            return false;
+        }
+        VersionMessage::getSignedHash(mData, handshake->versionHash);
+        ChosenSigner::get().sign(mData.signature, handshake->versionHash.data(), handshake->versionHash.size(), *wallet_->getExpandedSecretKey());
+        connection->handshake = std::move(handshake);
         return true;
     }
 
-    void ConnectionManager::deleteConnection(const socket_t connectionID){
-        auto connection = getConnectionFromConnectionPool(connectionID);
-        if (connection != nullptr){
-            deleteConnectionFromConnectionPool(connectionID, connection->connID);
-            PQB_LOG_INFO("CONNECTION MANAGER", "Connection with {} was closed", shortStr(connection->connID));
+    bool ConnectionManager::acceptNewConnection(std::string &port, Sock *socket){
+        Connection *connection = new Connection(port, socket);
+        NetworkReactor *reactor = chooseReactor();
+        if (!registerConnection(socket->getSocketFD(), port, reactor, false)){
             delete connection;
+            return false;
         }
+        reactor->addConnection(connection, nullptr);
+        return true;
     }
 
-    bool ConnectionManager::sendMessageToPeer(const socket_t connectionID, std::string &peerID, Message *message){
-        auto connection = getConnectionFromConnectionPool(connectionID);
-        if (connection != nullptr){
-            if (connection->connID == peerID && connection->isConfirmed){
-                connection->sendMessage(message);
-                delete message;
-                return true;
+    NetworkReactor *ConnectionManager::chooseReactor(){
+        NetworkReactor *chosen = reactors.front();
+        for (const auto reactor : reactors){
+            if (reactor->getNumberOfConnections() < chosen->getNumberOfConnections()){
+                chosen = reactor;
             }
         }
-        delete message;
-        return false;
+        return chosen;
     }
 
-    void ConnectionManager::broadcastMessageToAllPeers(const socket_t connectionID, std::string &peerID, Message *message){
-        for (const auto &conn : connectionPool){
-            if (conn.second->isConfirmed){
-                if (conn.first != connectionID && conn.second->connID != peerID){
-                    conn.second->sendMessage(message);
-                }
-            }
+    bool ConnectionManager::registerConnection(const socket_t connectionID, const std::string &peerID, NetworkReactor *reactor, bool isUNL){
+        std::lock_guard<std::mutex> lock(registryMutex);
+        if (connectionOwners.find(connectionID) != connectionOwners.end() || peerConnections.find(peerID) != peerConnections.end()){
+            return false;
         }
-        delete message;
+        connectionOwners[connectionID] = reactor;
+        peerConnections[peerID] = {.connectionID=connectionID, .isUNL=isUNL};
+        return true;
     }
 
-    void ConnectionManager::broadcastMessageToUNLPeers(const socket_t connectionID, std::string &peerID, Message *message){
-        for (const auto &conn : connectionPool){
-            if (conn.second->isUNL && conn.second->isConfirmed){
-                if (conn.first != connectionID && conn.second->connID != peerID){
-                    conn.second->sendMessage(message);
-                }
-            }
+    void ConnectionManager::unregisterConnection(const socket_t connectionID, const std::string &peerID){
+        std::lock_guard<std::mutex> lock(registryMutex);
+        connectionOwners.erase(connectionID);
+        auto it = peerConnections.find(peerID);
+        if (it != peerConnections.end() && it->second.connectionID == connectionID){
+            peerConnections.erase(it);
         }
-        delete message;
     }
 
-    bool ConnectionManager::addConnectionToConnectionPool(const socket_t connectionID, Connection* connection, const std::string &peerID){
-        if (connectionPool.find(connectionID) == connectionPool.end()){
-            setOfConnectedPeers.insert(peerID);
-            connectionPool[connectionID] = connection;
-            addSocketDescriptor(connectionID);
-            return true;
+    void ConnectionManager::renameConnection(const socket_t connectionID, const std::string &oldPeerID, const std::string &newPeerID, bool isUNL){
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto it = peerConnections.find(oldPeerID);
+        if (it != peerConnections.end() && it->second.connectionID == connectionID){
+            peerConnections.erase(it);
         }
-        return false;
-    }
-
-    void ConnectionManager::deleteConnectionFromConnectionPool(const socket_t connectionID, const std::string &peerID){
-        setOfConnectedPeers.erase(peerID);
-        connectionPool.erase(connectionID);
-        deleteSocketDescriptor(connectionID);
+        peerConnections[newPeerID] = {.connectionID=connectionID, .isUNL=isUNL};
     }
 
-    Connection* ConnectionManager::getConnectionFromConnectionPool(const socket_t connectionID){
-        auto it = connectionPool.find(connectionID);
-        if (it == connectionPool.end())
-            return nullptr;
-        else
+    NetworkReactor *ConnectionManager::getConnectionOwner(const socket_t connectionID){
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto it = connectionOwners.find(connectionID);
+        if (it != connectionOwners.end()){
             return it->second;
-    }
-
-    Connection *ConnectionManager::getConnectionFromConnectionPool(const std::string &peerID){
-        if (isConnectionInConnectionPool(peerID)){
-            for (auto &conn : connectionPool){
-                if (conn.second->connID == peerID)
-                    return conn.second;
-            }
         }
         return nullptr;
     }
 
     bool ConnectionManager::isConnectionInConnectionPool(const std::string &peerID){
-        auto it = setOfConnectedPeers.find(peerID);
-        if (it == setOfConnectedPeers.end())
-            return false;
-        return true;
-    }
-
-    bool ConnectionManager::isConnectionInConnectionPool(const socket_t connectionID){
-        auto it = connectionPool.find(connectionID);
-        if (it == connectionPool.end())
-            return false;
-        return true;
-    }
-
-    bool ConnectionManager::updatePeerIdOfConnectionInConnectionPool(const socket_t connectionID, const std::string &oldPeerID, std::string &newPeerID){
-        auto it = connectionPool.find(connectionID);
-        if (it != connectionPool.end()){
-            setOfConnectedPeers.erase(oldPeerID);
-            setOfConnectedPeers.insert(newPeerID);
-            it->second->connID = newPeerID;
-            return true;
-        }
-        return false;
+        std::lock_guard<std::mutex> lock(registryMutex);
+        return peerConnections.find(peerID) != peerConnections.end();
     }
 
     void ConnectionManager::addSocketDescriptor(const socket_t socket_fd){
-        struct pollfd newDescriptor = {.fd=socket_fd, .events=POLLIN | POLLPRI, .revents=0};
-        socketDescriptors.push_back(newDescriptor);
+        struct epoll_event event = {.events=EPOLLIN | EPOLLPRI | EPOLLET, .data={.fd=socket_fd}};
+        if (epoll_ctl(epollFD, EPOLL_CTL_ADD, socket_fd, &event) < 0){
+            PQB_LOG_ERROR("CONNECTION MANAGER", "Socket {} can not be added to epoll", socket_fd);
+        }
     }
 
     void ConnectionManager::deleteSocketDescriptor(const socket_t socket_fd){
-        auto it = std::remove_if(socketDescriptors.begin(), socketDescriptors.end(),
-            [socket_fd] (const struct pollfd &s) {
-                return s.fd == socket_fd;
-            });
-        if (it != socketDescriptors.end())
-            socketDescriptors.erase(it);
+        epoll_ctl(epollFD, EPOLL_CTL_DEL, socket_fd, nullptr);
     }
 
     bool ConnectionManager::runServer(){
         Sock *serverSock = server->OpenServer();
         if (serverSock != nullptr){
-            struct pollfd serverFD = {.fd=serverSock->getSocketFD(), .events=POLLIN, .revents=0};
-            socketDescriptors.insert(socketDescriptors.begin(), serverFD);
+            addSocketDescriptor(serverSock->getSocketFD());
             return true;
         }
         return false;
     }
 
     void ConnectionManager::stopServer(){
-        if (!socketDescriptors.empty()){
-            if (socketDescriptors[0].fd == server->getSocketFD())
-                socketDescriptors.erase(socketDescriptors.begin());
+        if (server->getSocketFD() >= 0){
+            deleteSocketDescriptor(server->getSocketFD());
         }
         server->CloseServer();
     }
@@ -357,88 +454,36 @@ namespace PQB
 
     void ConnectionManager::manageConnections(){
         PQB_LOG_INFO("CONNECTION MANAGER", "Connection managing thread started");
+        std::vector<struct epoll_event> events(2); // server socket and wakeupFD
         int changed;
         while (connectionManagerRunFlag)
         {
-            changed = poll(socketDescriptors.data(), socketDescriptors.size(), 1000);
-
-            if (changed < 0){ // poll failure
-                /// @todo handle poll failure
-                PQB_LOG_ERROR("CONNECTION MANAGER", "poll() function failed");
-            } else if (changed > 0 && !socketDescriptors.empty()){ // read sockets
-                int isServer = (socketDescriptors.at(0).fd == server->getSocketFD()) ? 1 : 0;
-                if ((socketDescriptors.at(0).revents & POLLIN) && (isServer)){
-                    handleServerPoll();
-                    socketDescriptors.at(0).revents = 0;
-                }
-                bool closeFlag = false;
-                for (auto it = socketDescriptors.begin() + isServer; it != socketDescriptors.end(); ++it){
-                    if ((it->revents & (POLLIN | POLLPRI)) != 0){
-                        handleConnectionPoll(it->fd, &closeFlag);
-                        if (closeFlag){
-                            socketsToClose.push_back(it->fd);
-                            closeFlag = false;
-                            continue;
-                        }
-                        it->revents = 0;
-                    }
+            changed = epoll_wait(epollFD, events.data(), events.size(), 1000);
+
+            if (changed < 0){ // epoll failure
+                if (errno != EINTR){
+                    PQB_LOG_ERROR("CONNECTION MANAGER", "epoll_wait() function failed");
                 }
-                // Remove closed connections
-                for (const auto sock_fd : socketsToClose){
-                    deleteConnection(sock_fd);
+            }
+            for (int i = 0; i < changed; i++){
+                if (events[i].data.fd == wakeupFD){
+                    // requests are processed after each wakeup, just reset the counter
+                    uint64_t counter;
+                    ssize_t ret = read(wakeupFD, &counter, sizeof(counter));
+                    (void)ret;
+                } else if (events[i].data.fd == server->getSocketFD()){
+                    handleServerPoll();
                 }
-                socketsToClose.clear();
             }
-            processMessageQueueRequests();
             processConnectionQueueRequests();
         }
     }
      
     void ConnectionManager::handleServerPoll(){
         std::string clientPort;
-        Sock *clientSock = server->AcceptConnection(&clientPort);
-        if (clientSock != nullptr)
+        Sock *clientSock;
+        while ((clientSock = server->AcceptConnection(&clientPort)) != nullptr){
             acceptNewConnection(clientPort, clientSock);
-        
-    }
-
-    void ConnectionManager::handleConnectionPoll(int socket_fd, bool *closeFlag){
-        Connection *conn = getConnectionFromConnectionPool(socket_fd);
-        if (conn != nullptr){
-            Message *msg = conn->receiveMessage(closeFlag);
-            if (*closeFlag){
-                return;
-            } else {
-                if (msg != nullptr){
-                    counterOfProcessedBytes_ += msg->getSize(); // just for the statistics
-                    messsagProcessor->processMessage(socket_fd, conn->connID, conn->isUNL, msg);
-                }
-            }
-        }
-    }
-
-    void ConnectionManager::processMessageQueueRequests(){
-        std::lock_guard<std::mutex> lock(messageRequestQueueMutex);
-        while (!messageRequestQueue.empty()){
-            MessageRequest_t req = messageRequestQueue.top();
-            messageRequestQueue.pop();
-
-            counterOfProcessedBytes_ += req.message->getSize(); // just for the statistics
-
-            switch (req.type)
-            {
-            case MessageRequestType::ONE:
-                sendMessageToPeer(req.connectionID, req.peerID, req.message);
-                break;
-            case MessageRequestType::UNLCAST:
-                broadcastMessageToUNLPeers(req.connectionID, req.peerID, req.message);
-                break;
-            case MessageRequestType::BROADCAST:
-                broadcastMessageToAllPeers(req.connectionID, req.peerID, req.message);
-                break;           
-            default:
-                break;
-            }
         }
     }
 
@@ -447,7 +492,7 @@ namespace PQB
         while (!connectionRequestQueue.empty()){
             ConnectionRequest_t req = connectionRequestQueue.front();
             connectionRequestQueue.pop();
-            byte64_t peerHash;
+            byteId_t peerHash;
             peerHash.setHex(req.peerID);
             AccountAddress accAddrs;
             if (!addrStorage->getAddresses(peerHash, accAddrs)){
@@ -460,129 +505,847 @@ namespace PQB
     }
 
 /************************************************************************/
-/*************************** MessageProcessor ***************************/
+/**************************** NetworkReactor ****************************/
 /************************************************************************/
 
 
-    MessageProcessor::MessageProcessor(AccountStorage *accountStorage, BlocksStorage *blockStorage, ConsensusWrapper *consensusAlgorithm, Wallet *localWallet)
-    : connMng(nullptr), accStor(accountStorage), blockStor(blockStorage), consensus(consensusAlgorithm), wallet(localWallet){
-        processingRun = true;
-        processingThread = std::jthread(&MessageProcessor::messageProcessor, this);
-    }
-
-    MessageProcessor::~MessageProcessor(){
-        processingRun = false;
-        processCondition.notify_one();
-        if (processingThread.joinable())
-            processingThread.join();
-        // Delete all messages from message processing queue
-        while (!processingQueue.empty()){
-            message_item_t item = processingQueue.top();
-            delete item.msg;
-            processingQueue.pop();
+    NetworkReactor::NetworkReactor(ConnectionManager *connectionManager, size_t id, IOBackend backend)
+    : connMng(connectionManager), reactorID(id), requestedBackend(backend){
+        backend_ = IOBackend::EPOLL;
+        numOfConnections = 0;
+        receivedMessages_ = 0;
+        receivedBytes_ = 0;
+        sentMessages_ = 0;
+        droppedMessages_ = 0;
+        loops_ = 0;
+        systemCalls_ = 0;
+        lastReceiveTimeoutCheck = std::chrono::steady_clock::now();
+        epollFD = epoll_create1(EPOLL_CLOEXEC);
+        if (epollFD < 0){
+            PQB_LOG_ERROR("NETWORK REACTOR", "epoll_create1() function failed");
         }
-    }
-
-    void MessageProcessor::processMessage(int connectionID, std::string &peerID, bool isUNL, Message *message){
-        MessageType msgType = message->getType(); // save message type for log
-        PQB_LOG_TRACE("MESSAGE PROCESSOR", "Message of type {} from peer {} was received for processing", 
-                    Message::messageTypeToString(msgType), shortStr(peerID));
-        if (connMng != nullptr){
-            message_item_t msgi = {.connection_id=connectionID, .peer_id=peerID, .isUNL=isUNL, .msg=message};
-            if (!earlyProcessing(msgi)){
-                addMessageToProcessingQueue(msgi);
-            } else {
-                PQB_LOG_TRACE("MESSAGE PROCESSOR", "Message of type {} from peer {} was processed", 
-                            Message::messageTypeToString(msgType), shortStr(peerID));
-            }
+        wakeupFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wakeupFD < 0){
+            PQB_LOG_ERROR("NETWORK REACTOR", "eventfd() function failed");
+        } else {
+            struct epoll_event event = {.events=EPOLLIN | EPOLLET, .data={.fd=wakeupFD}};
+            epoll_ctl(epollFD, EPOLL_CTL_ADD, wakeupFD, &event);
         }
+        runFlag = true;
+        reactorThread = std::jthread(&NetworkReactor::run, this);
     }
 
-    bool MessageProcessor::checkTransaction(const TransactionPtr tx){
-        // Check structure of transaction
-        if (!tx->checkTransactionStructure()){
-            return false;
+    NetworkReactor::~NetworkReactor(){
+        runFlag = false;
+        wakeup();
+        if (reactorThread.joinable())
+            reactorThread.join();
+        for (auto &connection : connectionPool){
+            delete connection.second;
         }
-        // Check if sender and receiver are not the same
-        if (tx->senderWalletAddress == tx->receiverWalletAddress){
-            return false;
+        for (auto &connection : newConnections){
+            delete connection.first;
         }
-        AccountBalance accBalance;
-        // Check if sender exists
-        if (!accStor->blncDB->getBalance(tx->senderWalletAddress, accBalance)){
-            return false;
+#ifdef PQB_IO_URING
+        for (auto &connection : closingConnections){
+            delete connection.second;
         }
-        // Check transaction signature
-        if (!tx->verify(accBalance.publicKey)){                    
-            return false;        
+#endif
+        if (wakeupFD >= 0){
+            close(wakeupFD);
         }
-        // Check if receiver exists
-        if (!accStor->blncDB->getBalance(tx->receiverWalletAddress, accBalance)){
-            return false;
+        if (epollFD >= 0){
+            close(epollFD);
         }
-        return true;
     }
 
-    bool MessageProcessor::checkProposal(const BlockProposalPtr &prop){
-        // Check structure of proposalň
-        if (!prop->check()){
-            return false;
+    void NetworkReactor::addConnection(Connection *connection, const MessagePtr &message){
+        numOfConnections++;
+        {
+            std::lock_guard<std::mutex> lock(inboxMutex);
+            newConnections.emplace_back(connection, message);
         }
-        // Check if issuer exists
-        AccountBalance accBalance;
-        if (!accStor->blncDB->getBalance(prop->issuer, accBalance)){
-            return false;
+        wakeup();
+    }
+
+    void NetworkReactor::addMessageRequest(const ConnectionManager::MessageRequest_t &req, const MessagePtr &message, const LazyMessagePtr &legacyMessage, bool recordLatency){
+        {
+            std::lock_guard<std::mutex> lock(inboxMutex);
+            messageRequests.push({.type=req.type, .connectionID=req.connectionID, .peerID=req.peerID, .message=message,
+                                  .legacyMessage=legacyMessage, .enqueued=req.enqueued, .recordLatency=recordLatency});
         }
-        // Check proposal signature
-        if (!prop->verify(accBalance.publicKey)){
-            return false;
+        wakeup();
+    }
+
+    void NetworkReactor::closeConnection(socket_t connectionID){
+        {
+            std::lock_guard<std::mutex> lock(inboxMutex);
+            closeRequests.push_back(connectionID);
         }
-        return true;
+        wakeup();
     }
 
-    bool MessageProcessor::checkProposal(const TxSetProposalPtr &prop){
-        // Check structure of proposal
-        if (!prop->check()){
-            return false;
+    void NetworkReactor::confirmConnection(socket_t connectionID, std::string &peerID, uint32_t peerVersion, bool isUNL, PeerSessionPtr session, const MessagePtr &ack){
+        Connection *conn = getConnectionFromConnectionPool(connectionID);
+        if (conn == nullptr){
+            return;
         }
-        // Check if issuer exists
-        AccountBalance accBalance;
-        if (!accStor->blncDB->getBalance(prop->issuer, accBalance)){
-            return false;
+        PQB_LOG_TRACE("NETWORK REACTOR", "Connection {} renamed to {}", shortStr(conn->connID), shortStr(peerID));
+        connMng->renameConnection(connectionID, conn->connID, peerID, isUNL);
+        {
+            std::lock_guard<std::mutex> lock(connectionPoolMutex);
+            conn->connID = peerID;
         }
-        // Check proposal signature
-        if (!prop->verify(accBalance.publicKey)){
-            return false;
+        conn->isUNL = isUNL;
+        // session has to be set before the connection is confirmed, so all messages after ACK are authenticated
+        if (session != nullptr){
+            conn->session = std::move(session);
+            PQB_LOG_INFO("NETWORK REACTOR", "Session with {} established", shortStr(peerID));
         }
-        return true;
+        conn->isConfirmed = true;
+        conn->frameCheck = Message::getFrameCheckForVersion(std::min(peerVersion, MSG_VERSION));
+        conn->peerVersion = peerVersion;
+        queueMessage(conn, ack);
     }
 
-
-    void MessageProcessor::addMessageToProcessingQueue(message_item_t &msgi){
-        std::lock_guard<std::mutex> lock(processingQueueMutex);
-        processingQueue.push(msgi);
-        processCondition.notify_one();
+    NetworkReactor::Stats_t NetworkReactor::getStats() const{
+        return {.connections=numOfConnections, .receivedMessages=receivedMessages_, .receivedBytes=receivedBytes_,
+                .sentMessages=sentMessages_, .droppedMessages=droppedMessages_, .loops=loops_, .systemCalls=systemCalls_,
+                .backend=backend_};
     }
 
-    void MessageProcessor::messageProcessor(){
-        PQB_LOG_INFO("MESSAGE PROCESSOR", "Message processing thread started");
-        while (processingRun)
-        {
-            std::unique_lock<std::mutex> lock(processingQueueMutex);
-            processCondition.wait(lock, [this]{ return (!processingQueue.empty() || !processingRun); });
-            if (!processingRun){
-                lock.unlock();
-                continue;
-            }
-            message_item_t msg = processingQueue.top();
-            processingQueue.pop();
-            lock.unlock();
-
-            MessageType msgType = msg.msg->getType(); // save message type for log
-            std::string_view msgSender = shortStr(msg.peer_id);
-            lateProcessing(msg);
-            PQB_LOG_TRACE("MESSAGE PROCESSOR", "Message of type {} from peer {} was processed", 
-                        Message::messageTypeToString(msgType), msgSender);
+    void NetworkReactor::putConnectionDataToStringStream(std::stringstream &ss){
+        std::lock_guard<std::mutex> lock(connectionPoolMutex);
+        for (const auto &it : connectionPool){
+            Connection *conn = it.second;
+            ss
+            << std::setw(15) << shortStr(conn->connID)
+            << std::setw(11) << it.first
+            << std::setw(14) << (conn->isConfirmed ? "true" : "false")
+            << std::setw(8) << (conn->isUNL ? "true" : "false") 
+            << std::setw(12) << conn->getQueuedBytes()
+            << std::setw(8) << reactorID
+            << std::endl;
+        }
+    }
+
+    void NetworkReactor::wakeup(){
+        if (wakeupFD >= 0){
+            uint64_t one = 1;
+            ssize_t ret = write(wakeupFD, &one, sizeof(one));
+            (void)ret; // counter overflow (EAGAIN) means that the thread is already signaled
+        }
+    }
+
+    void NetworkReactor::addSocketDescriptor(const socket_t socket_fd){
+        // EPOLLOUT is edge-triggered too, so it is reported just when the socket becomes writable again (after EAGAIN)
+        struct epoll_event event = {.events=EPOLLIN | EPOLLPRI | EPOLLRDHUP | EPOLLOUT | EPOLLET, .data={.fd=socket_fd}};
+        if (epoll_ctl(epollFD, EPOLL_CTL_ADD, socket_fd, &event) < 0){
+            PQB_LOG_ERROR("NETWORK REACTOR", "Socket {} can not be added to epoll", socket_fd);
+        }
+    }
+
+    Connection* NetworkReactor::getConnectionFromConnectionPool(const socket_t connectionID){
+        auto it = connectionPool.find(connectionID);
+        if (it != connectionPool.end()){
+            return it->second;
+        }
+        return nullptr;
+    }
+
+    void NetworkReactor::deleteConnection(const socket_t connectionID){
+        auto it = connectionPool.find(connectionID);
+        if (it == connectionPool.end()){
+            return;
+        }
+        Connection *connection = it->second;
+        if (backend_ == IOBackend::EPOLL){
+            epoll_ctl(epollFD, EPOLL_CTL_DEL, connectionID, nullptr);
+        }
+        {
+            std::lock_guard<std::mutex> lock(connectionPoolMutex);
+            connectionPool.erase(it);
+        }
+        // connection is removed from the registry before its socket is closed, so the socket descriptor can not be reused meanwhile
+        connMng->unregisterConnection(connectionID, connection->connID);
+        numOfConnections--;
+        PQB_LOG_INFO("NETWORK REACTOR", "Connection with {} was closed", shortStr(connection->connID));
+#ifdef PQB_IO_URING
+        if (ring != nullptr){
+            // requests in flight use the socket and the outbound queue, so the connection is deleted after they complete
+            closingConnections[connectionID] = connection;
+            ring->prepareCancel(connectionID, ringUserData(connectionID, RingRequest::CANCEL));
+            finishRingClose(connectionID);
+            return;
+        }
+#endif
+        delete connection;
+    }
+
+    bool NetworkReactor::sendMessageToPeer(const socket_t connectionID, const std::string &peerID, const MessagePtr &message, const LazyMessagePtr &legacyMessage){
+        auto connection = getConnectionFromConnectionPool(connectionID);
+        if (connection != nullptr){
+            if (connection->connID == peerID && connection->isConfirmed){
+                const MessagePtr &toSend = selectMessage(connection, message, legacyMessage);
+                if (toSend != nullptr){
+                    queueMessage(connection, toSend);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void NetworkReactor::broadcastMessage(const socket_t connectionID, const std::string &peerID, const MessagePtr &message, const LazyMessagePtr &legacyMessage, bool onlyUNL){
+        for (const auto &conn : connectionPool){
+            if (conn.second->isConfirmed && (conn.second->isUNL || !onlyUNL)){
+                if (conn.first != connectionID && conn.second->connID != peerID){
+                    const MessagePtr &toSend = selectMessage(conn.second, message, legacyMessage);
+                    if (toSend != nullptr){
+                        queueMessage(conn.second, toSend);
+                    }
+                }
+            }
+        }
+    }
+
+    const MessagePtr &NetworkReactor::selectMessage(const Connection *connection, const MessagePtr &message, const LazyMessagePtr &legacyMessage){
+        static const MessagePtr noMessage = nullptr;
+        if (Message::isSupportedByVersion(message->getType(), connection->peerVersion)){
+            return message;
+        }
+        if (legacyMessage == nullptr){
+            return noMessage;
+        }
+        // the first I/O thread with a receiver of the legacy message creates it, other I/O threads wait for it
+        std::call_once(legacyMessage->created, [&legacy = *legacyMessage]{
+            legacy.message = MessagePtr(legacy.factory());
+            legacy.message->getCheckSum(Message::getFrameCheckForVersion(MSG_VERSION));
+            legacy.factory = nullptr;
+        });
+        return legacyMessage->message;
+    }
+
+    void NetworkReactor::queueMessage(Connection *connection, const MessagePtr &message){
+        if (!connection->sendMessage(message)){
+            droppedMessages_++;
+            return;
+        }
+        sentMessages_++;
+        connectionsToFlush.insert(connection->getConnectionSocketFD());
+    }
+
+    void NetworkReactor::flushConnections(){
+        for (const auto sock_fd : connectionsToFlush){
+            Connection *conn = getConnectionFromConnectionPool(sock_fd);
+            if (conn == nullptr){
+                continue;
+            }
+            bool sent = true;
+#ifdef PQB_IO_URING
+            if (ring != nullptr){
+                submitRingSends(sock_fd, conn); // failures are reported by completions
+            } else
+#endif
+            {
+                sent = conn->flushOutboundQueue();
+                systemCalls_ += conn->takeNumberOfSystemCalls();
+            }
+            if (!sent){
+                PQB_LOG_WARN("NETWORK REACTOR", "Sending to {} failed, connection will be closed", shortStr(conn->connID));
+                socketsToClose.push_back(sock_fd);
+            } else if (conn->getQueuedBytes() > OUTBOUND_QUEUE_LIMIT){
+                PQB_LOG_WARN("NETWORK REACTOR", "Peer {} is not reading ({} bytes are waiting), connection will be closed", shortStr(conn->connID), conn->getQueuedBytes());
+                socketsToClose.push_back(sock_fd);
+            }
+        }
+        connectionsToFlush.clear();
+    }
+
+    void NetworkReactor::processInbox(){
+        std::vector<std::pair<Connection*, MessagePtr>> connections;
+        std::priority_queue<Request_t, std::vector<Request_t>, RequestComparator> requests;
+        std::vector<socket_t> closing;
+        // take everything at once, so other threads are not blocked from adding requests while messages are queued
+        {
+            std::lock_guard<std::mutex> lock(inboxMutex);
+            std::swap(connections, newConnections);
+            std::swap(requests, messageRequests);
+            std::swap(closing, closeRequests);
+        }
+        for (auto &[connection, message] : connections){
+            socket_t sock_fd = connection->getConnectionSocketFD();
+            {
+                std::lock_guard<std::mutex> lock(connectionPoolMutex);
+                connectionPool[sock_fd] = connection;
+            }
+            startReceiving(sock_fd);
+            if (message != nullptr){
+                queueMessage(connection, message);
+            }
+        }
+        while (!requests.empty()){
+            const Request_t &req = requests.top();
+            switch (req.type)
+            {
+            case ConnectionManager::MessageRequestType::ONE:
+                sendMessageToPeer(req.connectionID, req.peerID, req.message, req.legacyMessage);
+                break;
+            case ConnectionManager::MessageRequestType::UNLCAST:
+                broadcastMessage(req.connectionID, req.peerID, req.message, req.legacyMessage, true);
+                break;
+            case ConnectionManager::MessageRequestType::BROADCAST:
+                broadcastMessage(req.connectionID, req.peerID, req.message, req.legacyMessage, false);
+                break;           
+            default:
+                break;
+            }
+            if (req.recordLatency){
+                connMng->recordQueueLatency(req.enqueued);
+            }
+            requests.pop();
+        }
+        socketsToClose.insert(socketsToClose.end(), closing.begin(), closing.end());
+    }
+
+    void NetworkReactor::run(){
+        if (requestedBackend == IOBackend::IO_URING){
+#ifdef PQB_IO_URING
+            // the instance is created by the thread which uses it (IORING_SETUP_SINGLE_ISSUER)
+            ring = IoUring::create(IO_URING_QUEUE_DEPTH, IO_URING_BUFFER_COUNT, RECEIVE_BUFFER_SIZE);
+            if (ring != nullptr){
+                backend_ = IOBackend::IO_URING;
+                PQB_LOG_INFO("NETWORK REACTOR", "Network I/O thread {} started (io_uring)", reactorID);
+                runIoUring();
+                return;
+            }
+            PQB_LOG_WARN("NETWORK REACTOR", "io_uring is not available, network I/O thread {} uses epoll", reactorID);
+#else
+            PQB_LOG_WARN("NETWORK REACTOR", "io_uring backend was not built, network I/O thread {} uses epoll", reactorID);
+#endif
+        }
+        PQB_LOG_INFO("NETWORK REACTOR", "Network I/O thread {} started", reactorID);
+        runEpoll();
+    }
+
+    void NetworkReactor::startReceiving(const socket_t socket_fd){
+#ifdef PQB_IO_URING
+        if (ring != nullptr){
+            ringConnections[socket_fd].receiving = true;
+            ring->prepareMultishotReceive(socket_fd, ringUserData(socket_fd, RingRequest::RECEIVE));
+            return;
+        }
+#endif
+        addSocketDescriptor(socket_fd);
+    }
+
+    void NetworkReactor::processReceivedMessage(socket_t socket_fd, Connection *conn, Message *msg){
+        receivedMessages_++;
+        receivedBytes_ += msg->getSize();
+        connMng->counterOfProcessedBytes_ += msg->getSize(); // just for the statistics
+        connMng->messsagProcessor->processMessage(socket_fd, conn->connID, conn->isUNL, msg);
+    }
+
+    void NetworkReactor::runEpoll(){
+        std::vector<struct epoll_event> events(MAX_EPOLL_EVENTS);
+        int changed;
+        while (runFlag)
+        {
+            // connections with not read bytes do not get new EPOLLIN event, so epoll_wait() does not wait for them
+            changed = epoll_wait(epollFD, events.data(), events.size(), connectionsToRead.empty() ? 1000 : 0);
+            loops_++;
+            systemCalls_++;
+
+            if (changed < 0){ // epoll failure
+                if (errno != EINTR){
+                    PQB_LOG_ERROR("NETWORK REACTOR", "epoll_wait() function failed");
+                }
+            } else if (changed > 0){ // read sockets
+                bool closeFlag = false;
+                for (int i = 0; i < changed; i++){
+                    const struct epoll_event &event = events[i];
+                    if (event.data.fd == wakeupFD){
+                        // inbox is processed after each wakeup, just reset the counter
+                        uint64_t counter;
+                        ssize_t ret = read(wakeupFD, &counter, sizeof(counter));
+                        (void)ret;
+                        systemCalls_++;
+                        continue;
+                    }
+                    if ((event.events & EPOLLOUT) != 0){
+                        handleConnectionWrite(event.data.fd, &closeFlag);
+                    }
+                    if (!closeFlag && (event.events & (EPOLLIN | EPOLLPRI | EPOLLRDHUP)) != 0){
+                        handleConnectionPoll(event.data.fd, &closeFlag);
+                    }
+                    if (closeFlag || (event.events & (EPOLLERR | EPOLLHUP)) != 0){
+                        socketsToClose.push_back(event.data.fd);
+                        closeFlag = false;
+                    }
+                }
+            }
+            handlePendingReads();
+            closeExpiredConnections();
+            processInbox();
+            // messages of all requests are queued first, so small frames are sent together
+            flushConnections();
+            // Remove closed connections
+            for (const auto sock_fd : socketsToClose){
+                deleteConnection(sock_fd);
+            }
+            socketsToClose.clear();
+        }
+    }
+
+    void NetworkReactor::handleConnectionWrite(int socket_fd, bool *closeFlag){
+        Connection *conn = getConnectionFromConnectionPool(socket_fd);
+        if (conn == nullptr || !conn->hasQueuedFrames()){
+            return;
+        }
+        if (!conn->flushOutboundQueue()){
+            *closeFlag = true;
+        }
+        systemCalls_ += conn->takeNumberOfSystemCalls();
+    }
+
+    void NetworkReactor::handleConnectionPoll(int socket_fd, bool *closeFlag){
+        Connection *conn = getConnectionFromConnectionPool(socket_fd);
+        if (conn == nullptr){
+            return;
+        }
+        size_t budget = MAX_RECEIVE_BYTES_PER_ROUND;
+        Message *msg;
+        while ((msg = conn->receiveMessage(closeFlag, &budget)) != nullptr){
+            processReceivedMessage(socket_fd, conn, msg);
+        }
+        systemCalls_ += conn->takeNumberOfSystemCalls();
+        if (!*closeFlag && budget == 0){
+            connectionsToRead.push_back(socket_fd);
+        }
+    }
+
+    void NetworkReactor::handlePendingReads(){
+        std::vector<socket_t> pending;
+        std::swap(pending, connectionsToRead);
+        for (const auto sock_fd : pending){
+            bool closeFlag = false;
+            handleConnectionPoll(sock_fd, &closeFlag);
+            if (closeFlag){
+                socketsToClose.push_back(sock_fd);
+            }
+        }
+    }
+
+    void NetworkReactor::closeExpiredConnections(){
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastReceiveTimeoutCheck < std::chrono::seconds(1)){
+            return;
+        }
+        lastReceiveTimeoutCheck = now;
+        for (const auto &conn : connectionPool){
+            if (conn.second->isReceiveExpired(now)){
+                PQB_LOG_WARN("NETWORK REACTOR", "Message from {} was not received in time, connection will be closed", shortStr(conn.second->connID));
+                socketsToClose.push_back(conn.first);
+            }
+        }
+    }
+
+#ifdef PQB_IO_URING
+
+    void NetworkReactor::runIoUring(){
+        ring->prepareRead(wakeupFD, &wakeupCounter, sizeof(wakeupCounter), ringUserData(wakeupFD, RingRequest::WAKEUP));
+        while (runFlag)
+        {
+            // submit requests of the previous iteration and wait for completions (if there are not any already)
+            if (!ring->submitAndWait(ring->hasCompletions() ? 0 : 1, 1000)){
+                break;
+            }
+            loops_++;
+            systemCalls_ = ring->getNumberOfSystemCalls();
+            ring->forEachCompletion([this](const struct io_uring_cqe &cqe){
+                handleRingCompletion(cqe);
+            });
+            closeExpiredConnections();
+            processInbox();
+            // messages of all requests are queued first, so small frames are sent together
+            flushConnections();
+            // Remove closed connections
+            for (const auto sock_fd : socketsToClose){
+                deleteConnection(sock_fd);
+            }
+            socketsToClose.clear();
+        }
+        // requests are canceled when the instance is closed, connections are deleted by the destructor
+        ring.reset();
+    }
+
+    void NetworkReactor::handleRingCompletion(const struct io_uring_cqe &cqe){
+        socket_t socket_fd = static_cast<socket_t>(cqe.user_data >> 8);
+        switch (static_cast<RingRequest>(cqe.user_data & 0xff))
+        {
+        case RingRequest::WAKEUP:
+            // inbox is processed after each iteration, just read the counter again
+            ring->prepareRead(wakeupFD, &wakeupCounter, sizeof(wakeupCounter), ringUserData(wakeupFD, RingRequest::WAKEUP));
+            break;
+        case RingRequest::RECEIVE:
+            handleRingReceive(socket_fd, cqe);
+            break;
+        case RingRequest::SEND:
+            handleRingSend(socket_fd, cqe);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void NetworkReactor::handleRingReceive(socket_t socket_fd, const struct io_uring_cqe &cqe){
+        RingConnection_t &requests = ringConnections[socket_fd];
+        if ((cqe.flags & IORING_CQE_F_MORE) == 0){
+            requests.receiving = false;
+        }
+        Connection *conn = getConnectionFromConnectionPool(socket_fd);
+        bool closeFlag = false;
+        if ((cqe.flags & IORING_CQE_F_BUFFER) != 0){
+            uint16_t bufferID = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+            if (conn != nullptr && cqe.res > 0){
+                const byte *data = ring->getBuffer(bufferID);
+                size_t size = cqe.res;
+                Message *msg;
+                while (size > 0 && !closeFlag){
+                    if ((msg = conn->receiveMessage(&data, &size, &closeFlag)) != nullptr){
+                        processReceivedMessage(socket_fd, conn, msg);
+                    }
+                }
+            }
+            ring->recycleBuffer(bufferID);
+        }
+        // 0 is end of the stream, ENOBUFS means that all provided buffers were used (receiving is started again)
+        if (cqe.res == 0 || (cqe.res < 0 && cqe.res != -ENOBUFS)){
+            closeFlag = true;
+        }
+        if (conn == nullptr){
+            finishRingClose(socket_fd);
+        } else if (closeFlag){
+            socketsToClose.push_back(socket_fd);
+        } else if (!requests.receiving){
+            startReceiving(socket_fd);
+        }
+    }
+
+    void NetworkReactor::handleRingSend(socket_t socket_fd, const struct io_uring_cqe &cqe){
+        RingConnection_t &requests = ringConnections[socket_fd];
+        const RingSend_t &request = requests.sendRequests[requests.nextSend++];
+        requests.sends--;
+        Connection *conn = getConnectionFromConnectionPool(socket_fd);
+        if (conn == nullptr){
+            finishRingClose(socket_fd);
+            return;
+        }
+        if (cqe.res < 0 || static_cast<size_t>(cqe.res) != request.size){
+            // following linked requests are canceled, so the connection can not continue
+            PQB_LOG_WARN("NETWORK REACTOR", "Sending to {} failed, connection will be closed", shortStr(conn->connID));
+            socketsToClose.push_back(socket_fd);
+            return;
+        }
+        conn->outboundBytesSent(cqe.res);
+        if (requests.sends == 0 && conn->hasQueuedFrames()){
+            connectionsToFlush.insert(socket_fd);
+        }
+    }
+
+    void NetworkReactor::submitRingSends(socket_t socket_fd, Connection *conn){
+        RingConnection_t &requests = ringConnections[socket_fd];
+        if (requests.sends > 0){
+            return; // the rest is sent after the requests in flight complete
+        }
+        size_t offset = 0;
+        size_t count = 0;
+        for (; count < RING_MAX_LINKED_SENDS; count++){
+            RingSend_t &request = requests.sendRequests[count];
+            std::memset(&request.message, 0, sizeof(request.message));
+            request.message.msg_iov = request.iov;
+            request.message.msg_iovlen = conn->fillOutboundIovec(request.iov, RING_MAX_IOVEC, offset, &request.size);
+            if (request.message.msg_iovlen == 0){
+                break;
+            }
+            offset += request.size;
+        }
+        if (count == 0){
+            return;
+        }
+        // linked requests are submitted together, so the chain is not broken by a full submission queue
+        ring->reserve(count);
+        for (size_t i = 0; i < count; i++){
+            ring->prepareSendmsg(socket_fd, &requests.sendRequests[i].message, i + 1 < count, ringUserData(socket_fd, RingRequest::SEND));
+        }
+        requests.sends = count;
+        requests.nextSend = 0;
+    }
+
+    void NetworkReactor::finishRingClose(socket_t socket_fd){
+        auto it = closingConnections.find(socket_fd);
+        if (it == closingConnections.end()){
+            return;
+        }
+        auto requests = ringConnections.find(socket_fd);
+        if (requests != ringConnections.end()){
+            if (requests->second.receiving || requests->second.sends > 0){
+                return;
+            }
+            ringConnections.erase(requests);
+        }
+        delete it->second;
+        closingConnections.erase(it);
+    }
+
+#endif // PQB_IO_URING
+
+/************************************************************************/
+/*************************** MessageProcessor ***************************/
+/************************************************************************/
+
+
+    MessageProcessor::MessageProcessor(AccountStorage *accountStorage, BlocksStorage *blockStorage, ConsensusWrapper *consensusAlgorithm, Wallet *localWallet)
+    : connMng(nullptr), accStor(accountStorage), blockStor(blockStorage), consensus(consensusAlgorithm), wallet(localWallet){
+        processingRun = true;
+        arrivalCounter = 0;
+        // UNL nodes sign all proposals, so their prepared public keys are kept in the cache
+        for (const auto &peer : wallet->getUNL()){
+            byteId_t peerID;
+            peerID.setHex(peer);
+            accStor->keyCache.pin(peerID);
+        }
+        processingThread = std::jthread(&MessageProcessor::messageProcessor, this);
+    }
+
+    MessageProcessor::~MessageProcessor(){
+        processingRun = false;
+        processCondition.notify_one();
+        if (processingThread.joinable())
+            processingThread.join();
+        // Delete all messages from message processing queue
+        while (!processingQueue.empty()){
+            message_item_t item = processingQueue.top();
+            delete item.msg;
+            processingQueue.pop();
+        }
+    }
+
+    void MessageProcessor::processMessage(int connectionID, std::string &peerID, bool isUNL, Message *message){
+        MessageType msgType = message->getType(); // save message type for log
+        PQB_LOG_TRACE("MESSAGE PROCESSOR", "Message of type {} from peer {} was received for processing", 
+                    Message::messageTypeToString(msgType), shortStr(peerID));
+        if (connMng != nullptr){
+            message_item_t msgi = {.connection_id=connectionID, .peer_id=peerID, .isUNL=isUNL, .msg=message, .arrival=0};
+            if (!earlyProcessing(msgi)){
+                addMessageToProcessingQueue(msgi);
+            } else {
+                PQB_LOG_TRACE("MESSAGE PROCESSOR", "Message of type {} from peer {} was processed", 
+                            Message::messageTypeToString(msgType), shortStr(peerID));
+            }
+        }
+    }
+
+    bool MessageProcessor::checkTransaction(const TransactionPtr tx){
+        AccountBalance senderBalance;
+        if (!checkTransactionAccounts(tx, senderBalance)){
+            return false;
+        }
+        // Check transaction signature (Merkle root of batch-signed transaction is verified only once for whole batch thanks to sigCache)
+        return verifySignature(tx->getSignedHash(), tx->signature, tx->senderWalletAddress, senderBalance.publicKey);
+    }
+
+    std::vector<bool> MessageProcessor::checkTransactions(const std::vector<TransactionPtr> &txs){
+        std::vector<bool> results(txs.size(), false);
+        // public keys have to stay on the same address until the verification is done
+        std::vector<AccountBalance> senderBalances(txs.size());
+        std::vector<PreparedPublicKeyPtr> preparedKeys(txs.size());
+        std::vector<byteId_t> signedHashes(txs.size());
+        std::vector<std::pair<size_t, size_t>> verifiedTxs; // index of transaction and index of its job in the batch
+        std::vector<VerifiedSignatureCache::Entry> cacheEntries; // cache entry of each job
+        std::unordered_map<VerifiedSignatureCache::Entry, size_t, VerifiedSignatureCache::EntryHash> jobs;
+        SignatureVerifier::VerifyBatch batch;
+        for (size_t i = 0; i < txs.size(); i++){
+            if (checkTransactionAccounts(txs[i], senderBalances[i])){
+                signedHashes[i] = txs[i]->getSignedHash();
+                VerifiedSignatureCache::Entry entry = VerifiedSignatureCache::createEntry(signedHashes[i].data(), signedHashes[i].size(),
+                                                                                          txs[i]->signature, senderBalances[i].publicKey);
+                if (sigCache.contains(entry)){ // signature was already verified
+                    results[i] = true;
+                    continue;
+                }
+                // transactions of one batch have the same signature, verify it only once
+                auto [job, isNew] = jobs.emplace(entry, batch.size());
+                if (isNew){
+                    preparedKeys[i] = accStor->keyCache.get(txs[i]->senderWalletAddress, senderBalances[i].publicKey);
+                    batch.push_back({.data=signedHashes[i].data(), .dataSize=signedHashes[i].size(),
+                                     .signature=&txs[i]->signature, .publicKey=&senderBalances[i].publicKey,
+                                     .preparedKey=preparedKeys[i].get()});
+                    cacheEntries.push_back(entry);
+                }
+                verifiedTxs.emplace_back(i, job->second);
+            }
+        }
+        if (batch.empty()){
+            return results;
+        }
+        SignatureVerifier::Verdicts verdicts = sigVerifier.verify(std::move(batch));
+        for (size_t i = 0; i < cacheEntries.size(); i++){
+            if (verdicts[i]){
+                sigCache.insert(cacheEntries[i]);
+            }
+        }
+        for (const auto &[txIndex, jobIndex] : verifiedTxs){
+            results[txIndex] = verdicts[jobIndex];
+        }
+        return results;
+    }
+
+    bool MessageProcessor::checkTransactionAccounts(const TransactionPtr &tx, AccountBalance &senderBalance){
+        // Check structure of transaction
+        if (!tx->checkTransactionStructure()){
+            return false;
+        }
+        // Check if sender exists
+        if (!accStor->blncDB->getBalance(tx->senderWalletAddress, senderBalance)){
+            return false;
+        }
+        // Check if sender and receivers are not the same and if receivers exist
+        bool validReceivers = true;
+        tx->forEachOutput([&](const byteId_t &receiver, PQB::cash){
+            AccountBalance receiverBalance;
+            if (validReceivers && (tx->senderWalletAddress == receiver || !accStor->blncDB->getBalance(receiver, receiverBalance))){
+                validReceivers = false;
+            }
+        });
+        return validReceivers;
+    }
+
+    bool MessageProcessor::checkProposal(const BlockProposalPtr &prop){
+        // Check structure of proposalň
+        if (!prop->check()){
+            return false;
+        }
+        // Check if issuer exists
+        AccountBalance accBalance;
+        if (!accStor->blncDB->getBalance(prop->issuer, accBalance)){
+            return false;
+        }
+        // Check proposal signature
+        byteId_t propHash;
+        prop->getHash(propHash);
+        return verifySignature(propHash, prop->signature, prop->issuer, accBalance.publicKey);
+    }
+
+    bool MessageProcessor::checkProposal(const TxSetProposalPtr &prop){
+        // Check structure of proposal
+        if (!prop->check()){
+            return false;
+        }
+        // Check if issuer exists
+        AccountBalance accBalance;
+        if (!accStor->blncDB->getBalance(prop->issuer, accBalance)){
+            return false;
+        }
+        // Check proposal signature
+        byteId_t propHash;
+        prop->getHash(propHash);
+        return verifySignature(propHash, prop->signature, prop->issuer, accBalance.publicKey);
+    }
+
+
+    bool MessageProcessor::verifySignature(const byteId_t &signedHash, const byteBuffer &signature, const byteId_t &signerID, const byteBuffer &publicKey){
+        VerifiedSignatureCache::Entry entry = VerifiedSignatureCache::createEntry(signedHash.data(), signedHash.size(), signature, publicKey);
+        if (sigCache.contains(entry)){
+            return true;
+        }
+        PreparedPublicKeyPtr preparedKey = accStor->keyCache.get(signerID, publicKey);
+        bool valid;
+        if (preparedKey != nullptr)
+            valid = ChosenSigner::get().verify(signature, signedHash.data(), signedHash.size(), *preparedKey);
+        else
+            valid = ChosenSigner::get().verify(signature, signedHash.data(), signedHash.size(), publicKey);
+        if (!valid){
+            return false;
+        }
+        sigCache.insert(entry);
+        return true;
+    }
+
+
+    PeerSessionPtr MessageProcessor::acceptSession(const VersionMessage::version_msg_t &versionData, AckMessage::ack_msg_t &ackData){
+        AccountBalance peerBalance;
+        if (!accStor->blncDB->getBalance(versionData.peerID, peerBalance)){
+            return nullptr;
+        }
+        byteId_t versionHash;
+        VersionMessage::getSignedHash(versionData, versionHash);
+        if (!verifySignature(versionHash, versionData.signature, versionData.peerID, peerBalance.publicKey)){
+            return nullptr;
+        }
+        byteBuffer sharedSecret;
+        if (!PeerSession::encapsulate(ackData.kemCiphertext, sharedSecret, versionData.kemPublicKey)){
+            ackData.kemCiphertext.clear();
+            return nullptr;
+        }
+        byteId_t ackHash;
+        AckMessage::getSignedHash(ackData, versionHash, ackHash);
+        ChosenSigner::get().sign(ackData.signature, ackHash.data(), ackHash.size(), *wallet->getExpandedSecretKey());
+        PeerSessionPtr session = std::make_unique<PeerSession>(sharedSecret, ackHash, false);
+        CryptoPP::SecureWipeBuffer(sharedSecret.data(), sharedSecret.size());
+        return session;
+    }
+
+    bool MessageProcessor::getAccountPublicKey(const byteId_t &accountID, byteBuffer &publicKey){
+        AccountBalance accBalance;
+        if (!accStor->blncDB->getBalance(accountID, accBalance)){
+            return false;
+        }
+        publicKey = accBalance.publicKey;
+        return true;
+    }
+
+
+    void MessageProcessor::addMessageToProcessingQueue(message_item_t &msgi){
+        std::lock_guard<std::mutex> lock(processingQueueMutex);
+        msgi.arrival = arrivalCounter++;
+        processingQueue.push(msgi);
+        processCondition.notify_one();
+    }
+
+    void MessageProcessor::messageProcessor(){
+        PQB_LOG_INFO("MESSAGE PROCESSOR", "Message processing thread started");
+        while (processingRun)
+        {
+            std::unique_lock<std::mutex> lock(processingQueueMutex);
+            processCondition.wait(lock, [this]{ return (!processingQueue.empty() || !processingRun); });
+            if (!processingRun){
+                lock.unlock();
+                continue;
+            }
+            message_item_t msg = processingQueue.top();
+            processingQueue.pop();
+            // TX messages are taken together, so their signatures can be verified in parallel
+            if (msg.msg->getType() == MessageType::TX){
+                std::vector<message_item_t> txMsgs = {msg};
+                while (!processingQueue.empty() && txMsgs.size() < MAX_TX_BATCH_SIZE &&
+                       processingQueue.top().msg->getType() == MessageType::TX){
+                    txMsgs.push_back(processingQueue.top());
+                    processingQueue.pop();
+                }
+                lock.unlock();
+                procTransactionMessages(txMsgs);
+                PQB_LOG_TRACE("MESSAGE PROCESSOR", "{} messages of type {} were processed",
+                            txMsgs.size(), Message::messageTypeToString(MessageType::TX));
+                continue;
+            }
+            lock.unlock();
+
+            MessageType msgType = msg.msg->getType(); // save message type for log
+            std::string_view msgSender = shortStr(msg.peer_id);
+            lateProcessing(msg);
+            PQB_LOG_TRACE("MESSAGE PROCESSOR", "Message of type {} from peer {} was processed", 
+                        Message::messageTypeToString(msgType), msgSender);
         }
     }
 
@@ -609,6 +1372,21 @@ namespace PQB
         case MessageType::TXSETPROPOSAL:
             procTxSetProposalMessage(msgi);
             break;
+        case MessageType::COMPACTTXSETPROPOSAL:
+            procCompactTxSetProposalMessage(msgi);
+            break;
+        case MessageType::TXSETDELTAPROPOSAL:
+            procTxSetDeltaProposalMessage(msgi);
+            break;
+        case MessageType::TXSETSKETCHPROPOSAL:
+            procTxSetSketchProposalMessage(msgi);
+            break;
+        case MessageType::GETPROPOSALTXS:
+            procGetProposalTxsMessage(msgi);
+            break;
+        case MessageType::PROPOSALTXS:
+            procProposalTxsMessage(msgi);
+            break;
         case MessageType::BLOCK:
             procBlockMessage(msgi);
             break;
@@ -632,25 +1410,53 @@ namespace PQB
             VersionMessage::version_msg_t msgData;
             msg->deserialize(&msgData);
             std::string peerID = msgData.peerID.getHex();
-            // True is here hardcoded for now, so every connection will be accepted.
+            // Connections with peers which use identifiers of different size are not accepted, other connections are accepted.
             // In case of any changes here can be put any check that can decide if connection should be accepted or not.
-            connMng->notifyConnectionVersion(msgi.connection_id, peerID, true);
+            bool status = Message::hasCompatibleIds(msgData.version) && !msgData.peerID.IsNull();
+            if (!status){
+                PQB_LOG_WARN("MESSAGE PROCESSOR", "Peer {} uses identifiers of different size", shortStr(peerID));
+            }
+            // Offered session has to be accepted, else the peer would close the connection anyway
+            AckMessage::ack_msg_t ackData = {.version=MSG_VERSION};
+            PeerSessionPtr session = nullptr;
+            if (status && !msgData.kemPublicKey.empty()){
+                session = acceptSession(msgData, ackData);
+                if (session == nullptr){
+                    status = false;
+                    PQB_LOG_WARN("MESSAGE PROCESSOR", "Session offered by {} is not valid", shortStr(peerID));
+                }
+            }
+            connMng->notifyConnectionVersion(msgi.connection_id, peerID, msgData.version, status, ackData, std::move(session));
             delete msgi.msg;
         }
     }
 
     void MessageProcessor::procTransactionMessage(const message_item_t &msgi){
-        TransactionMessage *msg = dynamic_cast<TransactionMessage*>(msgi.msg);
-        if (msg != nullptr){
-            TransactionPtr msgData = std::make_shared<Transaction>();
-            msg->deserialize(msgData.get());
-            waitingData.erase(msgData->IDHash); // if it is waiting list, then remove it
-            if (checkTransaction(msgData)){
-                if (consensus->addTransactionToPool(msgData)){ // If not processed yet
-                    forwardInvMessage(msgData->IDHash, InvType::TX, msgi);
+        std::vector<message_item_t> msgis = {msgi};
+        procTransactionMessages(msgis);
+    }
+
+    void MessageProcessor::procTransactionMessages(std::vector<message_item_t> &msgis){
+        std::vector<TransactionPtr> txs;
+        std::vector<message_item_t> txMsgis;
+        for (auto &msgi : msgis){
+            TransactionMessage *msg = dynamic_cast<TransactionMessage*>(msgi.msg);
+            if (msg != nullptr){
+                TransactionPtr msgData = std::make_shared<Transaction>();
+                msg->deserialize(msgData.get());
+                txs.push_back(msgData);
+                txMsgis.push_back(msgi);
+            }
+        }
+        std::vector<bool> results = checkTransactions(txs);
+        for (size_t i = 0; i < txs.size(); i++){
+            waitingData.erase(txs[i]->IDHash); // if it is waiting list, then remove it
+            if (results[i]){
+                if (consensus->addTransactionToPool(txs[i])){ // If not processed yet
+                    forwardInvMessage(txs[i]->IDHash, InvType::TX, txMsgis[i]);
                 }
             }
-            delete msgi.msg;
+            delete txMsgis[i].msg;
         }
     }
 
@@ -674,19 +1480,12 @@ namespace PQB
             if (checkProposal(msgData)){
                 // Create new transaction set and put there exising transaction that were proposed
                 // This will save some memory, because there won't be allocated memory for same transactions twice
+                std::vector<TransactionPtr> txs(msgData->txSet.txSet.begin(), msgData->txSet.txSet.end());
+                acceptProposedTransactions(txs);
                 TransactionSet newSet;
-                for (auto tx : msgData->txSet.txSet){
-                    TransactionPtr exTx = consensus->getTransactionFromPool(tx->IDHash);
-                    if (exTx != nullptr){
-                        newSet.insert(exTx);
-                    } else { // Proposed Tx Set include transaction that is not in our transaction pool
-                        // Check this transaction
-                        if (checkTransaction(tx)){
-                            // Insert it to newSet and transaction pool, if it is on waiting list remove it
-                            newSet.insert(tx);
-                            consensus->addTransactionToPool(tx);
-                            waitingData.erase(tx->IDHash);
-                        }
+                for (const auto &tx : txs){
+                    if (tx != nullptr){
+                        newSet.insert(tx);
                     }
                 }
                 msgData->txSet.txSet.clear();
@@ -697,12 +1496,257 @@ namespace PQB
         }
     }
 
+    void MessageProcessor::procCompactTxSetProposalMessage(const message_item_t &msgi){
+        CompactTxSetProposalMessage *msg = dynamic_cast<CompactTxSetProposalMessage*>(msgi.msg);
+        if (msg != nullptr){
+            CompactTxSetProposalPtr compact = std::make_shared<CompactTxSetProposal>();
+            TxSetProposalPtr msgData = nullptr;
+            try{
+                msg->deserialize(compact.get());
+                msgData = std::make_shared<TxSetProposal>(compact->proposal);
+            } catch (const std::exception &e){
+                PQB_LOG_WARN("MESSAGE PROCESSOR", "Compact transaction set proposal from {} is malformed: {}", shortStr(msgi.peer_id), e.what());
+            }
+            delete msgi.msg;
+            if (msgData == nullptr || !checkProposal(msgData)){
+                return;
+            }
+            expirePendingTxSets();
+            auto [pendingIt, inserted] = pendingTxSets.try_emplace(msgData->TxSetId.getHex());
+            if (!inserted){ // transactions of the set are already requested
+                pendingIt->second.proposals.push_back(msgData);
+                return;
+            }
+            pendingIt->second = {.compact=compact, .proposals={msgData}, .txsRequested=false, .fullSetRequested=false,
+                                 .received=std::chrono::steady_clock::now()};
+            // prefilled transactions are added to the transaction pool, so they are found by short IDs as the others
+            std::vector<TransactionPtr> prefilled(compact->prefilled.txSet.begin(), compact->prefilled.txSet.end());
+            acceptProposedTransactions(prefilled);
+            compact->prefilled.setNull();
+            completeTxSet(pendingIt, msgi);
+        }
+    }
+
+    void MessageProcessor::procTxSetDeltaProposalMessage(const message_item_t &msgi){
+        TxSetDeltaProposalMessage *msg = dynamic_cast<TxSetDeltaProposalMessage*>(msgi.msg);
+        if (msg != nullptr){
+            TxSetDeltaProposal delta;
+            TxSetProposalPtr msgData = nullptr;
+            try{
+                msg->deserialize(&delta);
+                msgData = std::make_shared<TxSetProposal>(delta.proposal);
+            } catch (const std::exception &e){
+                PQB_LOG_WARN("MESSAGE PROCESSOR", "Delta transaction set proposal from {} is malformed: {}", shortStr(msgi.peer_id), e.what());
+            }
+            delete msgi.msg;
+            if (msgData == nullptr || delta.baseSeq >= msgData->seq || !checkProposal(msgData)){
+                return;
+            }
+            TransactionSet set;
+            if (consensus->applyTxSetDelta(delta, set) && set.size() == msgData->txSet.transactionCount
+                && ComputeTxSetMerkleRoot(set) == msgData->TxSetId){
+                msgData->txSet.txSet = std::move(set);
+                consensus->notifyTxSetProposal(msgData);
+                return;
+            }
+            // base set or some added transaction is not known
+            requestWholeTxSet(msgData, msgi);
+        }
+    }
+
+    void MessageProcessor::procTxSetSketchProposalMessage(const message_item_t &msgi){
+        TxSetSketchProposalMessage *msg = dynamic_cast<TxSetSketchProposalMessage*>(msgi.msg);
+        if (msg != nullptr){
+            TxSetSketchProposal sketchProp;
+            TxSetProposalPtr msgData = nullptr;
+            try{
+                msg->deserialize(&sketchProp);
+                msgData = std::make_shared<TxSetProposal>(sketchProp.proposal);
+            } catch (const std::exception &e){
+                PQB_LOG_WARN("MESSAGE PROCESSOR", "Transaction set sketch proposal from {} is malformed: {}", shortStr(msgi.peer_id), e.what());
+            }
+            delete msgi.msg;
+            if (msgData == nullptr || !checkProposal(msgData)){
+                return;
+            }
+            // prefilled transactions are added to the transaction pool, so they are found by short IDs as the others
+            std::vector<TransactionPtr> prefilled(sketchProp.prefilled.txSet.begin(), sketchProp.prefilled.txSet.end());
+            acceptProposedTransactions(prefilled);
+            sketchProp.prefilled.setNull();
+            if (!consensus->notifyTxSetSketchProposal(sketchProp, msgData)){
+                // difference is too large or some different transaction is not known
+                requestWholeTxSet(msgData, msgi);
+            }
+        }
+    }
+
+    void MessageProcessor::procGetProposalTxsMessage(const message_item_t &msgi){
+        GetProposalTxsMessage *msg = dynamic_cast<GetProposalTxsMessage*>(msgi.msg);
+        if (msg != nullptr){
+            GetProposalTxsMessage::get_proposal_txs_msg_t msgData;
+            bool valid = true;
+            try{
+                msg->deserialize(&msgData);
+            } catch (const std::exception &e){
+                PQB_LOG_WARN("MESSAGE PROCESSOR", "Request for proposed transactions from {} is malformed: {}", shortStr(msgi.peer_id), e.what());
+                valid = false;
+            }
+            ProposalTxsMessage::proposal_txs_msg_t reply = {.txSetId=msgData.txSetId, .txs={}};
+            if (valid && consensus->getProposedTransactions(msgData.txSetId, msgData.indexes, reply.txs)){
+                ProposalTxsMessage *replyMsg = new ProposalTxsMessage(ProposalTxsMessage::getPayloadSize(reply));
+                replyMsg->serialize(&reply);
+                ConnectionManager::MessageRequest_t req = {.type=ConnectionManager::MessageRequestType::ONE, .connectionID=msgi.connection_id, .peerID=msgi.peer_id, .message=replyMsg};
+                connMng->addMessageRequest(req);
+            }
+            delete msgi.msg;
+        }
+    }
+
+    void MessageProcessor::procProposalTxsMessage(const message_item_t &msgi){
+        ProposalTxsMessage *msg = dynamic_cast<ProposalTxsMessage*>(msgi.msg);
+        if (msg != nullptr){
+            ProposalTxsMessage::proposal_txs_msg_t msgData;
+            bool valid = true;
+            try{
+                msg->deserialize(&msgData);
+            } catch (const std::exception &e){
+                PQB_LOG_WARN("MESSAGE PROCESSOR", "Proposed transactions from {} are malformed: {}", shortStr(msgi.peer_id), e.what());
+                valid = false;
+            }
+            delete msgi.msg;
+            if (!valid){
+                return;
+            }
+            auto pendingIt = pendingTxSets.find(msgData.txSetId.getHex());
+            if (pendingIt == pendingTxSets.end()){ // transactions were not requested or the request expired
+                return;
+            }
+            std::vector<TransactionPtr> txs(msgData.txs.txSet.begin(), msgData.txs.txSet.end());
+            acceptProposedTransactions(txs);
+            if (!pendingIt->second.fullSetRequested){
+                completeTxSet(pendingIt, msgi);
+                return;
+            }
+            // the whole set was requested, so it has to match its ID
+            TransactionSet set;
+            for (const auto &tx : txs){
+                if (tx != nullptr){
+                    set.insert(tx);
+                }
+            }
+            if (set.size() == txs.size() && ComputeTxSetMerkleRoot(set) == msgData.txSetId){
+                notifyPendingProposals(pendingIt->second, set);
+            } else {
+                PQB_LOG_WARN("MESSAGE PROCESSOR", "Transaction set {} received from {} does not match its ID",
+                            shortStr(pendingIt->first), shortStr(msgi.peer_id));
+            }
+            pendingTxSets.erase(pendingIt);
+        }
+    }
+
+    void MessageProcessor::acceptProposedTransactions(std::vector<TransactionPtr> &txs){
+        std::vector<TransactionPtr> newTxs; // proposed transactions that are not in our transaction pool
+        std::vector<size_t> newTxsIndexes;
+        for (size_t i = 0; i < txs.size(); i++){
+            TransactionPtr exTx = consensus->getTransactionFromPool(txs[i]->IDHash);
+            if (exTx != nullptr){
+                txs[i] = exTx;
+            } else {
+                newTxs.push_back(txs[i]);
+                newTxsIndexes.push_back(i);
+            }
+        }
+        // Check new transactions (signatures are verified in parallel)
+        std::vector<bool> results = checkTransactions(newTxs);
+        for (size_t i = 0; i < newTxs.size(); i++){
+            if (results[i]){
+                // Insert it to transaction pool, if it is on waiting list remove it
+                consensus->addTransactionToPool(newTxs[i]);
+                waitingData.erase(newTxs[i]->IDHash);
+            } else {
+                txs[newTxsIndexes[i]] = nullptr;
+            }
+        }
+    }
+
+    void MessageProcessor::completeTxSet(std::unordered_map<std::string, PendingTxSet_t>::iterator pendingIt, const message_item_t &msgi){
+        PendingTxSet_t &pending = pendingIt->second;
+        const byteId_t &txSetId = pending.compact->proposal.TxSetId;
+        TransactionSet set;
+        std::vector<uint32_t> missing;
+        if (consensus->reconstructTxSet(*pending.compact, set, missing)){
+            notifyPendingProposals(pending, set);
+            pendingTxSets.erase(pendingIt);
+            return;
+        }
+        // the whole set is requested if the missing transactions were already requested or if short IDs matched wrong transactions
+        if (!missing.empty() && !pending.txsRequested && GetProposalTxsMessage::getPayloadSize(missing.size()) <= MAX_INV_MESSAGE_SIZE){
+            PQB_LOG_TRACE("MESSAGE PROCESSOR", "Requesting {} of {} transactions of set {} from {}",
+                        missing.size(), pending.compact->shortIds.size(), shortStr(pendingIt->first), shortStr(msgi.peer_id));
+            pending.txsRequested = true;
+            requestProposalTxs(txSetId, missing, msgi);
+        } else if (!pending.fullSetRequested){
+            PQB_LOG_TRACE("MESSAGE PROCESSOR", "Requesting whole transaction set {} from {}", shortStr(pendingIt->first), shortStr(msgi.peer_id));
+            pending.fullSetRequested = true;
+            requestProposalTxs(txSetId, {}, msgi);
+        }
+    }
+
+    void MessageProcessor::notifyPendingProposals(PendingTxSet_t &pending, const TransactionSet &set){
+        for (auto &prop : pending.proposals){
+            prop->txSet.transactionCount = set.size();
+            prop->txSet.txSet = set;
+            consensus->notifyTxSetProposal(prop);
+        }
+    }
+
+    void MessageProcessor::requestWholeTxSet(TxSetProposalPtr &prop, const message_item_t &msgi){
+        expirePendingTxSets();
+        auto [pendingIt, inserted] = pendingTxSets.try_emplace(prop->TxSetId.getHex());
+        if (!inserted){ // transactions of the set are already requested
+            pendingIt->second.proposals.push_back(prop);
+            return;
+        }
+        PQB_LOG_TRACE("MESSAGE PROCESSOR", "Transaction set {} from {} can not be reconstructed, requesting whole set",
+                    shortStr(pendingIt->first), shortStr(msgi.peer_id));
+        pendingIt->second = {.compact=nullptr, .proposals={prop}, .txsRequested=false, .fullSetRequested=true,
+                             .received=std::chrono::steady_clock::now()};
+        requestProposalTxs(prop->TxSetId, {}, msgi);
+    }
+
+    void MessageProcessor::requestProposalTxs(const byteId_t &txSetId, const std::vector<uint32_t> &indexes, const message_item_t &msgi){
+        GetProposalTxsMessage::get_proposal_txs_msg_t msgData = {.txSetId=txSetId, .indexes=indexes};
+        GetProposalTxsMessage *msg = new GetProposalTxsMessage(GetProposalTxsMessage::getPayloadSize(indexes.size()));
+        msg->serialize(&msgData);
+        ConnectionManager::MessageRequest_t req = {.type=ConnectionManager::MessageRequestType::ONE, .connectionID=msgi.connection_id, .peerID=msgi.peer_id, .message=msg};
+        connMng->addMessageRequest(req);
+    }
+
+    void MessageProcessor::expirePendingTxSets(){
+        auto now = std::chrono::steady_clock::now();
+        for (auto it = pendingTxSets.begin(); it != pendingTxSets.end();){
+            if ((now - it->second.received) > std::chrono::milliseconds(COMPACT_PROPOSAL_TIMEOUT)){
+                PQB_LOG_TRACE("MESSAGE PROCESSOR", "Reconstruction of transaction set {} expired", shortStr(it->first));
+                it = pendingTxSets.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
     void MessageProcessor::procBlockMessage(const message_item_t &msgi){
         BlockMessage *msg = dynamic_cast<BlockMessage*>(msgi.msg);
         if (msg != nullptr){
             Block block;
             msg->deserialize(&block);
-            byte64_t blockHash = block.getBlockHash();
+            byteId_t blockHash = block.getBlockHash();
+            // block hash covers just the header, so received transactions and their witnesses have to match its Merkle roots
+            if (ComputeBlocksMerkleRoot(block) != block.transactionsMerkleRootHash ||
+                (block.hasSignatures() && ComputeTxSetSignaturesMerkleRoot(block.txSet) != block.signaturesMerkleRootHash)){
+                PQB_LOG_WARN("MESSAGE PROCESSOR", "Block {} from {} does not match its Merkle roots", shortStr(blockHash.getHex()), shortStr(msgi.peer_id));
+                delete msgi.msg;
+                return;
+            }
 
             const auto it = blockInvQuorum.find(blockHash);
             if (it != blockInvQuorum.end()){
@@ -720,7 +1764,7 @@ namespace PQB
         if (msg != nullptr){
             Account acc;
             msg->deserialize(&acc);
-            byte64_t accID = acc.getAccountID();
+            byteId_t accID = acc.getAccountID();
             const auto wit = waitingData.find(accID);
             if (wit != waitingData.end()){
                 waitingData.erase(wit);
@@ -830,7 +1874,7 @@ namespace PQB
                 }
             }
         } else {
-            if (!blockStor->getBlock(inv.itemID)){ // start quorum counting
+            if (!blockStor->hasBlock(inv.itemID)){ // start quorum counting
                 blockInvQuorum.emplace(inv.itemID, 1);
             }
         }
@@ -848,7 +1892,7 @@ namespace PQB
         return false;
     }
 
-    void MessageProcessor::forwardInvMessage(const byte64_t &item_id, InvType type, const message_item_t &msgi){
+    void MessageProcessor::forwardInvMessage(const byteId_t &item_id, InvType type, const message_item_t &msgi){
         // Create Inventory message for this transaction
         inv_message_t inv = {.requestType=type, .itemID=item_id};
         std::vector<inv_message_t> invVec = {inv};
@@ -868,7 +1912,7 @@ namespace PQB
         connMng->addMessageRequest(req);
     }
 
-    void MessageProcessor::procGetTransaction(const byte64_t &tx_id, const message_item_t &msgi){
+    void MessageProcessor::procGetTransaction(const byteId_t &tx_id, const message_item_t &msgi){
         TransactionPtr tx = consensus->getTransactionFromPool(tx_id);
         if (tx != nullptr){
             TransactionMessage *msg = new TransactionMessage(tx->getSize());
@@ -878,7 +1922,7 @@ namespace PQB
         }
     }
 
-    void MessageProcessor::procGetBlock(const byte64_t &block_id, const message_item_t &msgi){
+    void MessageProcessor::procGetBlock(const byteId_t &block_id, const message_item_t &msgi){
         byteBuffer rawBlock;
         if (blockStor->getRawBlock(block_id, rawBlock)){
             BlockMessage *msg = new BlockMessage(rawBlock.size());
@@ -888,7 +1932,7 @@ namespace PQB
         }
     }
 
-    void MessageProcessor::procGetAccount(const byte64_t &acc_id, const message_item_t &msgi){
+    void MessageProcessor::procGetAccount(const byteId_t &acc_id, const message_item_t &msgi){
         Account acc;
         if (accStor->getAccount(acc_id, acc)){
             AccountMessage *msg = new AccountMessage(acc.getSize());
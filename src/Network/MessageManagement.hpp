@@ -17,6 +17,7 @@
 #include <sstream>
 #include <queue>
 #include <set>
+#include <unordered_set>
 #include <map>
 #include <unordered_map>
 #include <algorithm>
@@ -26,7 +27,10 @@
 #include <atomic>
 #include <condition_variable>
 #include <memory>
-#include <poll.h>
+#include <functional>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <chrono>
 #include <sys/socket.h>
 #include <netdb.h>
 #include <arpa/inet.h>
@@ -36,8 +40,11 @@
 #include "AccountStorage.hpp"
 #include "BlocksStorage.hpp"
 #include "Connection.hpp"
+#include "IoUring.hpp"
 #include "AccountStorage.hpp"
 #include "Wallet.hpp"
+#include "SignatureVerifier.hpp"
+#include "VerifiedSignatureCache.hpp"
 
 
 namespace PQB
@@ -45,11 +52,26 @@ namespace PQB
 
 class ConsensusWrapper;
 class MessageProcessor;
+class NetworkReactor;
 
 
-/// @brief Class for managing connections with peers
+/// @brief Message which is created by the first I/O thread that has a receiver for it, then it is shared by all I/O threads
+struct LazyMessage_t{
+    std::once_flag created;
+    std::function<Message*()> factory; ///< creates the message, it is released after the message is created
+    MessagePtr message;
+};
+
+using LazyMessagePtr = std::shared_ptr<LazyMessage_t>;
+
+
+/// @brief Class for managing connections with peers. The connection managing thread accepts new connections and creates
+/// connections requested by addConnectionRequest(). Each connection is then owned by one of NetworkReactor threads,
+/// which receives and sends all its messages.
 class ConnectionManager{
 
+    friend class NetworkReactor;
+
 public:
 
     /// @brief Possible messages types for MessageProcessor
@@ -62,15 +84,19 @@ public:
     /// @brief Datatype representing a message request. Message requests are made for ConnectionManager that will process it.
     struct MessageRequest_t{
         MessageRequestType type; ///< Type of request
-        socket_t connectionID;   ///< ID of connection where the message will be sent, ignored if UNLCAST or BROADCASR message type
+        socket_t connectionID;   ///< ID of connection where the message will be sent, ignored if UNLCAST or BROADCASR message type
         std::string peerID;      ///< ID of peer to which the message will be sent, ignored if UNLCAST or BROADCASR message type    
         Message *message;        ///< Message to sent
+        std::chrono::steady_clock::time_point enqueued = {}; ///< time when the request was added (set by addMessageRequest())
+        std::function<Message*()> legacyMessage = nullptr; ///< Creates message sent instead of `message` to peers whose message version does not support it,
+                                                           ///< it is called at most once and only if there is such peer (nullptr to skip them)
     };
 
-    struct MessageRequestComparator {
-        bool operator()(const MessageRequest_t &a, const MessageRequest_t &b) const {
-            return a.message->getType() < b.message->getType();
-        }
+    /// @brief Statistics of time between adding a message request and sending the message (queue-to-wire latency)
+    struct QueueLatency_t{
+        uint64_t requests;  ///< number of sent message requests
+        double averageMs;   ///< average latency in milliseconds
+        double maxMs;       ///< maximal latency in milliseconds
     };
 
     /// @brief Datatype representing a connection request. Connection requests are mode for ConnectionManager that will try to initialize this connections.
@@ -79,12 +105,24 @@ public:
         bool setAsUNL;      ///< flag telling if connection should be treated as connection on the UNL
     };
 
-    ConnectionManager(MessageProcessor *msgProcessor, AccountAddressStorage *addressStorage, Wallet *wallet, NodeType type);
+    /**
+     * @brief Construct a new Connection Manager object
+     * 
+     * @param msgProcessor processor of received messages
+     * @param addressStorage storage with addresses of peers
+     * @param wallet local wallet
+     * @param type type of the local node
+     * @param numOfIOThreads number of network I/O threads (NetworkReactor), if 0 then a quarter of hardware threads is used
+     * @param backend backend of network I/O threads
+     */
+    ConnectionManager(MessageProcessor *msgProcessor, AccountAddressStorage *addressStorage, Wallet *wallet, NodeType type,
+                      size_t numOfIOThreads = 0, IOBackend backend = IOBackend::EPOLL);
 
     ~ConnectionManager();
 
     /**
-     * @brief Add a request for sending a message to the ConnectionMannager
+     * @brief Add a request for sending a message to the ConnectionMannager. The request is passed to the I/O thread which owns
+     * the connection (broadcasts to all I/O threads, they share the message), so the message is sent immediately.
      * 
      * @param req Message request to send
      */
@@ -106,13 +144,42 @@ public:
     int getConnectionID(std::string &peerID);
 
     /**
-     * @brief Notify this ConnectionManager that VERSION message was processed
+     * @brief Notify this ConnectionManager that VERSION message was processed. It is called by the I/O thread which
+     * owns the connection (VERSION messages are processed as soon as they are received).
      * 
      * @param connectionID ID of connection where VERSION message was received
      * @param peerID ID of the peer from VERSION message
+     * @param peerVersion message version of the peer from VERSION message
      * @param status The result of the processing. True if connection should be accepted, false if connection should be closed
+     * @param ackData ACK message which is sent to the peer if the connection is accepted
+     * @param session session accepted in ackData or nullptr if the peer did not offer a session
+     */
+    void notifyConnectionVersion(socket_t connectionID, std::string &peerID, uint32_t peerVersion, bool status,
+                                 AckMessage::ack_msg_t &ackData, PeerSessionPtr session);
+
+    /**
+     * @brief Decide if a connection gets UNL status. Peer ID from VERSION message is not authenticated itself,
+     * so the status is given only to a connection with session signed by the peer.
+     *
+     * @param unl IDs of peers on the UNL
+     * @param peerID ID of the peer from VERSION message
+     * @param hasSession true if a session was established with the peer
+     * @return true if the connection is UNL connection
      */
-    void notifyConnectionVersion(socket_t connectionID, std::string &peerID, bool status);
+    static bool grantsUNLStatus(const std::vector<std::string> &unl, const std::string &peerID, bool hasSession);
+
+    /**
+     * @brief Decide which of two connections with the same peer is kept. Connection with session is always preferred,
+     * else local wallet ID and peer ID are compared, so both peers keep the same connection.
+     *
+     * @param newHasSession true if the new connection has a session
+     * @param existingHasSession true if the existing connection has a session
+     * @param localID ID of the local wallet
+     * @param peerID ID of the peer
+     * @return true if the new connection is kept and the existing one is closed
+     * @return false if the new connection is closed
+     */
+    static bool keepNewConnection(bool newHasSession, bool existingHasSession, const std::string &localID, const std::string &peerID);
 
     /**
      * @brief Put Connection information to the string stream `ss`
@@ -126,8 +193,28 @@ public:
         return counterOfProcessedBytes_;
     }
 
+    /// @brief Give statistics of queue-to-wire latency of message requests
+    QueueLatency_t getQueueLatency();
+
+    /// @brief Give the number of low priority messages which were dropped because outbound queue of the peer was full
+    uint64_t getNumberOfDroppedMessages();
+
+    /// @brief Give the number of network I/O threads
+    size_t getNumberOfIOThreads() const {
+        return reactors.size();
+    }
+
+    /// @brief Put statistics of each network I/O thread to the string stream `ss`
+    void putIOThreadStatsToStringStream(std::stringstream &ss);
+
 private:
 
+    /// @brief Registered connection of a peer
+    struct PeerEntry_t{
+        socket_t connectionID;  ///< socket descriptor of the connection
+        bool isUNL;             ///< true if the connection is with peer on the UNL
+    };
+
     MessageProcessor *messsagProcessor;
     AccountAddressStorage *addrStorage;
     Wallet *wallet_;
@@ -136,19 +223,22 @@ private:
 
     std::queue<ConnectionRequest_t> connectionRequestQueue; ///< queue with requests for creating new connections
     std::mutex connectionRequestQueueMutex;
-    std::priority_queue<MessageRequest_t, std::vector<MessageRequest_t>, MessageRequestComparator> messageRequestQueue; ///< queue with requests for messages to send
-    std::mutex messageRequestQueueMutex;
 
     std::jthread connectionManagerThread;
     std::atomic_bool connectionManagerRunFlag; ///< true if message connection manager should run, false if should stop
 
-    std::unordered_map<socket_t, Connection*> connectionPool; ///< socket descriptors mapped to Connections
-    std::vector<struct pollfd> socketDescriptors; ///< vector of sokcet descriptors
-    std::set<std::string> setOfConnectedPeers; ///< addresses of connected peers (use for check that just one connection with peer is kept)
+    int epollFD; ///< epoll instance watching the server socket (edge-triggered)
+    int wakeupFD; ///< eventfd signaled when a connection request is added, it wakes up the connection managing thread from epoll_wait()
+    std::vector<NetworkReactor*> reactors; ///< network I/O threads, each of them owns a subset of connections
 
-    std::vector<socket_t> socketsToClose; ///< vector with socket IDs that should be closed
+    std::mutex registryMutex; ///< guards connectionOwners and peerConnections (they are used by all I/O threads)
+    std::unordered_map<socket_t, NetworkReactor*> connectionOwners; ///< socket descriptors mapped to I/O threads owning the connections
+    std::unordered_map<std::string, PeerEntry_t> peerConnections; ///< IDs of connected peers mapped to connections (use for check that just one connection with peer is kept)
 
-    size_t counterOfProcessedBytes_; ///< the number of bytes that were sent or received during the execution of this program
+    std::atomic<size_t> counterOfProcessedBytes_; ///< the number of bytes that were sent or received during the execution of this program
+    std::atomic<uint64_t> sentRequests_;        ///< number of sent message requests
+    std::atomic<uint64_t> queueLatencySumUs_;   ///< sum of queue-to-wire latencies of sent message requests in microseconds
+    std::atomic<uint64_t> queueLatencyMaxUs_;   ///< maximal queue-to-wire latency of a message request in microseconds
 
     /**
      * @brief Initialize new Connection to peer (Create a New Connection object)
@@ -162,7 +252,18 @@ private:
     bool createNewConnection(std::string &peerID, std::vector<std::string> &addresses, bool isOnUNL);
 
     /**
-     * @brief Add connection to connections pool
+     * @brief Offer a session to a UNL peer. Ephemeral Kyber1024 key and signature are added to the VERSION message
+     * and the handshake is stored in the connection until ACK message is received.
+     * 
+     * @param connection new connection with the peer
+     * @param peerID ID of the peer
+     * @param mData [in,out] VERSION message which will be sent to the peer
+     * @return false if the session can not be offered (public key of the peer is unknown)
+     */
+    bool offerSession(Connection *connection, std::string &peerID, VersionMessage::version_msg_t &mData);
+
+    /**
+     * @brief Register new connection and pass it to an I/O thread
      * 
      * @param port Port of the connection. Serves as temporory Connection ID
      * @param socket Sock object of the new connection
@@ -171,83 +272,29 @@ private:
      */
     bool acceptNewConnection(std::string &port, Sock *socket);
 
-    /**
-     * @brief Delete/Close a Connection
-     * 
-     * @param connectionID ID/address of peer to which the connection is made
-     */
-    void deleteConnection(const socket_t connectionID);
+    /// @brief Choose I/O thread for a new connection (the one with the least connections)
+    NetworkReactor *chooseReactor();
 
-    /**
-     * @brief Send a message to a peer
-     * 
-     * @param connectionID ID of the connection (socked descriptor of the connection)
-     * @param peerID ID of peer to which the message is addressed
-     * @param message message to be sent
-     * @return true If sending was successful
-     * @return false if sending failed
-     */
-    bool sendMessageToPeer(const socket_t connectionID, std::string &peerID, Message *message);
-
-    /**
-     * @brief Send a message to all connected peer (can exclude on connection). The connectionID and peerID
-     * specify connection that will be excluded from BROADCAST. This is useful when some peer send some message that
-     * will be propagated further to other peers. In this case it is not useful to send such a message to original sender.
-     * 
-     * If connectionID is set to 0 and peerID to empty string (""), then this message is sended to all peers without any excludion.
-     * 
-     * @param connectionID connection ID which will be excluded from broadcast
-     * @param peerID peer ID which will be excluded from broadcast
-     * @param message message to broadcast
-     */
-    void broadcastMessageToAllPeers(const socket_t connectionID, std::string &peerID, Message *message);
-
-    /**
-     * @brief Send a message to peers on the UNL (Unique Node List). The connectionID and peerID
-     * specify connection that will be excluded from UNLCAST. This is useful when some peer send some message that
-     * will be propagated further to other peers. In this case it is not useful to send such a message to original sender.
-     * 
-     * If connectionID is set to 0 and peerID to empty string (""), then this message is sended to all peers without any excludion.
-     * 
-     * @param connectionID connection ID which will be excluded from unlcast
-     * @param peerID peer ID which will be excluded from unlcast
-     * @param message message to unlcast
-     */
-    void broadcastMessageToUNLPeers(const socket_t connectionID, std::string &peerID, Message *message);
+    /// @brief Register connection owned by the reactor under the peer ID
+    /// @return True if success, False if ther is already existing connection with this socket descriptor or peer
+    bool registerConnection(const socket_t connectionID, const std::string &peerID, NetworkReactor *reactor, bool isUNL);
 
-    /// @brief Add Connection to connectionPool map and ID to setOfConnectedPeers
-    /// @return True if success, False if ther is already existing connection with this peer
-    bool addConnectionToConnectionPool(const socket_t connectionID, Connection* connection, const std::string &peerID);
+    /// @brief Remove closed connection from the registry. The peer ID is removed only if it belongs to this connection.
+    void unregisterConnection(const socket_t connectionID, const std::string &peerID);
 
-    /// @brief Delete Connection from peerConnections map and peerID from serOfConnectedPeers
-    void deleteConnectionFromConnectionPool(const socket_t connectionID, const std::string &peerID);
+    /// @brief Register the connection under new peer ID (old peer ID is removed if it belongs to this connection)
+    void renameConnection(const socket_t connectionID, const std::string &oldPeerID, const std::string &newPeerID, bool isUNL);
 
-    /// @brief Get a Connection from connectionPool, return nullptr if not found
-    Connection* getConnectionFromConnectionPool(const socket_t connectionID);
-    /// @brief Get a Connection from connectionPool, return nullptr if not found. THIS METHOD IS NOT OPTIMIZED!
-    Connection* getConnectionFromConnectionPool(const std::string &peerID);
+    /// @brief Get I/O thread owning the connection, return nullptr if not found
+    NetworkReactor *getConnectionOwner(const socket_t connectionID);
 
     /// @brief Check if exists connection with a peer (peerID). True if yes, False if no
     bool isConnectionInConnectionPool(const std::string &peerID);
 
-    /// @brief Check if connection with given connection ID is in the connectionPool. True if yes, False if no
-    bool isConnectionInConnectionPool(const socket_t connectionID);
-
-    /**
-     * @brief Update the Peer ID
-     * 
-     * @param connectionID ID of the connection (socked descriptor of the connection)
-     * @param oldPeerID used to be port of the connection with the peer
-     * @param newPeerID new ID to be set
-     * @return true if operation success
-     * @return false if connection with given connectionID is not presented in connection pool
-     */
-    bool updatePeerIdOfConnectionInConnectionPool(const socket_t connectionID, const std::string &oldPeerID, std::string &newPeerID);
-
-    /// @brief Add new socket descriptor to socketDescriptors vector
+    /// @brief Add new socket descriptor to the epoll instance (edge-triggered)
     void addSocketDescriptor(const socket_t socket_fd);
 
-    /// @brief Delete the socket descriptor from the socketDescriptors vector
+    /// @brief Delete the socket descriptor from the epoll instance
     void deleteSocketDescriptor(const socket_t socket_fd);
 
     /// @brief Start the server
@@ -272,16 +319,14 @@ private:
     /// @brief Method for running ConnectionManager thread
     void manageConnections();
 
-    /// @brief Handle accepting new connections aftere poll() set POLLIN flag
+    /// @brief Handle accepting new connections after epoll_wait() reported EPOLLIN event. All pending connections are accepted.
     void handleServerPoll();
 
-    /// @brief Handle message receiving of single connection after poll() set POLLIN flag
-    /// @param socket_fd Socket descriptor of the connection
-    /// @param closeFlag indicates if connection have closed
-    void handleConnectionPoll(int socket_fd, bool *closeFlag);
+    /// @brief Wake up the connection managing thread (signal wakeupFD)
+    void wakeup();
 
-    /// @brief Process all requests in the message queue
-    void processMessageQueueRequests();
+    /// @brief Record queue-to-wire latency of a sent message request
+    void recordQueueLatency(std::chrono::steady_clock::time_point enqueued);
 
     /// @brief Process all requests in the connection queue
     void processConnectionQueueRequests();
@@ -289,6 +334,285 @@ private:
 };
 
 
+/// @brief Event loop of one network I/O thread. It owns a subset of connections, all their sockets are watched by its epoll
+/// instance (or io_uring instance) and all messages of these connections are received and sent by this thread. Other threads
+/// pass requests to the reactor through its inbox and wake it up.
+class NetworkReactor{
+public:
+
+    /// @brief Statistics of one I/O thread
+    struct Stats_t{
+        size_t connections;         ///< number of connections owned by the thread
+        uint64_t receivedMessages;  ///< number of received messages
+        uint64_t receivedBytes;     ///< number of bytes of received messages
+        uint64_t sentMessages;      ///< number of messages queued for sending
+        uint64_t droppedMessages;   ///< number of low priority messages dropped because of full outbound queues
+        uint64_t loops;             ///< number of iterations of the event loop
+        uint64_t systemCalls;       ///< number of system calls of the event loop (waiting, receiving and sending)
+        IOBackend backend;          ///< backend used by the thread
+    };
+
+    /**
+     * @brief Construct a new Network Reactor object and start its thread
+     * 
+     * @param connectionManager ConnectionManager owning the reactor
+     * @param id index of the I/O thread
+     * @param backend requested backend, epoll is used if io_uring is not available
+     */
+    NetworkReactor(ConnectionManager *connectionManager, size_t id, IOBackend backend = IOBackend::EPOLL);
+    ~NetworkReactor();
+
+    NetworkReactor(const NetworkReactor&) = delete;
+    NetworkReactor& operator=(const NetworkReactor&) = delete;
+
+    /**
+     * @brief Pass new connection to this I/O thread (thread-safe)
+     * 
+     * @param connection new connection, the reactor takes its ownership
+     * @param message first message sent on the connection (VERSION) or nullptr
+     */
+    void addConnection(Connection *connection, const MessagePtr &message);
+
+    /**
+     * @brief Add request for sending a message to the connections of this I/O thread (thread-safe). The message is shared
+     * with other I/O threads, each of them queues it to its connections (just the header is specific for a connection).
+     * 
+     * @param req message request (the messages of the request are not used)
+     * @param message shared message to send
+     * @param legacyMessage shared message sent to peers which do not support `message` (created on first use) or nullptr
+     * @param recordLatency true if queue-to-wire latency should be recorded (once per request)
+     */
+    void addMessageRequest(const ConnectionManager::MessageRequest_t &req, const MessagePtr &message, const LazyMessagePtr &legacyMessage, bool recordLatency);
+
+    /// @brief Request closing of a connection of this I/O thread (thread-safe)
+    void closeConnection(socket_t connectionID);
+
+    /**
+     * @brief Confirm connection after its VERSION message was accepted and send ACK message. It has to be called
+     * by the thread of this reactor (from ConnectionManager::notifyConnectionVersion()).
+     * 
+     * @param connectionID ID of the connection
+     * @param peerID ID of the peer from VERSION message
+     * @param peerVersion message version of the peer
+     * @param isUNL true if the peer is on the UNL and the session was established with it
+     * @param session session accepted by the ACK message or nullptr
+     * @param ack ACK message
+     */
+    void confirmConnection(socket_t connectionID, std::string &peerID, uint32_t peerVersion, bool isUNL, PeerSessionPtr session, const MessagePtr &ack);
+
+    /// @brief Give number of connections owned by this I/O thread (including connections waiting in the inbox)
+    size_t getNumberOfConnections() const {
+        return numOfConnections;
+    }
+
+    /// @brief Give statistics of this I/O thread
+    Stats_t getStats() const;
+
+    /// @brief Put information about connections of this I/O thread to the string stream `ss`
+    void putConnectionDataToStringStream(std::stringstream &ss);
+
+private:
+
+    /// @brief Message request waiting in the inbox
+    struct Request_t{
+        ConnectionManager::MessageRequestType type;
+        socket_t connectionID;
+        std::string peerID;
+        MessagePtr message;
+        LazyMessagePtr legacyMessage;
+        std::chrono::steady_clock::time_point enqueued;
+        bool recordLatency;
+    };
+
+    struct RequestComparator {
+        bool operator()(const Request_t &a, const Request_t &b) const {
+            return a.message->getType() < b.message->getType();
+        }
+    };
+
+    ConnectionManager *connMng;
+    size_t reactorID; ///< index of the I/O thread
+    IOBackend requestedBackend; ///< backend requested by the constructor
+    std::atomic<IOBackend> backend_; ///< backend used by the thread
+
+    int epollFD; ///< epoll instance watching sockets of connections of this thread (edge-triggered)
+    int wakeupFD; ///< eventfd signaled when something is added to the inbox
+
+    std::mutex inboxMutex;
+    std::vector<std::pair<Connection*, MessagePtr>> newConnections; ///< connections passed to this thread with their first message
+    std::priority_queue<Request_t, std::vector<Request_t>, RequestComparator> messageRequests; ///< requests for messages to send
+    std::vector<socket_t> closeRequests; ///< connections which should be closed
+
+    std::mutex connectionPoolMutex; ///< guards connectionPool and connection IDs against readers from other threads (just this thread modifies them)
+    std::unordered_map<socket_t, Connection*> connectionPool; ///< socket descriptors mapped to Connections
+
+    std::vector<socket_t> socketsToClose; ///< vector with socket IDs that should be closed
+    std::unordered_set<socket_t> connectionsToFlush; ///< connections with new frames in the outbound queue
+    std::vector<socket_t> connectionsToRead; ///< connections with received bytes which were not read yet because of the receive budget
+    std::chrono::steady_clock::time_point lastReceiveTimeoutCheck; ///< time of the last check of receive deadlines of connections
+
+    std::atomic<size_t> numOfConnections;
+    std::atomic<uint64_t> receivedMessages_;
+    std::atomic<uint64_t> receivedBytes_;
+    std::atomic<uint64_t> sentMessages_;
+    std::atomic<uint64_t> droppedMessages_;
+    std::atomic<uint64_t> loops_;
+    std::atomic<uint64_t> systemCalls_;
+
+#ifdef PQB_IO_URING
+    /// @brief Types of io_uring requests (lowest byte of user data, the rest is the socket descriptor)
+    enum class RingRequest : uint8_t{
+        WAKEUP,     ///< read of wakeupFD
+        RECEIVE,    ///< multishot receive of a connection
+        SEND,       ///< sendmsg() of a connection
+        CANCEL      ///< cancellation of requests of a closed connection
+    };
+
+    /// @brief Maximal number of I/O vectors of one send request
+    static constexpr size_t RING_MAX_IOVEC = 64;
+    /// @brief Maximal number of linked send requests of one connection
+    static constexpr size_t RING_MAX_LINKED_SENDS = 4;
+
+    /// @brief Send request of a connection, it has to be valid until the request completes
+    struct RingSend_t{
+        struct msghdr message;
+        struct iovec iov[RING_MAX_IOVEC];
+        size_t size;    ///< number of bytes of the request
+    };
+
+    /// @brief io_uring requests of a connection
+    struct RingConnection_t{
+        bool receiving = false;     ///< multishot receive is active
+        size_t sends = 0;           ///< number of send requests in flight
+        size_t nextSend = 0;        ///< index of the send request which completes next
+        RingSend_t sendRequests[RING_MAX_LINKED_SENDS];
+    };
+
+    std::unique_ptr<IoUring> ring; ///< io_uring instance (nullptr if epoll is used)
+    std::unordered_map<socket_t, RingConnection_t> ringConnections; ///< requests of connections (also of closed connections with requests in flight)
+    std::unordered_map<socket_t, Connection*> closingConnections; ///< closed connections waiting for completion of their requests
+    uint64_t wakeupCounter; ///< buffer of the read request of wakeupFD
+#endif
+
+    std::atomic_bool runFlag; ///< true if the event loop should run, false if should stop
+    std::jthread reactorThread;
+
+    /// @brief Run event loop of the requested backend
+    void run();
+
+    /// @brief Event loop of the I/O thread with epoll backend
+    void runEpoll();
+
+    /// @brief Pass received message to MessageProcessor
+    void processReceivedMessage(socket_t socket_fd, Connection *conn, Message *msg);
+
+    /// @brief Start receiving of a new connection (epoll or io_uring)
+    void startReceiving(const socket_t socket_fd);
+
+    /// @brief Wake up the thread of this reactor (signal wakeupFD)
+    void wakeup();
+
+    /// @brief Take new connections, message requests and close requests from the inbox
+    void processInbox();
+
+    /// @brief Add socket of a connection to the epoll instance (EPOLLIN and EPOLLOUT, edge-triggered)
+    void addSocketDescriptor(const socket_t socket_fd);
+
+    /// @brief Get a Connection from connectionPool, return nullptr if not found
+    Connection* getConnectionFromConnectionPool(const socket_t connectionID);
+
+    /// @brief Close connection and delete it from connectionPool and from the registry of ConnectionManager
+    void deleteConnection(const socket_t connectionID);
+
+    /**
+     * @brief Send a message to a peer
+     * 
+     * @param connectionID ID of the connection (socked descriptor of the connection)
+     * @param peerID ID of peer to which the message is addressed
+     * @param message message to be sent
+     * @param legacyMessage message sent instead if the peer does not support `message` (nullptr to not send anything)
+     * @return true If sending was successful
+     * @return false if sending failed
+     */
+    bool sendMessageToPeer(const socket_t connectionID, const std::string &peerID, const MessagePtr &message, const LazyMessagePtr &legacyMessage);
+
+    /**
+     * @brief Send a message to all confirmed connections of this thread except the connection given by connectionID and peerID
+     * (the original sender of the message). If connectionID is set to 0 and peerID to empty string (""), then this message
+     * is sended to all peers without any excludion.
+     * 
+     * @param connectionID connection ID which will be excluded from broadcast
+     * @param peerID peer ID which will be excluded from broadcast
+     * @param message message to broadcast
+     * @param legacyMessage message sent to peers which do not support `message` (nullptr to skip them)
+     * @param onlyUNL true if the message is sent just to peers on the UNL (UNLCAST)
+     */
+    void broadcastMessage(const socket_t connectionID, const std::string &peerID, const MessagePtr &message, const LazyMessagePtr &legacyMessage, bool onlyUNL);
+
+    /// @brief Get the message of a request which can be sent to the connection (message or legacyMessage), nullptr if there is none.
+    /// Legacy message is created here when the first connection needs it.
+    static const MessagePtr &selectMessage(const Connection *connection, const MessagePtr &message, const LazyMessagePtr &legacyMessage);
+
+    /// @brief Put message to the outbound queue of the connection and schedule flushing of the queue
+    void queueMessage(Connection *connection, const MessagePtr &message);
+
+    /// @brief Send outbound queues of connections with new messages. Connections which failed or which peer is
+    /// not reading (queue is longer than OUTBOUND_QUEUE_LIMIT) are closed.
+    void flushConnections();
+
+    /// @brief Continue sending of the outbound queue of single connection after epoll_wait() reported EPOLLOUT event.
+    /// @param socket_fd Socket descriptor of the connection
+    /// @param closeFlag indicates if connection have failed
+    void handleConnectionWrite(int socket_fd, bool *closeFlag);
+
+    /// @brief Handle message receiving of single connection after epoll_wait() reported EPOLLIN event.
+    /// Socket is edge-triggered, so messages are received until all received bytes are read. If more than MAX_RECEIVE_BYTES_PER_ROUND
+    /// bytes were read, then the connection is added to connectionsToRead and reading continues in next round, so other connections
+    /// are served in the meantime.
+    /// @param socket_fd Socket descriptor of the connection
+    /// @param closeFlag indicates if connection have closed
+    void handleConnectionPoll(int socket_fd, bool *closeFlag);
+
+    /// @brief Continue reading of connections in connectionsToRead
+    void handlePendingReads();
+
+    /// @brief Close connections which did not send started message within MESSAGE_RECEIVE_TIMEOUT (checked at most once per second)
+    void closeExpiredConnections();
+
+#ifdef PQB_IO_URING
+    /// @brief Event loop of the I/O thread with io_uring backend. All requests of one iteration are submitted together
+    /// with waiting for completions, so the loop makes one system call per iteration.
+    void runIoUring();
+
+    /// @brief Make user data of io_uring request
+    static uint64_t ringUserData(socket_t socket_fd, RingRequest request){
+        return (static_cast<uint64_t>(socket_fd) << 8) | static_cast<uint64_t>(request);
+    }
+
+    /// @brief Handle completion of io_uring request
+    void handleRingCompletion(const struct io_uring_cqe &cqe);
+
+    /// @brief Parse messages from provided buffer received by multishot receive and start receiving again if it ended
+    void handleRingReceive(socket_t socket_fd, const struct io_uring_cqe &cqe);
+
+    /// @brief Remove sent bytes from the outbound queue and send the rest when all linked requests complete
+    void handleRingSend(socket_t socket_fd, const struct io_uring_cqe &cqe);
+
+    /**
+     * @brief Submit linked send requests with the outbound queue of the connection (if no send request is in flight).
+     * The requests reference frames in the queue, new frames are added behind them.
+     * 
+     * @param socket_fd Socket descriptor of the connection
+     * @param conn connection
+     */
+    void submitRingSends(socket_t socket_fd, Connection *conn);
+
+    /// @brief Delete closed connection if it has no io_uring request in flight
+    void finishRingClose(socket_t socket_fd);
+#endif
+};
+
+
 class MessageProcessor{
 public:
     
@@ -321,6 +645,16 @@ public:
      */
     bool checkTransaction(const TransactionPtr tx);
 
+    /**
+     * @brief Check multiple transactions at once. Same as checkTransaction() but signatures of the transactions are
+     * verified in parallel by the SignatureVerifier. Transactions of one batch (batch-signed transactions with the same
+     * signature of the same Merkle root) share one verification.
+     * 
+     * @param txs transactions to check
+     * @return std::vector<bool> results[i] is result of the check of txs[i]
+     */
+    std::vector<bool> checkTransactions(const std::vector<TransactionPtr> &txs);
+
     /**
      * @brief Check structure and signature of a proposal
      * 
@@ -331,13 +665,27 @@ public:
     bool checkProposal(const BlockProposalPtr &prop);
     bool checkProposal(const TxSetProposalPtr &prop);
 
+    /**
+     * @brief Get public key of an account (used by ConnectionManager to authenticate sessions with UNL peers)
+     * 
+     * @param accountID ID of the account
+     * @param publicKey [out] public key of the account
+     * @return false if the account is unknown
+     */
+    bool getAccountPublicKey(const byteId_t &accountID, byteBuffer &publicKey);
+
 private:
 
+    /// @brief Maximal number of TX messages which are taken from processingQueue and verified at once
+    static constexpr size_t MAX_TX_BATCH_SIZE = 256;
+
     ConnectionManager *connMng;
     AccountStorage *accStor;
     BlocksStorage *blockStor;
     ConsensusWrapper *consensus;
     Wallet *wallet;
+    SignatureVerifier sigVerifier; ///< worker pool for parallel verification of transaction signatures
+    VerifiedSignatureCache sigCache; ///< signatures of transactions and proposals that were already verified
 
     /// @brief Item for processing
     struct message_item_t{
@@ -345,12 +693,15 @@ private:
         std::string peer_id;
         bool isUNL;
         Message *msg;
+        uint64_t arrival;   ///< order of arrival of the message (messages of the same type are processed in order of arrival)
     };
 
     std::jthread processingThread;
 
     struct ProcessingQueueComparator {
         bool operator()(const message_item_t &a, const message_item_t &b) const {
+            if (a.msg->getType() == b.msg->getType())
+                return a.arrival > b.arrival;
             return a.msg->getType() < b.msg->getType();
         }
     };
@@ -360,15 +711,28 @@ private:
     std::mutex processingQueueMutex; ///< mutex protecting access to processingQueue
     std::condition_variable processCondition; ///< Condition for processing
     std::atomic_bool processingRun;  ///< flag telling if message processor thred is running
+    uint64_t arrivalCounter;         ///< counter of received messages, protected by processingQueueMutex
 
     ///< Map for storing block hashes and information about how many UNL nodes propagates inventory of blocks.
     ///< If UNL quorum for some block is > 80% then the block is considered valid and can be optained from peer with GetData message.
     ///< This mechanism is for Server nodes only because validator nodes make block and consensus so they do not have to relly on other nodes.
-    std::map<byte64_t, uint32_t> blockInvQuorum;
+    std::map<byteId_t, uint32_t> blockInvQuorum;
 
     /// @brief Set of data identifier which are awaiting to be recived because GetData message was sent to optain them.
     /// This attribute is used to ensure that just one GetData message is sent
-    std::set<byte64_t> waitingData;
+    std::set<byteId_t> waitingData;
+
+    /// @brief Compact transaction set proposal waiting for transactions which were not found by short IDs
+    struct PendingTxSet_t{
+        CompactTxSetProposalPtr compact;            ///< the first received compact proposal of the set (nullptr if the whole set was requested because of a delta or sketch proposal)
+        std::vector<TxSetProposalPtr> proposals;    ///< proposals of the set waiting for the transactions
+        bool txsRequested;                          ///< missing transactions were requested by their indexes
+        bool fullSetRequested;                      ///< whole transaction set was requested
+        std::chrono::steady_clock::time_point received; ///< time when the first proposal was received
+    };
+
+    /// @brief Compact transaction set proposals with missing transactions, keyed by hex of the transaction set ID
+    std::unordered_map<std::string, PendingTxSet_t> pendingTxSets;
 
     bool consensusMessages; ///< tell if Processor should process also messages related to consensus
 
@@ -385,6 +749,66 @@ private:
     /// @brief Message processor thread
     void messageProcessor();
 
+    /**
+     * @brief Check structure of a transaction and if its sender and receiver exist (everything except the signature)
+     * 
+     * @param tx transaction to check
+     * @param senderBalance [out] account of the transaction sender
+     * @return true if transaction passed the checks
+     */
+    bool checkTransactionAccounts(const TransactionPtr &tx, AccountBalance &senderBalance);
+
+    /**
+     * @brief Verify signature of a hash (transaction ID or proposal hash). Signatures that were already verified
+     * are found in sigCache and they are not verified again.
+     * 
+     * @param signedHash signed hash
+     * @param signature signature of the hash
+     * @param signerID account ID of the signer (its prepared public key is taken from AccountStorage::keyCache)
+     * @param publicKey public key of the signer
+     * @return true if signature is valid
+     */
+    bool verifySignature(const byteId_t &signedHash, const byteBuffer &signature, const byteId_t &signerID, const byteBuffer &publicKey);
+
+    /**
+     * @brief Accept a session offered in VERSION message. The offer has to be signed by the account of the peer.
+     * 
+     * @param versionData VERSION message with the offer
+     * @param ackData [out] ACK message, the ciphertext and signature of the session are added
+     * @return PeerSessionPtr accepted session or nullptr if the offer is not valid
+     */
+    PeerSessionPtr acceptSession(const VersionMessage::version_msg_t &versionData, AckMessage::ack_msg_t &ackData);
+
+    /**
+     * @brief Replace proposed transactions with the same transactions from the transaction pool and check the others.
+     * Valid new transactions are added to the transaction pool (signatures are verified in parallel).
+     * 
+     * @param txs [in,out] proposed transactions, invalid transactions are replaced by nullptr
+     */
+    void acceptProposedTransactions(std::vector<TransactionPtr> &txs);
+
+    /**
+     * @brief Reconstruct transaction set of a pending compact proposal from the transaction pool. If it is complete,
+     * the consensus is notified about all waiting proposals of the set and the set is not pending anymore. Else missing
+     * transactions are requested from the peer (the whole set if they were already requested or if the set does not match its ID).
+     * 
+     * @param pendingIt pending transaction set in pendingTxSets
+     * @param msgi information about the peer which sent the proposal or the transactions
+     */
+    void completeTxSet(std::unordered_map<std::string, PendingTxSet_t>::iterator pendingIt, const message_item_t &msgi);
+
+    /// @brief Notify the consensus about all proposals of a reconstructed transaction set
+    void notifyPendingProposals(PendingTxSet_t &pending, const TransactionSet &set);
+
+    /// @brief Request whole transaction set of a proposal which can not be reconstructed (proposal waits in pendingTxSets)
+    void requestWholeTxSet(TxSetProposalPtr &prop, const message_item_t &msgi);
+
+    /// @brief Send GETPROPOSALTXS message to the peer (empty indexes request the whole set)
+    void requestProposalTxs(const byteId_t &txSetId, const std::vector<uint32_t> &indexes, const message_item_t &msgi);
+
+    /// @brief Forget pending transaction sets which were not completed in COMPACT_PROPOSAL_TIMEOUT
+    void expirePendingTxSets();
+
     /**************************************************************/
 
     /*
@@ -399,10 +823,24 @@ private:
 
     void procTransactionMessage(const message_item_t &msgi);
 
+    /// @brief Process more TX messages at once, so signatures of the transactions can be verified in parallel.
+    /// Messages are processed in given order.
+    void procTransactionMessages(std::vector<message_item_t> &msgis);
+
     void procBlockProposalMessage(const message_item_t &msgi);
 
     void procTxSetProposalMessage(const message_item_t &msgi);
 
+    void procCompactTxSetProposalMessage(const message_item_t &msgi);
+
+    void procTxSetDeltaProposalMessage(const message_item_t &msgi);
+
+    void procTxSetSketchProposalMessage(const message_item_t &msgi);
+
+    void procGetProposalTxsMessage(const message_item_t &msgi);
+
+    void procProposalTxsMessage(const message_item_t &msgi);
+
     void procBlockMessage(const message_item_t &msgi);
 
     void procAccountMessage(const message_item_t &msgi);
@@ -429,7 +867,7 @@ private:
      * @param tx_id ID of the inventory item
      * @param msgi information about sender of original message (is used to exlude the original sender from broadcast)
      */
-    void forwardInvMessage(const byte64_t &item_id, InvType type, const message_item_t &msgi);
+    void forwardInvMessage(const byteId_t &item_id, InvType type, const message_item_t &msgi);
     void forwardInvMessage(const inv_message_t &inv, const message_item_t &msgi);
 
 
@@ -440,11 +878,11 @@ private:
      * and send them to peer.
     */
 
-    void procGetTransaction(const byte64_t &tx_id, const message_item_t &msgi);
+    void procGetTransaction(const byteId_t &tx_id, const message_item_t &msgi);
 
-    void procGetBlock(const byte64_t &block_id, const message_item_t &msgi);
+    void procGetBlock(const byteId_t &block_id, const message_item_t &msgi);
 
-    void procGetAccount(const byte64_t &acc_id, const message_item_t &msgi);
+    void procGetAccount(const byteId_t &acc_id, const message_item_t &msgi);
 
 };
 
@@ -87,6 +87,10 @@ namespace PQB{
         if (sock->Setsockopt(SOL_SOCKET, SO_REUSEADDR, (char *)&on, sizeof(on))){
             return false;
         }
+        // server socket is watched by edge-triggered epoll, so all pending connections are accepted until accept() fails
+        if (sock->SetNonBlocking() < 0){
+            return false;
+        }
         return true;
     }
 
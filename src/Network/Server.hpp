@@ -45,7 +45,7 @@ public:
      * @brief Accept a connection
      * 
      * @param [out] port This parameter will be set to port number of the new connection
-     * @return Sock* Socket object representing new connection
+     * @return Sock* Socket object representing new connection or nullptr if there is no pending connection (server socket is non-blocking)
      */
     Sock *AcceptConnection(std::string *port = nullptr);
 
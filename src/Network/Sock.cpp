@@ -9,6 +9,8 @@
  */
 
 #include "Sock.hpp"
+#include <fcntl.h>
+#include <sys/ioctl.h>
 
 
 namespace PQB{
@@ -55,6 +57,10 @@ namespace PQB{
         return send(socket, buffer, length, flags);
     }
 
+    ssize_t Sock::Sendmsg(const msghdr *message, int flags) const{
+        return sendmsg(socket, message, flags);
+    }
+
     ssize_t Sock::Recv(void *buffer, size_t length, int flags) const{
         return recv(socket, buffer, length, flags);
     }
@@ -71,6 +77,20 @@ namespace PQB{
         return shutdown(socket, how);
     }
 
+    int Sock::SetNonBlocking() const{
+        int flags = fcntl(socket, F_GETFL, 0);
+        if (flags < 0)
+            return flags;
+        return fcntl(socket, F_SETFL, flags | O_NONBLOCK);
+    }
+
+    int Sock::BytesAvailable() const{
+        int bytes = 0;
+        if (ioctl(socket, FIONREAD, &bytes) < 0)
+            return -1;
+        return bytes;
+    }
+
 } // namespace PQB
 
 /* END OF FILE */
\ No newline at end of file
@@ -51,6 +51,9 @@ public:
     /// @brief Wrapper for the standard Berkeley sockets send() function
     ssize_t Send(const void* buffer, size_t length, int flags) const;
 
+    /// @brief Wrapper for the standard Berkeley sockets sendmsg() function
+    ssize_t Sendmsg(const struct msghdr* message, int flags) const;
+
     /// @brief Wrapper for the standard Berkeley sockets recv() function
     ssize_t Recv(void* buffer, size_t length, int flags) const;
 
@@ -63,6 +66,13 @@ public:
     /// @brief Wrapper for the standard Berkeley sockets shutdown() function
     int Shutdown(int how);
 
+    /// @brief Set O_NONBLOCK flag of the socket with the standard fcntl() function
+    int SetNonBlocking() const;
+
+    /// @brief Get number of received bytes which were not read yet (FIONREAD request of the standard ioctl() function)
+    /// @return number of bytes or -1 on failure
+    int BytesAvailable() const;
+
 private:
     socket_t socket;
 };
@@ -27,7 +27,7 @@ namespace PQB{
         if ((buffer.size() - offset) < getAccountBalanceSize())
             throw PQB::Exceptions::Storage("Deseralization: buffer is smaller than BalanceData structure! Can not deserialize!");
 
-        publicKey.resize(Signer::GetInstance()->getPublicKeySize());
+        publicKey.resize(ChosenSigner::getPublicKeySize());
         std::memcpy(publicKey.data(), buffer.data() + offset, publicKey.size());
         offset += publicKey.size();
         deserializeField(buffer, offset, balance);
@@ -79,7 +79,7 @@ namespace PQB{
         }
     }
 
-    byte64_t Account::getAccountID(){
+    byteId_t Account::getAccountID(){
         if (id.IsNull() && !publicKey.empty()){
             HashMan::SHA512_hash(&id, publicKey.data(), publicKey.size());
         }
@@ -41,7 +41,7 @@ public:
     }
 
     size_t getAccountBalanceSize() const{
-        return sizeof(balance) + sizeof(txSequence) + Signer::GetInstance()->getPublicKeySize();
+        return sizeof(balance) + sizeof(txSequence) + ChosenSigner::getPublicKeySize();
     }
 
     void serializeAccountBalance(byteBuffer &buffer, size_t &offset);
@@ -89,7 +89,7 @@ public:
         id.SetNull();
     }
 
-    byte64_t getAccountID();
+    byteId_t getAccountID();
 
     size_t getSize() const{
         return getAccountBalanceSize() + getAccountAddressSize();
@@ -100,7 +100,7 @@ public:
     void deserialize(const byteBuffer &buffer, size_t &offset);
 
 private:
-    byte64_t id;
+    byteId_t id;
 };
 
 } // namespace PQB
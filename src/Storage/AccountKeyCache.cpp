@@ -0,0 +1,79 @@
+/**
+ * @file AccountKeyCache.cpp
+ * @author Michal Ľaš
+ * @brief Cache of prepared public keys of accounts which sign many messages
+ * @date 2024-05-08
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+#include "AccountKeyCache.hpp"
+#include "PQBExceptions.hpp"
+#include "Log.hpp"
+
+
+namespace PQB{
+
+    AccountKeyCache::AccountKeyCache(size_t capacity) : capacity(capacity), hits(0) {}
+
+    void AccountKeyCache::pin(const byteId_t &accountID){
+        std::lock_guard<std::mutex> lock(mutex);
+        auto [it, inserted] = keys.try_emplace(accountID);
+        if (!inserted && !it->second.pinned){
+            lru.erase(it->second.lruPosition);
+        }
+        it->second.pinned = true;
+    }
+
+    PreparedPublicKeyPtr AccountKeyCache::get(const byteId_t &accountID, const byteBuffer &publicKey){
+        std::lock_guard<std::mutex> lock(mutex);
+        auto [it, inserted] = keys.try_emplace(accountID);
+        CachedKey &cached = it->second;
+        if (inserted){
+            lru.push_front(accountID);
+            cached.lruPosition = lru.begin();
+        } else if (!cached.pinned){
+            lru.splice(lru.begin(), lru, cached.lruPosition);
+        }
+
+        if (cached.prepared != nullptr && cached.publicKey != publicKey){
+            cached.prepared = nullptr;
+            cached.publicKey.clear();
+        }
+        cached.uses++;
+
+        if (cached.prepared == nullptr && (cached.pinned || cached.uses >= HOT_SENDER_THRESHOLD)){
+            try{
+                cached.prepared = ChosenSigner::get().preparePublicKey(publicKey);
+                cached.publicKey = publicKey;
+            } catch (const PQB::Exceptions::Signer &e){
+                PQB_LOG_WARN("ACCOUNT KEY CACHE", "Failed to prepare public key of account {}: {}", shortStr(accountID.getHex()), e.what());
+            }
+        } else if (cached.prepared != nullptr){
+            hits.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        PreparedPublicKeyPtr prepared = cached.prepared;
+        if (inserted){
+            evict();
+        }
+        return prepared;
+    }
+
+    size_t AccountKeyCache::size(){
+        std::lock_guard<std::mutex> lock(mutex);
+        return keys.size();
+    }
+
+    void AccountKeyCache::evict(){
+        while (lru.size() > capacity){
+            keys.erase(lru.back());
+            lru.pop_back();
+        }
+    }
+
+} // namespace PQB
+
+/* END OF FILE */
@@ -0,0 +1,97 @@
+/**
+ * @file AccountKeyCache.hpp
+ * @author Michal Ľaš
+ * @brief Cache of prepared public keys of accounts which sign many messages
+ * @date 2024-05-08
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+#pragma once
+
+#include <map>
+#include <list>
+#include <mutex>
+#include <atomic>
+#include "PQBtypedefs.hpp"
+#include "Blob.hpp"
+#include "Signer.hpp"
+
+
+namespace PQB{
+
+
+/**
+ * @brief Cache of prepared public keys (SignAlgorithm::preparePublicKey()) of accounts that sign many messages.
+ * These are nodes on the UNL, which sign all proposals, and hot senders of transactions.
+ *
+ * Pinned accounts (UNL nodes) have the key prepared at the first lookup and they are never evicted. Other accounts
+ * get the key prepared when they are seen HOT_SENDER_THRESHOLD times, the least recently used of them are evicted
+ * when the capacity is exceeded. Cached key is dropped if the public key of the account is not the same as the key
+ * it was prepared from.
+ */
+class AccountKeyCache{
+public:
+
+    /// @brief Default maximal number of cached accounts which are not pinned
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+    /// @brief Number of lookups of an account after which its public key is prepared
+    static constexpr uint32_t HOT_SENDER_THRESHOLD = 2;
+
+    /**
+     * @brief Construct a new Account Key Cache object
+     *
+     * @param capacity maximal number of cached accounts which are not pinned
+     */
+    AccountKeyCache(size_t capacity = DEFAULT_CAPACITY);
+
+    AccountKeyCache(const AccountKeyCache &) = delete;
+    void operator=(const AccountKeyCache &) = delete;
+
+    /// @brief Keep prepared key of the account in the cache permanently (used for nodes on the UNL)
+    void pin(const byteId_t &accountID);
+
+    /**
+     * @brief Get prepared public key of an account. The key is prepared if the account is pinned or if it is a hot sender.
+     *
+     * @param accountID ID of the account
+     * @param publicKey current public key of the account
+     * @return PreparedPublicKeyPtr prepared public key or nullptr if the key is not (yet) prepared or it is invalid
+     */
+    PreparedPublicKeyPtr get(const byteId_t &accountID, const byteBuffer &publicKey);
+
+    /// @brief Get number of lookups that returned a prepared key
+    size_t getNumberOfHits() const {
+        return hits.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Get number of accounts in the cache (including accounts without prepared key)
+    size_t size();
+
+private:
+
+    /// @brief Cached account
+    struct CachedKey{
+        byteBuffer publicKey;                   ///< public key from which the prepared key was made
+        PreparedPublicKeyPtr prepared;          ///< prepared key or nullptr
+        uint32_t uses = 0;                      ///< number of lookups of the account
+        bool pinned = false;                    ///< pinned accounts are not in the lru list
+        std::list<byteId_t>::iterator lruPosition;
+    };
+
+    size_t capacity;
+    std::map<byteId_t, CachedKey> keys;
+    std::list<byteId_t> lru;                    ///< not pinned accounts, the most recently used first
+    std::mutex mutex;                           ///< mutex protecting keys and lru
+    std::atomic<size_t> hits;
+
+    /// @brief Remove the least recently used accounts if there are more than capacity of not pinned accounts
+    void evict();
+};
+
+
+} // namespace PQB
+
+/* END OF FILE */
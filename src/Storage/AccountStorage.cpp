@@ -34,7 +34,7 @@ void AccountBalanceStorage::Open(){
     }
 }
 
-bool AccountBalanceStorage::getBalance(const byte64_t &walletID, AccountBalance &acc) const{
+bool AccountBalanceStorage::getBalance(const byteId_t &walletID, AccountBalance &acc) const{
     std::string readValue;
     leveldb::Status status = db->Get(leveldb::ReadOptions(), leveldb::Slice((char*)walletID.data(), walletID.size()), &readValue);
     if (status.IsNotFound()){
@@ -49,7 +49,7 @@ bool AccountBalanceStorage::getBalance(const byte64_t &walletID, AccountBalance
     return true;
 }
 
-bool AccountBalanceStorage::setBalance(const byte64_t &walletID, AccountBalance &acc){
+bool AccountBalanceStorage::setBalance(const byteId_t &walletID, AccountBalance &acc){
     byteBuffer buffer;
     buffer.resize(acc.getAccountBalanceSize());
     size_t offset = 0;
@@ -85,7 +85,7 @@ void AccountBalanceStorage::setBalancesByAccDiffs(std::unordered_map<std::string
 
         acc.serializeAccountBalance(buffer, offset);
         leveldb::Slice value = leveldb::Slice((char*) buffer.data(), buffer.size());
-        batch.Put(leveldb::Slice((char*)tx.second.id, tx.second.id->size()), value);
+        batch.Put(leveldb::Slice((const char*)tx.second.id, tx.second.id->size()), value);
     }
     status = db->Write(leveldb::WriteOptions(), &batch);
     if (!status.ok())
@@ -93,10 +93,10 @@ void AccountBalanceStorage::setBalancesByAccDiffs(std::unordered_map<std::string
     PQB_LOG_TRACE("ACCOUNT STORAGE", "Account balances updated by transaction set");
 }
 
-byte64_t AccountBalanceStorage::getAccountsMerkleRootHash(){
+byteId_t AccountBalanceStorage::getAccountsMerkleRootHash(){
     leveldb::Iterator *it = db->NewIterator(leveldb::ReadOptions());
-    std::vector<byte64_t> accountHashes;
-    byte64_t hash;
+    std::vector<byteId_t> accountHashes;
+    byteId_t hash;
     // Iterate the database and get account hashes to accountHashes vector
     for (it->SeekToFirst(); it->Valid(); it->Next()){
         HashMan::SHA512_hash(&hash, (PQB::byte*)it->value().data(), it->value().size());
@@ -146,7 +146,7 @@ void AccountAddressStorage::Open(){
     }
 }
 
-bool AccountAddressStorage::getAddresses(const byte64_t &walletID, AccountAddress &acc) const{
+bool AccountAddressStorage::getAddresses(const byteId_t &walletID, AccountAddress &acc) const{
     std::string readValue;
     leveldb::Status status = db->Get(leveldb::ReadOptions(), leveldb::Slice((char*)walletID.data(), walletID.size()), &readValue);
     if (status.IsNotFound()){
@@ -161,7 +161,7 @@ bool AccountAddressStorage::getAddresses(const byte64_t &walletID, AccountAddres
     return true;
 }
 
-bool AccountAddressStorage::setAddresses(const byte64_t &walletID, AccountAddress &acc){
+bool AccountAddressStorage::setAddresses(const byteId_t &walletID, AccountAddress &acc){
     byteBuffer buffer;
     buffer.resize(acc.getAccountAddressSize());
     size_t offset = 0;
@@ -193,7 +193,7 @@ void AccountStorage::openDatabases(){
     addrDB->Open();
 }
 
-bool AccountStorage::getAccount(const byte64_t &walletID, Account &acc){
+bool AccountStorage::getAccount(const byteId_t &walletID, Account &acc){
     if (!blncDB->getBalance(walletID, acc))
         return false;
     if (!addrDB->getAddresses(walletID, acc))
@@ -201,7 +201,7 @@ bool AccountStorage::getAccount(const byte64_t &walletID, Account &acc){
     return true;
 }
 
-bool AccountStorage::setAccount(const byte64_t &walletID, Account &acc){
+bool AccountStorage::setAccount(const byteId_t &walletID, Account &acc){
     if (!blncDB->setBalance(walletID, acc))
         return false;
     if (!addrDB->setAddresses(walletID, acc))
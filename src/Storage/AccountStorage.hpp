@@ -21,6 +21,7 @@
 #include "leveldb/write_batch.h"
 #include "PQBtypedefs.hpp"
 #include "Account.hpp"
+#include "AccountKeyCache.hpp"
 #include "Blob.hpp"
 #include "Transaction.hpp"
 #include "Serialize.hpp"
@@ -52,7 +53,7 @@ public:
      * @return true if wallet was found
      * @return false if wallet was not found or if database Get operation fails
      */
-    bool getBalance(const byte64_t &walletID, AccountBalance &acc) const;
+    bool getBalance(const byteId_t &walletID, AccountBalance &acc) const;
 
     /**
      * @brief Put a BalanceData structure to the database.
@@ -64,11 +65,11 @@ public:
      * @return true if operation was successful
      * @return false if operation fails
      */
-    bool setBalance(const byte64_t &walletID, AccountBalance &acc);
+    bool setBalance(const byteId_t &walletID, AccountBalance &acc);
 
     /// @brief Structure with data for counting account differences
     struct AccountDifference{
-        byte64_t *id;            ///< pointer to identifier of account
+        const byteId_t *id;      ///< pointer to identifier of account
         signed long balanceDiff; ///< difference on account balance after applied transactions
         uint32_t txSequence;     ///< largest sequence number of transaction for particular account
     };
@@ -85,9 +86,9 @@ public:
     /**
      * @brief Calculate merkle tree root hash of all accounts (account balances) in the database
      * 
-     * @return byte64_t root hash of account balances
+     * @return byteId_t root hash of account balances
      */
-    byte64_t getAccountsMerkleRootHash();
+    byteId_t getAccountsMerkleRootHash();
 
     /**
      * @brief Put data of all account in the database to the string stream
@@ -126,7 +127,7 @@ public:
      * @return true if wallet was found
      * @return false if wallet was not found
      */
-    bool getAddresses(const byte64_t &walletID, AccountAddress &acc) const;
+    bool getAddresses(const byteId_t &walletID, AccountAddress &acc) const;
 
     /**
      * @brief Put an account addresses to the database.
@@ -138,7 +139,7 @@ public:
      * @return true if operation was successful
      * @return false if operation fails
      */
-    bool setAddresses(const byte64_t &walletID, AccountAddress &acc);
+    bool setAddresses(const byteId_t &walletID, AccountAddress &acc);
 
 
 protected:
@@ -176,7 +177,7 @@ public:
      * @return true if operation was successful
      * @return false if operation fails or wallet was not found
      */
-    bool getAccount(const byte64_t &walletID, Account &acc);
+    bool getAccount(const byteId_t &walletID, Account &acc);
 
     /**
      * @brief Set the Account object
@@ -186,11 +187,12 @@ public:
      * @return true if operation was successful
      * @return false if operation fails
      */
-    bool setAccount(const byte64_t &walletID, Account &acc);
+    bool setAccount(const byteId_t &walletID, Account &acc);
 
 
     AccountBalanceStorage *blncDB; ///< balance database
     AccountAddressStorage *addrDB; ///< address database
+    AccountKeyCache keyCache;      ///< prepared public keys of UNL nodes and hot senders
 };
 
 
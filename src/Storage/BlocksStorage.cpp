@@ -1,7 +1,7 @@
 /**
  * @file BlocksStorage.cpp
  * @author Michal Ľaš
- * @brief LevelDB databese for storing blockchain blocks (metadata + transactions)
+ * @brief LevelDB databese for storing blockchain blocks (metadata + transactions) and signatures of their transactions
  * @date 2024-02-26
  * 
  * @copyright Copyright (c) 2024
@@ -9,6 +9,7 @@
  */
 
 #include "BlocksStorage.hpp"
+#include "leveldb/write_batch.h"
 #include "PQBExceptions.hpp"
 #include "PQBconstants.hpp"
 #include "Log.hpp"
@@ -18,15 +19,21 @@ namespace PQB{
 
 BlocksStorage::BlocksStorage(){
     db = nullptr;
+    signaturesDb = nullptr;
     databaseOptions.create_if_missing = true;
     databaseOptions.block_size = MAX_BLOCK_SIZE;
     databaseOptions.block_cache = leveldb::NewLRUCache(2 * MAX_BLOCK_SIZE); /// 2MB, just for optimalization. This database wont be working with more than one block at once.
+    signaturesDatabaseOptions.create_if_missing = true;
+    signaturesDatabaseOptions.block_size = MAX_BLOCK_SIZE;
 }
 
 BlocksStorage::~BlocksStorage(){
     if(db != nullptr){
         delete db;
     }
+    if(signaturesDb != nullptr){
+        delete signaturesDb;
+    }
     delete databaseOptions.block_cache;
         
 }
@@ -36,9 +43,13 @@ void BlocksStorage::openDatabase(){
     if(!status.ok()){
         throw PQB::Exceptions::Storage(status.ToString());
     }
+    status = leveldb::DB::Open(signaturesDatabaseOptions, PQB::BLOCK_SIGNATURES_DATABASE_PATH.data(), &signaturesDb);
+    if(!status.ok()){
+        throw PQB::Exceptions::Storage(status.ToString());
+    }
 }
 
-Block *BlocksStorage::getBlock(const byte64_t &blockHash){
+Block *BlocksStorage::getBlock(const byteId_t &blockHash, bool withSignatures){
     std::string readValue;
     leveldb::Status status = db->Get(leveldb::ReadOptions(), leveldb::Slice((char*)blockHash.data(), blockHash.size()), &readValue);
     if (status.IsNotFound()){
@@ -51,10 +62,24 @@ Block *BlocksStorage::getBlock(const byte64_t &blockHash){
     Block *newBlock = new Block();
     size_t offset = 0;
     newBlock->deserialize(buffer, offset);
+    if (withSignatures && getSignatures(newBlock->sequence, blockHash, readValue)){
+        buffer.assign(readValue.begin(), readValue.end());
+        offset = 0;
+        newBlock->deserializeSignatures(buffer, offset);
+    }
     return newBlock;
 }
 
-bool BlocksStorage::getRawBlock(const byte64_t &blockHash, byteBuffer &buffer){
+bool BlocksStorage::hasBlock(const byteId_t &blockHash){
+    std::string readValue;
+    leveldb::Status status = db->Get(leveldb::ReadOptions(), leveldb::Slice((char*)blockHash.data(), blockHash.size()), &readValue);
+    if (!status.ok() && !status.IsNotFound()){
+        PQB_LOG_ERROR("BLOCK STORAGE", "Failed to get block: {}", status.ToString());
+    }
+    return status.ok();
+}
+
+bool BlocksStorage::getRawBlock(const byteId_t &blockHash, byteBuffer &buffer){
     std::string readValue;
     leveldb::Status status = db->Get(leveldb::ReadOptions(), leveldb::Slice((char*)blockHash.data(), blockHash.size()), &readValue);
     if (status.IsNotFound()){
@@ -65,21 +90,46 @@ bool BlocksStorage::getRawBlock(const byte64_t &blockHash, byteBuffer &buffer){
     }
     buffer.resize(readValue.size());
     std::memcpy(buffer.data(), readValue.data(), readValue.size());
-    return false;
+
+    BlockHeader header;
+    size_t offset = 0;
+    header.deserialize(buffer, offset);
+    std::string signatures;
+    if (getSignatures(header.sequence, blockHash, signatures)){
+        // stored block ends with the flag of the signatures section, set it and append the section
+        buffer.back() = 1;
+        buffer.insert(buffer.end(), signatures.begin(), signatures.end());
+    }
+    return true;
 }
 
 bool BlocksStorage::setBlock(const Block *block){
     byteBuffer buffer;
-    buffer.resize(block->getSize());
+    buffer.resize(block->getSize(false));
     size_t offset = 0;
-    block->serialize(buffer, offset);
-    byte64_t blockHash = block->getBlockHash();
+    block->serialize(buffer, offset, false);
+    byteId_t blockHash = block->getBlockHash();
+    // signatures and the block are in different databases, so the block record is written last as a commit marker
+    // and signatures are synced before it (signatures without the block are never read and they are pruned later)
+    if (block->hasSignatures()){
+        byteBuffer signatures(block->getSignaturesSize());
+        offset = 0;
+        block->serializeSignatures(signatures, offset);
+        leveldb::Slice value((char*) signatures.data(), signatures.size());
+        leveldb::WriteOptions writeOptions;
+        writeOptions.sync = true;
+        leveldb::Status status = signaturesDb->Put(writeOptions, getSignaturesKey(block->sequence, blockHash), value);
+        if (!status.ok()){
+            PQB_LOG_ERROR("BLOCK STORAGE", "Failed to put signatures of block: {}", status.ToString());
+            return false;
+        }
+    }
     if (setBlock(blockHash, buffer))
         return true;
     return false;
 }
 
-bool BlocksStorage::setBlock(const byte64_t &blockHash, const byteBuffer &buffer){
+bool BlocksStorage::setBlock(const byteId_t &blockHash, const byteBuffer &buffer){
     leveldb::Slice value((char*) buffer.data(), buffer.size());
     leveldb::Status status = db->Put(leveldb::WriteOptions(), leveldb::Slice((char*)blockHash.data(), blockHash.size()), value);
     if (!status.ok()){
@@ -90,6 +140,45 @@ bool BlocksStorage::setBlock(const byte64_t &blockHash, const byteBuffer &buffer
     return true;
 }
 
+size_t BlocksStorage::pruneSignatures(uint32_t sequence){
+    leveldb::WriteBatch batch;
+    size_t pruned = 0;
+    std::string lastKey = getSignaturesKey(sequence, byteId_t());
+    leveldb::Iterator *it = signaturesDb->NewIterator(leveldb::ReadOptions());
+    for (it->SeekToFirst(); it->Valid() && it->key().compare(lastKey) < 0; it->Next()){
+        batch.Delete(it->key());
+        pruned++;
+    }
+    delete it;
+    if (pruned == 0){
+        return 0;
+    }
+    leveldb::Status status = signaturesDb->Write(leveldb::WriteOptions(), &batch);
+    if (!status.ok()){
+        PQB_LOG_ERROR("BLOCK STORAGE", "Failed to prune signatures: {}", status.ToString());
+        return 0;
+    }
+    PQB_LOG_TRACE("BLOCK STORAGE", "Signatures of {} blocks with sequence lower than {} pruned", pruned, sequence);
+    return pruned;
+}
+
+std::string BlocksStorage::getSignaturesKey(uint32_t sequence, const byteId_t &blockHash){
+    std::string key(sizeof(sequence) + blockHash.size(), '\0');
+    for (size_t i = 0; i < sizeof(sequence); i++){
+        key[i] = (char)(sequence >> (8 * (sizeof(sequence) - 1 - i)));
+    }
+    std::memcpy(key.data() + sizeof(sequence), blockHash.data(), blockHash.size());
+    return key;
+}
+
+bool BlocksStorage::getSignatures(uint32_t sequence, const byteId_t &blockHash, std::string &signatures){
+    leveldb::Status status = signaturesDb->Get(leveldb::ReadOptions(), getSignaturesKey(sequence, blockHash), &signatures);
+    if (!status.ok() && !status.IsNotFound()){
+        PQB_LOG_ERROR("BLOCK STORAGE", "Failed to get signatures of block: {}", status.ToString());
+    }
+    return status.ok();
+}
+
 void BlocksStorage::putBlockHeadersDataToStringStream(std::stringstream &ss){
     leveldb::Iterator *it = db->NewIterator(leveldb::ReadOptions());
     Block block;
@@ -117,10 +206,10 @@ void BlocksStorage::putBlockHeadersDataToStringStream(std::stringstream &ss){
 }
 
 void BlocksStorage::putBlockTxDataToStringStream(std::string &block_id, std::stringstream &ss){
-    byte64_t bid;
+    byteId_t bid;
     bid.setHex(block_id);
     Block *block;
-    block = getBlock(bid);
+    block = getBlock(bid, false);
 
     for (const auto &tx : block->txSet){
         using clock = std::chrono::system_clock;
@@ -134,9 +223,15 @@ void BlocksStorage::putBlockTxDataToStringStream(std::string &block_id, std::str
         << "Seq.: " << tx->sequenceNumber << std::endl
         << "Timestamp: " << buffer << std::endl
         << "Amount: " << tx->cashAmount << std::endl
-        << "Send.: " << tx->senderWalletAddress.getHex() << std::endl
-        << "Recv.: " << tx->receiverWalletAddress.getHex() << std::endl
-        << std::endl << "------------------------------" << std::endl;
+        << "Send.: " << tx->senderWalletAddress.getHex() << std::endl;
+        tx->forEachOutput([&ss, &tx](const byteId_t &receiver, PQB::cash amount){
+            ss << "Recv.: " << receiver.getHex();
+            if (tx->isMultiPayment()){
+                ss << " (" << amount << ")";
+            }
+            ss << std::endl;
+        });
+        ss << std::endl << "------------------------------" << std::endl;
     }
 
     delete block;
@@ -1,7 +1,7 @@
 /**
  * @file BlocksStorage.hpp
  * @author Michal Ľaš
- * @brief LevelDB databese for storing blockchain blocks (metadata + transactions)
+ * @brief LevelDB databese for storing blockchain blocks (metadata + transactions) and signatures of their transactions
  * @date 2024-02-26
  * 
  * @copyright Copyright (c) 2024
@@ -22,6 +22,13 @@
 namespace PQB{
 
 
+/**
+ * @brief Storage of blockchain blocks
+ * 
+ * Headers and data sections of blocks are stored in one database (key is the block hash) and signatures sections
+ * in another one (key is big-endian block sequence followed by the block hash), so scans of blocks do not load
+ * signatures and signatures of old blocks can be pruned in order of block sequence.
+ */
 class BlocksStorage{
 public:
 
@@ -29,7 +36,7 @@ public:
     ~BlocksStorage();
 
     /**
-     * @brief Open LevelDB database
+     * @brief Open LevelDB databases
      * @exception If database fails to open
      * 
      */
@@ -39,24 +46,34 @@ public:
      * @brief Query a block data from the database
      * 
      * @param blockHash Identifier of the block to query
+     * @param withSignatures if false, signatures of block's transactions are not loaded
      * @return Block* pointer to block's data or nullptr if a block with given hash was not found or database Get error occure
+     * @note If signatures of the block were pruned, transactions of the returned block have no signatures (see BlockBody::hasSignatures())
      */
-    Block* getBlock(const byte64_t &blockHash);
+    Block* getBlock(const byteId_t &blockHash, bool withSignatures = true);
 
+    /**
+     * @brief Check if a block is in the database
+     * 
+     * @param blockHash Identifier of the block
+     * @return true if the block was found
+     */
+    bool hasBlock(const byteId_t &blockHash);
 
     /**
      * @brief Query a block data from the database
      * 
      * @param blockHash Identifier of the block to query
-     * @param buffer [out] buffer for raw block data
+     * @param buffer [out] buffer for raw block data (with the signatures section if signatures were not pruned)
      * @return true if operation was successful
      * @return false if operation fails
      */
-    bool getRawBlock(const byte64_t &blockHash, byteBuffer &buffer);
+    bool getRawBlock(const byteId_t &blockHash, byteBuffer &buffer);
 
 
     /**
-     * @brief Put block into database
+     * @brief Put block into database (signatures of its transactions are put to the signatures database before the block,
+     * so a stored block always has its signatures unless they were pruned)
      * 
      * @param block block data that will be inserted into the database
      * @return true if operation was successful
@@ -68,11 +85,19 @@ public:
      * @brief Put block into database
      * 
      * @param blockHash Identifier of the block
-     * @param buffer serialized block data that will be inserted into the database
+     * @param buffer serialized block data without the signatures section that will be inserted into the database
      * @return true if operation was successful
      * @return false if operation fails
      */
-    bool setBlock(const byte64_t &blockHash, const byteBuffer &buffer);
+    bool setBlock(const byteId_t &blockHash, const byteBuffer &buffer);
+
+    /**
+     * @brief Remove signatures of blocks with sequence lower than `sequence` from the database
+     * 
+     * @param sequence sequence of the oldest block whose signatures are kept
+     * @return number of blocks whose signatures were removed
+     */
+    size_t pruneSignatures(uint32_t sequence);
 
     /**
      * @brief Put data of all blocks in the database to the string stream `ss`
@@ -91,7 +116,16 @@ public:
 
 private:
     leveldb::Options databaseOptions;
+    leveldb::Options signaturesDatabaseOptions;
     leveldb::DB* db; ///< Instance of LevelDB database
+    leveldb::DB* signaturesDb; ///< Instance of LevelDB database for signatures of block's transactions
+
+    /// @brief Key of block's signatures in the signatures database (big-endian sequence and block hash)
+    static std::string getSignaturesKey(uint32_t sequence, const byteId_t &blockHash);
+
+    /// @brief Get serialized signatures section of the block
+    /// @return false if signatures were not found (they were pruned) or database Get error occure
+    bool getSignatures(uint32_t sequence, const byteId_t &blockHash, std::string &signatures);
 };
 
 
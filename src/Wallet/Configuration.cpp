@@ -75,6 +75,11 @@ namespace PQB{
             tx.timestamp = rawTx["timestamp"];
             tx.version = rawTx["version"];
             tx.confirmed = rawTx["confirmed"];
+            if (rawTx.contains("outputs")){
+                for (const auto &rawOutput : rawTx["outputs"]){
+                    tx.outputs.emplace_back(rawOutput["receiver_id"].get<std::string>(), rawOutput["amount"].get<PQB::cash>());
+                }
+            }
             rwd.txRecords.push_back(tx);
         }
         confFile.close();
@@ -105,6 +110,9 @@ namespace PQB{
             jTx["timestamp"] = rawTx.timestamp;
             jTx["version"] = rawTx.version;
             jTx["confirmed"] = rawTx.confirmed;
+            for (const auto &output : rawTx.outputs){
+                jTx["outputs"].push_back({{"receiver_id", output.first}, {"amount", output.second}});
+            }
             json["txRecords"].push_back(jTx);
         }
 
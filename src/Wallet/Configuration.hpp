@@ -36,6 +36,7 @@ public:
         std::string txID;
         std::string senderID;
         std::string receiverID;
+        std::vector<std::pair<std::string, PQB::cash>> outputs; ///< receiverIDs and amounts of multi-payment transaction
     };
 
     /// @brief Row Wallet data. PK, SK, walletID are represented as hexadecimal string
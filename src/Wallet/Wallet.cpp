@@ -26,8 +26,9 @@ namespace PQB{
         if (!conf->loadConf(rwd))
             return false;
 
-        secretKey.resize(Signer::GetInstance()->getPrivateKeySize());
-        publicKey.resize(Signer::GetInstance()->getPublicKeySize());
+        resetExpandedSecretKey();
+        secretKey.resize(ChosenSigner::getPrivateKeySize());
+        publicKey.resize(ChosenSigner::getPublicKeySize());
         hexStringToBytes(rwd.publicKey, publicKey.data(), publicKey.size());
         hexStringToBytes(rwd.secretKey, secretKey.data(), secretKey.size());
         walletID.setHex(rwd.walletID);
@@ -43,6 +44,12 @@ namespace PQB{
             txData.sequenceNumber = tx.sequenceNumber;
             txData.timestamp = tx.timestamp;
             txData.versionNumber = tx.version;
+            for (const auto &output : tx.outputs){
+                TxOutput txOutput;
+                txOutput.receiverWalletAddress.setHex(output.first);
+                txOutput.cashAmount = output.second;
+                txData.outputs.push_back(txOutput);
+            }
             std::pair<TransactionData, TxState> p = std::make_pair(txData, TxState(tx.confirmed));
             txRecords.emplace(tx.txID, p);
         }
@@ -67,6 +74,9 @@ namespace PQB{
             WalletConf::RawTransactionData_t rtd;
             rtd.senderID = tx.second.first.senderWalletAddress.getHex();
             rtd.receiverID = tx.second.first.receiverWalletAddress.getHex();
+            for (const auto &output : tx.second.first.outputs){
+                rtd.outputs.emplace_back(output.receiverWalletAddress.getHex(), output.cashAmount);
+            }
             rtd.cashAmount = tx.second.first.cashAmount;
             rtd.sequenceNumber = tx.second.first.sequenceNumber;
             rtd.version = tx.second.first.versionNumber;
@@ -91,23 +101,89 @@ namespace PQB{
         }
         */
         
-        txSequenceNumber++;
-        balance -= amount;
-
-        const auto time = std::chrono::system_clock::now();
         TransactionPtr tx = std::make_shared<PQB::Transaction>();
         tx->versionNumber = TX_VERSION;
         tx->cashAmount = amount;
+        tx->receiverWalletAddress.setHex(receiver);
+        prepareNewTransaction(tx);
+        tx->sign(*getExpandedSecretKey());
+        recordNewTransaction(tx);
+        return tx;
+    }
+
+    TransactionPtr Wallet::createNewTransaction(std::vector<std::pair<std::string, PQB::cash>> &payments){
+        if (payments.empty() || payments.size() > MAX_TX_OUTPUTS){
+            return nullptr;
+        }
+
+        TransactionPtr tx = std::make_shared<PQB::Transaction>();
+        tx->versionNumber = TX_VERSION_MULTI_PAYMENT;
+        tx->outputs.resize(payments.size());
+        uint64_t sum = 0;
+        for (size_t i = 0; i < payments.size(); i++){
+            tx->outputs[i].receiverWalletAddress.setHex(payments[i].first);
+            tx->outputs[i].cashAmount = payments[i].second;
+            sum += payments[i].second;
+        }
+        if (sum > std::numeric_limits<PQB::cash>::max()){
+            return nullptr;
+        }
+        tx->cashAmount = static_cast<PQB::cash>(sum);
+        prepareNewTransaction(tx);
+        tx->sign(*getExpandedSecretKey());
+        recordNewTransaction(tx);
+        return tx;
+    }
+
+    std::vector<TransactionPtr> Wallet::createNewTransactionBatch(std::vector<std::pair<std::string, PQB::cash>> &payments){
+        std::vector<TransactionPtr> batch;
+        if (payments.empty() || payments.size() > (size_t(1) << MAX_TX_BATCH_DEPTH)){
+            return batch;
+        }
+
+        std::vector<byteId_t> txIDs;
+        batch.reserve(payments.size());
+        txIDs.reserve(payments.size() + 1);
+        for (const auto &payment : payments){
+            TransactionPtr tx = std::make_shared<PQB::Transaction>();
+            tx->versionNumber = TX_VERSION | TX_FLAG_BATCH_SIGNED;
+            tx->cashAmount = payment.second;
+            tx->receiverWalletAddress.setHex(payment.first);
+            prepareNewTransaction(tx);
+            txIDs.push_back(tx->IDHash);
+            batch.push_back(tx);
+        }
+
+        std::vector<std::vector<byteId_t>> paths;
+        ComputeMerkleRootAndPaths(std::move(txIDs), paths);
+        for (size_t i = 0; i < batch.size(); i++){
+            batch[i]->batchIndex = i;
+            batch[i]->batchPath = std::move(paths[i]);
+        }
+        // all transactions have the same signed hash (Merkle root), so they share one signature
+        batch[0]->sign(*getExpandedSecretKey());
+        for (auto &tx : batch){
+            tx->signature = batch[0]->signature;
+            tx->signatureSize = batch[0]->signatureSize;
+            recordNewTransaction(tx);
+        }
+        return batch;
+    }
+
+    void Wallet::prepareNewTransaction(TransactionPtr &tx){
+        txSequenceNumber++;
+        balance -= tx->cashAmount;
+
+        const auto time = std::chrono::system_clock::now();
         tx->sequenceNumber = txSequenceNumber;
         tx->senderWalletAddress = walletID;
-        tx->receiverWalletAddress.setHex(receiver);
         tx->timestamp = std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
         tx->setHash();
-        tx->sign(secretKey);
+    }
 
+    void Wallet::recordNewTransaction(TransactionPtr &tx){
         std::pair<TransactionData, TxState> p = std::make_pair(tx->getTransactionData(), TxState::WAITING);
         txRecords.emplace(tx->IDHash.getHex(), p);
-        return tx;
     }
 
     void Wallet::updateTransaction(std::string transactionID, TxState status){
@@ -122,7 +198,7 @@ namespace PQB{
 
     void Wallet::receivedTransaction(std::string transactionID, TransactionData txData, TxState status){
         if (status == TxState::CONFIRMED){
-            addToBlance(txData.cashAmount);
+            addToBlance(txData.getAmountFor(walletID));
         }
         std::pair<TransactionData, TxState> value = std::make_pair(std::move(txData), status);
         txRecords.emplace(transactionID, value);
@@ -130,11 +206,25 @@ namespace PQB{
 
     void Wallet::genNewKeys()
     {
-        Signer::GetInstance()->genKeys(secretKey, publicKey);
+        resetExpandedSecretKey();
+        ChosenSigner::get().genKeys(secretKey, publicKey);
         if (walletID.IsNull())
             HashMan::SHA512_hash(&walletID, publicKey.data(), publicKey.size());
     }
 
+    ExpandedPrivateKeyPtr Wallet::getExpandedSecretKey(){
+        std::lock_guard<std::mutex> lock(expandedSecretKeyMutex);
+        if (expandedSecretKey == nullptr){
+            expandedSecretKey = ChosenSigner::get().expandPrivateKey(secretKey);
+        }
+        return expandedSecretKey;
+    }
+
+    void Wallet::resetExpandedSecretKey(){
+        std::lock_guard<std::mutex> lock(expandedSecretKeyMutex);
+        expandedSecretKey = nullptr;
+    }
+
     void Wallet::outputWalletTxRecords(std::stringstream &outStringStream){
         outStringStream 
             << std::setw(33) << std::left << "Transaction ID"
@@ -154,7 +244,8 @@ namespace PQB{
 
             outStringStream 
             << std::setw(33) << tx.first.substr(0, 32)
-            << std::setw(33) << tx.second.first.receiverWalletAddress.getHex().substr(0, 32)
+            << std::setw(33) << (tx.second.first.isMultiPayment() ? ("multi-payment (" + std::to_string(tx.second.first.outputs.size()) + ")")
+                                                                   : tx.second.first.receiverWalletAddress.getHex().substr(0, 32))
             << std::setw(21) << tx.second.first.cashAmount
             << std::setw(21) << tx.second.first.sequenceNumber
             << std::setw(21) << buffer
@@ -18,13 +18,16 @@
 #include <chrono>
 #include <utility>
 #include <sstream>
+#include <mutex>
 #include <memory>
+#include <limits>
 #include "PQBconstants.hpp"
 #include "PQBtypedefs.hpp"
 #include "Transaction.hpp"
 #include "HashManager.hpp"
 #include "Signer.hpp"
 #include "Configuration.hpp"
+#include "MerkleRootCompute.hpp"
 
 
 namespace PQB{
@@ -60,7 +63,7 @@ public:
 protected:
     byteBuffer publicKey;
     byteBuffer secretKey;
-    byte64_t walletID;
+    byteId_t walletID;
     std::vector<std::string> nodeAddresses;
     std::vector<std::string> nodeUNL;
     
@@ -85,7 +88,7 @@ public:
     u_int32_t getTxSeqNum() { return txSequenceNumber; }
     byteBuffer& getPublicKey() { return publicKey; }
     byteBuffer& getSecretKey() { return secretKey; }
-    byte64_t& getWalletID() { return walletID; }
+    byteId_t& getWalletID() { return walletID; }
     std::vector<std::string>& getAddressList() { return nodeAddresses; }
     std::vector<std::string>& getUNL() { return nodeUNL; }
     void setBalance(PQB::cash newBalance) { balance = newBalance; }
@@ -98,6 +101,18 @@ class Wallet : public WalletData{
 private:
 
     WalletConf *conf; ///< Configuration file reader and writer
+    ExpandedPrivateKeyPtr expandedSecretKey; ///< secretKey expanded for signing, created by first signature
+    std::mutex expandedSecretKeyMutex;       ///< mutex protecting expandedSecretKey
+
+    /// @brief Drop expanded secret key (when the secret key changes)
+    void resetExpandedSecretKey();
+
+    /// @brief Assign sequence number, sender and timestamp to a new transaction and hash it
+    /// @param tx new transaction with version, receivers and amount
+    void prepareNewTransaction(TransactionPtr &tx);
+
+    /// @brief Add a new signed transaction to transaction records
+    void recordNewTransaction(TransactionPtr &tx);
 
 public:
 
@@ -118,6 +133,17 @@ public:
     /// @return New created Transaction, nullptr if transaction can not be created because of missing balance (cash in wallet)
     TransactionPtr createNewTransaction(std::string &receiver, PQB::cash amount);
 
+    /// @brief Create a multi-payment transaction with this wallet (one signature and one sequence number for all payments)
+    /// @param payments pairs of hexadecimal string representing wallet address of a receiver and amount of resources to transfer to the receiver
+    /// @return New created Transaction, nullptr if there are no payments, more than MAX_TX_OUTPUTS payments or their sum overflows
+    TransactionPtr createNewTransaction(std::vector<std::pair<std::string, PQB::cash>> &payments);
+
+    /// @brief Create a batch of transactions with this wallet, one transaction for each payment. All transactions are signed
+    /// with one signature of Merkle root of their IDs (see Transaction::getSignedHash()).
+    /// @param payments pairs of hexadecimal string representing wallet address of a receiver and amount of resources to transfer to the receiver
+    /// @return New created transactions, empty if there are no payments or more than 2^MAX_TX_BATCH_DEPTH payments
+    std::vector<TransactionPtr> createNewTransactionBatch(std::vector<std::pair<std::string, PQB::cash>> &payments);
+
     /// @todo confirmTx, cancelTx, printTxRecords, keep track if transaction is confirmed or not
 
     /// @brief Set transaction in transaction records given `status`
@@ -134,6 +160,10 @@ public:
     /// @brief Generate new pair of keys for making digital signatures
     void genNewKeys();
 
+    /// @brief Get secret key of the wallet expanded for fast signing (see SignAlgorithm::expandPrivateKey())
+    /// @exception PQB::Exceptions::Signer if the secret key is invalid
+    ExpandedPrivateKeyPtr getExpandedSecretKey();
+
     /// @brief Serialize transactions made with this wallet and put them into `outStringStream` stream
     /// @param outStringStream [out] string stream where to put serialized wallet transactions
     void outputWalletTxRecords(std::stringstream &outStringStream);
@@ -1,16 +1,17 @@
 
 #include <gtest/gtest.h>
 #include "Blob.hpp"
+#include "TestIds.hpp"
 
 #include <string>
 #include <cstring>
 
 struct BlobTest : public testing::Test{
-    byte64_t *blob;
-    byte64_t *blob2;
+    byteId_t *blob;
+    byteId_t *blob2;
     void SetUp() { 
-        blob = new byte64_t(); 
-        blob2 = new byte64_t(4);
+        blob = new byteId_t(); 
+        blob2 = new byteId_t(4);
     }
 
     void TearDown() { 
@@ -42,11 +43,11 @@ TEST_F(BlobTest, Set_Hex){
 TEST_F(BlobTest, GetHex){
     std::string hex = "CF83E1357EEFB8BDF1542850D66D8007D620E4050B5715DC83F4A921D36CE9CE47D0D13C5D85F2B0FF8318D2877EEC2F63B931BD47417A81A538327AF927DA3E";
     blob->setHex(hex);
-    ASSERT_TRUE(blob->getHex() == hex);
+    ASSERT_TRUE(blob->getHex() == IdHex(hex));
 }
 
 TEST_F(BlobTest, Blob_EQ_1){
-    byte64_t b(4);
+    byteId_t b(4);
     ASSERT_TRUE(*blob2 == b);
 }
 
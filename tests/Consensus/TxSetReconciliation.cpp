@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include "Log.hpp"
+#include "Consensus.hpp"
+
+
+struct TxSetReconciliationTest : testing::Test{
+
+    PQB::Chain *chain;
+    PQB::ConsensusWrapper *consensus;
+    std::vector<PQB::TransactionPtr> txs;
+
+    void SetUp() {
+        PQB::Log::init(); // to avoid segfault from uninitialized logger
+        chain = new PQB::Chain(1, "ABC");
+        // storages and wallet are used just when a block is closed, which does not happen in the first seconds of a round
+        consensus = new PQB::ConsensusWrapper(chain, nullptr, nullptr, nullptr);
+        for (uint32_t i = 0; i < 64; i++){
+            txs.push_back(createTransaction(i));
+        }
+    }
+
+    void TearDown() {
+        delete consensus;
+        delete chain;
+        spdlog::drop_all();
+    }
+
+    /// @brief Create transaction with a dummy signature and given sequence number
+    PQB::TransactionPtr createTransaction(uint32_t sequenceNumber){
+        PQB::TransactionPtr tx = std::make_shared<PQB::Transaction>();
+        tx->receiverWalletAddress.setHex("ABC");
+        tx->senderWalletAddress.setHex("CAB");
+        tx->signature.resize(64, 'c');
+        tx->signatureSize = 64;
+        tx->sequenceNumber = sequenceNumber;
+        tx->setHash();
+        return tx;
+    }
+
+    /// @brief Create set of transactions txs[first], ..., txs[last - 1]
+    PQB::TransactionSet createSet(size_t first, size_t last){
+        return PQB::TransactionSet(txs.begin() + first, txs.begin() + last);
+    }
+
+    /// @brief Add transactions txs[first], ..., txs[last - 1] to the transaction pool
+    void addToPool(size_t first, size_t last){
+        for (size_t i = first; i < last; i++){
+            consensus->addTransactionToPool(txs[i]);
+        }
+    }
+
+    /// @brief Create proposal of current round with given transaction set
+    PQB::TxSetProposal createProposal(PQB::TransactionSet set, uint32_t seq){
+        PQB::TxSetProposal prop;
+        prop.seq = seq;
+        prop.issuer.setHex("DEF");
+        prop.previousBlockId.setHex(std::string(PQB::GENESIS_BLOCK_HASH));
+        prop.TxSetId = PQB::ComputeTxSetMerkleRoot(set);
+        prop.txSet.transactionCount = set.size();
+        prop.txSet.txSet = set;
+        return prop;
+    }
+
+    /// @brief Check if the consensus acquired transaction set with given ID
+    bool isAcquired(const byteId_t &txSetId){
+        PQB::BlockBody body;
+        return consensus->getProposedTransactions(txSetId, {}, body);
+    }
+};
+
+
+TEST_F(TxSetReconciliationTest, Reconstruct_Compact_Set){
+    addToPool(0, 12);
+    PQB::CompactTxSetProposal compact(createProposal(createSet(0, 10), 1), 42);
+    PQB::TransactionSet set;
+    std::vector<uint32_t> missing;
+    ASSERT_TRUE(consensus->reconstructTxSet(compact, set, missing));
+    EXPECT_TRUE(missing.empty());
+    EXPECT_EQ(set.size(), 10);
+    EXPECT_EQ(PQB::ComputeTxSetMerkleRoot(set), compact.proposal.TxSetId);
+}
+
+TEST_F(TxSetReconciliationTest, Reconstruct_Compact_Set_Missing_Transactions){
+    addToPool(0, 8);
+    PQB::TransactionSet proposed = createSet(0, 10);
+    PQB::CompactTxSetProposal compact(createProposal(proposed, 1), 42);
+    PQB::TransactionSet set;
+    std::vector<uint32_t> missing;
+    EXPECT_FALSE(consensus->reconstructTxSet(compact, set, missing));
+    EXPECT_TRUE(set.empty());
+    // missing transactions are requested by their indexes in the proposed set
+    std::vector<uint32_t> expected;
+    uint32_t index = 0;
+    for (const auto &tx : proposed){
+        if (tx == txs[8] || tx == txs[9]){
+            expected.push_back(index);
+        }
+        index++;
+    }
+    EXPECT_EQ(missing, expected);
+}
+
+TEST_F(TxSetReconciliationTest, Reconstruct_Compact_Set_Mismatch){
+    addToPool(0, 10);
+    PQB::CompactTxSetProposal compact(createProposal(createSet(0, 10), 1), 42);
+    PQB::TransactionSet other = createSet(0, 9);
+    compact.proposal.TxSetId = PQB::ComputeTxSetMerkleRoot(other);
+    PQB::TransactionSet set;
+    std::vector<uint32_t> missing;
+    // all short IDs are resolved, but the set does not match its ID, so the whole set has to be requested
+    EXPECT_FALSE(consensus->reconstructTxSet(compact, set, missing));
+    EXPECT_TRUE(missing.empty());
+    EXPECT_TRUE(set.empty());
+}
+
+TEST_F(TxSetReconciliationTest, Apply_Delta){
+    addToPool(0, 12);
+    PQB::TxSetProposalPtr base = std::make_shared<PQB::TxSetProposal>(createProposal(createSet(0, 10), 1));
+    consensus->notifyTxSetProposal(base);
+    ASSERT_TRUE(isAcquired(base->TxSetId));
+
+    PQB::TransactionSet baseSet = createSet(0, 10);
+    PQB::TransactionSet newSet = createSet(2, 12);
+    PQB::TxSetDeltaProposal delta(1, base->TxSetId, baseSet, newSet);
+    delta.proposal = createProposal(newSet, 2);
+    PQB::TransactionSet set;
+    ASSERT_TRUE(consensus->applyTxSetDelta(delta, set));
+    EXPECT_EQ(set.size(), newSet.size());
+    EXPECT_EQ(PQB::ComputeTxSetMerkleRoot(set), delta.proposal.TxSetId);
+}
+
+TEST_F(TxSetReconciliationTest, Apply_Delta_Fallback){
+    addToPool(0, 10);
+    PQB::TransactionSet baseSet = createSet(0, 10);
+    PQB::TransactionSet newSet = createSet(2, 12);
+    PQB::TxSetProposal baseProp = createProposal(baseSet, 1);
+    PQB::TxSetDeltaProposal delta(1, baseProp.TxSetId, baseSet, newSet);
+    delta.proposal = createProposal(newSet, 2);
+    PQB::TransactionSet set;
+    // base set is not known
+    EXPECT_FALSE(consensus->applyTxSetDelta(delta, set));
+
+    // added transactions are not in the transaction pool
+    PQB::TxSetProposalPtr base = std::make_shared<PQB::TxSetProposal>(baseProp);
+    consensus->notifyTxSetProposal(base);
+    EXPECT_FALSE(consensus->applyTxSetDelta(delta, set));
+}
+
+TEST_F(TxSetReconciliationTest, Sketch_Proposal_Reconciled){
+    addToPool(0, 14);
+    // our set is the whole transaction pool, the proposed set differs in 4 transactions
+    PQB::TransactionSet proposed = createSet(0, 10);
+    PQB::TxSetSketchProposal sketchProp(createProposal(proposed, 1), 42, 8);
+    PQB::TxSetProposalPtr prop = std::make_shared<PQB::TxSetProposal>(sketchProp.proposal);
+    ASSERT_TRUE(consensus->notifyTxSetSketchProposal(sketchProp, prop));
+    // reconciled set is taken over by the consensus
+    PQB::BlockBody body;
+    ASSERT_TRUE(consensus->getProposedTransactions(sketchProp.proposal.TxSetId, {}, body));
+    EXPECT_EQ(body.txSet.size(), proposed.size());
+    EXPECT_EQ(PQB::ComputeTxSetMerkleRoot(body.txSet), sketchProp.proposal.TxSetId);
+}
+
+TEST_F(TxSetReconciliationTest, Sketch_Proposal_Fallback){
+    addToPool(0, 10);
+    // proposed transaction is not in our transaction pool
+    PQB::TxSetSketchProposal unknownTx(createProposal(createSet(2, 12), 1), 42, 8);
+    PQB::TxSetProposalPtr prop = std::make_shared<PQB::TxSetProposal>(unknownTx.proposal);
+    EXPECT_FALSE(consensus->notifyTxSetSketchProposal(unknownTx, prop));
+    EXPECT_FALSE(isAcquired(unknownTx.proposal.TxSetId));
+
+    // difference is larger than capacity of the sketch
+    addToPool(10, 64);
+    PQB::TxSetSketchProposal tooLarge(createProposal(createSet(0, 2), 1), 42, 1);
+    prop = std::make_shared<PQB::TxSetProposal>(tooLarge.proposal);
+    EXPECT_FALSE(consensus->notifyTxSetSketchProposal(tooLarge, prop));
+    EXPECT_FALSE(isAcquired(tooLarge.proposal.TxSetId));
+}
+
+TEST_F(TxSetReconciliationTest, Sketch_Proposal_Mismatch){
+    addToPool(0, 12);
+    PQB::TxSetSketchProposal sketchProp(createProposal(createSet(0, 10), 1), 42, 8);
+    PQB::TransactionSet other = createSet(0, 9);
+    sketchProp.proposal.TxSetId = PQB::ComputeTxSetMerkleRoot(other);
+    PQB::TxSetProposalPtr prop = std::make_shared<PQB::TxSetProposal>(sketchProp.proposal);
+    EXPECT_FALSE(consensus->notifyTxSetSketchProposal(sketchProp, prop));
+    EXPECT_FALSE(isAcquired(sketchProp.proposal.TxSetId));
+}
+
+TEST_F(TxSetReconciliationTest, Sketch_Proposal_Stale){
+    addToPool(0, 12);
+    PQB::TxSetProposal stale = createProposal(createSet(0, 10), 1);
+    stale.previousBlockId.SetNull();
+    // sketch which can not be decoded, it is not decoded at all for proposal of other round
+    PQB::TxSetSketchProposal sketchProp(stale, 42, 0);
+    for (uint64_t key = 0; key < 1000; key++){
+        sketchProp.sketch.insert(key);
+    }
+    PQB::TxSetProposalPtr prop = std::make_shared<PQB::TxSetProposal>(sketchProp.proposal);
+    EXPECT_TRUE(consensus->notifyTxSetSketchProposal(sketchProp, prop));
+    EXPECT_TRUE(prop->txSet.txSet.empty());
+    EXPECT_FALSE(isAcquired(stale.TxSetId));
+
+    // proposal older than the last proposal of the issuer
+    PQB::TxSetProposalPtr last = std::make_shared<PQB::TxSetProposal>(createProposal(createSet(0, 11), 2));
+    consensus->notifyTxSetProposal(last);
+    PQB::TxSetSketchProposal older(createProposal(createSet(0, 10), 1), 42, 8);
+    prop = std::make_shared<PQB::TxSetProposal>(older.proposal);
+    EXPECT_TRUE(consensus->notifyTxSetSketchProposal(older, prop));
+    EXPECT_FALSE(isAcquired(older.proposal.TxSetId));
+}
+
+TEST_F(TxSetReconciliationTest, Sketch_Proposal_Crafted_Sketch){
+    // with empty transaction pool the sketch is decoded as it was received
+    PQB::TxSetSketchProposal sketchProp(createProposal(createSet(0, 10), 1), 42, 0);
+    // one key in the first cell only, decoding of such sketch would never end
+    PQB::SetSketch sketch(PQB::SetSketch::PARTS);
+    sketch.insert(0x0123456789ABCDEFULL);
+    PQB::byteBuffer buffer(sketch.getSize());
+    size_t offset = 0;
+    sketch.serialize(buffer, offset);
+    std::fill(buffer.begin() + sizeof(uint32_t) + sizeof(int32_t) + 2 * sizeof(uint64_t), buffer.end(), 0);
+    offset = 0;
+    sketchProp.sketch.deserialize(buffer, offset);
+    PQB::TxSetProposalPtr prop = std::make_shared<PQB::TxSetProposal>(sketchProp.proposal);
+    EXPECT_FALSE(consensus->notifyTxSetSketchProposal(sketchProp, prop));
+}
@@ -1,41 +1,97 @@
 
 #include <gtest/gtest.h>
 #include "HashManager.hpp"
+#include "TestIds.hpp"
 
 
 TEST(HashManagerTest, Hash_Empty_String){
-    byte64_t result;
+    byteId_t result;
     std::string str;
     str.clear();
     PQB::HashMan::SHA512_hash(&result, (PQB::byte *) str.data(), str.size());
-    EXPECT_STREQ(
-        result.getHex().c_str(),
-        "CF83E1357EEFB8BDF1542850D66D8007D620E4050B5715DC83F4A921D36CE9CE47D0D13C5D85F2B0FF8318D2877EEC2F63B931BD47417A81A538327AF927DA3E"
+    EXPECT_EQ(
+        result.getHex(),
+        IdHex("CF83E1357EEFB8BDF1542850D66D8007D620E4050B5715DC83F4A921D36CE9CE47D0D13C5D85F2B0FF8318D2877EEC2F63B931BD47417A81A538327AF927DA3E")
     );
 }
 
 TEST(HashManagerTest, Hash_Byte_Array){
-    byte64_t result;
+    byteId_t result;
     std::string str = "Hello world!";
     PQB::byteBuffer buffer;
     buffer.resize(str.size());
     std::memcpy(buffer.data(), str.data(), str.size());
     PQB::HashMan::SHA512_hash(&result, buffer.data(), buffer.size());
-    EXPECT_STREQ(
-        result.getHex().c_str(),
-        "F6CDE2A0F819314CDDE55FC227D8D7DAE3D28CC556222A0A8AD66D91CCAD4AAD6094F517A2182360C9AACF6A3DC323162CB6FD8CDFFEDB0FE038F55E85FFB5B6"
+    EXPECT_EQ(
+        result.getHex(),
+        IdHex("F6CDE2A0F819314CDDE55FC227D8D7DAE3D28CC556222A0A8AD66D91CCAD4AAD6094F517A2182360C9AACF6A3DC323162CB6FD8CDFFEDB0FE038F55E85FFB5B6")
     );
 }
 
 TEST(HashManagerTest, Hash_Hashes){
-    byte64_t result;
-    byte64_t first;
-    byte64_t second;
+    byteId_t result;
+    byteId_t first;
+    byteId_t second;
     first.setHex("21B4F4BD9E64ED355C3EB676A28EBEDAF6D8F17BDC365995B319097153044080516BD083BFCCE66121A3072646994C8430CC382B8DC543E84880183BF856CFF5");
     second.setHex("848B0779FF415F0AF4EA14DF9DD1D3C29AC41D836C7808896C4EBA19C51AC40A439CAF5E61EC88C307C7D619195229412EAA73FB2A5EA20D23CC86A9D8F86A0F");
     PQB::HashMan::SHA512_hash(&result, first, second);
-    EXPECT_STREQ(
-        result.getHex().c_str(),
-        "BA3E96C25D79453CD9F0E44EAECD8039F52AECB2BE8846D125C570374E5117713E364999653ECCAF2EED3B4A1B447AE59D294406DCC83F44183328E8BAE39673"
+    EXPECT_EQ(
+        result.getHex(),
+        IdHex(
+            "BA3E96C25D79453CD9F0E44EAECD8039F52AECB2BE8846D125C570374E5117713E364999653ECCAF2EED3B4A1B447AE59D294406DCC83F44183328E8BAE39673",
+            "E851552AFC28C4C03D65313759957DB659245E859A6C85E07BFD9EC2505B9218"
+        )
     );
-}
\ No newline at end of file
+}
+
+TEST(HashManagerTest, Hash_Truncated_To_Id_Size){
+    // result is prefix of SHA-512 with size of identifiers (whole SHA-512, or 32 bytes with SHORT_IDS option)
+    byteId_t result;
+    std::string str = "Hello world!";
+    PQB::HashMan::SHA512_hash(&result, (PQB::byte *) str.data(), str.size());
+    std::string sha512 = "F6CDE2A0F819314CDDE55FC227D8D7DAE3D28CC556222A0A8AD66D91CCAD4AAD6094F517A2182360C9AACF6A3DC323162CB6FD8CDFFEDB0FE038F55E85FFB5B6";
+    EXPECT_EQ(byteId_t::size() * 8, PQB_ID_BITS);
+    EXPECT_EQ(result.getHex(), sha512.substr(0, 2 * byteId_t::size()));
+}
+
+TEST(HashManagerTest, CRC32C_Check_Value){
+    std::string str = "123456789";
+    EXPECT_EQ(PQB::HashMan::CRC32C((PQB::byte *) str.data(), str.size()), 0xE3069283);
+    EXPECT_EQ(PQB::HashMan::CRC32C_software((PQB::byte *) str.data(), str.size()), 0xE3069283);
+    EXPECT_EQ(PQB::HashMan::CRC32C(nullptr, 0), 0);
+}
+
+TEST(HashManagerTest, CRC32C_Hardware_Matches_Software){
+    PQB::byteBuffer buffer(4099);
+    for (size_t i = 0; i < buffer.size(); i++){
+        buffer[i] = (PQB::byte) (i * 31 + 7);
+    }
+    // different alignments and sizes
+    for (size_t offset = 0; offset < 9; offset++){
+        EXPECT_EQ(
+            PQB::HashMan::CRC32C(buffer.data() + offset, buffer.size() - offset),
+            PQB::HashMan::CRC32C_software(buffer.data() + offset, buffer.size() - offset)
+        );
+    }
+    // check sum computed in more parts
+    uint32_t crc = PQB::HashMan::CRC32C(buffer.data(), 1000);
+    crc = PQB::HashMan::CRC32C(buffer.data() + 1000, buffer.size() - 1000, crc);
+    EXPECT_EQ(crc, PQB::HashMan::CRC32C(buffer.data(), buffer.size()));
+}
+
+TEST(HashManagerTest, SipHash24_Reference_Vectors){
+    // vectors from the SipHash paper (key 00 01 .. 0f, message 00 01 .. of given length)
+    PQB::byte key[PQB::HashMan::SIPHASH_KEY_SIZE];
+    PQB::byte message[15];
+    for (PQB::byte i = 0; i < sizeof(key); i++){
+        key[i] = i;
+    }
+    for (PQB::byte i = 0; i < sizeof(message); i++){
+        message[i] = i;
+    }
+    EXPECT_EQ(PQB::HashMan::SipHash24(key, message, 0), 0x726fdb47dd0e0e31ULL);
+    EXPECT_EQ(PQB::HashMan::SipHash24(key, message, 8), 0x93f5f5799a932462ULL);
+    EXPECT_EQ(PQB::HashMan::SipHash24(key, message, 15), 0xa129ca6149be45e5ULL);
+    key[0] ^= 1;
+    EXPECT_NE(PQB::HashMan::SipHash24(key, message, 15), 0xa129ca6149be45e5ULL);
+}
@@ -1,6 +1,7 @@
 
 #include <gtest/gtest.h>
 #include "MerkleRootCompute.hpp"
+#include "TestIds.hpp"
 
 
 struct MerkleTreeTest : testing::Test{
@@ -31,10 +32,13 @@ struct MerkleTreeTest : testing::Test{
 
 
 TEST_F(MerkleTreeTest, Merkle_Root_Odd){
-    byte64_t root = PQB::ComputeTxSetMerkleRoot(txSet);
-    EXPECT_STREQ(
-        root.getHex().c_str(),
-        "BAFEB796899BB1DEDA596C0C146BBF7F8C4E04A0D3488D0F5D96B5531F5A317B51C04B0CA52467ACD4603EB105A0FC1447D453431A7BC7B17B40FC2B10459255"
+    byteId_t root = PQB::ComputeTxSetMerkleRoot(txSet);
+    EXPECT_EQ(
+        root.getHex(),
+        IdHex(
+            "BAFEB796899BB1DEDA596C0C146BBF7F8C4E04A0D3488D0F5D96B5531F5A317B51C04B0CA52467ACD4603EB105A0FC1447D453431A7BC7B17B40FC2B10459255",
+            "9054EE7DAF578E6123AB97FF5ED695F636C68561310201B2158041E1FA7222EB"
+        )
     );
 }
 
@@ -44,10 +48,13 @@ TEST_F(MerkleTreeTest, Merkle_Root_Even){
     tx4->IDHash.setHex("2AC968752F624BE3E3DF46764B51B7831FEB70D40307DF5D587D4793BFFEAF8B4042A1FD6D465DF2AACC3304328D431EF10E083BAF690B8CC535480A4FEF092F");
     tx4->sequenceNumber = 4;
     txSet.insert(tx4);
-    byte64_t root = PQB::ComputeTxSetMerkleRoot(txSet);
-    EXPECT_STREQ(
-        root.getHex().c_str(),
-        "6594F932C421EE904B7D3C0A7BBC097DD23DBA201DC0E61D5848D5440FE458E59D895A93DF82130B18A54587450E9C69269798448B70186696176D3DDACE95C5"
+    byteId_t root = PQB::ComputeTxSetMerkleRoot(txSet);
+    EXPECT_EQ(
+        root.getHex(),
+        IdHex(
+            "6594F932C421EE904B7D3C0A7BBC097DD23DBA201DC0E61D5848D5440FE458E59D895A93DF82130B18A54587450E9C69269798448B70186696176D3DDACE95C5",
+            "7EB6C853A2053E40635A7ADF75FD45957F3B7A43E9D0328E2D70CA4618C48B0E"
+        )
     );
 
 }
@@ -58,20 +65,46 @@ TEST_F(MerkleTreeTest, Merkle_Root_Tree_Only_One){
     tx->IDHash.setHex("A");
     tx->sequenceNumber = 1;
     txSetOne.insert(tx);
-    byte64_t root = PQB::ComputeTxSetMerkleRoot(txSetOne);
-    EXPECT_STREQ(
-        root.getHex().c_str(),
-        "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    byteId_t root = PQB::ComputeTxSetMerkleRoot(txSetOne);
+    EXPECT_EQ(
+        root.getHex(),
+        IdHex("00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000")
     );
 }
 
 TEST_F(MerkleTreeTest, Empty_Tree){
     PQB::TransactionSet txSetEmpty;
     txSetEmpty.clear();
-    byte64_t root = PQB::ComputeTxSetMerkleRoot(txSetEmpty);
-    EXPECT_STREQ(
-        root.getHex().c_str(),
-        "CF83E1357EEFB8BDF1542850D66D8007D620E4050B5715DC83F4A921D36CE9CE47D0D13C5D85F2B0FF8318D2877EEC2F63B931BD47417A81A538327AF927DA3E"
+    byteId_t root = PQB::ComputeTxSetMerkleRoot(txSetEmpty);
+    EXPECT_EQ(
+        root.getHex(),
+        IdHex("CF83E1357EEFB8BDF1542850D66D8007D620E4050B5715DC83F4A921D36CE9CE47D0D13C5D85F2B0FF8318D2877EEC2F63B931BD47417A81A538327AF927DA3E")
     );
 }
 
+
+TEST_F(MerkleTreeTest, Audit_Paths){
+    // audit path of every leaf leads to the Merkle root (also for odd numbers of leafs)
+    for (size_t n = 1; n <= 9; n++){
+        std::vector<byteId_t> leafs;
+        for (size_t i = 0; i < n; i++){
+            leafs.push_back(byteId_t(i + 1));
+        }
+        std::vector<std::vector<byteId_t>> paths;
+        byteId_t root = PQB::ComputeMerkleRootAndPaths(leafs, paths);
+        EXPECT_TRUE(root == PQB::ComputeMerkleRoot(leafs));
+        ASSERT_EQ(paths.size(), n);
+        for (size_t i = 0; i < n; i++){
+            PQB::Transaction tx;
+            tx.versionNumber = PQB::TX_VERSION | PQB::TX_FLAG_BATCH_SIGNED;
+            tx.IDHash = leafs[i];
+            tx.batchIndex = i;
+            tx.batchPath = paths[i];
+            EXPECT_TRUE(tx.getSignedHash() == root);
+            tx.batchIndex = (i + 1) % n;
+            if (n > 1){
+                EXPECT_FALSE(tx.getSignedHash() == root);
+            }
+        }
+    }
+}
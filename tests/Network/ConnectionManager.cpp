@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "MessageManagement.hpp"
+
+
+struct ConnectionManagerTest : testing::Test{
+
+    std::string localID;
+    std::string unlPeerID;
+    std::string otherPeerID;
+    std::vector<std::string> unl;
+
+    void SetUp() {
+        localID = std::string(PQB_ID_BITS / 4, '5');
+        unlPeerID = std::string(PQB_ID_BITS / 4, 'A');
+        otherPeerID = std::string(PQB_ID_BITS / 4, '1');
+        unl = {unlPeerID};
+    }
+
+    void TearDown() {
+
+    }
+};
+
+
+TEST_F(ConnectionManagerTest, UNL_Status_Requires_Session){
+    EXPECT_TRUE(PQB::ConnectionManager::grantsUNLStatus(unl, unlPeerID, true));
+    EXPECT_FALSE(PQB::ConnectionManager::grantsUNLStatus(unl, otherPeerID, true));
+    EXPECT_FALSE(PQB::ConnectionManager::grantsUNLStatus(unl, otherPeerID, false));
+}
+
+TEST_F(ConnectionManagerTest, Spoofed_UNL_ID_Does_Not_Replace_Session){
+    // Peer claims ID from the UNL, but it does not offer a session (it does not have the secret key of the UNL peer)
+    bool spoofedIsUNL = PQB::ConnectionManager::grantsUNLStatus(unl, unlPeerID, false);
+    EXPECT_FALSE(spoofedIsUNL);
+    // Existing authenticated connection with the UNL peer is kept regardless of the order of IDs
+    EXPECT_GT(unlPeerID, localID);
+    EXPECT_FALSE(PQB::ConnectionManager::keepNewConnection(spoofedIsUNL, true, localID, unlPeerID));
+    EXPECT_FALSE(PQB::ConnectionManager::keepNewConnection(spoofedIsUNL, true, unlPeerID, localID));
+}
+
+TEST_F(ConnectionManagerTest, Session_Replaces_Connection_Without_Session){
+    EXPECT_TRUE(PQB::ConnectionManager::keepNewConnection(true, false, localID, unlPeerID));
+    EXPECT_TRUE(PQB::ConnectionManager::keepNewConnection(true, false, unlPeerID, localID));
+}
+
+TEST_F(ConnectionManagerTest, Duplicit_Connections_Decided_By_IDs){
+    // Both peers have to keep the same connection, so the decisions of the two sides are opposite
+    for (bool hasSession : {false, true}){
+        bool localKeepsNew = PQB::ConnectionManager::keepNewConnection(hasSession, hasSession, localID, otherPeerID);
+        bool peerKeepsNew = PQB::ConnectionManager::keepNewConnection(hasSession, hasSession, otherPeerID, localID);
+        EXPECT_NE(localKeepsNew, peerKeepsNew);
+        EXPECT_FALSE(localKeepsNew);
+    }
+}
@@ -0,0 +1,293 @@
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "CpuFeatures.hpp"
+
+extern "C"{
+    #include <aes.h>
+    #include <sha2.h>
+    #include <randombytes.h>
+    #include <falcon1024.h>
+    #include <falcon1024_clean.h>
+    #include <falcon512.h>
+    #include <falcon512_clean.h>
+    #include <dilithium5.h>
+    #include <dilithium5_clean.h>
+    #include <dilithium3.h>
+    #include <dilithium3_clean.h>
+    #include <dilithium2.h>
+    #include <dilithium2_clean.h>
+}
+
+
+/// @brief AES-256 CTR DRBG of NIST KAT generators (PQCgenKAT_sign.c), it serves PQClean randombytes() in tests
+struct NistKatRng{
+    static inline uint8_t key[32];
+    static inline uint8_t v[16];
+
+    static void incrementV(){
+        for (int j = 15; j >= 0; j--){
+            if (++v[j] != 0){
+                break;
+            }
+        }
+    }
+
+    static void update(const uint8_t *providedData){
+        uint8_t temp[48];
+        aes256ctx ctx;
+        aes256_ecb_keyexp(&ctx, key);
+        for (int i = 0; i < 3; i++){
+            incrementV();
+            aes256_ecb(temp + 16 * i, v, 1, &ctx);
+        }
+        aes256_ctx_release(&ctx);
+        if (providedData != nullptr){
+            for (int i = 0; i < 48; i++){
+                temp[i] ^= providedData[i];
+            }
+        }
+        std::memcpy(key, temp, 32);
+        std::memcpy(v, temp + 32, 16);
+    }
+
+    static void init(const uint8_t entropy[48]){
+        std::memset(key, 0, sizeof(key));
+        std::memset(v, 0, sizeof(v));
+        update(entropy);
+    }
+
+    static int randombytes(uint8_t *output, size_t n){
+        uint8_t block[16];
+        aes256ctx ctx;
+        aes256_ecb_keyexp(&ctx, key);
+        while (n > 0){
+            incrementV();
+            aes256_ecb(block, v, 1, &ctx);
+            size_t chunk = n < 16 ? n : 16;
+            std::memcpy(output, block, chunk);
+            output += chunk;
+            n -= chunk;
+        }
+        aes256_ctx_release(&ctx);
+        update(nullptr);
+        return 0;
+    }
+};
+
+
+/// @brief Functions and sizes of one implementation (build) of PQClean signature algorithm
+struct Implementation{
+    bool avx2;
+    size_t pkSize;
+    size_t skSize;
+    size_t sigSize;
+    size_t preparedPkSize;
+    int (*keypair)(uint8_t *pk, uint8_t *sk);
+    int (*sign)(uint8_t *sm, size_t *smlen, const uint8_t *m, size_t mlen, const uint8_t *sk);
+    int (*signature)(uint8_t *sig, size_t *siglen, const uint8_t *m, size_t mlen, const uint8_t *sk);
+    int (*verify)(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen, const uint8_t *pk);
+    int (*preparePk)(uint8_t *ppk, const uint8_t *pk);
+    int (*verifyPrepared)(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen, const uint8_t *ppk);
+};
+
+#define PQB_TEST_IMPLEMENTATION(avx2, prefix) \
+    Implementation{avx2, prefix##CRYPTO_PUBLICKEYBYTES, prefix##CRYPTO_SECRETKEYBYTES, prefix##CRYPTO_BYTES, \
+        prefix##CRYPTO_PREPAREDPKBYTES, prefix##crypto_sign_keypair, prefix##crypto_sign, prefix##crypto_sign_signature, \
+        prefix##crypto_sign_verify, prefix##crypto_sign_prepare_pk, prefix##crypto_sign_verify_prepared}
+
+const Implementation falcon1024Avx2 = PQB_TEST_IMPLEMENTATION(true, PQCLEAN_FALCON1024_AVX2_);
+const Implementation falcon1024Clean = PQB_TEST_IMPLEMENTATION(false, PQCLEAN_FALCON1024_CLEAN_);
+const Implementation falcon512Avx2 = PQB_TEST_IMPLEMENTATION(true, PQCLEAN_FALCON512_AVX2_);
+const Implementation falcon512Clean = PQB_TEST_IMPLEMENTATION(false, PQCLEAN_FALCON512_CLEAN_);
+const Implementation dilithium5Avx2 = PQB_TEST_IMPLEMENTATION(true, PQCLEAN_DILITHIUM5_AVX2_);
+const Implementation dilithium5Clean = PQB_TEST_IMPLEMENTATION(false, PQCLEAN_DILITHIUM5_CLEAN_);
+const Implementation dilithium3Avx2 = PQB_TEST_IMPLEMENTATION(true, PQCLEAN_DILITHIUM3_AVX2_);
+const Implementation dilithium3Clean = PQB_TEST_IMPLEMENTATION(false, PQCLEAN_DILITHIUM3_CLEAN_);
+const Implementation dilithium2Avx2 = PQB_TEST_IMPLEMENTATION(true, PQCLEAN_DILITHIUM2_AVX2_);
+const Implementation dilithium2Clean = PQB_TEST_IMPLEMENTATION(false, PQCLEAN_DILITHIUM2_CLEAN_);
+
+/// SHA-256 of the first KAT entry ("count = 0") in the format of PQClean nistkat test (nistkat-sha256 in META.yml)
+const char *FALCON1024_KAT = "e699d88eb214fef30597385f40814baeb84ac505d5f05f5c257b0726fc4530b8";
+const char *FALCON512_KAT = "da27fe8a462de7307ddf1f9b00072a457d9c5b14e838c148fbe2662094b9a2ca";
+const char *DILITHIUM5_KAT = "8f6dd41c211b1cde8c726cad3c1c12bb6e92bd925bdb087c1d193be454775c50";
+const char *DILITHIUM3_KAT = "4ae9921a12524a31599550f2b4e57b6db1b133987c348f07e12d20fc4aa426d5";
+const char *DILITHIUM2_KAT = "3198fb788e0b18103add2e9ea5408cf6545a967f9bbed8be06a11915fcd87ad5";
+
+
+struct PQCleanTest : testing::Test{
+
+    void SetUp() {
+        PQCLEAN_randombytes_set_source(NistKatRng::randombytes);
+    }
+
+    void TearDown() {
+        PQCLEAN_randombytes_set_source(nullptr);
+    }
+
+    /// @brief AVX2 builds of Falcon are compiled with -mavx2 and Dilithium with -mavx2 -mpopcnt (popcnt is checked for both)
+    static bool supported(const Implementation &impl){
+        const PQB::CpuFeatures &cpu = PQB::CpuFeatures::get();
+        return !impl.avx2 || (cpu.avx2 && cpu.popcnt);
+    }
+
+    static void seed(uint8_t value){
+        uint8_t entropy[48];
+        for (uint8_t i = 0; i < 48; i++){
+            entropy[i] = value + i;
+        }
+        NistKatRng::init(entropy);
+    }
+
+    static void appendHex(std::string &out, const char *label, const uint8_t *data, size_t size){
+        char hex[3];
+        out += label;
+        for (size_t i = 0; i < size; i++){
+            std::snprintf(hex, sizeof(hex), "%02X", data[i]);
+            out += hex;
+        }
+        if (size == 0){
+            out += "00";
+        }
+        out += "\n";
+    }
+
+    /// @brief Generate the first entry of NIST KAT response file and get its SHA-256 as hex
+    static std::string katDigest(const Implementation &impl){
+        uint8_t seedBytes[48];
+        uint8_t message[33];
+        std::vector<uint8_t> pk(impl.pkSize);
+        std::vector<uint8_t> sk(impl.skSize);
+        std::vector<uint8_t> sm(sizeof(message) + impl.sigSize);
+        size_t smlen = 0;
+        std::string rsp;
+
+        seed(0);
+        rsp += "count = 0\n";
+        NistKatRng::randombytes(seedBytes, sizeof(seedBytes));
+        appendHex(rsp, "seed = ", seedBytes, sizeof(seedBytes));
+        rsp += "mlen = 33\n";
+        NistKatRng::randombytes(message, sizeof(message));
+        appendHex(rsp, "msg = ", message, sizeof(message));
+
+        NistKatRng::init(seedBytes);
+        EXPECT_EQ(impl.keypair(pk.data(), sk.data()), 0);
+        appendHex(rsp, "pk = ", pk.data(), pk.size());
+        appendHex(rsp, "sk = ", sk.data(), sk.size());
+        EXPECT_EQ(impl.sign(sm.data(), &smlen, message, sizeof(message), sk.data()), 0);
+        rsp += "smlen = " + std::to_string(smlen) + "\n";
+        appendHex(rsp, "sm = ", sm.data(), smlen);
+
+        uint8_t digest[32];
+        sha256(digest, (const uint8_t*)rsp.data(), rsp.size());
+        std::string digestHex;
+        char hex[3];
+        for (uint8_t b : digest){
+            std::snprintf(hex, sizeof(hex), "%02x", b);
+            digestHex += hex;
+        }
+        return digestHex;
+    }
+
+    using AlignedBuffer = std::unique_ptr<uint8_t, decltype(&std::free)>;
+
+    /// @brief Prepared public keys have to be aligned to 32 bytes
+    static AlignedBuffer preparePk(const Implementation &impl, const std::vector<uint8_t> &pk){
+        AlignedBuffer ppk((uint8_t*)std::aligned_alloc(32, (impl.preparedPkSize + 31) / 32 * 32), &std::free);
+        EXPECT_EQ(impl.preparePk(ppk.get(), pk.data()), 0);
+        return ppk;
+    }
+
+    /// @brief Check that both implementations generate the same keys and signatures from the same randomness and
+    /// that they agree on validity of valid and corrupted signatures
+    static void crossCheck(const Implementation &avx2, const Implementation &clean){
+        ASSERT_EQ(avx2.pkSize, clean.pkSize);
+        ASSERT_EQ(avx2.skSize, clean.skSize);
+        ASSERT_EQ(avx2.sigSize, clean.sigSize);
+        ASSERT_EQ(avx2.preparedPkSize, clean.preparedPkSize);
+
+        for (uint8_t trial = 0; trial < 8; trial++){
+            std::vector<uint8_t> pkA(avx2.pkSize), skA(avx2.skSize), pkC(clean.pkSize), skC(clean.skSize);
+            seed(trial);
+            ASSERT_EQ(avx2.keypair(pkA.data(), skA.data()), 0);
+            seed(trial);
+            ASSERT_EQ(clean.keypair(pkC.data(), skC.data()), 0);
+            EXPECT_EQ(pkA, pkC);
+            EXPECT_EQ(skA, skC);
+
+            std::vector<uint8_t> message(trial * 37 + 1);
+            NistKatRng::randombytes(message.data(), message.size());
+
+            std::vector<uint8_t> sigA(avx2.sigSize), sigC(clean.sigSize);
+            size_t sigLenA = 0, sigLenC = 0;
+            seed(trial + 100);
+            ASSERT_EQ(avx2.signature(sigA.data(), &sigLenA, message.data(), message.size(), skA.data()), 0);
+            seed(trial + 100);
+            ASSERT_EQ(clean.signature(sigC.data(), &sigLenC, message.data(), message.size(), skC.data()), 0);
+            sigA.resize(sigLenA);
+            sigC.resize(sigLenC);
+            EXPECT_EQ(sigA, sigC);
+
+            AlignedBuffer ppkA = preparePk(avx2, pkA);
+            AlignedBuffer ppkC = preparePk(clean, pkC);     // layouts of prepared keys differ (e.g. NTT order of Dilithium)
+
+            // each implementation accepts signatures of the other one
+            EXPECT_EQ(avx2.verify(sigC.data(), sigC.size(), message.data(), message.size(), pkA.data()), 0);
+            EXPECT_EQ(clean.verify(sigA.data(), sigA.size(), message.data(), message.size(), pkC.data()), 0);
+            EXPECT_EQ(avx2.verifyPrepared(sigC.data(), sigC.size(), message.data(), message.size(), ppkA.get()), 0);
+            EXPECT_EQ(clean.verifyPrepared(sigA.data(), sigA.size(), message.data(), message.size(), ppkC.get()), 0);
+
+            // both implementations agree on corrupted signatures
+            for (int corruption = 0; corruption < 16; corruption++){
+                std::vector<uint8_t> corrupted = sigA;
+                uint8_t position[2];
+                NistKatRng::randombytes(position, sizeof(position));
+                corrupted[(position[0] * 256 + position[1]) % corrupted.size()] ^= 1 << (corruption % 8);
+
+                int verdict = avx2.verify(corrupted.data(), corrupted.size(), message.data(), message.size(), pkA.data());
+                EXPECT_EQ(clean.verify(corrupted.data(), corrupted.size(), message.data(), message.size(), pkC.data()), verdict);
+                EXPECT_EQ(avx2.verifyPrepared(corrupted.data(), corrupted.size(), message.data(), message.size(), ppkA.get()), verdict);
+                EXPECT_EQ(clean.verifyPrepared(corrupted.data(), corrupted.size(), message.data(), message.size(), ppkC.get()), verdict);
+            }
+        }
+    }
+};
+
+
+#define PQB_KAT_TEST(name, impl, expected) \
+    TEST_F(PQCleanTest, name){ \
+        if (!supported(impl)){ \
+            GTEST_SKIP() << "CPU does not support AVX2 build"; \
+        } \
+        EXPECT_EQ(katDigest(impl), expected); \
+    }
+
+#define PQB_CROSS_CHECK_TEST(name, avx2, clean) \
+    TEST_F(PQCleanTest, name){ \
+        if (!supported(avx2)){ \
+            GTEST_SKIP() << "CPU does not support AVX2 build"; \
+        } \
+        crossCheck(avx2, clean); \
+    }
+
+PQB_KAT_TEST(Falcon1024_AVX2_KAT, falcon1024Avx2, FALCON1024_KAT)
+PQB_KAT_TEST(Falcon1024_Clean_KAT, falcon1024Clean, FALCON1024_KAT)
+PQB_KAT_TEST(Falcon512_AVX2_KAT, falcon512Avx2, FALCON512_KAT)
+PQB_KAT_TEST(Falcon512_Clean_KAT, falcon512Clean, FALCON512_KAT)
+PQB_KAT_TEST(Dilithium5_AVX2_KAT, dilithium5Avx2, DILITHIUM5_KAT)
+PQB_KAT_TEST(Dilithium5_Clean_KAT, dilithium5Clean, DILITHIUM5_KAT)
+PQB_KAT_TEST(Dilithium3_AVX2_KAT, dilithium3Avx2, DILITHIUM3_KAT)
+PQB_KAT_TEST(Dilithium3_Clean_KAT, dilithium3Clean, DILITHIUM3_KAT)
+PQB_KAT_TEST(Dilithium2_AVX2_KAT, dilithium2Avx2, DILITHIUM2_KAT)
+PQB_KAT_TEST(Dilithium2_Clean_KAT, dilithium2Clean, DILITHIUM2_KAT)
+
+PQB_CROSS_CHECK_TEST(Falcon1024_AVX2_Clean_Cross_Check, falcon1024Avx2, falcon1024Clean)
+PQB_CROSS_CHECK_TEST(Falcon512_AVX2_Clean_Cross_Check, falcon512Avx2, falcon512Clean)
+PQB_CROSS_CHECK_TEST(Dilithium5_AVX2_Clean_Cross_Check, dilithium5Avx2, dilithium5Clean)
+PQB_CROSS_CHECK_TEST(Dilithium3_AVX2_Clean_Cross_Check, dilithium3Avx2, dilithium3Clean)
+PQB_CROSS_CHECK_TEST(Dilithium2_AVX2_Clean_Cross_Check, dilithium2Avx2, dilithium2Clean)
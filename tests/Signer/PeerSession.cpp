@@ -0,0 +1,103 @@
+
+#include <gtest/gtest.h>
+#include "PeerSession.hpp"
+#include "HashManager.hpp"
+
+
+struct PeerSessionTest : testing::Test{
+
+    byteId_t transcriptHash;
+    PQB::byteBuffer initiatorSecret;
+    PQB::byteBuffer responderSecret;
+    PQB::byteBuffer message;
+
+    void SetUp() {
+        PQB::byteBuffer secretKey, publicKey, ciphertext;
+        PQB::PeerSession::genKemKeys(secretKey, publicKey);
+        ASSERT_TRUE(PQB::PeerSession::encapsulate(ciphertext, responderSecret, publicKey));
+        ASSERT_TRUE(PQB::PeerSession::decapsulate(initiatorSecret, ciphertext, secretKey));
+        PQB::HashMan::SHA512_hash(&transcriptHash, ciphertext.data(), ciphertext.size());
+        message.resize(200, 'm');
+    }
+
+    void TearDown() {
+
+    }
+};
+
+
+TEST_F(PeerSessionTest, Key_Encapsulation){
+    EXPECT_EQ(initiatorSecret.size(), 32);
+    EXPECT_EQ(initiatorSecret, responderSecret);
+
+    PQB::byteBuffer secretKey, publicKey, ciphertext, sharedSecret;
+    PQB::PeerSession::genKemKeys(secretKey, publicKey);
+    publicKey.pop_back();
+    EXPECT_FALSE(PQB::PeerSession::encapsulate(ciphertext, sharedSecret, publicKey));
+    ciphertext.resize(10);
+    EXPECT_FALSE(PQB::PeerSession::decapsulate(sharedSecret, ciphertext, secretKey));
+}
+
+TEST_F(PeerSessionTest, Both_Directions){
+    PQB::PeerSession initiator(initiatorSecret, transcriptHash, true);
+    PQB::PeerSession responder(responderSecret, transcriptHash, false);
+    PQB::byte tag[PQB::PeerSession::TAG_SIZE];
+
+    for (int i = 0; i < 3; i++){
+        initiator.computeTag(message.data(), message.size(), tag);
+        EXPECT_TRUE(responder.verifyTag(message.data(), message.size(), tag));
+        responder.computeTag(message.data(), message.size(), tag);
+        EXPECT_TRUE(initiator.verifyTag(message.data(), message.size(), tag));
+    }
+}
+
+TEST_F(PeerSessionTest, Reject_Modified_Message){
+    PQB::PeerSession initiator(initiatorSecret, transcriptHash, true);
+    PQB::PeerSession responder(responderSecret, transcriptHash, false);
+    PQB::byte tag[PQB::PeerSession::TAG_SIZE];
+
+    initiator.computeTag(message.data(), message.size(), tag);
+    message[100] ^= 1;
+    EXPECT_FALSE(responder.verifyTag(message.data(), message.size(), tag));
+    message[100] ^= 1;
+    tag[0] ^= 1;
+    EXPECT_FALSE(responder.verifyTag(message.data(), message.size(), tag));
+    tag[0] ^= 1;
+    // rejected tags do not change the state of the session
+    EXPECT_TRUE(responder.verifyTag(message.data(), message.size(), tag));
+}
+
+TEST_F(PeerSessionTest, Reject_Replayed_Message){
+    PQB::PeerSession initiator(initiatorSecret, transcriptHash, true);
+    PQB::PeerSession responder(responderSecret, transcriptHash, false);
+    PQB::byte tag[PQB::PeerSession::TAG_SIZE];
+
+    initiator.computeTag(message.data(), message.size(), tag);
+    EXPECT_TRUE(responder.verifyTag(message.data(), message.size(), tag));
+    EXPECT_FALSE(responder.verifyTag(message.data(), message.size(), tag));
+    // tag of the other direction is not valid
+    responder.computeTag(message.data(), message.size(), tag);
+    EXPECT_FALSE(responder.verifyTag(message.data(), message.size(), tag));
+}
+
+TEST_F(PeerSessionTest, Different_Transcript){
+    byteId_t otherHash;
+    PQB::HashMan::SHA512_hash(&otherHash, message.data(), message.size());
+    PQB::PeerSession initiator(initiatorSecret, transcriptHash, true);
+    PQB::PeerSession responder(responderSecret, otherHash, false);
+    PQB::byte tag[PQB::PeerSession::TAG_SIZE];
+
+    initiator.computeTag(message.data(), message.size(), tag);
+    EXPECT_FALSE(responder.verifyTag(message.data(), message.size(), tag));
+}
+
+TEST_F(PeerSessionTest, Separate_Header_And_Payload){
+    PQB::PeerSession initiator(initiatorSecret, transcriptHash, true);
+    PQB::PeerSession responder(responderSecret, transcriptHash, false);
+    PQB::byte tag[PQB::PeerSession::TAG_SIZE];
+
+    initiator.computeTag(message.data(), 16, message.data() + 16, message.size() - 16, tag);
+    EXPECT_TRUE(responder.verifyTag(message.data(), message.size(), tag));
+    initiator.computeTag(message.data(), message.size(), nullptr, 0, tag);
+    EXPECT_TRUE(responder.verifyTag(message.data(), message.size(), tag));
+}
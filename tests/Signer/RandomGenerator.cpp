@@ -0,0 +1,120 @@
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Log.hpp"
+#include "Signer.hpp"
+#include "RandomGenerator.hpp"
+#include "randombytes.h"
+#include "TestSigner.hpp"
+
+
+struct RandomGeneratorTest : testing::Test{
+
+    void SetUp() {
+        PQB::Log::init(); // to avoid segfault from uninitialized logger
+    }
+
+    void TearDown() {
+        PQB::RandomGenerator::configure({});
+        spdlog::drop_all();
+    }
+
+    static PQB::byteBuffer generate(size_t size){
+        PQB::byteBuffer output(size);
+        PQB::RandomGenerator::generate(output.data(), output.size());
+        return output;
+    }
+};
+
+
+TEST_F(RandomGeneratorTest, ChaCha20_Test_Vector){
+    // RFC 8439, section 2.3.2
+    PQB::byte key[32];
+    for (int i = 0; i < 32; i++){
+        key[i] = i;
+    }
+    PQB::byte nonce[12] = {0, 0, 0, 0x09, 0, 0, 0, 0x4a, 0, 0, 0, 0};
+    PQB::byteBuffer expected = {0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15, 0x50, 0x0f, 0xdd, 0x1f, 0xa3, 0x20, 0x71, 0xc4};
+    PQB::byteBuffer output(16);
+    PQB::RandomGenerator::chacha20(output.data(), output.size(), key, nonce, 1);
+    EXPECT_EQ(output, expected);
+}
+
+TEST_F(RandomGeneratorTest, Deterministic_Seed){
+    PQB::RandomGenerator::configure({.deterministic=true, .seed=42});
+    PQB::byteBuffer first = generate(3000);
+    PQB::RandomGenerator::configure({.deterministic=true, .seed=42});
+    EXPECT_EQ(generate(3000), first);
+    PQB::RandomGenerator::configure({.deterministic=true, .seed=43});
+    EXPECT_NE(generate(3000), first);
+}
+
+TEST_F(RandomGeneratorTest, Deterministic_Keys){
+    PQB_REQUIRE_SIGN_ALGORITHM("falcon512");
+    auto ss = PQB::Signer::GetInstance("falcon512");
+    PQB::byteBuffer sk1, pk1, sk2, pk2;
+    PQB::RandomGenerator::configure({.deterministic=true, .seed=7});
+    ss->genKeys(sk1, pk1);
+    PQB::RandomGenerator::configure({.deterministic=true, .seed=7});
+    ss->genKeys(sk2, pk2);
+    EXPECT_EQ(pk1, pk2);
+    EXPECT_EQ(sk1, sk2);
+}
+
+TEST_F(RandomGeneratorTest, Threads_Differ){
+    PQB::RandomGenerator::configure({.deterministic=true, .seed=42});
+    PQB::byteBuffer first = generate(64);
+    PQB::byteBuffer second;
+    std::thread thread([&second](){ second = generate(64); });
+    thread.join();
+    EXPECT_NE(first, second);
+}
+
+TEST_F(RandomGeneratorTest, Not_Repeated){
+    PQB::byteBuffer first = generate(64);
+    PQB::byteBuffer second = generate(64);
+    EXPECT_NE(first, second);
+    // reseeding (after every refill of the buffer) does not break the generator
+    PQB::RandomGenerator::configure({.reseedBytes=1});
+    first = generate(5000);
+    second = generate(5000);
+    EXPECT_NE(first, second);
+}
+
+TEST_F(RandomGeneratorTest, Fork){
+    // buffered bytes of the parent are not served in the child
+    generate(1);
+    int pipes[2];
+    ASSERT_EQ(pipe(pipes), 0);
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0){
+        PQB::byteBuffer childOutput = generate(64);
+        write(pipes[1], childOutput.data(), childOutput.size());
+        _exit(0);
+    }
+    PQB::byteBuffer parentOutput = generate(64);
+    PQB::byteBuffer childOutput(64);
+    EXPECT_EQ(read(pipes[0], childOutput.data(), childOutput.size()), 64);
+    waitpid(pid, nullptr, 0);
+    close(pipes[0]);
+    close(pipes[1]);
+    EXPECT_NE(parentOutput, childOutput);
+}
+
+TEST_F(RandomGeneratorTest, PQClean_Source){
+    PQB::RandomGenerator::install();
+    PQB::RandomGenerator::configure({.deterministic=true, .seed=42});
+    PQB::byteBuffer expected = generate(100);
+    PQB::RandomGenerator::configure({.deterministic=true, .seed=42});
+    PQB::byteBuffer output(100);
+    ASSERT_EQ(PQCLEAN_randombytes(output.data(), output.size()), 0);
+    EXPECT_EQ(output, expected);
+
+    PQB::RandomGenerator::uninstall();
+    PQB::RandomGenerator::configure({.deterministic=true, .seed=42});
+    ASSERT_EQ(PQCLEAN_randombytes(output.data(), output.size()), 0);
+    EXPECT_NE(output, expected);
+}
@@ -0,0 +1,117 @@
+
+#include <gtest/gtest.h>
+#include "Log.hpp"
+#include "SignatureVerifier.hpp"
+#include "TestSigner.hpp"
+
+
+struct SignatureVerifierTest : testing::Test{
+
+    static constexpr size_t NUM_OF_SIGNATURES = 32;
+
+    PQB::byteBuffer pk;
+    PQB::byteBuffer sk;
+    std::vector<std::string> messages;
+    std::vector<PQB::byteBuffer> signatures;
+
+    void SetUp() {
+        PQB::Log::init(); // to avoid segfault from uninitialized logger
+        PQB_REQUIRE_SIGN_ALGORITHM("falcon512");
+        auto ss = PQB::Signer::GetInstance("falcon512");
+        ss->genKeys(sk, pk);
+        messages.resize(NUM_OF_SIGNATURES);
+        signatures.resize(NUM_OF_SIGNATURES);
+        for (size_t i = 0; i < NUM_OF_SIGNATURES; i++){
+            messages[i] = "Message to sign " + std::to_string(i);
+            ss->sign(signatures[i], (PQB::byte*)messages[i].data(), messages[i].size(), sk);
+        }
+    }
+
+    void TearDown() {
+        spdlog::drop_all();
+    }
+
+    PQB::SignatureVerifier::VerifyBatch createBatch(){
+        PQB::SignatureVerifier::VerifyBatch batch;
+        for (size_t i = 0; i < NUM_OF_SIGNATURES; i++){
+            batch.push_back({.data=(PQB::byte*)messages[i].data(), .dataSize=messages[i].size(), .signature=&signatures[i], .publicKey=&pk});
+        }
+        return batch;
+    }
+};
+
+
+TEST_F(SignatureVerifierTest, Verify_Batch){
+    PQB::SignatureVerifier verifier(4);
+    EXPECT_EQ(verifier.getNumberOfThreads(), 4);
+
+    // all signatures are valid
+    PQB::SignatureVerifier::Verdicts verdicts = verifier.verify(createBatch());
+    ASSERT_EQ(verdicts.size(), NUM_OF_SIGNATURES);
+    for (size_t i = 0; i < NUM_OF_SIGNATURES; i++){
+        EXPECT_TRUE(verdicts[i]);
+    }
+
+    // every third message is altered
+    for (size_t i = 0; i < NUM_OF_SIGNATURES; i += 3){
+        messages[i] = "Altered message";
+    }
+    verdicts = verifier.verify(createBatch());
+    ASSERT_EQ(verdicts.size(), NUM_OF_SIGNATURES);
+    for (size_t i = 0; i < NUM_OF_SIGNATURES; i++){
+        EXPECT_EQ(verdicts[i], (i % 3 != 0));
+    }
+}
+
+TEST_F(SignatureVerifierTest, Verify_Batch_Prepared_Key){
+    PQB::SignatureVerifier verifier(4);
+    PQB::PreparedPublicKeyPtr prepared = PQB::Signer::GetInstance()->preparePublicKey(pk);
+    messages[1] = "Altered message";
+
+    PQB::SignatureVerifier::VerifyBatch batch = createBatch();
+    for (auto &job : batch){
+        job.preparedKey = prepared.get();
+    }
+    PQB::SignatureVerifier::Verdicts verdicts = verifier.verify(std::move(batch));
+    ASSERT_EQ(verdicts.size(), NUM_OF_SIGNATURES);
+    for (size_t i = 0; i < NUM_OF_SIGNATURES; i++){
+        EXPECT_EQ(verdicts[i], (i != 1));
+    }
+}
+
+TEST_F(SignatureVerifierTest, Verify_Empty_Batch){
+    PQB::SignatureVerifier verifier(2);
+    PQB::SignatureVerifier::Verdicts verdicts = verifier.verify({});
+    EXPECT_TRUE(verdicts.empty());
+}
+
+TEST_F(SignatureVerifierTest, Ordering_Of_Callbacks){
+    PQB::SignatureVerifier verifier(4);
+    std::mutex resultsMutex;
+    std::map<uint64_t, std::vector<size_t>> results; // ordering key -> order of called callbacks
+    std::vector<std::future<PQB::SignatureVerifier::Verdicts>> done;
+
+    for (size_t i = 0; i < NUM_OF_SIGNATURES; i++){
+        uint64_t key = i % 3;
+        // batches of different sizes, so later batches may be verified sooner
+        PQB::SignatureVerifier::VerifyBatch batch = createBatch();
+        batch.resize((i % 2 == 0) ? NUM_OF_SIGNATURES : 1);
+        verifier.submit(batch, key, [&resultsMutex, &results, key, i](PQB::SignatureVerifier::Verdicts &verdicts){
+            std::lock_guard<std::mutex> lock(resultsMutex);
+            results[key].push_back(i);
+            EXPECT_TRUE(verdicts[0]);
+        });
+        done.push_back(verifier.submit({}, key)); // empty batch is completed in order as well
+    }
+    for (auto &f : done){
+        f.wait();
+    }
+
+    std::lock_guard<std::mutex> lock(resultsMutex);
+    size_t numOfCallbacks = 0;
+    for (const auto &r : results){
+        EXPECT_TRUE(std::is_sorted(r.second.begin(), r.second.end()));
+        numOfCallbacks += r.second.size();
+    }
+    EXPECT_EQ(numOfCallbacks, NUM_OF_SIGNATURES);
+}
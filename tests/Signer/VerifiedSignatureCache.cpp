@@ -0,0 +1,93 @@
+
+#include <gtest/gtest.h>
+#include <thread>
+#include "VerifiedSignatureCache.hpp"
+#include "HashManager.hpp"
+
+
+struct VerifiedSignatureCacheTest : testing::Test{
+
+    byteId_t txID;
+    PQB::byteBuffer signature;
+    PQB::byteBuffer publicKey;
+
+    void SetUp() {
+        txID.setHex("21B4F4BD9E64ED355C3EB676A28EBEDAF6D8F17BDC365995B319097153044080516BD083BFCCE66121A3072646994C8430CC382B8DC543E84880183BF856CFF5");
+        signature.resize(64, 's');
+        publicKey.resize(32, 'k');
+    }
+
+    void TearDown() {
+
+    }
+};
+
+
+TEST_F(VerifiedSignatureCacheTest, Insert_And_Find){
+    PQB::VerifiedSignatureCache cache(16);
+    EXPECT_EQ(cache.getCapacity(), 16);
+
+    PQB::VerifiedSignatureCache::Entry entry = PQB::VerifiedSignatureCache::createEntry(txID.data(), txID.size(), signature, publicKey);
+    EXPECT_FALSE(cache.contains(entry));
+    cache.insert(entry);
+    EXPECT_TRUE(cache.contains(entry));
+    EXPECT_EQ(cache.getNumberOfHits(), 1);
+    EXPECT_EQ(cache.getNumberOfMisses(), 1);
+}
+
+TEST_F(VerifiedSignatureCacheTest, Entry_Depends_On_All_Parts){
+    PQB::VerifiedSignatureCache cache(16);
+    PQB::VerifiedSignatureCache::Entry entry = PQB::VerifiedSignatureCache::createEntry(txID.data(), txID.size(), signature, publicKey);
+    cache.insert(entry);
+
+    // same transaction ID with different signature
+    PQB::byteBuffer otherSignature = signature;
+    otherSignature[0] = 'x';
+    EXPECT_FALSE(cache.contains(PQB::VerifiedSignatureCache::createEntry(txID.data(), txID.size(), otherSignature, publicKey)));
+    // same transaction ID and signature with different public key
+    PQB::byteBuffer otherPublicKey = publicKey;
+    otherPublicKey[0] = 'x';
+    EXPECT_FALSE(cache.contains(PQB::VerifiedSignatureCache::createEntry(txID.data(), txID.size(), signature, otherPublicKey)));
+    // entry created with hash of the public key is the same
+    byteId_t publicKeyHash;
+    PQB::HashMan::SHA512_hash(&publicKeyHash, publicKey.data(), publicKey.size());
+    EXPECT_TRUE(cache.contains(PQB::VerifiedSignatureCache::createEntry(txID.data(), txID.size(), signature, publicKeyHash)));
+}
+
+TEST_F(VerifiedSignatureCacheTest, Cache_Is_Bounded){
+    PQB::VerifiedSignatureCache cache(8);
+    std::vector<PQB::VerifiedSignatureCache::Entry> entries;
+    for (uint64_t i = 0; i < 100; i++){
+        PQB::VerifiedSignatureCache::Entry entry = {{i, i * 7 + 3, i, i}};
+        entries.push_back(entry);
+        cache.insert(entry);
+    }
+    size_t found = 0;
+    for (const auto &entry : entries){
+        found += cache.contains(entry);
+    }
+    EXPECT_LE(found, cache.getCapacity());
+    EXPECT_TRUE(cache.contains(entries.back())); // the last inserted entry is always in the cache
+}
+
+TEST_F(VerifiedSignatureCacheTest, Concurrent_Access){
+    PQB::VerifiedSignatureCache cache(1024);
+    std::vector<std::thread> threads;
+    std::atomic<size_t> falseHits = 0;
+    for (uint64_t t = 0; t < 4; t++){
+        threads.emplace_back([&cache, &falseHits, t](){
+            for (uint64_t i = 0; i < 10000; i++){
+                PQB::VerifiedSignatureCache::Entry entry = {{i, i + t, t, i}};
+                cache.insert(entry);
+                // entry that is never inserted can not be found
+                PQB::VerifiedSignatureCache::Entry notInserted = {{i, i + t, t, i + 1}};
+                if (cache.contains(notInserted))
+                    falseHits++;
+            }
+        });
+    }
+    for (auto &thread : threads){
+        thread.join();
+    }
+    EXPECT_EQ(falseHits, 0);
+}
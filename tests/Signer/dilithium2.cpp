@@ -2,9 +2,11 @@
 #include <gtest/gtest.h>
 #include "Log.hpp"
 #include "Signer.hpp"
+#include "TestSigner.hpp"
 
 TEST(Dilithium2, Sign){
     PQB::Log::init(); // to avoid segfault from uninitialized logger
+    PQB_REQUIRE_SIGN_ALGORITHM("dilithium2");
     auto ss = PQB::Signer::GetInstance("dilithium2");
 
     std::string message = "Message to sign";
@@ -20,4 +22,61 @@ TEST(Dilithium2, Sign){
     message = "Altered message";
     EXPECT_FALSE(ss->verify(signature, (PQB::byte*)message.data(), message.size(), pk));
 
-}
\ No newline at end of file
+}
+
+TEST(Dilithium2, PreparedKey){
+    PQB::Log::init(); // to avoid segfault from uninitialized logger
+    PQB_REQUIRE_SIGN_ALGORITHM("dilithium2");
+    auto ss = PQB::Signer::GetInstance("dilithium2");
+
+    std::string message = "Message to sign";
+    PQB::byteBuffer pk;
+    PQB::byteBuffer sk;
+    PQB::byteBuffer signature;
+
+    ss->genKeys(sk, pk);
+    PQB::PreparedPublicKeyPtr prepared = ss->preparePublicKey(pk);
+    ASSERT_NE(prepared, nullptr);
+
+    // prepared key can be used for more signatures
+    for (int i = 0; i < 3; i++){
+        message = "Message to sign " + std::to_string(i);
+        ss->sign(signature, (PQB::byte*)message.data(), message.size(), sk);
+        EXPECT_TRUE(ss->verify(signature, (PQB::byte*)message.data(), message.size(), *prepared));
+    }
+
+    message = "Altered message";
+    EXPECT_FALSE(ss->verify(signature, (PQB::byte*)message.data(), message.size(), *prepared));
+
+    PQB::byteBuffer invalidKey(pk.begin(), pk.end() - 1);
+    EXPECT_ANY_THROW(ss->preparePublicKey(invalidKey));
+}
+
+TEST(Dilithium2, ExpandedKey){
+    PQB::Log::init(); // to avoid segfault from uninitialized logger
+    PQB_REQUIRE_SIGN_ALGORITHM("dilithium2");
+    auto ss = PQB::Signer::GetInstance("dilithium2");
+
+    std::string message = "Message to sign";
+    PQB::byteBuffer pk;
+    PQB::byteBuffer sk;
+    PQB::byteBuffer signature;
+
+    ss->genKeys(sk, pk);
+    PQB::ExpandedPrivateKeyPtr expanded = ss->expandPrivateKey(sk);
+    ASSERT_NE(expanded, nullptr);
+
+    // expanded key can be used for more signatures
+    for (int i = 0; i < 3; i++){
+        message = "Message to sign " + std::to_string(i);
+        size_t signatureLength = ss->sign(signature, (PQB::byte*)message.data(), message.size(), *expanded);
+        EXPECT_EQ(signatureLength, signature.size());
+        EXPECT_TRUE(ss->verify(signature, (PQB::byte*)message.data(), message.size(), pk));
+    }
+
+    message = "Altered message";
+    EXPECT_FALSE(ss->verify(signature, (PQB::byte*)message.data(), message.size(), pk));
+
+    PQB::byteBuffer invalidKey(sk.begin(), sk.end() - 1);
+    EXPECT_ANY_THROW(ss->expandPrivateKey(invalidKey));
+}
@@ -2,9 +2,11 @@
 #include <gtest/gtest.h>
 #include "Log.hpp"
 #include "Signer.hpp"
+#include "TestSigner.hpp"
 
 TEST(Ed25519, Sign){
     PQB::Log::init(); // to avoid segfault from uninitialized logger
+    PQB_REQUIRE_SIGN_ALGORITHM("ed25519");
     auto ss = PQB::Signer::GetInstance("ed25519");
 
     std::string message = "Message to sign";
@@ -20,4 +22,32 @@ TEST(Ed25519, Sign){
     message = "Altered message";
     EXPECT_FALSE(ss->verify(signature, (PQB::byte*)message.data(), message.size(), pk));
 
-}
\ No newline at end of file
+}
+
+TEST(Ed25519, PreparedKey){
+    PQB::Log::init(); // to avoid segfault from uninitialized logger
+    PQB_REQUIRE_SIGN_ALGORITHM("ed25519");
+    auto ss = PQB::Signer::GetInstance("ed25519");
+
+    std::string message = "Message to sign";
+    PQB::byteBuffer pk;
+    PQB::byteBuffer sk;
+    PQB::byteBuffer signature;
+
+    ss->genKeys(sk, pk);
+    PQB::PreparedPublicKeyPtr prepared = ss->preparePublicKey(pk);
+    ASSERT_NE(prepared, nullptr);
+
+    // prepared key can be used for more signatures
+    for (int i = 0; i < 3; i++){
+        message = "Message to sign " + std::to_string(i);
+        ss->sign(signature, (PQB::byte*)message.data(), message.size(), sk);
+        EXPECT_TRUE(ss->verify(signature, (PQB::byte*)message.data(), message.size(), *prepared));
+    }
+
+    message = "Altered message";
+    EXPECT_FALSE(ss->verify(signature, (PQB::byte*)message.data(), message.size(), *prepared));
+
+    PQB::byteBuffer invalidKey(pk.begin(), pk.end() - 1);
+    EXPECT_ANY_THROW(ss->preparePublicKey(invalidKey));
+}
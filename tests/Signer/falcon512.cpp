@@ -2,9 +2,11 @@
 #include <gtest/gtest.h>
 #include "Log.hpp"
 #include "Signer.hpp"
+#include "TestSigner.hpp"
 
 TEST(Falcon512, Sign){
     PQB::Log::init(); // to avoid segfault from uninitialized logger
+    PQB_REQUIRE_SIGN_ALGORITHM("falcon512");
     auto ss = PQB::Signer::GetInstance("falcon512");
 
     std::string message = "Message to sign";
@@ -20,4 +22,79 @@ TEST(Falcon512, Sign){
     message = "Altered message";
     EXPECT_FALSE(ss->verify(signature, (PQB::byte*)message.data(), message.size(), pk));
 
-}
\ No newline at end of file
+}
+
+TEST(Falcon512, PreparedKey){
+    PQB::Log::init(); // to avoid segfault from uninitialized logger
+    PQB_REQUIRE_SIGN_ALGORITHM("falcon512");
+    auto ss = PQB::Signer::GetInstance("falcon512");
+
+    std::string message = "Message to sign";
+    PQB::byteBuffer pk;
+    PQB::byteBuffer sk;
+    PQB::byteBuffer signature;
+
+    ss->genKeys(sk, pk);
+    PQB::PreparedPublicKeyPtr prepared = ss->preparePublicKey(pk);
+    ASSERT_NE(prepared, nullptr);
+
+    // prepared key can be used for more signatures
+    for (int i = 0; i < 3; i++){
+        message = "Message to sign " + std::to_string(i);
+        ss->sign(signature, (PQB::byte*)message.data(), message.size(), sk);
+        EXPECT_TRUE(ss->verify(signature, (PQB::byte*)message.data(), message.size(), *prepared));
+    }
+
+    message = "Altered message";
+    EXPECT_FALSE(ss->verify(signature, (PQB::byte*)message.data(), message.size(), *prepared));
+
+    PQB::byteBuffer invalidKey(pk.begin(), pk.end() - 1);
+    EXPECT_ANY_THROW(ss->preparePublicKey(invalidKey));
+}
+
+TEST(Falcon512, ExpandedKey){
+    PQB::Log::init(); // to avoid segfault from uninitialized logger
+    PQB_REQUIRE_SIGN_ALGORITHM("falcon512");
+    auto ss = PQB::Signer::GetInstance("falcon512");
+
+    std::string message = "Message to sign";
+    PQB::byteBuffer pk;
+    PQB::byteBuffer sk;
+    PQB::byteBuffer signature;
+
+    ss->genKeys(sk, pk);
+    PQB::ExpandedPrivateKeyPtr expanded = ss->expandPrivateKey(sk);
+    ASSERT_NE(expanded, nullptr);
+
+    // expanded key can be used for more signatures
+    for (int i = 0; i < 3; i++){
+        message = "Message to sign " + std::to_string(i);
+        size_t signatureLength = ss->sign(signature, (PQB::byte*)message.data(), message.size(), *expanded);
+        EXPECT_EQ(signatureLength, signature.size());
+        EXPECT_TRUE(ss->verify(signature, (PQB::byte*)message.data(), message.size(), pk));
+    }
+
+    message = "Altered message";
+    EXPECT_FALSE(ss->verify(signature, (PQB::byte*)message.data(), message.size(), pk));
+
+    PQB::byteBuffer invalidKey(sk.begin(), sk.end() - 1);
+    EXPECT_ANY_THROW(ss->expandPrivateKey(invalidKey));
+}
+
+TEST(Falcon512, StaticSigner){
+    using FixedSigner = PQB::StaticSigner<PQB::Falcon512>;
+    static_assert(FixedSigner::getPublicKeySize() == PQCLEAN_FALCON512_AVX2_CRYPTO_PUBLICKEYBYTES);
+    static_assert(FixedSigner::getSignatureSize() == PQCLEAN_FALCON512_AVX2_CRYPTO_BYTES);
+
+    std::string message = "Message to sign";
+    PQB::byteBuffer pk;
+    PQB::byteBuffer sk;
+    PQB::byteBuffer signature;
+
+    FixedSigner::get().genKeys(sk, pk);
+    EXPECT_EQ(pk.size(), FixedSigner::getPublicKeySize());
+    EXPECT_EQ(sk.size(), FixedSigner::getPrivateKeySize());
+    FixedSigner::get().sign(signature, (PQB::byte*)message.data(), message.size(), sk);
+    EXPECT_LE(signature.size(), FixedSigner::getSignatureSize());
+    EXPECT_TRUE(FixedSigner::get().verify(signature, (PQB::byte*)message.data(), message.size(), pk));
+}
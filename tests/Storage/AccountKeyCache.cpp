@@ -0,0 +1,105 @@
+
+#include <gtest/gtest.h>
+#include "Log.hpp"
+#include "Signer.hpp"
+#include "AccountKeyCache.hpp"
+#include "TestSigner.hpp"
+
+
+static byteId_t makeAccountID(PQB::byte value){
+    byteId_t id;
+    std::fill(id.begin(), id.end(), value);
+    return id;
+}
+
+
+struct AccountKeyCacheTest : testing::Test{
+
+    PQB::SignAlgorithmPtr ss;
+    PQB::byteBuffer sk;
+    PQB::byteBuffer pk;
+    byteId_t acc_id;
+
+    void SetUp() {
+        PQB::Log::init(); // to avoid segfault from uninitialized logger
+        PQB_REQUIRE_SIGN_ALGORITHM("falcon512");
+        ss = PQB::Signer::GetInstance("falcon512");
+        ss->genKeys(sk, pk);
+        acc_id = makeAccountID(0xaa);
+    }
+
+    void TearDown() {
+        spdlog::drop_all();
+    }
+};
+
+
+TEST_F(AccountKeyCacheTest, Hot_Sender){
+    PQB::AccountKeyCache cache;
+
+    // the first lookup does not prepare the key
+    EXPECT_EQ(cache.get(acc_id, pk), nullptr);
+    for (uint32_t i = 1; i < PQB::AccountKeyCache::HOT_SENDER_THRESHOLD - 1; i++){
+        EXPECT_EQ(cache.get(acc_id, pk), nullptr);
+    }
+    PQB::PreparedPublicKeyPtr prepared = cache.get(acc_id, pk);
+    ASSERT_NE(prepared, nullptr);
+    // the same prepared key is returned next time
+    EXPECT_EQ(cache.get(acc_id, pk), prepared);
+    EXPECT_EQ(cache.getNumberOfHits(), 1);
+
+    std::string message = "Message to sign";
+    PQB::byteBuffer signature;
+    ss->sign(signature, (PQB::byte*)message.data(), message.size(), sk);
+    EXPECT_TRUE(ss->verify(signature, (PQB::byte*)message.data(), message.size(), *prepared));
+}
+
+TEST_F(AccountKeyCacheTest, Pinned){
+    PQB::AccountKeyCache cache(1);
+    cache.pin(acc_id);
+    EXPECT_NE(cache.get(acc_id, pk), nullptr);
+
+    // pinned account is not evicted by other accounts
+    cache.get(makeAccountID(0xbb), pk);
+    cache.get(makeAccountID(0xcc), pk);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_NE(cache.get(acc_id, pk), nullptr);
+}
+
+TEST_F(AccountKeyCacheTest, Eviction){
+    PQB::AccountKeyCache cache(2);
+    byteId_t ids[3];
+    for (int i = 0; i < 3; i++){
+        ids[i] = makeAccountID(i);
+        cache.get(ids[i], pk);
+    }
+    EXPECT_EQ(cache.size(), 2);
+    // the least recently used account was evicted, so its use count starts again
+    EXPECT_EQ(cache.get(ids[0], pk), nullptr);
+    EXPECT_NE(cache.get(ids[2], pk), nullptr);
+}
+
+TEST_F(AccountKeyCacheTest, Changed_Key){
+    PQB::AccountKeyCache cache;
+    cache.pin(acc_id);
+    PQB::PreparedPublicKeyPtr prepared = cache.get(acc_id, pk);
+    ASSERT_NE(prepared, nullptr);
+
+    PQB::byteBuffer newSk, newPk;
+    ss->genKeys(newSk, newPk);
+    PQB::PreparedPublicKeyPtr newPrepared = cache.get(acc_id, newPk);
+    ASSERT_NE(newPrepared, nullptr);
+    EXPECT_NE(newPrepared, prepared);
+
+    std::string message = "Message to sign";
+    PQB::byteBuffer signature;
+    ss->sign(signature, (PQB::byte*)message.data(), message.size(), newSk);
+    EXPECT_TRUE(ss->verify(signature, (PQB::byte*)message.data(), message.size(), *newPrepared));
+}
+
+TEST_F(AccountKeyCacheTest, Invalid_Key){
+    PQB::AccountKeyCache cache;
+    cache.pin(acc_id);
+    PQB::byteBuffer invalidKey(pk.begin(), pk.end() - 1);
+    EXPECT_EQ(cache.get(acc_id, invalidKey), nullptr);
+}
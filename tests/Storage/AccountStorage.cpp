@@ -4,16 +4,18 @@
 #include "Signer.hpp"
 #include "Account.hpp"
 #include "AccountStorage.hpp"
+#include "TestSigner.hpp"
 
 
 struct AccountStorageTest : testing::Test{
 
     PQB::AccountStorage *accS;
     PQB::Account acc;
-    byte64_t acc_id;
+    byteId_t acc_id;
 
     void SetUp() {
         PQB::Log::init(); // to avoid segfault from uninitialized logger
+        PQB_REQUIRE_SIGN_ALGORITHM("ed25519");
         auto ss = PQB::Signer::GetInstance("ed25519");
 
         acc.balance = 42;
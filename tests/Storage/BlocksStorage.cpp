@@ -4,22 +4,26 @@
 #include "Signer.hpp"
 #include "Account.hpp"
 #include "BlocksStorage.hpp"
+#include "TestIds.hpp"
+#include "TestSigner.hpp"
 
 
 struct BlockStorageTest : testing::Test{
 
     PQB::BlocksStorage *blockS;
     PQB::Block block;
-    byte64_t block_id;
+    byteId_t block_id;
 
     void SetUp() {
         PQB::Log::init(); // to avoid segfault from uninitialized logger
+        PQB_REQUIRE_SIGN_ALGORITHM("ed25519");
         auto ss = PQB::Signer::GetInstance("ed25519");
 
         block.txSet.clear();
         block.transactionCount = 0;
         block.previousBlockHash.setHex("3173F0564AB9462B0978A765C1283F96F05AC9E9F8361EE1006DC905C153D85BF0E4C45622E5E990ABCF48FB5192AD34722E8D6A723278B39FEF9E4F9FC62378");
         block.transactionsMerkleRootHash.setHex("4921DE1EDB2ECC8CA3A22823705194B902CFA471675F2D1AE8BF67D0C7B060A7C192E36FFCA9F1A0D90AC2DBBDAF429EE1EC97E160EB00DC80B07000935304F3");
+        block.signaturesMerkleRootHash.setHex("905F2C7F971992EB39F4EDC1520E4C14663176134EF35B9F056C3EA4D829EC1BA215EB81301879806D33BBDA259F8A68FF9BA1543921EC242B7ABC1888D9F0B1");
         block.accountBalanceMerkleRootHash.setHex("3225DFF071CD0CCFF736B0B159CC722963310C008472BE814669451A062C25C5F7654F079D3E0AE1CF2FDA1551A5A0B1F5E988383BE7D383D57F73D4012C4024");
         block.sequence = 2;
         block.version = 1;
@@ -46,16 +50,62 @@ TEST_F(BlockStorageTest, Get_Block){
     EXPECT_EQ(b->transactionCount, 0);
     EXPECT_EQ(b->sequence, 2);
     EXPECT_EQ(b->version, 1);
-    EXPECT_STREQ(
-        b->previousBlockHash.getHex().c_str(),
-        "3173F0564AB9462B0978A765C1283F96F05AC9E9F8361EE1006DC905C153D85BF0E4C45622E5E990ABCF48FB5192AD34722E8D6A723278B39FEF9E4F9FC62378"
+    EXPECT_EQ(
+        b->previousBlockHash.getHex(),
+        IdHex("3173F0564AB9462B0978A765C1283F96F05AC9E9F8361EE1006DC905C153D85BF0E4C45622E5E990ABCF48FB5192AD34722E8D6A723278B39FEF9E4F9FC62378")
     );
-    EXPECT_STREQ(
-        b->transactionsMerkleRootHash.getHex().c_str(),
-        "4921DE1EDB2ECC8CA3A22823705194B902CFA471675F2D1AE8BF67D0C7B060A7C192E36FFCA9F1A0D90AC2DBBDAF429EE1EC97E160EB00DC80B07000935304F3"
+    EXPECT_EQ(
+        b->transactionsMerkleRootHash.getHex(),
+        IdHex("4921DE1EDB2ECC8CA3A22823705194B902CFA471675F2D1AE8BF67D0C7B060A7C192E36FFCA9F1A0D90AC2DBBDAF429EE1EC97E160EB00DC80B07000935304F3")
     );
-    EXPECT_STREQ(
-        b->accountBalanceMerkleRootHash.getHex().c_str(),
-        "3225DFF071CD0CCFF736B0B159CC722963310C008472BE814669451A062C25C5F7654F079D3E0AE1CF2FDA1551A5A0B1F5E988383BE7D383D57F73D4012C4024"
+    EXPECT_EQ(
+        b->accountBalanceMerkleRootHash.getHex(),
+        IdHex("3225DFF071CD0CCFF736B0B159CC722963310C008472BE814669451A062C25C5F7654F079D3E0AE1CF2FDA1551A5A0B1F5E988383BE7D383D57F73D4012C4024")
     );
 }
+
+TEST_F(BlockStorageTest, Has_Block){
+    EXPECT_TRUE(blockS->hasBlock(block_id));
+    byteId_t unknown;
+    EXPECT_FALSE(blockS->hasBlock(unknown));
+}
+
+TEST_F(BlockStorageTest, Raw_Block){
+    PQB::byteBuffer buffer;
+    ASSERT_TRUE(blockS->getRawBlock(block_id, buffer));
+    PQB::Block b;
+    size_t offset = 0;
+    b.deserialize(buffer, offset);
+    EXPECT_EQ(b.getBlockHash(), block_id);
+}
+
+TEST_F(BlockStorageTest, Prune_Signatures){
+    PQB::TransactionPtr tx = std::make_shared<PQB::Transaction>();
+    tx->IDHash.setHex("21B4F4BD9E64ED355C3EB676A28EBEDAF6D8F17BDC365995B319097153044080516BD083BFCCE66121A3072646994C8430CC382B8DC543E84880183BF856CFF5");
+    tx->sequenceNumber = 1;
+    tx->signature.resize(64, 'c');
+    tx->signatureSize = 64;
+    tx->senderWalletAddress.setHex("CF83E1357EEFB8BDF1542850D66D8007D620E4050B5715DC83F4A921D36CE9CE47D0D13C5D85F2B0FF8318D2877EEC2F63B931BD47417A81A538327AF927DA3E");
+    tx->receiverWalletAddress.setHex("CF83E1357EEFB8BDF1542850D66D8007D620E4050B5715DC83F4A921D36CE9CE47D0D13C5D85F2B0FF8318D2877EEC2F63B931BD47417A81A538327AF927DA3E");
+    block.addTransaction(tx);
+    block.sequence = 3;
+    block_id = block.getBlockHash();
+    ASSERT_TRUE(blockS->setBlock(&block));
+
+    PQB::Block *b = blockS->getBlock(block_id);
+    ASSERT_TRUE(b != nullptr);
+    EXPECT_EQ(b->txSet.size(), 1);
+    EXPECT_TRUE(b->hasSignatures());
+    delete b;
+    b = blockS->getBlock(block_id, false);
+    ASSERT_TRUE(b != nullptr);
+    EXPECT_FALSE(b->hasSignatures());
+    delete b;
+
+    EXPECT_GE(blockS->pruneSignatures(4), 1);
+    b = blockS->getBlock(block_id);
+    ASSERT_TRUE(b != nullptr);
+    EXPECT_EQ(b->txSet.size(), 1);
+    EXPECT_FALSE(b->hasSignatures());
+    delete b;
+}
@@ -3,6 +3,8 @@
 #include "Log.hpp"
 #include "Account.hpp"
 #include "Signer.hpp"
+#include "TestIds.hpp"
+#include "TestSigner.hpp"
 
 
 struct AccountTest : testing::Test{
@@ -11,6 +13,7 @@ struct AccountTest : testing::Test{
 
     void SetUp() {
         PQB::Log::init(); // to avoid segfault from uninitialized logger
+        PQB_REQUIRE_SIGN_ALGORITHM("ed25519");
         auto ss = PQB::Signer::GetInstance("ed25519");
 
         acc.balance = 42;
@@ -51,9 +54,9 @@ TEST_F(AccountTest, Serialize_Deserialize){
 }
 
 TEST_F(AccountTest, Hash){
-    byte64_t id = acc.getAccountID();
-    EXPECT_STREQ(
-        id.getHex().c_str(),
-        "7308948D99219C5D1DCA24F1FC07AAD940F821B53F17876AF3A12EC12A7463DC4234154CB281437A319EDB53220F110D8D51C5B716092BDFB4853D4809404AC3"
+    byteId_t id = acc.getAccountID();
+    EXPECT_EQ(
+        id.getHex(),
+        IdHex("7308948D99219C5D1DCA24F1FC07AAD940F821B53F17876AF3A12EC12A7463DC4234154CB281437A319EDB53220F110D8D51C5B716092BDFB4853D4809404AC3")
     );
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 
 #include <gtest/gtest.h>
+#include "Log.hpp"
 #include "Block.hpp"
+#include "TestIds.hpp"
+#include "TestSigner.hpp"
 
 
 struct BlockTest : testing::Test{
@@ -13,6 +16,9 @@ struct BlockTest : testing::Test{
     PQB::TransactionPtr tx3;
 
     void SetUp() { 
+        PQB::Log::init(); // to avoid segfault from uninitialized logger (signer is used in deserialization of transactions)
+        PQB_REQUIRE_SIGN_ALGORITHM("ed25519");
+        PQB::Signer::GetInstance("ed25519");
         tx1 = std::make_shared<PQB::Transaction>();
         tx2 = std::make_shared<PQB::Transaction>();
         tx3 = std::make_shared<PQB::Transaction>();
@@ -43,6 +49,7 @@ struct BlockTest : testing::Test{
 
         block.previousBlockHash.setHex("3173F0564AB9462B0978A765C1283F96F05AC9E9F8361EE1006DC905C153D85BF0E4C45622E5E990ABCF48FB5192AD34722E8D6A723278B39FEF9E4F9FC62378");
         block.transactionsMerkleRootHash.setHex("4921DE1EDB2ECC8CA3A22823705194B902CFA471675F2D1AE8BF67D0C7B060A7C192E36FFCA9F1A0D90AC2DBBDAF429EE1EC97E160EB00DC80B07000935304F3");
+        block.signaturesMerkleRootHash.setHex("905F2C7F971992EB39F4EDC1520E4C14663176134EF35B9F056C3EA4D829EC1BA215EB81301879806D33BBDA259F8A68FF9BA1543921EC242B7ABC1888D9F0B1");
         block.accountBalanceMerkleRootHash.setHex("3225DFF071CD0CCFF736B0B159CC722963310C008472BE814669451A062C25C5F7654F079D3E0AE1CF2FDA1551A5A0B1F5E988383BE7D383D57F73D4012C4024");
         block.sequence = 2;
         block.version = 1;
@@ -51,13 +58,14 @@ struct BlockTest : testing::Test{
         empty_block.transactionCount = 0;
         empty_block.previousBlockHash.setHex("3173F0564AB9462B0978A765C1283F96F05AC9E9F8361EE1006DC905C153D85BF0E4C45622E5E990ABCF48FB5192AD34722E8D6A723278B39FEF9E4F9FC62378");
         empty_block.transactionsMerkleRootHash.setHex("4921DE1EDB2ECC8CA3A22823705194B902CFA471675F2D1AE8BF67D0C7B060A7C192E36FFCA9F1A0D90AC2DBBDAF429EE1EC97E160EB00DC80B07000935304F3");
+        empty_block.signaturesMerkleRootHash.setHex("905F2C7F971992EB39F4EDC1520E4C14663176134EF35B9F056C3EA4D829EC1BA215EB81301879806D33BBDA259F8A68FF9BA1543921EC242B7ABC1888D9F0B1");
         empty_block.accountBalanceMerkleRootHash.setHex("3225DFF071CD0CCFF736B0B159CC722963310C008472BE814669451A062C25C5F7654F079D3E0AE1CF2FDA1551A5A0B1F5E988383BE7D383D57F73D4012C4024");
         empty_block.sequence = 2;
         empty_block.version = 1;
     }
 
     void TearDown() { 
-
+        spdlog::drop_all();
     }
 };
 
@@ -70,17 +78,17 @@ TEST_F(BlockTest, Serialize_Deserialize){
     PQB::Block b;
     offset = 0;
     b.deserialize(buffer, offset);
-    EXPECT_STREQ(
-        b.previousBlockHash.getHex().c_str(),
-        "3173F0564AB9462B0978A765C1283F96F05AC9E9F8361EE1006DC905C153D85BF0E4C45622E5E990ABCF48FB5192AD34722E8D6A723278B39FEF9E4F9FC62378"
+    EXPECT_EQ(
+        b.previousBlockHash.getHex(),
+        IdHex("3173F0564AB9462B0978A765C1283F96F05AC9E9F8361EE1006DC905C153D85BF0E4C45622E5E990ABCF48FB5192AD34722E8D6A723278B39FEF9E4F9FC62378")
     );
-    EXPECT_STREQ(
-        b.transactionsMerkleRootHash.getHex().c_str(),
-        "4921DE1EDB2ECC8CA3A22823705194B902CFA471675F2D1AE8BF67D0C7B060A7C192E36FFCA9F1A0D90AC2DBBDAF429EE1EC97E160EB00DC80B07000935304F3"
+    EXPECT_EQ(
+        b.transactionsMerkleRootHash.getHex(),
+        IdHex("4921DE1EDB2ECC8CA3A22823705194B902CFA471675F2D1AE8BF67D0C7B060A7C192E36FFCA9F1A0D90AC2DBBDAF429EE1EC97E160EB00DC80B07000935304F3")
     );
-    EXPECT_STREQ(
-        b.accountBalanceMerkleRootHash.getHex().c_str(),
-        "3225DFF071CD0CCFF736B0B159CC722963310C008472BE814669451A062C25C5F7654F079D3E0AE1CF2FDA1551A5A0B1F5E988383BE7D383D57F73D4012C4024"
+    EXPECT_EQ(
+        b.accountBalanceMerkleRootHash.getHex(),
+        IdHex("3225DFF071CD0CCFF736B0B159CC722963310C008472BE814669451A062C25C5F7654F079D3E0AE1CF2FDA1551A5A0B1F5E988383BE7D383D57F73D4012C4024")
     );
     EXPECT_EQ(b.version, 1);
     EXPECT_EQ(b.sequence, 2);
@@ -99,17 +107,17 @@ TEST_F(BlockTest, Serialize_Deserialize_Empty){
     PQB::Block b;
     offset = 0;
     b.deserialize(buffer, offset);
-    EXPECT_STREQ(
-        b.previousBlockHash.getHex().c_str(),
-        "3173F0564AB9462B0978A765C1283F96F05AC9E9F8361EE1006DC905C153D85BF0E4C45622E5E990ABCF48FB5192AD34722E8D6A723278B39FEF9E4F9FC62378"
+    EXPECT_EQ(
+        b.previousBlockHash.getHex(),
+        IdHex("3173F0564AB9462B0978A765C1283F96F05AC9E9F8361EE1006DC905C153D85BF0E4C45622E5E990ABCF48FB5192AD34722E8D6A723278B39FEF9E4F9FC62378")
     );
-    EXPECT_STREQ(
-        b.transactionsMerkleRootHash.getHex().c_str(),
-        "4921DE1EDB2ECC8CA3A22823705194B902CFA471675F2D1AE8BF67D0C7B060A7C192E36FFCA9F1A0D90AC2DBBDAF429EE1EC97E160EB00DC80B07000935304F3"
+    EXPECT_EQ(
+        b.transactionsMerkleRootHash.getHex(),
+        IdHex("4921DE1EDB2ECC8CA3A22823705194B902CFA471675F2D1AE8BF67D0C7B060A7C192E36FFCA9F1A0D90AC2DBBDAF429EE1EC97E160EB00DC80B07000935304F3")
     );
-    EXPECT_STREQ(
-        b.accountBalanceMerkleRootHash.getHex().c_str(),
-        "3225DFF071CD0CCFF736B0B159CC722963310C008472BE814669451A062C25C5F7654F079D3E0AE1CF2FDA1551A5A0B1F5E988383BE7D383D57F73D4012C4024"
+    EXPECT_EQ(
+        b.accountBalanceMerkleRootHash.getHex(),
+        IdHex("3225DFF071CD0CCFF736B0B159CC722963310C008472BE814669451A062C25C5F7654F079D3E0AE1CF2FDA1551A5A0B1F5E988383BE7D383D57F73D4012C4024")
     );
     EXPECT_EQ(b.version, 1);
     EXPECT_EQ(b.sequence, 2);
@@ -125,6 +133,14 @@ TEST_F(BlockTest, Missing_Merkle_Root){
     EXPECT_THROW(block.serialize(buffer, offset), PQB::Exceptions::Block);
 }
 
+TEST_F(BlockTest, Missing_Signatures_Merkle_Root){
+    block.signaturesMerkleRootHash.SetNull();
+    PQB::byteBuffer buffer;
+    buffer.resize(block.getSize());
+    size_t offset = 0;
+    EXPECT_THROW(block.serialize(buffer, offset), PQB::Exceptions::Block);
+}
+
 TEST_F(BlockTest, Missing_Previous_Hash){
     block.previousBlockHash.SetNull();
     PQB::byteBuffer buffer;
@@ -142,9 +158,51 @@ TEST_F(BlockTest, Missing_Account_Hash){
 }
 
 TEST_F(BlockTest, Hash){
-    byte64_t blockHash = block.getBlockHash();
-    EXPECT_STREQ(
-        blockHash.getHex().c_str(),
-        "5788A5C113EBBA196D252F165F9AA08570FB9B31CAF8DCF32925F350DD70907A72F09B09802AE0926A13E49BD934B1AC1291FC12738504DCBF3A9DB60A1CE858"
+    byteId_t blockHash = block.getBlockHash();
+    EXPECT_EQ(
+        blockHash.getHex(),
+        IdHex(
+            "50F4549FE4BB08A4D5B02AE4EC4938C453DEA76B01482CB4EBA60111AC7DCCDEA602F94B4DAC4543B4C4F6B2377F82CC32BB0D865002F04B9FEEBF33A630C6FF",
+            "2951BEAD8C7F1EE60B360F64F0A4F0B0742F70D3A00626F201017BF79F007B0E"
+        )
     );
-}
\ No newline at end of file
+}
+
+TEST_F(BlockTest, Serialize_Without_Signatures){
+    PQB::byteBuffer buffer;
+    buffer.resize(block.getSize(false));
+    EXPECT_EQ(block.getSize(false) + block.getSignaturesSize(), block.getSize());
+    size_t offset = 0;
+    block.serialize(buffer, offset, false);
+    EXPECT_EQ(offset, buffer.size());
+    PQB::Block b;
+    offset = 0;
+    b.deserialize(buffer, offset);
+    EXPECT_EQ(b.txSet.size(), 3);
+    EXPECT_FALSE(b.hasSignatures());
+
+    // signatures section can be added later
+    PQB::byteBuffer signatures;
+    signatures.resize(block.getSignaturesSize());
+    offset = 0;
+    block.serializeSignatures(signatures, offset);
+    offset = 0;
+    b.deserializeSignatures(signatures, offset);
+    EXPECT_TRUE(b.hasSignatures());
+    for (const auto &tx : b.txSet){
+        EXPECT_EQ(tx->signature, tx1->signature);
+    }
+}
+
+TEST_F(BlockTest, Skip_Signatures){
+    PQB::byteBuffer buffer;
+    buffer.resize(block.getSize());
+    size_t offset = 0;
+    block.serialize(buffer, offset);
+    PQB::Block b;
+    offset = 0;
+    b.deserialize(buffer, offset, false);
+    EXPECT_EQ(b.txSet.size(), 3);
+    EXPECT_FALSE(b.hasSignatures());
+    EXPECT_EQ(offset, block.getSize(false));
+}
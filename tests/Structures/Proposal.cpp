@@ -1,17 +1,43 @@
 
 #include <gtest/gtest.h>
+#include "Log.hpp"
 #include "Proposal.hpp"
+#include "TestSigner.hpp"
 
 struct TxProposalTest : testing::Test{
 
     PQB::TxSetProposal *txProposal;
 
     void SetUp() { 
+        PQB::Log::init(); // to avoid segfault from uninitialized logger (signer is used in deserialization of transactions)
+        PQB_REQUIRE_SIGN_ALGORITHM("ed25519");
+        PQB::Signer::GetInstance("ed25519");
         txProposal = new PQB::TxSetProposal();
     }
 
     void TearDown() { 
         delete txProposal;
+        spdlog::drop_all();
+    }
+
+    /// @brief Create transaction with a dummy signature and given sequence number
+    PQB::TransactionPtr createTransaction(uint32_t sequenceNumber){
+        PQB::TransactionPtr tx = std::make_shared<PQB::Transaction>();
+        tx->receiverWalletAddress.setHex("ABC");
+        tx->senderWalletAddress.setHex("CAB");
+        tx->signature.resize(64, 'c');
+        tx->signatureSize = 64;
+        tx->sequenceNumber = sequenceNumber;
+        tx->setHash();
+        return tx;
+    }
+
+    /// @brief Set sequence number, issuer and a dummy signature of txProposal
+    void signProposal(uint32_t seq){
+        txProposal->seq = seq;
+        txProposal->issuer.setHex("DEF");
+        txProposal->signature.resize(64, 'c');
+        txProposal->signatureSize = 64;
     }
 };
 
@@ -30,8 +56,8 @@ struct BlockProposalTest : testing::Test{
 
 
 TEST_F(TxProposalTest, Hash){
-    byte64_t hash1;
-    byte64_t hash2;
+    byteId_t hash1;
+    byteId_t hash2;
     PQB::TxSetProposal p;
     txProposal->getHash(hash1);
     p.getHash(hash2);
@@ -110,4 +136,153 @@ TEST_F(TxProposalTest, Deserialize_from_Small_Buffer){
     PQB::byteBuffer buffer;
     size_t offset = 0;
     EXPECT_THROW(txProposal->deserialize(buffer, offset), PQB::Exceptions::Proposal);
-}
\ No newline at end of file
+}
+
+TEST_F(TxProposalTest, Compact_Serialize_Deserialize){
+    for (uint32_t i = 1; i <= 3; i++){
+        txProposal->txSet.addTransaction(createTransaction(i));
+    }
+    signProposal(42);
+
+    PQB::CompactTxSetProposal compact(*txProposal, 7);
+    compact.prefilled.addTransaction(*txProposal->txSet.txSet.begin());
+    EXPECT_EQ(compact.shortIds.size(), 3);
+    EXPECT_LT(compact.getSize(), txProposal->getSize());
+
+    PQB::byteBuffer buffer;
+    size_t offset = 0;
+    buffer.resize(compact.getSize());
+    compact.serialize(buffer, offset);
+    EXPECT_EQ(offset, buffer.size());
+
+    offset = 0;
+    PQB::CompactTxSetProposal cp;
+    cp.deserialize(buffer, offset);
+    EXPECT_EQ(cp.proposal.seq, 42);
+    EXPECT_EQ(cp.proposal.txSet.transactionCount, 3);
+    EXPECT_EQ(cp.salt, 7);
+    EXPECT_EQ(cp.shortIds, compact.shortIds);
+    ASSERT_EQ(cp.prefilled.txSet.size(), 1);
+    EXPECT_TRUE((*cp.prefilled.txSet.begin())->IDHash == (*txProposal->txSet.txSet.begin())->IDHash);
+    // signed hash of the compact proposal is the hash of the original proposal
+    byteId_t hash1, hash2;
+    txProposal->getHash(hash1);
+    cp.proposal.getHash(hash2);
+    EXPECT_TRUE(hash1 == hash2);
+
+    // short IDs are in order of the transaction set and they depend on the salt
+    PQB::byte key[PQB::HashMan::SIPHASH_KEY_SIZE];
+    cp.getShortIdKey(key);
+    size_t i = 0;
+    for (const auto &tx : txProposal->txSet.txSet){
+        EXPECT_EQ(cp.shortIds[i++], PQB::CompactTxSetProposal::getShortId(key, tx->IDHash));
+    }
+    PQB::CompactTxSetProposal otherSalt(*txProposal, 8);
+    EXPECT_NE(otherSalt.shortIds, compact.shortIds);
+}
+
+TEST_F(TxProposalTest, Compact_Deserialize_Truncated){
+    txProposal->seq = 42;
+    txProposal->signature.resize(64, 'c');
+    txProposal->signatureSize = 64;
+    PQB::CompactTxSetProposal compact(*txProposal, 7);
+    compact.proposal.txSet.transactionCount = 1000000; // more short IDs than the buffer has
+    compact.shortIds.resize(1000000);
+
+    PQB::byteBuffer buffer;
+    size_t offset = 0;
+    buffer.resize(compact.getSize());
+    compact.serialize(buffer, offset);
+    buffer.resize(compact.proposal.getSizeExceptTxSet() + 100);
+
+    offset = 0;
+    PQB::CompactTxSetProposal cp;
+    EXPECT_THROW(cp.deserialize(buffer, offset), PQB::Exceptions::Proposal);
+}
+
+TEST_F(TxProposalTest, Delta_Serialize_Deserialize){
+    std::vector<PQB::TransactionPtr> txs;
+    for (uint32_t i = 1; i <= 4; i++){
+        txs.push_back(createTransaction(i));
+    }
+    PQB::TransactionSet baseSet = {txs[0], txs[1], txs[2]};
+    PQB::TransactionSet newSet = {txs[1], txs[2], txs[3]};
+    byteId_t baseId;
+    baseId.setHex("BA5E");
+    PQB::TxSetDeltaProposal delta(4, baseId, baseSet, newSet);
+    ASSERT_EQ(delta.removed.size(), 1);
+    ASSERT_EQ(delta.added.size(), 1);
+    EXPECT_TRUE(delta.removed[0] == txs[0]->IDHash);
+    EXPECT_TRUE(delta.added[0] == txs[3]->IDHash);
+
+    txProposal->txSet.txSet = newSet;
+    signProposal(5);
+    delta.proposal.setExceptTxSet(*txProposal);
+
+    PQB::byteBuffer buffer;
+    size_t offset = 0;
+    buffer.resize(delta.getSize());
+    delta.serialize(buffer, offset);
+    EXPECT_EQ(offset, buffer.size());
+
+    offset = 0;
+    PQB::TxSetDeltaProposal dp;
+    dp.deserialize(buffer, offset);
+    EXPECT_EQ(dp.proposal.seq, 5);
+    EXPECT_EQ(dp.proposal.txSet.transactionCount, 3);
+    EXPECT_EQ(dp.baseSeq, 4);
+    EXPECT_TRUE(dp.baseTxSetId == baseId);
+    EXPECT_EQ(dp.removed, delta.removed);
+    EXPECT_EQ(dp.added, delta.added);
+    // signed hash of the delta proposal is the hash of the original proposal
+    byteId_t hash1, hash2;
+    txProposal->getHash(hash1);
+    dp.proposal.getHash(hash2);
+    EXPECT_TRUE(hash1 == hash2);
+
+    buffer.resize(buffer.size() - 1);
+    offset = 0;
+    EXPECT_THROW(dp.deserialize(buffer, offset), PQB::Exceptions::Proposal);
+}
+
+TEST_F(TxProposalTest, Sketch_Serialize_Deserialize){
+    for (uint32_t i = 1; i <= 3; i++){
+        txProposal->txSet.addTransaction(createTransaction(i));
+    }
+    signProposal(42);
+
+    PQB::TxSetSketchProposal sketchProp(*txProposal, 7, 4);
+    sketchProp.prefilled.addTransaction(*txProposal->txSet.txSet.begin());
+    EXPECT_EQ(sketchProp.sketch.getCellCount(), PQB::SetSketch::getCellCount(4));
+
+    PQB::byteBuffer buffer;
+    size_t offset = 0;
+    buffer.resize(sketchProp.getSize());
+    sketchProp.serialize(buffer, offset);
+    EXPECT_EQ(offset, buffer.size());
+
+    offset = 0;
+    PQB::TxSetSketchProposal sp;
+    sp.deserialize(buffer, offset);
+    EXPECT_EQ(sp.proposal.seq, 42);
+    EXPECT_EQ(sp.proposal.txSet.transactionCount, 3);
+    EXPECT_EQ(sp.salt, 7);
+    EXPECT_EQ(sp.prefilled.txSet.size(), 1);
+
+    // sketch of the same short IDs decodes empty difference, a missing transaction is decoded
+    PQB::byte key[PQB::HashMan::SIPHASH_KEY_SIZE];
+    sp.getShortIdKey(key);
+    PQB::SetSketch ours(sp.sketch.getCellCount());
+    auto lastTx = *txProposal->txSet.txSet.rbegin();
+    for (const auto &tx : txProposal->txSet.txSet){
+        if (tx != lastTx){
+            ours.insert(PQB::CompactTxSetProposal::getShortId(key, tx->IDHash));
+        }
+    }
+    ASSERT_TRUE(sp.sketch.subtract(ours));
+    std::vector<uint64_t> onlyPeer, onlyOur;
+    ASSERT_TRUE(sp.sketch.decode(onlyPeer, onlyOur));
+    ASSERT_EQ(onlyPeer.size(), 1);
+    EXPECT_EQ(onlyPeer[0], PQB::CompactTxSetProposal::getShortId(key, lastTx->IDHash));
+    EXPECT_TRUE(onlyOur.empty());
+}
@@ -0,0 +1,126 @@
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "SetSketch.hpp"
+
+
+struct SetSketchTest : testing::Test{
+
+    std::vector<uint64_t> keys;
+
+    void SetUp() {
+        uint64_t key = 0x0123456789ABCDEFULL;
+        for (size_t i = 0; i < 1000; i++){
+            key = key * 6364136223846793005ULL + 1442695040888963407ULL;
+            keys.push_back(key);
+        }
+    }
+
+    void TearDown() {
+
+    }
+};
+
+
+TEST_F(SetSketchTest, Decode_Difference){
+    // sets share 990 keys, the first set has 6 more keys and the second set 4 more keys
+    PQB::SetSketch first(PQB::SetSketch::getCellCount(16));
+    PQB::SetSketch second(PQB::SetSketch::getCellCount(16));
+    for (size_t i = 0; i < 996; i++){
+        first.insert(keys[i]);
+    }
+    for (size_t i = 6; i < 1000; i++){
+        second.insert(keys[i]);
+    }
+    ASSERT_TRUE(first.subtract(second));
+    std::vector<uint64_t> onlyFirst, onlySecond;
+    ASSERT_TRUE(first.decode(onlyFirst, onlySecond));
+    std::sort(onlyFirst.begin(), onlyFirst.end());
+    std::sort(onlySecond.begin(), onlySecond.end());
+    std::vector<uint64_t> expectedFirst(keys.begin(), keys.begin() + 6);
+    std::vector<uint64_t> expectedSecond(keys.begin() + 996, keys.end());
+    std::sort(expectedFirst.begin(), expectedFirst.end());
+    std::sort(expectedSecond.begin(), expectedSecond.end());
+    EXPECT_EQ(onlyFirst, expectedFirst);
+    EXPECT_EQ(onlySecond, expectedSecond);
+}
+
+TEST_F(SetSketchTest, Same_Sets){
+    PQB::SetSketch first(PQB::SetSketch::getCellCount(4));
+    PQB::SetSketch second(PQB::SetSketch::getCellCount(4));
+    for (const auto key : keys){
+        first.insert(key);
+        second.insert(key);
+    }
+    ASSERT_TRUE(first.subtract(second));
+    std::vector<uint64_t> onlyFirst, onlySecond;
+    EXPECT_TRUE(first.decode(onlyFirst, onlySecond));
+    EXPECT_TRUE(onlyFirst.empty());
+    EXPECT_TRUE(onlySecond.empty());
+}
+
+TEST_F(SetSketchTest, Difference_Over_Capacity){
+    PQB::SetSketch first(PQB::SetSketch::getCellCount(4));
+    PQB::SetSketch second(PQB::SetSketch::getCellCount(4));
+    for (size_t i = 0; i < 500; i++){
+        first.insert(keys[i]);
+    }
+    for (size_t i = 300; i < 1000; i++){
+        second.insert(keys[i]);
+    }
+    ASSERT_TRUE(first.subtract(second));
+    std::vector<uint64_t> onlyFirst, onlySecond;
+    EXPECT_FALSE(first.decode(onlyFirst, onlySecond));
+
+    PQB::SetSketch other(PQB::SetSketch::getCellCount(8));
+    EXPECT_FALSE(first.subtract(other));
+}
+
+TEST_F(SetSketchTest, Crafted_Sketch_Is_Not_Decoded){
+    // sketch with one key in the first cell only, peeling it makes the key pure in the other cells with opposite count
+    PQB::SetSketch sketch(PQB::SetSketch::PARTS);
+    sketch.insert(keys[0]);
+    PQB::byteBuffer buffer(sketch.getSize());
+    size_t offset = 0;
+    sketch.serialize(buffer, offset);
+    const size_t cellSize = sizeof(int32_t) + 2 * sizeof(uint64_t);
+    std::fill(buffer.begin() + sizeof(uint32_t) + cellSize, buffer.end(), 0);
+    PQB::SetSketch crafted;
+    offset = 0;
+    crafted.deserialize(buffer, offset);
+    ASSERT_EQ(crafted.getCellCount(), sketch.getCellCount());
+
+    std::vector<uint64_t> onlyThis, onlyOther;
+    EXPECT_FALSE(crafted.decode(onlyThis, onlyOther));
+    EXPECT_LE(onlyThis.size() + onlyOther.size(), crafted.getCellCount());
+}
+
+TEST_F(SetSketchTest, Serialize_Deserialize){
+    PQB::SetSketch sketch(PQB::SetSketch::getCellCount(8));
+    for (size_t i = 0; i < 10; i++){
+        sketch.insert(keys[i]);
+    }
+    PQB::byteBuffer buffer;
+    size_t offset = 0;
+    buffer.resize(sketch.getSize());
+    sketch.serialize(buffer, offset);
+    EXPECT_EQ(offset, buffer.size());
+
+    offset = 0;
+    PQB::SetSketch ss;
+    ss.deserialize(buffer, offset);
+    EXPECT_EQ(ss.getCellCount(), sketch.getCellCount());
+    ASSERT_TRUE(ss.subtract(sketch));
+    std::vector<uint64_t> onlyFirst, onlySecond;
+    EXPECT_TRUE(ss.decode(onlyFirst, onlySecond));
+    EXPECT_TRUE(onlyFirst.empty() && onlySecond.empty());
+
+    buffer.resize(buffer.size() - 1);
+    offset = 0;
+    EXPECT_THROW(ss.deserialize(buffer, offset), PQB::Exceptions::Proposal);
+    // number of cells has to be a multiple of the number of parts
+    buffer.assign(sizeof(uint32_t), 0);
+    buffer[0] = 4;
+    offset = 0;
+    EXPECT_THROW(ss.deserialize(buffer, offset), PQB::Exceptions::Proposal);
+}
@@ -1,6 +1,9 @@
 
 #include <gtest/gtest.h>
+#include "Log.hpp"
 #include "Transaction.hpp"
+#include "TestIds.hpp"
+#include "TestSigner.hpp"
 
 
 struct TransactionTest : testing::Test{
@@ -8,6 +11,9 @@ struct TransactionTest : testing::Test{
     PQB::Transaction tx;
 
     void SetUp() { 
+        PQB::Log::init(); // to avoid segfault from uninitialized logger (signer is used in deserialization)
+        PQB_REQUIRE_SIGN_ALGORITHM("ed25519");
+        PQB::Signer::GetInstance("ed25519");
         tx.IDHash.setHex("21B4F4BD9E64ED355C3EB676A28EBEDAF6D8F17BDC365995B319097153044080516BD083BFCCE66121A3072646994C8430CC382B8DC543E84880183BF856CFF5");
         tx.signature.resize(64, 'c');
         tx.signatureSize = 64;
@@ -20,7 +26,7 @@ struct TransactionTest : testing::Test{
     }
 
     void TearDown() { 
-
+        spdlog::drop_all();
     }
 };
 
@@ -34,17 +40,17 @@ TEST_F(TransactionTest, Serialize_Deserialize){
     offset = 0;
     tx_t.deserialize(buffer, offset);
 
-    EXPECT_STREQ(
-        tx_t.IDHash.getHex().c_str(),
-        "21B4F4BD9E64ED355C3EB676A28EBEDAF6D8F17BDC365995B319097153044080516BD083BFCCE66121A3072646994C8430CC382B8DC543E84880183BF856CFF5"
+    EXPECT_EQ(
+        tx_t.IDHash.getHex(),
+        IdHex("21B4F4BD9E64ED355C3EB676A28EBEDAF6D8F17BDC365995B319097153044080516BD083BFCCE66121A3072646994C8430CC382B8DC543E84880183BF856CFF5")
     );
-    EXPECT_STREQ(
-        tx_t.senderWalletAddress.getHex().c_str(),
-        "CF83E1357EEFB8BDF1542850D66D8007D620E4050B5715DC83F4A921D36CE9CE47D0D13C5D85F2B0FF8318D2877EEC2F63B931BD47417A81A538327AF927DA3E"
+    EXPECT_EQ(
+        tx_t.senderWalletAddress.getHex(),
+        IdHex("CF83E1357EEFB8BDF1542850D66D8007D620E4050B5715DC83F4A921D36CE9CE47D0D13C5D85F2B0FF8318D2877EEC2F63B931BD47417A81A538327AF927DA3E")
     );
-    EXPECT_STREQ(
-        tx_t.receiverWalletAddress.getHex().c_str(),
-        "CF83E1357EEFB8BDF1542850D66D8007D620E4050B5715DC83F4A921D36CE9CE47D0D13C5D85F2B0FF8318D2877EEC2F63B931BD47417A81A538327AF927DA3E"
+    EXPECT_EQ(
+        tx_t.receiverWalletAddress.getHex(),
+        IdHex("CF83E1357EEFB8BDF1542850D66D8007D620E4050B5715DC83F4A921D36CE9CE47D0D13C5D85F2B0FF8318D2877EEC2F63B931BD47417A81A538327AF927DA3E")
     );
     EXPECT_EQ(tx_t.cashAmount, 42);
     EXPECT_EQ(tx_t.sequenceNumber, 11);
@@ -81,4 +87,114 @@ TEST_F(TransactionTest, Missing_ID){
     buffer.resize(tx.getSize());
     size_t offset = 0;
     EXPECT_THROW(tx.serialize(buffer, offset), PQB::Exceptions::Transaction);
-}
\ No newline at end of file
+}
+
+TEST_F(TransactionTest, Multi_Payment_Serialize_Deserialize){
+    tx.versionNumber = PQB::TX_VERSION_MULTI_PAYMENT;
+    tx.receiverWalletAddress.SetNull();
+    tx.outputs.resize(3);
+    for (size_t i = 0; i < tx.outputs.size(); i++){
+        tx.outputs[i].receiverWalletAddress = byteId_t(i + 1);
+        tx.outputs[i].cashAmount = 10 * (i + 1);
+    }
+    tx.cashAmount = 60;
+    EXPECT_TRUE(tx.checkTransactionStructure());
+
+    PQB::byteBuffer buffer;
+    buffer.resize(tx.getSize());
+    size_t offset = 0;
+    tx.serialize(buffer, offset);
+    EXPECT_EQ(offset, buffer.size());
+    PQB::Transaction tx_t;
+    offset = 0;
+    tx_t.deserialize(buffer, offset);
+
+    EXPECT_EQ(offset, buffer.size());
+    EXPECT_TRUE(tx_t.isMultiPayment());
+    EXPECT_TRUE(tx_t.receiverWalletAddress.IsNull());
+    ASSERT_EQ(tx_t.outputs.size(), 3);
+    for (size_t i = 0; i < tx_t.outputs.size(); i++){
+        EXPECT_TRUE(tx_t.outputs[i].receiverWalletAddress == byteId_t(i + 1));
+        EXPECT_EQ(tx_t.outputs[i].cashAmount, 10 * (i + 1));
+    }
+    EXPECT_EQ(tx_t.cashAmount, 60);
+    EXPECT_EQ(tx_t.getAmountFor(byteId_t(2)), 20);
+    EXPECT_EQ(tx_t.getAmountFor(byteId_t(4)), 0);
+    EXPECT_TRUE(tx_t.checkTransactionStructure());
+}
+
+TEST_F(TransactionTest, Multi_Payment_Invalid_Structure){
+    tx.versionNumber = PQB::TX_VERSION_MULTI_PAYMENT;
+    tx.receiverWalletAddress.SetNull();
+    EXPECT_FALSE(tx.checkTransactionStructure()); // no outputs
+    tx.outputs.push_back({.receiverWalletAddress=byteId_t(1), .cashAmount=10});
+    tx.outputs.push_back({.receiverWalletAddress=byteId_t(2), .cashAmount=10});
+    tx.cashAmount = 30;
+    EXPECT_FALSE(tx.checkTransactionStructure()); // cashAmount is not the sum of outputs
+    tx.cashAmount = 20;
+    EXPECT_TRUE(tx.checkTransactionStructure());
+    tx.outputs[1].receiverWalletAddress.SetNull();
+    EXPECT_FALSE(tx.checkTransactionStructure());
+    PQB::byteBuffer buffer;
+    buffer.resize(tx.getSize());
+    size_t offset = 0;
+    EXPECT_THROW(tx.serialize(buffer, offset), PQB::Exceptions::Transaction);
+}
+
+TEST_F(TransactionTest, Multi_Payment_Too_Many_Outputs){
+    tx.versionNumber = PQB::TX_VERSION_MULTI_PAYMENT;
+    tx.outputs.resize(PQB::MAX_TX_OUTPUTS + 1, {.receiverWalletAddress=byteId_t(1), .cashAmount=0});
+    tx.cashAmount = 0;
+    EXPECT_FALSE(tx.checkTransactionStructure());
+    PQB::byteBuffer buffer;
+    buffer.resize(tx.getSize());
+    size_t offset = 0;
+    EXPECT_THROW(tx.serialize(buffer, offset), PQB::Exceptions::Transaction);
+}
+
+TEST_F(TransactionTest, Multi_Payment_Truncated){
+    tx.versionNumber = PQB::TX_VERSION_MULTI_PAYMENT;
+    tx.outputs.resize(4, {.receiverWalletAddress=byteId_t(1), .cashAmount=1});
+    tx.cashAmount = 4;
+    PQB::byteBuffer buffer;
+    buffer.resize(tx.getSize());
+    size_t offset = 0;
+    tx.serialize(buffer, offset);
+    buffer.resize(buffer.size() - tx.signatureSize - 1);
+    PQB::Transaction tx_t;
+    offset = 0;
+    EXPECT_THROW(tx_t.deserialize(buffer, offset), PQB::Exceptions::Transaction);
+}
+
+TEST_F(TransactionTest, Batch_Signed_Serialize_Deserialize){
+    tx.versionNumber = PQB::TX_VERSION | PQB::TX_FLAG_BATCH_SIGNED;
+    tx.batchIndex = 5;
+    tx.batchPath = {byteId_t(1), byteId_t(2), byteId_t(3)};
+    EXPECT_TRUE(tx.isBatchSigned());
+    EXPECT_FALSE(tx.isMultiPayment());
+    EXPECT_EQ(tx.getVersion(), PQB::TX_VERSION);
+    EXPECT_FALSE(tx.getSignedHash() == tx.IDHash);
+
+    PQB::byteBuffer buffer;
+    buffer.resize(tx.getSize());
+    size_t offset = 0;
+    tx.serialize(buffer, offset);
+    EXPECT_EQ(offset, buffer.size());
+    PQB::Transaction tx_t;
+    offset = 0;
+    tx_t.deserialize(buffer, offset);
+    EXPECT_EQ(offset, buffer.size());
+    EXPECT_EQ(tx_t.batchIndex, 5);
+    ASSERT_EQ(tx_t.batchPath.size(), 3);
+    EXPECT_TRUE(tx_t.batchPath[2] == byteId_t(3));
+    EXPECT_TRUE(tx_t.getSignedHash() == tx.getSignedHash());
+}
+
+TEST_F(TransactionTest, Batch_Signed_Invalid_Index){
+    tx.versionNumber = PQB::TX_VERSION | PQB::TX_FLAG_BATCH_SIGNED;
+    tx.batchPath = {byteId_t(1), byteId_t(2)};
+    tx.batchIndex = 3;
+    EXPECT_TRUE(tx.checkTransactionStructure());
+    tx.batchIndex = 4; // batch with audit path of length 2 has at most 4 transactions
+    EXPECT_FALSE(tx.checkTransactionStructure());
+}
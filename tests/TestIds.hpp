@@ -0,0 +1,29 @@
+/**
+ * @file TestIds.hpp
+ * @author Michal Ľaš
+ * @brief Expected values of identifiers in tests, which have 64 bytes or 32 bytes with SHORT_IDS option (PQB_ID_BITS)
+ * @date 2024-05-22
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <string>
+#include "Blob.hpp"
+
+
+/// @brief Get hex of identifier set by setHex() from given 64-byte hex string (identifiers with 32 bytes keep just its prefix).
+/// The same holds for SHA-512 hashes of data, which are truncated to the size of identifiers.
+inline std::string IdHex(const std::string &hex512){
+    return hex512.substr(0, 2 * byteId_t::size());
+}
+
+/// @brief Choose expected hex by the size of identifiers. Hashes computed from identifiers (Merkle roots, block hashes)
+/// are not prefixes of each other, so they need a vector for each size.
+inline std::string IdHex(const std::string &hex512, const std::string &hex256){
+    return PQB_ID_BITS == 256 ? hex256 : hex512;
+}
+
+/* END OF FILE */
@@ -0,0 +1,30 @@
+/**
+ * @file TestSigner.hpp
+ * @author Michal Ľaš
+ * @brief Skipping of tests written for other signature algorithm than the one fixed at compile time (SIGN_ALGORITHM)
+ * @date 2024-05-23
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <gtest/gtest.h>
+#include <string>
+
+
+/// @brief Skip the test if the program is compiled only with other signature algorithm (PQB_SIGN_ALGORITHM_NAME).
+/// Signer::GetInstance() would throw for the given algorithm, so it has to be used in the test or SetUp() before it.
+#ifdef PQB_SIGN_ALGORITHM_NAME
+#define PQB_REQUIRE_SIGN_ALGORITHM(name) \
+    do { \
+        if (std::string(PQB_SIGN_ALGORITHM_NAME) != (name)){ \
+            GTEST_SKIP() << "Program was compiled only with " PQB_SIGN_ALGORITHM_NAME " signature algorithm"; \
+        } \
+    } while (0)
+#else
+#define PQB_REQUIRE_SIGN_ALGORITHM(name) do {} while (0)
+#endif
+
+/* END OF FILE */
@@ -5,15 +5,18 @@
 #include "Wallet.hpp"
 #include "Transaction.hpp"
 #include "PQBtypedefs.hpp"
+#include "TestIds.hpp"
+#include "TestSigner.hpp"
 
 
 struct WalletTest : testing::Test{
 
     PQB::Wallet *wallet;
-    byte64_t tx_id;
+    byteId_t tx_id;
 
     void SetUp() {
         PQB::Log::init(); // to avoid segfault from uninitialized logger
+        PQB_REQUIRE_SIGN_ALGORITHM("ed25519");
         auto ss = PQB::Signer::GetInstance("ed25519");
 
         tx_id.setHex("CF83E1357EEFB8BDF1542850D66D8007D620E4050B5715DC83F4A921D36CE9CE47D0D13C5D85F2B0FF8318D2877EEC2F63B931BD47417A81A538327AF927DA3E");
@@ -48,9 +51,51 @@ TEST_F(WalletTest, Create_Transaction){
         tx->senderWalletAddress.getHex().c_str(),
         wallet->getWalletID().getHex().c_str()
     );
-    EXPECT_STREQ(
-        tx->receiverWalletAddress.getHex().c_str(),
-        "3173F0564AB9462B0978A765C1283F96F05AC9E9F8361EE1006DC905C153D85BF0E4C45622E5E990ABCF48FB5192AD34722E8D6A723278B39FEF9E4F9FC62378"
+    EXPECT_EQ(
+        tx->receiverWalletAddress.getHex(),
+        IdHex("3173F0564AB9462B0978A765C1283F96F05AC9E9F8361EE1006DC905C153D85BF0E4C45622E5E990ABCF48FB5192AD34722E8D6A723278B39FEF9E4F9FC62378")
     );
     EXPECT_TRUE(tx->verify(wallet->getPublicKey()));
-}
\ No newline at end of file
+}
+
+TEST_F(WalletTest, Create_Multi_Payment_Transaction){
+    std::vector<std::pair<std::string, PQB::cash>> payments = {
+        {"3173F0564AB9462B0978A765C1283F96F05AC9E9F8361EE1006DC905C153D85BF0E4C45622E5E990ABCF48FB5192AD34722E8D6A723278B39FEF9E4F9FC62378", 10},
+        {"CF83E1357EEFB8BDF1542850D66D8007D620E4050B5715DC83F4A921D36CE9CE47D0D13C5D85F2B0FF8318D2877EEC2F63B931BD47417A81A538327AF927DA3E", 25}
+    };
+    PQB::TransactionPtr tx = wallet->createNewTransaction(payments);
+    ASSERT_TRUE(tx != nullptr);
+    EXPECT_EQ(wallet->getBalance(), 9965);
+    EXPECT_EQ(tx->cashAmount, 35);
+    EXPECT_EQ(tx->versionNumber, PQB::TX_VERSION_MULTI_PAYMENT);
+    ASSERT_EQ(tx->outputs.size(), 2);
+    EXPECT_EQ(tx->outputs[1].cashAmount, 25);
+    EXPECT_TRUE(tx->checkTransactionStructure());
+    EXPECT_TRUE(tx->verify(wallet->getPublicKey()));
+
+    payments.clear();
+    EXPECT_TRUE(wallet->createNewTransaction(payments) == nullptr);
+}
+
+TEST_F(WalletTest, Create_Transaction_Batch){
+    std::vector<std::pair<std::string, PQB::cash>> payments;
+    for (PQB::cash amount = 1; amount <= 5; amount++){
+        payments.emplace_back("3173F0564AB9462B0978A765C1283F96F05AC9E9F8361EE1006DC905C153D85BF0E4C45622E5E990ABCF48FB5192AD34722E8D6A723278B39FEF9E4F9FC62378", amount);
+    }
+    uint32_t sequence = wallet->getTxSeqNum();
+    std::vector<PQB::TransactionPtr> batch = wallet->createNewTransactionBatch(payments);
+    ASSERT_EQ(batch.size(), 5);
+    EXPECT_EQ(wallet->getBalance(), 9985);
+    for (size_t i = 0; i < batch.size(); i++){
+        EXPECT_TRUE(batch[i]->isBatchSigned());
+        EXPECT_EQ(batch[i]->sequenceNumber, sequence + i + 1);
+        EXPECT_EQ(batch[i]->batchIndex, i);
+        EXPECT_TRUE(batch[i]->signature == batch[0]->signature);
+        EXPECT_TRUE(batch[i]->getSignedHash() == batch[0]->getSignedHash());
+        EXPECT_TRUE(batch[i]->checkTransactionStructure());
+        EXPECT_TRUE(batch[i]->verify(wallet->getPublicKey()));
+    }
+    // a transaction moved to other position of the batch is not valid
+    batch[1]->batchIndex = 2;
+    EXPECT_FALSE(batch[1]->verify(wallet->getPublicKey()));
+}